@@ -174,9 +174,10 @@ static uint16_t odp_key_hash(void *key, uint32_t key_size)
 	register uint32_t hash = 0;
 	uint32_t idx = (key_size == 0 ? 1 : key_size);
 	uint32_t ch;
+	const char *ptr = key;
 
 	while (idx != 0) {
-		ch = (uint32_t)(*(char *)key);
+		ch = (uint32_t)(*ptr++);
 		hash = hash * 131 + ch;
 		idx--;
 	}
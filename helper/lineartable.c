@@ -71,7 +71,7 @@ odph_table_t odph_linear_table_create(const char *name, uint32_t capacity,
 	/* clean this block of memory */
 	memset(tbl, 0, capacity << 20);
 
-	tbl->init_cap = capacity < 20;
+	tbl->init_cap = capacity << 20;
 
 	strncpy(tbl->name, name, ODPH_TABLE_NAME_LEN - 1);
 
@@ -82,7 +82,9 @@ odph_table_t odph_linear_table_create(const char *name, uint32_t capacity,
 
 	tbl->value_size = value_size + sizeof(odp_rwlock_t);
 
-	node_num = tbl->init_cap / tbl->value_size;
+	/* nodes are stored after the table header */
+	node_num = (tbl->init_cap - sizeof(odph_linear_table_imp))
+		   / tbl->value_size;
 	tbl->node_sum = node_num;
 
 	tbl->value_array = (void *)((char *)tbl
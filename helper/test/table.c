@@ -23,6 +23,122 @@
  * value (data): MAC address of the next hop station (6 bytes).
  */
 
+#define NUM_HASH_KEYS   1000
+#define LINEAR_VAL_SIZE 12
+
+/* Keys which differ only after the first byte must be stored and found as
+ * separate entries */
+static int test_hash_keys(void)
+{
+	odph_table_t table;
+	odph_table_ops_t *test_ops = &odph_hash_table_ops;
+	char key[8];
+	uint32_t val, tmp;
+	uint32_t i;
+
+	table = test_ops->f_create("test_keys", 2, sizeof(key), sizeof(val));
+	if (table == NULL) {
+		printf("table create fail\n");
+		return -1;
+	}
+
+	for (i = 0; i < NUM_HASH_KEYS; i++) {
+		snprintf(key, sizeof(key), "k%06u", i);
+		val = i;
+		if (test_ops->f_put(table, key, &val)) {
+			printf("put key %u fail\n", i);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NUM_HASH_KEYS; i++) {
+		snprintf(key, sizeof(key), "k%06u", i);
+		if (test_ops->f_get(table, key, &tmp, sizeof(tmp)) ||
+		    tmp != i) {
+			printf("get key %u fail\n", i);
+			return -1;
+		}
+	}
+
+	/* Remove every other key */
+	for (i = 0; i < NUM_HASH_KEYS; i += 2) {
+		snprintf(key, sizeof(key), "k%06u", i);
+		if (test_ops->f_remove(table, key)) {
+			printf("remove key %u fail\n", i);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NUM_HASH_KEYS; i++) {
+		int ret;
+
+		snprintf(key, sizeof(key), "k%06u", i);
+		ret = test_ops->f_get(table, key, &tmp, sizeof(tmp));
+		if ((i % 2 == 0 && ret == 0) ||
+		    (i % 2 && (ret != 0 || tmp != i))) {
+			printf("get key %u after remove fail\n", i);
+			return -1;
+		}
+	}
+
+	if (test_ops->f_des(table)) {
+		printf("destroy table fail!!!\n");
+		return -1;
+	}
+
+	printf("\t6  hash keys success!\n");
+
+	return 0;
+}
+
+/* Linear table must have entries, and all of them must fit into the table
+ * memory after the table header */
+static int test_linear_table(void)
+{
+	odph_table_t table;
+	odph_table_ops_t *test_ops = &odph_linear_table_ops;
+	uint8_t val[LINEAR_VAL_SIZE];
+	uint8_t tmp[LINEAR_VAL_SIZE];
+	uint32_t entry_size = LINEAR_VAL_SIZE + sizeof(odp_rwlock_t);
+	uint32_t max_num = (1 << 20) / entry_size;
+	uint32_t i, num;
+
+	table = test_ops->f_create("test_linear", 1, 0, sizeof(val));
+	if (table == NULL) {
+		printf("linear table create fail\n");
+		return -1;
+	}
+
+	for (num = 0; num <= max_num; num++) {
+		memset(val, (uint8_t)num, sizeof(val));
+		if (test_ops->f_put(table, &num, val))
+			break;
+	}
+
+	if (num == 0 || num * entry_size >= (1 << 20)) {
+		printf("linear table size %u fail\n", num);
+		return -1;
+	}
+
+	for (i = 0; i < num; i++) {
+		memset(val, (uint8_t)i, sizeof(val));
+		if (test_ops->f_get(table, &i, tmp, sizeof(tmp)) ||
+		    memcmp(val, tmp, sizeof(val))) {
+			printf("linear table get %u fail\n", i);
+			return -1;
+		}
+	}
+
+	if (test_ops->f_des(table)) {
+		printf("destroy linear table fail!!!\n");
+		return -1;
+	}
+
+	printf("\t7  linear table success!\n");
+
+	return 0;
+}
+
 int main(int argc ODP_UNUSED, char *argv[] ODP_UNUSED)
 {
 	odp_instance_t instance;
@@ -116,6 +232,9 @@ int main(int argc ODP_UNUSED, char *argv[] ODP_UNUSED)
 	}
 	printf("\t5  destroy table success!\n");
 
+	if (test_hash_keys() || test_linear_table())
+		return -1;
+
 	printf("all test finished success!!\n");
 
 	if (odp_term_local()) {
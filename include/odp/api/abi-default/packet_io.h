@@ -45,6 +45,9 @@ typedef struct odp_pktout_queue_t {
 
 #define ODP_PKTIO_MACADDR_MAXSIZE 16
 
+#define ODP_PKTIN_MAX_QUEUES  64
+#define ODP_PKTOUT_MAX_QUEUES 64
+
 #define ODP_PKTIN_NO_WAIT 0
 
 /**
@@ -686,6 +686,70 @@ int odp_cls_cos_pool_set(odp_cos_t cos_id, odp_pool_t pool_id);
 */
 odp_pool_t odp_cls_cos_pool(odp_cos_t cos_id);
 
+/**
+ * Class of service statistics
+ *
+ * Counters are maintained per class of service from its creation onwards.
+ * Counter values are aggregated from per thread counters on read, and thus
+ * may lag behind packets that are being classified concurrently.
+ */
+typedef struct odp_cls_cos_stats_t {
+	/** Number of packets classified into the CoS */
+	uint64_t packets;
+
+	/** Number of octets in packets classified into the CoS */
+	uint64_t octets;
+
+	/** Number of packets dropped after being classified into the CoS,
+	 *  e.g. due to missing destination queue or pool */
+	uint64_t discards;
+
+} odp_cls_cos_stats_t;
+
+/**
+ * Packet matching rule statistics
+ *
+ * Counters are maintained per PMR from its creation onwards. Counter values
+ * are aggregated from per thread counters on read.
+ */
+typedef struct odp_cls_pmr_stats_t {
+	/** Number of packets that matched the PMR */
+	uint64_t hits;
+
+} odp_cls_pmr_stats_t;
+
+/**
+ * Read class of service statistics
+ *
+ * @param      cos_id   Class of service handle
+ * @param[out] stats    Pointer to statistics structure for output
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_cls_cos_stats(odp_cos_t cos_id, odp_cls_cos_stats_t *stats);
+
+/**
+ * Read packet matching rule statistics
+ *
+ * @param      pmr_id   PMR handle
+ * @param[out] stats    Pointer to statistics structure for output
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_cls_pmr_stats(odp_pmr_t pmr_id, odp_cls_pmr_stats_t *stats);
+
+/**
+ * Print classifier info
+ *
+ * Print implementation defined information about all classes of service and
+ * packet matching rules, including their statistics, to the ODP log. The
+ * information is intended to be used for debugging, e.g. for tuning the
+ * order of PMRs.
+ */
+void odp_cls_print_all(void);
+
 /**
  * Get printable value for an odp_cos_t
  *
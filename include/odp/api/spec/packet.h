@@ -218,6 +218,25 @@ typedef struct odp_packet_data_range {
 
 } odp_packet_data_range_t;
 
+/**
+ * Packet large send offload (LSO) options
+ */
+typedef struct odp_packet_lso_opt_t {
+	/** Offset to the first byte of TCP payload
+	 *
+	 *  Packet headers (from start of packet until this offset) are
+	 *  replicated to all output packets. The offset must be within the
+	 *  first packet segment. */
+	uint32_t payload_offset;
+
+	/** Maximum TCP payload length in an output packet
+	 *
+	 *  E.g. MTU minus header length (payload_offset). The last output
+	 *  packet may have less payload. */
+	uint32_t max_payload_len;
+
+} odp_packet_lso_opt_t;
+
 /**
  * Checksum check status in packet
  */
@@ -234,6 +253,25 @@ typedef enum odp_packet_chksum_status_t {
 
 } odp_packet_chksum_status_t;
 
+/**
+ * IP reassembly status of a packet
+ */
+typedef enum odp_packet_reass_status_t {
+	/** Packet was not processed by IP reassembly. It is not an IP
+	  * fragment, or reassembly is not enabled for it. */
+	ODP_PACKET_REASS_NONE = 0,
+
+	/** Packet is a fragment of a packet that could not be reassembled.
+	  * Reassembly did not complete within the maximum wait time, the
+	  * packet had too many fragments, fragments overlapped, or the
+	  * reassembly table was full. */
+	ODP_PACKET_REASS_INCOMPLETE,
+
+	/** Packet was reassembled from fragments */
+	ODP_PACKET_REASS_COMPLETE
+
+} odp_packet_reass_status_t;
+
 /**
  * Event subtype of a packet
  *
@@ -1819,6 +1857,23 @@ odp_packet_chksum_status_t odp_packet_l3_chksum_status(odp_packet_t pkt);
  */
 odp_packet_chksum_status_t odp_packet_l4_chksum_status(odp_packet_t pkt);
 
+/**
+ * IP reassembly status
+ *
+ * Returns the result of IP reassembly on packet input. Packet parsing and
+ * classification metadata of a reassembled packet (ODP_PACKET_REASS_COMPLETE)
+ * describe the whole packet. Fragments that could not be reassembled
+ * (ODP_PACKET_REASS_INCOMPLETE) are delivered as received, with ipfrag
+ * metadata set (odp_packet_has_ipfrag()).
+ *
+ * @param pkt     Packet handle
+ *
+ * @return IP reassembly status
+ *
+ * @see odp_pktio_config_t::reassembly
+ */
+odp_packet_reass_status_t odp_packet_reass_status(odp_packet_t pkt);
+
 /**
  * Layer 3 checksum insertion override
  *
@@ -1853,6 +1908,52 @@ void odp_packet_l3_chksum_insert(odp_packet_t pkt, int insert);
  */
 void odp_packet_l4_chksum_insert(odp_packet_t pkt, int insert);
 
+/**
+ * Request large send offload (LSO) for a packet
+ *
+ * Requests TCP segmentation of the packet during packet output. The packet
+ * is segmented into packets that carry at most 'lso_opt.max_payload_len'
+ * bytes of TCP payload each. Packet headers are replicated and IP length,
+ * IP identification, TCP sequence number, TCP flags and checksums are
+ * updated in each output packet. Packet L3 and L4 offsets must be set, and
+ * the packet must be a TCP over IPv4 or IPv6 packet without IP options or
+ * extension headers that would require per segment updates.
+ *
+ * LSO requests are processed only by pktios that have LSO enabled
+ * (see odp_pktio_config_t::enable_lso). Otherwise, the packet is transmitted
+ * as is. Packet output drops packets with an LSO request that cannot be
+ * processed (e.g. non-TCP packets). The request is cleared by
+ * odp_packet_lso_request_clr() and reset when packet is allocated or
+ * received.
+ *
+ * @param pkt      Packet handle
+ * @param lso_opt  LSO options
+ *
+ * @retval 0  On success
+ * @retval <0 On failure (e.g. bad options)
+ *
+ * @see odp_pktio_capability_t::lso
+ */
+int odp_packet_lso_request(odp_packet_t pkt,
+			   const odp_packet_lso_opt_t *lso_opt);
+
+/**
+ * Clear LSO request from a packet
+ *
+ * @param pkt      Packet handle
+ */
+void odp_packet_lso_request_clr(odp_packet_t pkt);
+
+/**
+ * Check if packet has an LSO request
+ *
+ * @param pkt      Packet handle
+ *
+ * @retval 0  Packet does not have an LSO request
+ * @retval 1  Packet has an LSO request
+ */
+int odp_packet_has_lso_request(odp_packet_t pkt);
+
 /**
  * Ones' complement sum of packet data
  *
@@ -1940,6 +2041,22 @@ odp_time_t odp_packet_ts(odp_packet_t pkt);
  */
 void odp_packet_ts_set(odp_packet_t pkt, odp_time_t timestamp);
 
+/**
+ * Request packet output timestamp
+ *
+ * Controls whether packet output timestamp is captured when the packet is
+ * transmitted. Timestamp capture must have been enabled with pktout
+ * configuration option 'ts_ena' of the output interface. The captured
+ * timestamp can be read with odp_pktout_ts_read() after transmission.
+ * Packets are received and allocated with the request disabled.
+ *
+ * @param pkt     Packet handle
+ * @param enable  0: do not capture timestamp, 1: capture timestamp
+ *
+ * @see odp_pktout_ts_read()
+ */
+void odp_packet_ts_request(odp_packet_t pkt, int enable);
+
 /**
  * Get packet color
  *
@@ -72,6 +72,18 @@ extern "C" {
  * Do not wait on packet input
  */
 
+/**
+ * @def ODP_PKTIN_MAX_QUEUES
+ * Maximum number of packet input queues supported by the API. Use
+ * odp_pktio_capability() to check the maximum number of queues per interface.
+ */
+
+/**
+ * @def ODP_PKTOUT_MAX_QUEUES
+ * Maximum number of packet output queues supported by the API. Use
+ * odp_pktio_capability() to check the maximum number of queues per interface.
+ */
+
 /**
  * Packet input mode
  */
@@ -226,6 +238,41 @@ typedef struct odp_pktin_queue_param_t {
 	  * NULL.
 	  */
 	odp_pktin_queue_param_ovr_t *queue_param_ovr;
+
+	/** Queue size array
+	  *
+	  * Sizes (number of packets) of interface input rings for each
+	  * 'num_queues' input queues. The value of zero means implementation
+	  * specific default size. Nonzero values must be between
+	  * 'min_input_queue_size' and 'max_input_queue_size' capabilities. The
+	  * implementation may round up the values if required by the
+	  * underlying hardware. Large rings absorb traffic bursts without
+	  * drops, while small rings keep the queueing latency low.
+	  *
+	  * The default value is zero. */
+	uint32_t queue_size[ODP_PKTIN_MAX_QUEUES];
+
+	/** GRO enable array
+	  *
+	  * Enables generic receive offload (GRO) per input queue for each
+	  * 'num_queues' input queues. Values are ignored when GRO is not
+	  * enabled on the interface (see odp_pktio_config_t::enable_gro).
+	  * GRO adds processing to the input path, so that it is typically
+	  * enabled only on queues that receive bulk TCP traffic.
+	  *
+	  * The default value is false. */
+	odp_bool_t enable_gro[ODP_PKTIN_MAX_QUEUES];
+
+	/** Back-pressure from congested event queues
+	  *
+	  * When enabled, packet input reacts to congestion of its
+	  * destination event queues (see odp_queue_param_t::threshold).
+	  * In ODP_PKTIN_MODE_SCHED mode, an input queue is not polled while
+	  * its event queue is congested, so that packets are held, and
+	  * eventually dropped, by the interface. When classifier is enabled,
+	  * packets destined to a congested CoS queue are dropped at input and
+	  * counted as input discards. The default value is false. */
+	odp_bool_t backpressure;
 } odp_pktin_queue_param_t;
 
 /**
@@ -246,6 +293,18 @@ typedef struct odp_pktout_queue_param_t {
 	  * 1 and interface capability. The default value is 1. */
 	unsigned int num_queues;
 
+	/** Queue size array
+	  *
+	  * Sizes (number of packets) of interface output rings for each
+	  * 'num_queues' output queues. The value of zero means implementation
+	  * specific default size. Nonzero values must be between
+	  * 'min_output_queue_size' and 'max_output_queue_size' capabilities.
+	  * The implementation may round up the values if required by the
+	  * underlying hardware.
+	  *
+	  * The default value is zero. */
+	uint32_t queue_size[ODP_PKTOUT_MAX_QUEUES];
+
 } odp_pktout_queue_param_t;
 
 /**
@@ -412,6 +471,13 @@ typedef union odp_pktout_config_opt_t {
 		/** Insert SCTP checksum on packet by default */
 		uint64_t sctp_chksum     : 1;
 
+		/** Enable packet output timestamp capture
+		  *
+		  * Timestamps are captured for packets requested with
+		  * odp_packet_ts_request() and read with
+		  * odp_pktout_ts_read(). */
+		uint64_t ts_ena          : 1;
+
 	} bit;
 
 	/** All bits of the bit field structure
@@ -465,6 +531,39 @@ typedef struct odp_pktio_parser_config_t {
 
 } odp_pktio_parser_config_t;
 
+/**
+ * IP reassembly configuration
+ */
+typedef struct odp_pktio_reass_config_t {
+	/** Enable reassembly of IPv4 fragments
+	 *
+	 *  0: Disable (default)
+	 *  1: Enable */
+	odp_bool_t en_ipv4;
+
+	/** Enable reassembly of IPv6 fragments
+	 *
+	 *  0: Disable (default)
+	 *  1: Enable */
+	odp_bool_t en_ipv6;
+
+	/** Maximum time in nanoseconds to wait for all fragments of a packet
+	 *
+	 *  Fragments of a packet that has not been completed within this time
+	 *  are delivered as incomplete. Zero selects the maximum value
+	 *  supported by the interface (odp_pktio_capability_t::reassembly).
+	 *  The default value is zero. */
+	uint64_t max_wait_time;
+
+	/** Maximum number of fragments per packet
+	 *
+	 *  Fragments of packets with more fragments are delivered as
+	 *  incomplete. Zero selects the maximum value supported by the
+	 *  interface. The default value is zero. */
+	uint16_t max_num_frags;
+
+} odp_pktio_reass_config_t;
+
 /**
  * Packet IO configuration options
  *
@@ -526,6 +625,72 @@ typedef struct odp_pktio_config_t {
 	 */
 	odp_bool_t outbound_ipsec;
 
+	/** Enable large send offload (LSO)
+	 *
+	 *  Enables processing of per packet LSO requests on packet output.
+	 *  Packets without an LSO request are not affected.
+	 *
+	 *  0: Disable LSO (default)
+	 *  1: Enable LSO
+	 *
+	 *  @see odp_packet_lso_request(), odp_pktio_capability_t::lso
+	 */
+	odp_bool_t enable_lso;
+
+	/** Enable generic receive offload (GRO)
+	 *
+	 *  Enables coalescing of received TCP segments on packet input.
+	 *  Consecutive, in-order TCP over IPv4 or IPv6 segments of the same
+	 *  flow are merged into a single multi-segment packet. The packet
+	 *  carries headers of the first segment with IP length fields updated
+	 *  to match the coalesced packet. TCP checksum field is not updated,
+	 *  but checksum status metadata (e.g. odp_packet_l4_chksum_status())
+	 *  reflects the status of all coalesced segments. Segments with
+	 *  checksum errors are never coalesced.
+	 *
+	 *  GRO is applied only on input queues selected with
+	 *  odp_pktin_queue_param_t::enable_gro.
+	 *
+	 *  0: Disable GRO (default)
+	 *  1: Enable GRO on the interface
+	 */
+	odp_bool_t enable_gro;
+
+	/** Enable IP fragmentation on packet output
+	 *
+	 *  When enabled, IPv4 and IPv6 packets longer than the interface MTU
+	 *  are split into IP fragments on packet output. Headers preceding
+	 *  the IP header are copied into every fragment. L4 checksum is
+	 *  inserted before fragmentation when checksum insertion is enabled.
+	 *  IPv4 packets with the don't fragment flag set and IPv6 packets
+	 *  with hop-by-hop or routing extension headers are dropped. Other
+	 *  packets are not affected.
+	 *
+	 *  0: Disable fragmentation (default)
+	 *  1: Enable fragmentation
+	 *
+	 *  @see odp_pktio_capability_t::frag
+	 */
+	odp_bool_t enable_frag;
+
+	/** IP reassembly on packet input
+	 *
+	 *  When enabled, IP fragments received from the interface are
+	 *  reassembled before packet parsing and classification, so that
+	 *  classification rules on L4 and upper layer headers apply also to
+	 *  fragmented packets. A reassembled packet carries L2 and IP headers
+	 *  of the first fragment with IP length and fragmentation fields
+	 *  updated. Fragment payloads are linked into the packet without
+	 *  copying, so reassembled packets are typically segmented.
+	 *  odp_packet_reass_status() tells if a packet was reassembled, or
+	 *  if it is a fragment of a packet that could not be reassembled.
+	 *
+	 *  By default, reassembly is disabled.
+	 *
+	 *  @see odp_pktio_capability_t::reassembly
+	 */
+	odp_pktio_reass_config_t reassembly;
+
 } odp_pktio_config_t;
 
 /**
@@ -557,6 +722,26 @@ typedef struct odp_pktio_capability_t {
 	/** Maximum number of output queues */
 	unsigned int max_output_queues;
 
+	/** Minimum input queue size
+	 *
+	 *  Zero if configuring queue size is not supported. */
+	uint32_t min_input_queue_size;
+
+	/** Maximum input queue size
+	 *
+	 *  Zero if configuring queue size is not supported. */
+	uint32_t max_input_queue_size;
+
+	/** Minimum output queue size
+	 *
+	 *  Zero if configuring queue size is not supported. */
+	uint32_t min_output_queue_size;
+
+	/** Maximum output queue size
+	 *
+	 *  Zero if configuring queue size is not supported. */
+	uint32_t max_output_queue_size;
+
 	/** Supported pktio configuration options */
 	odp_pktio_config_t config;
 
@@ -566,6 +751,86 @@ typedef struct odp_pktio_capability_t {
 	 * set to zero. */
 	odp_pktio_set_op_t set_op;
 
+	/** Large send offload (LSO) capabilities
+	 *
+	 *  Valid when LSO is supported (config.enable_lso is set). */
+	struct {
+		/** TCP over IPv4 LSO support */
+		odp_bool_t tcp_ipv4;
+
+		/** TCP over IPv6 LSO support */
+		odp_bool_t tcp_ipv6;
+
+		/** Maximum payload offset (header length) */
+		uint32_t max_payload_offset;
+
+		/** Maximum number of output packets per LSO request */
+		uint32_t max_segments;
+
+	} lso;
+
+	/** IP fragmentation capabilities
+	 *
+	 *  Valid when fragmentation is supported (config.enable_frag is set).
+	 */
+	struct {
+		/** IPv4 fragmentation support */
+		odp_bool_t ipv4;
+
+		/** IPv6 fragmentation support */
+		odp_bool_t ipv6;
+
+		/** Maximum number of fragments per packet */
+		uint32_t max_frags;
+
+	} frag;
+
+	/** IP reassembly capabilities */
+	struct {
+		/** IPv4 reassembly support */
+		odp_bool_t ipv4;
+
+		/** IPv6 reassembly support */
+		odp_bool_t ipv6;
+
+		/** Maximum reassembly wait time in nanoseconds */
+		uint64_t max_wait_time;
+
+		/** Maximum number of fragments per packet */
+		uint16_t max_num_frags;
+
+	} reassembly;
+
+	/** Statistics counter capabilities */
+	odp_pktio_stats_capability_t stats;
+
+	/** Packet input hash capabilities
+	 *
+	 *  Runtime update capabilities of packet input flow hashing. Updates
+	 *  are possible only when flow hashing has been enabled with more than
+	 *  one input queue. */
+	struct {
+		/** Hash protocols can be changed with
+		 *  odp_pktin_hash_proto_set() */
+		odp_bool_t proto_update;
+
+		/** Hash key can be changed with odp_pktin_hash_key_set() */
+		odp_bool_t key_update;
+
+		/** Redirection table can be read and written with
+		 *  odp_pktin_hash_reta() and odp_pktin_hash_reta_set() */
+		odp_bool_t reta_update;
+
+		/** Hash key size in bytes. Zero when key update is not
+		 *  supported. */
+		uint32_t key_size;
+
+		/** Number of redirection table entries. Zero when redirection
+		 *  table update is not supported. */
+		uint32_t reta_size;
+
+	} hash;
+
 	/** @deprecated Use enable_loop inside odp_pktin_config_t */
 	odp_bool_t ODP_DEPRECATE(loop_supported);
 } odp_pktio_capability_t;
@@ -724,6 +989,96 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 int odp_pktout_queue_config(odp_pktio_t pktio,
 			    const odp_pktout_queue_param_t *param);
 
+/**
+ * Change packet input hash protocols
+ *
+ * Changes protocol header fields included into packet input hash calculation
+ * on an active interface. Flow hashing must have been enabled in
+ * odp_pktin_queue_config() with more than one input queue. Packets received
+ * after the call are spread into input queues using the new protocol fields.
+ * Use odp_pktio_capability() to check if the operation is supported
+ * (hash.proto_update).
+ *
+ * @param pktio       Packet IO handle
+ * @param hash_proto  Protocol field selection for hashing
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_pktin_hash_proto_set(odp_pktio_t pktio,
+			     const odp_pktin_hash_proto_t *hash_proto);
+
+/**
+ * Change packet input hash key
+ *
+ * Changes the key used in packet input hash calculation on an active
+ * interface. Flow hashing must have been enabled in odp_pktin_queue_config()
+ * with more than one input queue. Key length must equal hash.key_size
+ * capability.
+ *
+ * @param pktio   Packet IO handle
+ * @param key     Hash key
+ * @param len     Hash key length in bytes
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_pktin_hash_key_set(odp_pktio_t pktio, const uint8_t key[],
+			   uint32_t len);
+
+/**
+ * Read packet input hash redirection table
+ *
+ * The redirection table maps packet input hash values into input queues.
+ * A packet is received into input queue 'reta[hash % reta_size]', where queue
+ * values are input queue indexes (0 ... num_queues - 1) of the interface.
+ * Outputs up to 'num' table entries. The interface must be active.
+ *
+ * @param      pktio  Packet IO handle
+ * @param[out] reta   Input queue index array for output
+ * @param      num    Maximum number of entries to output
+ *
+ * @return Number of redirection table entries (hash.reta_size)
+ * @retval <0 on failure
+ */
+int odp_pktin_hash_reta(odp_pktio_t pktio, uint32_t reta[], uint32_t num);
+
+/**
+ * Write packet input hash redirection table
+ *
+ * Rewrites the redirection table of an active interface without stopping
+ * it. 'num' must equal hash.reta_size capability and all table entries
+ * must be valid input queue indexes. Packets of a flow may be reordered
+ * when the flow moves from one input queue to another.
+ *
+ * @param pktio   Packet IO handle
+ * @param reta    Input queue index array
+ * @param num     Number of entries in the array
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ *
+ * @see odp_pktin_hash_reta()
+ */
+int odp_pktin_hash_reta_set(odp_pktio_t pktio, const uint32_t reta[],
+			    uint32_t num);
+
+/**
+ * Balance packet input hash redirection table
+ *
+ * Performs one redirection table balancing round. The implementation
+ * samples input load per redirection table entry between calls and moves
+ * entries from the most loaded input queues to the least loaded ones. The
+ * first call starts load sampling. Implementations may also perform
+ * balancing rounds automatically. Requires hash.reta_update capability.
+ *
+ * @param pktio   Packet IO handle
+ *
+ * @return Number of redirection table entries moved
+ * @retval <0 on failure
+ */
+int odp_pktin_hash_balance(odp_pktio_t pktio);
+
 /**
  * Event queues for packet input
  *
@@ -1394,6 +1749,25 @@ uint64_t odp_pktin_ts_res(odp_pktio_t pktio);
  */
 odp_time_t odp_pktin_ts_from_ns(odp_pktio_t pktio, uint64_t ns);
 
+/**
+ * Read last captured packet output timestamp
+ *
+ * Reads the timestamp of the latest transmitted packet, which requested
+ * timestamp capture with odp_packet_ts_request(). Packet output timestamp
+ * capture must have been enabled with pktout configuration option 'ts_ena'.
+ * Timestamp is captured when the packet is transmitted, so it may not be
+ * available yet right after odp_pktout_send() returns. Timestamps use the same
+ * time base as odp_time_global().
+ *
+ * @param      pktio   Packet IO handle
+ * @param[out] ts      Pointer to timestamp for output
+ *
+ * @retval  0 on success
+ * @retval >0 Timestamp not available
+ * @retval <0 on failure
+ */
+int odp_pktout_ts_read(odp_pktio_t pktio, odp_time_t *ts);
+
 /**
  * @}
  */
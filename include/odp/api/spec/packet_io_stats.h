@@ -18,10 +18,15 @@
 extern "C" {
 #endif
 
+#include <odp/api/queue.h>
+
 /** @addtogroup odp_packet_io
  *  @{
  */
 
+/** Maximum length of packet IO extra statistics counter name */
+#define ODP_PKTIO_STATS_EXTRA_NAME_LEN 64
+
 /**
  * Packet IO statistics
  *
@@ -106,6 +111,119 @@ typedef struct odp_pktio_stats_t {
 	uint64_t out_errors;
 } odp_pktio_stats_t;
 
+/**
+ * Packet IO input queue specific statistics counters
+ *
+ * Statistics counters for an individual packet input queue. Refer to packet IO
+ * level statistics odp_pktio_stats_t for counter definitions.
+ */
+typedef struct odp_pktin_queue_stats_t {
+	/** See odp_pktio_stats_t::in_octets */
+	uint64_t octets;
+
+	/** Number of packets received from the queue */
+	uint64_t packets;
+
+	/** See odp_pktio_stats_t::in_discards */
+	uint64_t discards;
+
+	/** See odp_pktio_stats_t::in_errors */
+	uint64_t errors;
+
+} odp_pktin_queue_stats_t;
+
+/**
+ * Packet IO output queue specific statistics counters
+ *
+ * Statistics counters for an individual packet output queue. Refer to packet
+ * IO level statistics odp_pktio_stats_t for counter definitions.
+ */
+typedef struct odp_pktout_queue_stats_t {
+	/** See odp_pktio_stats_t::out_octets */
+	uint64_t octets;
+
+	/** Number of packets sent through the queue */
+	uint64_t packets;
+
+	/** See odp_pktio_stats_t::out_discards */
+	uint64_t discards;
+
+	/** See odp_pktio_stats_t::out_errors */
+	uint64_t errors;
+
+} odp_pktout_queue_stats_t;
+
+/**
+ * Packet IO statistics capabilities
+ */
+typedef struct odp_pktio_stats_capability_t {
+	/** Supported packet input queue statistics counters */
+	struct {
+		/** Supported counters */
+		union {
+			/** Statistics counters in a bit field structure */
+			struct {
+				/** @see odp_pktin_queue_stats_t::octets */
+				uint64_t octets          : 1;
+
+				/** @see odp_pktin_queue_stats_t::packets */
+				uint64_t packets         : 1;
+
+				/** @see odp_pktin_queue_stats_t::discards */
+				uint64_t discards        : 1;
+
+				/** @see odp_pktin_queue_stats_t::errors */
+				uint64_t errors          : 1;
+
+			} counter;
+
+			/** All bits of the bit field structure
+			 *
+			 *  This field can be used to set/clear all flags, or
+			 *  for bitwise operations over the entire structure. */
+			uint64_t all_counters;
+		};
+	} pktin_queue;
+
+	/** Supported packet output queue statistics counters */
+	struct {
+		/** Supported counters */
+		union {
+			/** Statistics counters in a bit field structure */
+			struct {
+				/** @see odp_pktout_queue_stats_t::octets */
+				uint64_t octets          : 1;
+
+				/** @see odp_pktout_queue_stats_t::packets */
+				uint64_t packets         : 1;
+
+				/** @see odp_pktout_queue_stats_t::discards */
+				uint64_t discards        : 1;
+
+				/** @see odp_pktout_queue_stats_t::errors */
+				uint64_t errors          : 1;
+
+			} counter;
+
+			/** All bits of the bit field structure
+			 *
+			 *  This field can be used to set/clear all flags, or
+			 *  for bitwise operations over the entire structure. */
+			uint64_t all_counters;
+		};
+	} pktout_queue;
+
+} odp_pktio_stats_capability_t;
+
+/**
+ * Packet IO extra statistics counter information
+ */
+typedef struct odp_pktio_extra_stat_info_t {
+	/** Name of the counter */
+	char name[ODP_PKTIO_STATS_EXTRA_NAME_LEN];
+
+} odp_pktio_extra_stat_info_t;
+
 /**
  * Get statistics for pktio handle
  *
@@ -131,6 +249,139 @@ int odp_pktio_stats(odp_pktio_t pktio,
  */
 int odp_pktio_stats_reset(odp_pktio_t pktio);
 
+/**
+ * Get statistics for direct packet input queue
+ *
+ * Packet input queue handles can be requested with odp_pktin_queue(). Counters
+ * not supported by the queue are set to zero. Counters are reset with
+ * odp_pktio_stats_reset().
+ *
+ * @param      queue    Packet input queue handle
+ * @param[out] stats    Output buffer for counters
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ *
+ * @see odp_pktio_stats_capability_t::pktin_queue
+ */
+int odp_pktin_queue_stats(odp_pktin_queue_t queue,
+			  odp_pktin_queue_stats_t *stats);
+
+/**
+ * Get statistics for packet input event queue
+ *
+ * Packet input event queue handles can be requested with
+ * odp_pktin_event_queue(). Counters not supported by the queue are set to
+ * zero. Counters are reset with odp_pktio_stats_reset().
+ *
+ * @param      pktio    Packet IO handle
+ * @param      queue    Packet input event queue handle
+ * @param[out] stats    Output buffer for counters
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_pktin_event_queue_stats(odp_pktio_t pktio, odp_queue_t queue,
+				odp_pktin_queue_stats_t *stats);
+
+/**
+ * Get statistics for direct packet output queue
+ *
+ * Packet output queue handles can be requested with odp_pktout_queue().
+ * Counters not supported by the queue are set to zero. Counters are reset
+ * with odp_pktio_stats_reset().
+ *
+ * @param      queue    Packet output queue handle
+ * @param[out] stats    Output buffer for counters
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ *
+ * @see odp_pktio_stats_capability_t::pktout_queue
+ */
+int odp_pktout_queue_stats(odp_pktout_queue_t queue,
+			   odp_pktout_queue_stats_t *stats);
+
+/**
+ * Get statistics for packet output event queue
+ *
+ * Packet output event queue handles can be requested with
+ * odp_pktout_event_queue(). Counters not supported by the queue are set to
+ * zero. Counters are reset with odp_pktio_stats_reset().
+ *
+ * @param      pktio    Packet IO handle
+ * @param      queue    Packet output event queue handle
+ * @param[out] stats    Output buffer for counters
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_pktout_event_queue_stats(odp_pktio_t pktio, odp_queue_t queue,
+				 odp_pktout_queue_stats_t *stats);
+
+/**
+ * Get extra statistics counter information for a packet IO interface
+ *
+ * Extra statistics are implementation and interface specific counters (e.g.
+ * counters provided by a device driver). Returns the number of available
+ * counters, and outputs information of up to 'num' counters into 'info'
+ * array. The array index of a counter is its counter ID, which is valid
+ * until the interface is closed.
+ *
+ * @param      pktio    Packet IO handle
+ * @param[out] info     Array of counter information structures for output.
+ *                      May be NULL when 'num' is zero.
+ * @param      num      Maximum number of counter information structures to
+ *                      output
+ *
+ * @return Number of extra statistics counters available
+ * @retval <0 on failure
+ */
+int odp_pktio_extra_stat_info(odp_pktio_t pktio,
+			      odp_pktio_extra_stat_info_t info[], int num);
+
+/**
+ * Get extra statistics counters for a packet IO interface
+ *
+ * Outputs up to 'num' counter values into 'stats' array in counter ID order.
+ *
+ * @param      pktio    Packet IO handle
+ * @param[out] stats    Array of counter values for output. May be NULL when
+ *                      'num' is zero.
+ * @param      num      Maximum number of counter values to output
+ *
+ * @return Number of extra statistics counters available
+ * @retval <0 on failure
+ *
+ * @see odp_pktio_extra_stat_info()
+ */
+int odp_pktio_extra_stats(odp_pktio_t pktio, uint64_t stats[], int num);
+
+/**
+ * Get an extra statistics counter value
+ *
+ * @param      pktio    Packet IO handle
+ * @param      id       Counter ID
+ * @param[out] stat     Pointer for counter value output
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ *
+ * @see odp_pktio_extra_stat_info()
+ */
+int odp_pktio_extra_stat_counter(odp_pktio_t pktio, uint32_t id,
+				 uint64_t *stat);
+
+/**
+ * Print extra statistics for a packet IO interface
+ *
+ * Prints names and values of all extra statistics counters of the interface
+ * to the ODP log. The format is implementation specific.
+ *
+ * @param pktio    Packet IO handle
+ */
+void odp_pktio_extra_stats_print(odp_pktio_t pktio);
+
 /**
  * @}
  */
@@ -294,6 +294,21 @@ void odp_queue_param_init(odp_queue_param_t *param);
  */
 int odp_queue_info(odp_queue_t queue, odp_queue_info_t *info);
 
+/**
+ * Check queue congestion state
+ *
+ * Returns congestion state of a queue which has congestion thresholds
+ * enabled (see odp_queue_param_t::threshold). A queue without thresholds is
+ * never congested. This is a cheap operation intended for fast path use,
+ * e.g. for admission control before enqueueing new work into a queue.
+ *
+ * @param      queue   Queue handle
+ *
+ * @retval 1 Queue is congested
+ * @retval 0 Queue is not congested
+ */
+int odp_queue_congested(odp_queue_t queue);
+
 /**
  * Print queue info
  *
@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include <odp/api/schedule_types.h>
+#include <odp/api/pool.h>
 #include <odp/api/deprecated.h>
 
 /** @addtogroup odp_queue
@@ -216,6 +217,12 @@ typedef struct odp_queue_capability_t {
 
 	} plain;
 
+	/** Congestion threshold support
+	  *
+	  * When true, congestion thresholds (odp_queue_param_t::threshold)
+	  * are supported for plain and scheduled ODP_BLOCKING queues. */
+	odp_bool_t threshold;
+
 	/** @deprecated Use queue capabilities in odp_schedule_capability_t
 	 * instead */
 	struct {
@@ -259,6 +266,68 @@ typedef struct odp_queue_capability_t {
 
 } odp_queue_capability_t;
 
+/**
+ * Queue congestion threshold parameters
+ *
+ * A queue becomes congested when the number of events stored in it reaches
+ * the high threshold, and stops being congested when the number drops to the
+ * low threshold or below. Congestion state can be polled with
+ * odp_queue_congested(). In addition, a notification event can be sent on
+ * each state change. Thresholds are checked during enqueue and dequeue
+ * operations, so the state may lag behind the actual queue depth.
+ */
+typedef struct odp_queue_threshold_t {
+	/** High threshold
+	  *
+	  * Number of events which marks the queue congested. The value must
+	  * not exceed queue size. The value of zero disables congestion
+	  * thresholds. The default value is zero. */
+	uint32_t high;
+
+	/** Low threshold
+	  *
+	  * Number of events at or below which the queue is not congested
+	  * anymore. The value must be less than 'high'. The default value is
+	  * zero. */
+	uint32_t low;
+
+	/** Notification queue
+	  *
+	  * When a valid queue is given, a notification event is enqueued into
+	  * it each time the queue enters or leaves the congested state.
+	  * Notification is an ODP_EVENT_BUFFER event from 'notif_pool', which
+	  * contains odp_queue_threshold_notif_t structure in the beginning of
+	  * the buffer data. Notifications are dropped when the pool is empty
+	  * or the notification queue is full. The default value is
+	  * ODP_QUEUE_INVALID (no notifications). */
+	odp_queue_t notif_queue;
+
+	/** Buffer pool for notification events
+	  *
+	  * Buffer size must be at least sizeof(odp_queue_threshold_notif_t).
+	  * Ignored when 'notif_queue' is ODP_QUEUE_INVALID. */
+	odp_pool_t notif_pool;
+
+} odp_queue_threshold_t;
+
+/**
+ * Queue congestion notification
+ *
+ * Content of a notification event sent to odp_queue_threshold_t::notif_queue.
+ */
+typedef struct odp_queue_threshold_notif_t {
+	/** Queue which changed its congestion state */
+	odp_queue_t queue;
+
+	/** Number of events in the queue when the state changed */
+	uint32_t depth;
+
+	/** New state. True when the queue became congested, false when
+	  * it dropped to the low threshold. */
+	odp_bool_t congested;
+
+} odp_queue_threshold_notif_t;
+
 /**
  * ODP Queue parameters
  */
@@ -332,6 +401,13 @@ typedef struct odp_queue_param_t {
 	  * default size. */
 	uint32_t size;
 
+	/** Congestion thresholds
+	  *
+	  * Thresholds are supported only for ODP_BLOCKING queues and only when
+	  * 'threshold' queue capability is true. Congestion thresholds are
+	  * disabled by default. */
+	odp_queue_threshold_t threshold;
+
 } odp_queue_param_t;
 
 /**
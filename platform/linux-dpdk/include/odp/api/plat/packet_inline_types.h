@@ -100,6 +100,7 @@ typedef union {
 		uint64_t l4_chksum_done:1; /* L4 checksum validation done */
 		uint64_t ipsec_udp:1; /* UDP-encapsulated IPsec packet */
 		uint64_t udp_chksum_zero:1; /* UDP header had 0 as chksum */
+		uint64_t tunnel:1;    /* Tunnel with parsed inner headers */
 	};
 } _odp_packet_input_flags_t;
 
@@ -111,7 +112,7 @@ typedef union {
 	uint32_t all_flags;
 
 	struct {
-		uint32_t reserved1:     10;
+		uint32_t reserved1:      8;
 
 	/*
 	 * Init flags
@@ -125,6 +126,8 @@ typedef union {
 		uint32_t l3_chksum:      1; /* L3 chksum override */
 		uint32_t l4_chksum_set:  1; /* L4 chksum bit is valid */
 		uint32_t l4_chksum:      1; /* L4 chksum override  */
+		uint32_t lso:            1; /* LSO requested */
+		uint32_t ts_set:         1; /* Output timestamp requested */
 		uint32_t shaper_len_adj: 8; /* Adjustment for traffic mgr */
 
 	/*
@@ -143,8 +146,8 @@ typedef union {
 
 	/* Flag groups */
 	struct {
-		uint32_t reserved2:     10;
-		uint32_t other:         13; /* All other flags */
+		uint32_t reserved2:      8;
+		uint32_t other:         15; /* All other flags */
 		uint32_t error:          9; /* All error flags */
 	} all;
 
@@ -109,6 +109,9 @@ typedef struct {
 		uint8_t num_parallel;
 	} event_queue;
 	pktio_entry_t *pktio[RTE_MAX_ETHPORTS];
+	/* Ports with IP reassembly enabled. Protected by rx_adapter.lock. */
+	uint8_t reass_port[RTE_MAX_ETHPORTS];
+	odp_atomic_u32_t num_reass_ports;
 
 	odp_ticketlock_t port_lock;
 	struct {
@@ -22,6 +22,10 @@
 #define PTYPE_IPV6      0x10
 #define PTYPE_UDP       0x20
 #define PTYPE_TCP       0x40
+#define PTYPE_TUNNEL_VXLAN  0x80
+#define PTYPE_TUNNEL_GENEVE 0x100
+#define PTYPE_TUNNEL_GRE    0x200
+#define PTYPE_TUNNEL_GTPU   0x400
 
 /** Packet parser using DPDK interface */
 int _odp_dpdk_packet_parse_common(packet_parser_t *prs,
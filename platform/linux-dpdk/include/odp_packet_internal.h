@@ -31,6 +31,7 @@ extern "C" {
 #include <odp/api/abi/packet.h>
 #include <protocols/eth.h>
 #include <odp_queue_if.h>
+#include <odp_packet_tunnel_internal.h>
 
 #include <rte_config.h>
 #if defined(__clang__)
@@ -39,6 +40,9 @@ extern "C" {
 #include <rte_mbuf.h>
 #include <rte_memory.h>
 
+#include <stddef.h>
+#include <string.h>
+
 /** Minimum segment length expected by packet_parse_common() */
 #define PACKET_PARSE_SEG_LEN 96
 
@@ -88,6 +92,9 @@ typedef struct {
 
 	/* offset to L4 hdr (TCP, UDP, SCTP, also ICMP) */
 	uint16_t l4_offset;
+
+	/* Tunnel and inner headers, valid when input_flags.tunnel is set */
+	packet_tunnel_t tunnel;
 } packet_parser_t;
 
 /**
@@ -95,7 +102,8 @@ typedef struct {
  *
  * To optimize fast path performance this struct is not initialized to zero in
  * packet_init(). Because of this any new fields added must be reviewed for
- * initialization requirements.
+ * initialization requirements. Members initialized by packet_init() must
+ * match packet_init_tmpl_t.
  */
 typedef struct {
 	/* common buffer header */
@@ -112,6 +120,9 @@ typedef struct {
 	/* Event subtype */
 	int8_t subtype;
 
+	/* IP reassembly status (odp_packet_reass_status_t) */
+	uint8_t reass_status;
+
 	/*
 	 * Members below are not initialized by packet_init()
 	 */
@@ -122,6 +133,10 @@ typedef struct {
 	/* Classifier destination queue */
 	odp_queue_t dst_queue;
 
+	/* LSO options, valid when flags.lso is set */
+	uint16_t lso_payload_offset;
+	uint16_t lso_max_payload;
+
 	union {
 		struct {
 			/* Result for crypto packet op */
@@ -178,21 +193,66 @@ static inline void packet_subtype_set(odp_packet_t pkt, int ev)
 }
 
 /**
- * Initialize ODP headers
+ * Packet metadata template
+ *
+ * Preinitialized copy of the packet header members written by packet_init().
+ * Templates are prepared once (e.g. per pktio), so that packet_init() becomes
+ * a single fixed size copy, which compiler implements with a few wide stores.
+ */
+typedef struct ODP_ALIGNED(sizeof(uint64_t)) {
+	packet_parser_t p;
+
+	odp_pktio_t input;
+
+	int8_t subtype;
+
+	uint8_t reass_status;
+} packet_init_tmpl_t;
+
+#define PACKET_INIT_OFFSET offsetof(odp_packet_hdr_t, p)
+
+ODP_STATIC_ASSERT(offsetof(odp_packet_hdr_t, input) - PACKET_INIT_OFFSET ==
+		  offsetof(packet_init_tmpl_t, input),
+		  "PACKET_INIT_TMPL_INPUT_ERROR");
+
+ODP_STATIC_ASSERT(offsetof(odp_packet_hdr_t, subtype) - PACKET_INIT_OFFSET ==
+		  offsetof(packet_init_tmpl_t, subtype),
+		  "PACKET_INIT_TMPL_SUBTYPE_ERROR");
+
+ODP_STATIC_ASSERT(offsetof(odp_packet_hdr_t, reass_status) -
+		  PACKET_INIT_OFFSET ==
+		  offsetof(packet_init_tmpl_t, reass_status),
+		  "PACKET_INIT_TMPL_REASS_STATUS_ERROR");
+
+/* Template tail padding may overwrite only header padding */
+ODP_STATIC_ASSERT(PACKET_INIT_OFFSET + sizeof(packet_init_tmpl_t) <=
+		  offsetof(odp_packet_hdr_t, timestamp),
+		  "PACKET_INIT_TMPL_SIZE_ERROR");
+
+/**
+ * Prepare packet metadata template
  */
-static inline void packet_init(odp_packet_hdr_t *pkt_hdr, odp_pktio_t input)
+static inline void packet_init_tmpl_set(packet_init_tmpl_t *tmpl,
+					odp_pktio_t input)
 {
-	pkt_hdr->p.input_flags.all  = 0;
-	pkt_hdr->p.flags.all_flags  = 0;
+	memset(tmpl, 0, sizeof(packet_init_tmpl_t));
 
-	pkt_hdr->p.l2_offset        = 0;
-	pkt_hdr->p.l3_offset        = ODP_PACKET_OFFSET_INVALID;
-	pkt_hdr->p.l4_offset        = ODP_PACKET_OFFSET_INVALID;
+	tmpl->p.l2_offset = 0;
+	tmpl->p.l3_offset = ODP_PACKET_OFFSET_INVALID;
+	tmpl->p.l4_offset = ODP_PACKET_OFFSET_INVALID;
 
-	if (odp_unlikely(pkt_hdr->subtype != ODP_EVENT_PACKET_BASIC))
-		pkt_hdr->subtype = ODP_EVENT_PACKET_BASIC;
+	tmpl->input   = input;
+	tmpl->subtype = ODP_EVENT_PACKET_BASIC;
+}
 
-	pkt_hdr->input = input;
+/**
+ * Initialize ODP headers from a template
+ */
+static inline void packet_init(odp_packet_hdr_t *pkt_hdr,
+			       const packet_init_tmpl_t *tmpl)
+{
+	memcpy((uint8_t *)pkt_hdr + PACKET_INIT_OFFSET, tmpl,
+	       sizeof(packet_init_tmpl_t));
 }
 
 static inline void copy_packet_parser_metadata(odp_packet_hdr_t *src_hdr,
@@ -263,6 +323,23 @@ static inline int packet_hdr_has_ipv6(odp_packet_hdr_t *pkt_hdr)
 	return pkt_hdr->p.input_flags.ipv6;
 }
 
+static inline void packet_set_flow_hash(odp_packet_hdr_t *pkt_hdr,
+					uint32_t flow_hash)
+{
+	pkt_hdr->buf_hdr.mb.hash.rss = flow_hash;
+	pkt_hdr->buf_hdr.mb.ol_flags |= PKT_RX_RSS_HASH;
+}
+
+static inline int packet_hdr_has_flow_hash(odp_packet_hdr_t *pkt_hdr)
+{
+	return !!(pkt_hdr->buf_hdr.mb.ol_flags & PKT_RX_RSS_HASH);
+}
+
+static inline uint32_t packet_hdr_flow_hash(odp_packet_hdr_t *pkt_hdr)
+{
+	return pkt_hdr->buf_hdr.mb.hash.rss;
+}
+
 static inline void packet_set_ts(odp_packet_hdr_t *pkt_hdr, odp_time_t *ts)
 {
 	if (ts != NULL) {
@@ -286,6 +363,14 @@ int _odp_packet_tcp_chksum_insert(odp_packet_t pkt);
 int _odp_packet_udp_chksum_insert(odp_packet_t pkt);
 int _odp_packet_sctp_chksum_insert(odp_packet_t pkt);
 
+/* Split an IPv4 or IPv6 packet into fragments of at most 'mtu' bytes
+ * (counted from the IP header). Data preceding the IP header is copied into
+ * every fragment. Returns the number of fragments, or <0 when the packet
+ * cannot be fragmented into at most 'max_frags' fragments. The original
+ * packet is not modified and remains owned by the caller. */
+int _odp_packet_ip_fragment(odp_packet_t pkt, uint32_t l3_offset,
+			    uint32_t mtu, odp_packet_t frag[], int max_frags);
+
 /* We can't enforce tailroom reservation for received packets */
 ODP_STATIC_ASSERT(CONFIG_PACKET_TAILROOM == 0,
 		  "ERROR: Tailroom has to be 0, DPDK doesn't support this");
@@ -42,7 +42,7 @@ extern "C" {
 /* Forward declaration */
 struct pktio_if_ops;
 
-#define PKTIO_PRIVATE_SIZE 2048
+#define PKTIO_PRIVATE_SIZE 4096
 
 struct pktio_entry {
 	const struct pktio_if_ops *ops; /**< Implementation specific methods */
@@ -81,6 +81,7 @@ struct pktio_entry {
 		odp_atomic_u64_t in_discards;
 	} stats_extra;
 	odp_proto_chksums_t in_chksums; /**< Checksums validation settings */
+	odp_bool_t in_backpressure;	/**< Back-pressure from event queues */
 	char name[PKTIO_NAME_LEN];	/**< name of pktio provided to
 					     internal pktio_open() calls */
 	char full_name[PKTIO_NAME_LEN];	/**< original pktio name passed to
@@ -146,8 +147,28 @@ typedef struct pktio_if_ops {
 	int (*stop)(pktio_entry_t *pktio_entry);
 	int (*stats)(pktio_entry_t *pktio_entry, odp_pktio_stats_t *stats);
 	int (*stats_reset)(pktio_entry_t *pktio_entry);
+	int (*pktin_queue_stats)(pktio_entry_t *pktio_entry, uint32_t index,
+				 odp_pktin_queue_stats_t *pktin_stats);
+	int (*pktout_queue_stats)(pktio_entry_t *pktio_entry, uint32_t index,
+				  odp_pktout_queue_stats_t *pktout_stats);
+	int (*extra_stat_info)(pktio_entry_t *pktio_entry,
+			       odp_pktio_extra_stat_info_t info[], int num);
+	int (*extra_stats)(pktio_entry_t *pktio_entry, uint64_t stats[],
+			   int num);
+	int (*extra_stat_counter)(pktio_entry_t *pktio_entry, uint32_t id,
+				  uint64_t *stat);
+	int (*hash_proto_set)(pktio_entry_t *pktio_entry,
+			      const odp_pktin_hash_proto_t *hash_proto);
+	int (*hash_key_set)(pktio_entry_t *pktio_entry, const uint8_t key[],
+			    uint32_t len);
+	int (*hash_reta)(pktio_entry_t *pktio_entry, uint32_t reta[],
+			 uint32_t num);
+	int (*hash_reta_set)(pktio_entry_t *pktio_entry, const uint32_t reta[],
+			     uint32_t num);
+	int (*hash_balance)(pktio_entry_t *pktio_entry);
 	uint64_t (*pktin_ts_res)(pktio_entry_t *pktio_entry);
 	odp_time_t (*pktin_ts_from_ns)(pktio_entry_t *pktio_entry, uint64_t ns);
+	int (*pktout_ts_read)(pktio_entry_t *pktio_entry, odp_time_t *ts);
 	int (*recv)(pktio_entry_t *entry, int index, odp_packet_t packets[],
 		    int num);
 	int (*recv_tmo)(pktio_entry_t *entry, int index, odp_packet_t packets[],
@@ -207,7 +228,15 @@ static inline void pktio_cls_enabled_set(pktio_entry_t *entry, int ena)
 
 uint16_t dpdk_pktio_port_id(pktio_entry_t *entry);
 
-int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], int num);
+/* Process received packets. Input queue index is negative when unknown. */
+int input_pkts(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt_table[],
+	       int num);
+
+/* Output timed out IP fragments of a pktio without new input. Used when
+ * packets are received through eventdev, which does not poll the device
+ * when there is no input. Returns the number of packets in the table. */
+int input_pkts_reass_expired(pktio_entry_t *pktio_entry,
+			     odp_packet_t pkt_table[], int num);
 
 extern const pktio_if_ops_t null_pktio_ops;
 extern const pktio_if_ops_t dpdk_pktio_ops;
@@ -19,7 +19,9 @@ extern "C" {
 #include <odp_align_internal.h>
 #include <odp/api/packet_io.h>
 #include <odp/api/align.h>
+#include <odp/api/atomic.h>
 #include <odp/api/hints.h>
+#include <odp/api/sync.h>
 #include <odp/api/ticketlock.h>
 #include <odp_config_internal.h>
 #include <odp_ptr_ring_mpmc_internal.h>
@@ -52,6 +54,7 @@ struct queue_entry_s {
 	};
 
 	odp_atomic_u64_t     num_timers;
+	odp_atomic_u32_t     congested;
 	int                  status;
 
 	queue_deq_multi_fn_t orig_dequeue_multi;
@@ -116,6 +119,65 @@ int sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int num,
 		    int update_status);
 int sched_queue_empty(uint32_t queue_index);
 
+/* Congestion thresholds */
+void queue_thr_notify(queue_entry_t *queue, int congested, uint32_t depth);
+
+/* Congestion state for the given queue depth. Returns the new state when the
+ * current state needs to change, or -1 when it does not. */
+static inline int queue_thr_check(queue_entry_t *queue, uint32_t congested,
+				  uint32_t depth)
+{
+	if (congested == 0 && depth >= queue->s.param.threshold.high)
+		return 1;
+
+	if (congested && depth <= queue->s.param.threshold.low)
+		return 0;
+
+	return -1;
+}
+
+/* Update congestion state of a queue that is modified under the queue lock.
+ * Call with the lock held, after the enqueue or dequeue. Returns the new
+ * state, or -1 when the state did not change. The caller sends the
+ * notification after releasing the lock. */
+static inline int queue_thr_update_locked(queue_entry_t *queue, uint32_t depth)
+{
+	int state;
+
+	state = queue_thr_check(queue, odp_atomic_load_u32(&queue->s.congested),
+				depth);
+	if (state >= 0)
+		odp_atomic_store_u32(&queue->s.congested, state);
+
+	return state;
+}
+
+/* Update congestion state of a lock-free queue after an enqueue or dequeue.
+ * Concurrent operations may cross the other threshold between a depth read
+ * and a state change. So, after a state change the live depth is checked
+ * again and the change is reverted when needed. Otherwise the state could
+ * be left congested on an empty queue. */
+static inline void queue_thr_update(queue_entry_t *queue,
+				    uint32_t (*depth_fn)(queue_entry_t *queue))
+{
+	uint32_t old, depth;
+	int state;
+
+	while (1) {
+		/* Order ring update and state change before the reads */
+		odp_mb_full();
+		depth = depth_fn(queue);
+		old = odp_atomic_load_u32(&queue->s.congested);
+		state = queue_thr_check(queue, old, depth);
+
+		if (state < 0)
+			return;
+
+		if (odp_atomic_cas_u32(&queue->s.congested, &old, state))
+			queue_thr_notify(queue, state, depth);
+	}
+}
+
 #ifdef __cplusplus
 }
 #endif
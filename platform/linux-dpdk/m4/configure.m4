@@ -6,6 +6,7 @@ ODP_ATOMIC
 
 m4_include([platform/linux-dpdk/m4/odp_libconfig.m4])
 m4_include([platform/linux-dpdk/m4/odp_pcapng.m4])
+m4_include([platform/linux-dpdk/m4/odp_trace.m4])
 m4_include([platform/linux-dpdk/m4/odp_scheduler.m4])
 
 ODP_PTHREAD
@@ -55,6 +56,7 @@ AS_VAR_APPEND([PLAT_DEP_LIBS], ["${LIBCONFIG_LIBS} ${OPENSSL_LIBS} ${DPDK_LIBS_L
 AS_VAR_APPEND([PLAT_CFG_TEXT], ["
 	pcap:			${have_pmd_pcap}
 	pcapng:			${have_pcapng}
+	trace:			${have_trace}
 	default_config_path:	${default_config_path}"])
 
 ODP_CHECK_CFLAG([-Wno-error=cast-align])
@@ -20,6 +20,7 @@
 #include <odp/api/plat/time_inlines.h>
 #include <odp_packet_internal.h>
 #include <odp_global_data.h>
+#include <odp_trace_internal.h>
 
 /* Inlined API functions */
 #include <odp/api/plat/event_inlines.h>
@@ -1878,6 +1879,7 @@ int odp_crypto_int(odp_packet_t pkt_in,
 
 		/* There may be a delay until the crypto operation is
 		 * completed. */
+		_ODP_TRACE_BEGIN(_ODP_TRACE_CRYPTO_DEQ, session->cdev_id);
 		while (1) {
 			rc = rte_cryptodev_dequeue_burst(session->cdev_id,
 							 queue_pair, &op, 1);
@@ -1888,6 +1890,7 @@ int odp_crypto_int(odp_packet_t pkt_in,
 			}
 			break;
 		}
+		_ODP_TRACE_END(_ODP_TRACE_CRYPTO_DEQ, retry_count);
 		if (rc == 0) {
 			ODP_ERR("Failed to dequeue packet");
 			goto err_op_free;
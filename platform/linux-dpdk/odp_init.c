@@ -35,6 +35,7 @@ enum init_stage {
 	GLOBAL_RW_DATA_INIT,
 	HASH_INIT,
 	THREAD_INIT,
+	TRACE_INIT,
 	POOL_INIT,
 	STASH_INIT,
 	QUEUE_INIT,
@@ -272,6 +273,13 @@ static int term_global(enum init_stage stage)
 		}
 		/* Fall through */
 
+	case TRACE_INIT:
+		if (_odp_trace_term_global()) {
+			ODP_ERR("ODP trace term failed.\n");
+			rc = -1;
+		}
+		/* Fall through */
+
 	case THREAD_INIT:
 		if (_odp_thread_term_global()) {
 			ODP_ERR("ODP thread term failed.\n");
@@ -424,6 +432,12 @@ int odp_init_global(odp_instance_t *instance,
 	}
 	stage = THREAD_INIT;
 
+	if (_odp_trace_init_global()) {
+		ODP_ERR("ODP trace init failed.\n");
+		goto init_failed;
+	}
+	stage = TRACE_INIT;
+
 	if (_odp_pool_init_global()) {
 		ODP_ERR("ODP pool init failed.\n");
 		goto init_failed;
@@ -580,6 +594,13 @@ static int term_local(enum init_stage stage)
 		}
 		/* Fall through */
 
+	case TRACE_INIT:
+		if (_odp_trace_term_local()) {
+			ODP_ERR("ODP trace local term failed.\n");
+			rc = -1;
+		}
+		/* Fall through */
+
 	case THREAD_INIT:
 		rc_thd = _odp_thread_term_local();
 		if (rc_thd < 0) {
@@ -626,6 +647,12 @@ int odp_init_local(odp_instance_t instance, odp_thread_type_t thr_type)
 	}
 	stage = THREAD_INIT;
 
+	if (_odp_trace_init_local()) {
+		ODP_ERR("ODP trace local init failed.\n");
+		goto init_fail;
+	}
+	stage = TRACE_INIT;
+
 	if (_odp_pktio_init_local()) {
 		ODP_ERR("ODP packet io local init failed.\n");
 		goto init_fail;
@@ -103,6 +103,14 @@ static inline int num_segments(uint32_t len, uint32_t seg_len)
 	return num;
 }
 
+/* Metadata template for packets not received from a pktio */
+static const packet_init_tmpl_t packet_reset_tmpl = {
+	.p.l3_offset = ODP_PACKET_OFFSET_INVALID,
+	.p.l4_offset = ODP_PACKET_OFFSET_INVALID,
+	.input       = ODP_PKTIO_INVALID,
+	.subtype     = ODP_EVENT_PACKET_BASIC
+};
+
 static odp_packet_t packet_alloc(pool_t *pool, uint32_t len)
 {
 	odp_packet_t pkt;
@@ -219,15 +227,7 @@ int odp_packet_reset(odp_packet_t pkt, uint32_t len)
 		return -1;
 	}
 
-	pkt_hdr->p.input_flags.all  = 0;
-	pkt_hdr->p.flags.all_flags  = 0;
-
-	pkt_hdr->p.l2_offset = 0;
-	pkt_hdr->p.l3_offset = ODP_PACKET_OFFSET_INVALID;
-	pkt_hdr->p.l4_offset = ODP_PACKET_OFFSET_INVALID;
-
-	pkt_hdr->input = ODP_PKTIO_INVALID;
-	pkt_hdr->subtype = ODP_EVENT_PACKET_BASIC;
+	packet_init(pkt_hdr, &packet_reset_tmpl);
 
 	mb->port = 0xff;
 	mb->pkt_len = len;
@@ -637,6 +637,40 @@ void odp_packet_l4_chksum_insert(odp_packet_t pkt, int insert)
 	pkt_hdr->p.flags.l4_chksum = insert;
 }
 
+int odp_packet_lso_request(odp_packet_t pkt,
+			   const odp_packet_lso_opt_t *lso_opt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	if (odp_unlikely(lso_opt->payload_offset == 0 ||
+			 lso_opt->payload_offset > UINT16_MAX ||
+			 lso_opt->max_payload_len == 0 ||
+			 lso_opt->max_payload_len > UINT16_MAX)) {
+		ODP_ERR("Bad LSO options\n");
+		return -1;
+	}
+
+	pkt_hdr->lso_payload_offset = lso_opt->payload_offset;
+	pkt_hdr->lso_max_payload = lso_opt->max_payload_len;
+	pkt_hdr->p.flags.lso = 1;
+
+	return 0;
+}
+
+void odp_packet_lso_request_clr(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	pkt_hdr->p.flags.lso = 0;
+}
+
+int odp_packet_has_lso_request(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	return pkt_hdr->p.flags.lso;
+}
+
 odp_packet_chksum_status_t odp_packet_l3_chksum_status(odp_packet_t pkt)
 {
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
@@ -663,6 +697,11 @@ odp_packet_chksum_status_t odp_packet_l4_chksum_status(odp_packet_t pkt)
 	return ODP_PACKET_CHKSUM_OK;
 }
 
+odp_packet_reass_status_t odp_packet_reass_status(odp_packet_t pkt)
+{
+	return packet_hdr(pkt)->reass_status;
+}
+
 void odp_packet_ts_set(odp_packet_t pkt, odp_time_t timestamp)
 {
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
@@ -670,6 +709,11 @@ void odp_packet_ts_set(odp_packet_t pkt, odp_time_t timestamp)
 	packet_set_ts(pkt_hdr, &timestamp);
 }
 
+void odp_packet_ts_request(odp_packet_t pkt, int enable)
+{
+	packet_hdr(pkt)->p.flags.ts_set = !!enable;
+}
+
 /*
  *
  * Manipulation
@@ -1174,7 +1218,10 @@ int _odp_packet_copy_md_to_packet(odp_packet_t srcpkt, odp_packet_t dstpkt)
 	uint32_t dst_size = odp_packet_user_area_size(dstpkt);
 
 	dsthdr->input = srchdr->input;
+	dsthdr->reass_status = srchdr->reass_status;
 	dsthdr->dst_queue = srchdr->dst_queue;
+	dsthdr->lso_payload_offset = srchdr->lso_payload_offset;
+	dsthdr->lso_max_payload = srchdr->lso_max_payload;
 	dsthdr->buf_hdr.mb.userdata = srchdr->buf_hdr.mb.userdata;
 
 	dsthdr->buf_hdr.mb.port = srchdr->buf_hdr.mb.port;
@@ -1648,6 +1695,7 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 			      uint32_t *l4_part_sum)
 {
 	uint8_t  ip_proto;
+	const uint8_t *l4;
 
 	prs->l3_offset = offset;
 
@@ -1688,6 +1736,7 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 
 	/* Set l4 flag only for known ip_proto */
 	prs->input_flags.l4 = 1;
+	l4 = parseptr;
 
 	/* Parse Layer 4 headers */
 	switch (ip_proto) {
@@ -1742,6 +1791,19 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 		break;
 	}
 
+	/* Parse tunnel and inner headers */
+	if (layer == ODP_PROTO_LAYER_ALL && !prs->input_flags.ipfrag &&
+	    prs->l4_offset < seg_len) {
+		uint32_t len = seg_len - prs->l4_offset;
+		uint8_t tunnel = _odp_packet_tunnel_detect(l4, len, ip_proto);
+
+		if (odp_unlikely(tunnel != PACKET_TUNNEL_NONE))
+			prs->input_flags.tunnel =
+				_odp_packet_parse_tunnel(&prs->tunnel, l4,
+							 prs->l4_offset, len,
+							 tunnel, NULL);
+	}
+
 	return prs->flags.all.error != 0;
 }
 
@@ -1952,6 +2014,176 @@ int _odp_packet_sctp_chksum_insert(odp_packet_t pkt)
 	return odp_packet_copy_from_mem(pkt, pkt_hdr->p.l4_offset + 8, 4, &sum);
 }
 
+/* IPv6 fragment identification, unique per thread */
+static __thread uint32_t ipv6_frag_id;
+
+int _odp_packet_ip_fragment(odp_packet_t pkt, uint32_t l3_offset,
+			    uint32_t mtu, odp_packet_t frag[], int max_frags)
+{
+	struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
+	const uint8_t *data = rte_pktmbuf_mtod(mbuf, const uint8_t *);
+	struct rte_mbuf *src = mbuf;
+	uint32_t ip_hdr_len, hdr_len, payload_len, max_len, src_off;
+	uint32_t frag_hdr_len = 0;
+	uint32_t frag_base = 0;
+	uint32_t more = 0;
+	uint32_t id = 0;
+	uint32_t num, i;
+	int ipv4, ret;
+
+	if (l3_offset + _ODP_IPV4HDR_LEN > mbuf->data_len)
+		return -1;
+
+	ipv4 = _ODP_IPV4HDR_VER(data[l3_offset]) == _ODP_IPV4;
+
+	if (ipv4) {
+		const _odp_ipv4hdr_t *ip;
+		uint16_t frag_offset;
+
+		ip = (const _odp_ipv4hdr_t *)(uintptr_t)(data + l3_offset);
+		frag_offset = odp_be_to_cpu_16(ip->frag_offset);
+		if (_ODP_IPV4HDR_FLAGS_DONT_FRAG(frag_offset))
+			return -1;
+
+		ip_hdr_len = _ODP_IPV4HDR_IHL(ip->ver_ihl) * 4;
+		frag_base = _ODP_IPV4HDR_FRAG_OFFSET(frag_offset) * 8;
+		more = _ODP_IPV4HDR_FLAGS_MORE_FRAGS(frag_offset);
+	} else if (_ODP_IPV4HDR_VER(data[l3_offset]) == _ODP_IPV6) {
+		const _odp_ipv6hdr_t *ip;
+
+		/* Extension headers of the unfragmentable part are not
+		 * supported */
+		ip = (const _odp_ipv6hdr_t *)(uintptr_t)(data + l3_offset);
+		if (l3_offset + _ODP_IPV6HDR_LEN > mbuf->data_len ||
+		    ip->next_hdr == _ODP_IPPROTO_HOPOPTS ||
+		    ip->next_hdr == _ODP_IPPROTO_ROUTE ||
+		    ip->next_hdr == _ODP_IPPROTO_FRAG)
+			return -1;
+
+		ip_hdr_len = _ODP_IPV6HDR_LEN;
+		frag_hdr_len = _ODP_IPV6HDR_FRAG_LEN;
+		id = ((uint32_t)odp_thread_id() << 24) |
+		     (ipv6_frag_id++ & 0xffffff);
+	} else {
+		return -1;
+	}
+
+	hdr_len = l3_offset + ip_hdr_len;
+	if (ip_hdr_len < _ODP_IPV4HDR_LEN || hdr_len > mbuf->data_len ||
+	    mbuf->pkt_len <= hdr_len || mtu < ip_hdr_len + frag_hdr_len + 8)
+		return -1;
+
+	/* Fragment payload lengths are multiples of eight bytes */
+	payload_len = mbuf->pkt_len - hdr_len;
+	max_len = (mtu - ip_hdr_len - frag_hdr_len) & ~7u;
+	num = (payload_len + max_len - 1) / max_len;
+	if (num > (uint32_t)max_frags)
+		return -1;
+
+	ret = odp_packet_alloc_multi(odp_packet_pool(pkt),
+				     hdr_len + frag_hdr_len, frag, num);
+	if (odp_unlikely(ret != (int)num)) {
+		if (ret > 0)
+			odp_packet_free_multi(frag, ret);
+		return -1;
+	}
+
+	src_off = hdr_len;
+
+	for (i = 0; i < num; i++) {
+		struct rte_mbuf *seg = pkt_to_mbuf(frag[i]);
+		struct rte_mbuf *last = seg;
+		odp_packet_hdr_t *pkt_hdr = packet_hdr(frag[i]);
+		uint8_t *hdr = rte_pktmbuf_mtod(seg, uint8_t *);
+		uint32_t offset = i * max_len;
+		uint32_t len = RTE_MIN(max_len, payload_len - offset);
+		uint32_t left = len;
+		int last_frag = i == num - 1;
+
+		memcpy(hdr, data, hdr_len);
+		seg->pkt_len = hdr_len + frag_hdr_len + len;
+
+		/* Payload is attached from the original packet without
+		 * copying (indirect mbufs) */
+		while (left) {
+			struct rte_mbuf *ind;
+			uint32_t n;
+
+			if (src_off == src->data_len) {
+				src = src->next;
+				src_off = 0;
+				continue;
+			}
+
+			ind = rte_pktmbuf_alloc(mbuf->pool);
+			if (odp_unlikely(ind == NULL)) {
+				odp_packet_free_multi(frag, num);
+				return -1;
+			}
+
+			n = RTE_MIN(left, src->data_len - src_off);
+			rte_pktmbuf_attach(ind, src);
+			ind->data_off += src_off;
+			ind->data_len = n;
+			ind->pkt_len = n;
+
+			last->next = ind;
+			last = ind;
+			seg->nb_segs++;
+			src_off += n;
+			left -= n;
+		}
+
+		if (ipv4) {
+			_odp_ipv4hdr_t *ip;
+			uint16_t frag_offset = (frag_base + offset) / 8;
+
+			if (!last_frag || more)
+				frag_offset |= _ODP_IPV4HDR_MORE_FRAGS;
+
+			ip = (_odp_ipv4hdr_t *)(uintptr_t)(hdr + l3_offset);
+			ip->tot_len = odp_cpu_to_be_16(ip_hdr_len + len);
+			ip->frag_offset = odp_cpu_to_be_16(frag_offset);
+			if (i > 0)
+				_odp_ipv4_opts_frag(hdr + l3_offset +
+						    _ODP_IPV4HDR_LEN,
+						    ip_hdr_len -
+						    _ODP_IPV4HDR_LEN);
+			ip->chksum = 0;
+			ip->chksum = ~odp_chksum_ones_comp16(ip, ip_hdr_len);
+		} else {
+			_odp_ipv6hdr_t *ip;
+			_odp_ipv6hdr_frag_t *fh;
+			uint16_t frag_offset = offset;
+
+			if (!last_frag)
+				frag_offset |= 1;
+
+			ip = (_odp_ipv6hdr_t *)(uintptr_t)(hdr + l3_offset);
+			fh = (_odp_ipv6hdr_frag_t *)(uintptr_t)(hdr + hdr_len);
+			fh->next_hdr = ip->next_hdr;
+			fh->reserved = 0;
+			fh->frag_offset = odp_cpu_to_be_16(frag_offset);
+			fh->id = odp_cpu_to_be_32(id);
+			ip->next_hdr = _ODP_IPPROTO_FRAG;
+			ip->payload_len = odp_cpu_to_be_16(frag_hdr_len + len);
+		}
+
+		/* Checksums have been calculated in software */
+		_odp_packet_copy_md_to_packet(pkt, frag[i]);
+		seg->ol_flags &= ~(PKT_TX_IP_CKSUM | PKT_TX_L4_MASK);
+
+		pkt_hdr->p.l3_offset = l3_offset;
+		pkt_hdr->p.input_flags.ipfrag = 1;
+		if (i > 0)
+			pkt_hdr->p.l4_offset = ODP_PACKET_OFFSET_INVALID;
+		else if (pkt_hdr->p.l4_offset != ODP_PACKET_OFFSET_INVALID)
+			pkt_hdr->p.l4_offset += frag_hdr_len;
+	}
+
+	return num;
+}
+
 static int packet_l4_chksum(odp_packet_hdr_t *pkt_hdr,
 			    odp_proto_chksums_t chksums,
 			    uint32_t l4_part_sum)
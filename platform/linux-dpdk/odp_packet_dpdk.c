@@ -18,12 +18,15 @@
 #include <string.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <time.h>
 
 #include <linux/ethtool.h>
 #include <linux/sockios.h>
 
 #include <odp/api/cpu.h>
+#include <odp/api/hash.h>
 #include <odp/api/hints.h>
+#include <odp/api/shared_memory.h>
 #include <odp/api/system_info.h>
 #include <odp_debug_internal.h>
 #include <odp_errno_define.h>
@@ -41,16 +44,21 @@
 #include <protocols/udp.h>
 
 #include <rte_config.h>
+#include <rte_alarm.h>
 #if defined(__clang__)
 #undef RTE_TOOLCHAIN_GCC
 #endif
 #include <rte_bus_vdev.h>
+#include <rte_cycles.h>
 #include <rte_ethdev.h>
 #include <rte_eth_ring.h>
 #include <rte_ip_frag.h>
 #include <rte_udp.h>
 #include <rte_tcp.h>
 #include <rte_version.h>
+#if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 0, 0)
+#include <rte_mbuf_dyn.h>
+#endif
 
 #if RTE_VERSION < RTE_VERSION_NUM(19, 8, 0, 0)
 #define rte_ether_addr ether_addr
@@ -73,16 +81,200 @@
 /* Number of packet buffers to prefetch in RX */
 #define NUM_RX_PREFETCH 4
 
+/* Maximum LSO header length (payload offset) */
+#define DPDK_LSO_MAX_HDR_LEN 128
+
+/* Maximum number of output packets per LSO packet segmented in software */
+#define DPDK_LSO_MAX_SEGS 64
+
+/* TSO is used only together with IPv4 and TCP checksum offloads, since
+ * checksums of TSO output packets are not calculated in software */
+#define DPDK_TSO_OFFLOADS (DEV_TX_OFFLOAD_TCP_TSO | \
+			   DEV_TX_OFFLOAD_IPV4_CKSUM | \
+			   DEV_TX_OFFLOAD_TCP_CKSUM)
+
+/* Maximum number of fragments per IP fragmented output packet */
+#define DPDK_FRAG_MAX_FRAGS DPDK_LSO_MAX_SEGS
+
+/* Maximum number of retries to send the rest of the output packets of a
+ * packet segmented or fragmented in software */
+#define DPDK_SW_TX_RETRIES 16
+
+/* TCP flags cleared from all but the last LSO output packet */
+#define DPDK_LSO_TCP_FLAGS_LAST (0x01 | 0x08) /* FIN | PSH */
+
+/* Maximum number of GRO flows per packet input burst */
+#define DPDK_GRO_MAX_FLOWS 32
+
+/* TCP flags */
+#define DPDK_TCP_FLAG_PSH 0x08
+#define DPDK_TCP_FLAG_ACK 0x10
+
+/* Maximum number of RSS redirection table entries moved per balancing
+ * round */
+#define DPDK_RSS_BALANCE_MAX_MOVES 32
+
+/* Hardware RX timestamps need device clock reads for time conversion */
+#if RTE_VERSION >= RTE_VERSION_NUM(19, 8, 0, 0)
+#define DPDK_RX_HW_TS 1
+#endif
+
+/* Maximum device clock calibration time in milliseconds */
+#define DPDK_RX_TS_MAX_CALIB_TIME 100
+
+/* Interval of device clock recalibration for packet input timestamps in
+ * microseconds */
+#define DPDK_RX_TS_CALIB_INTERVAL 1000000
+
+/* Interval of device PTP clock offset recalibration for packet output
+ * timestamps in nanoseconds */
+#define DPDK_TX_TS_CALIB_INTERVAL ODP_TIME_SEC_IN_NS
+
+/* Ethernet preamble, start frame delimiter, FCS and inter-frame gap bytes
+ * per frame on the wire */
+#define DPDK_WIRE_OVERHEAD 24
+
+/* Maximum number of fragments per reassembled IP packet */
+#define DPDK_REASS_MAX_FRAGS 16
+
+/* Maximum IP reassembly wait time in nanoseconds */
+#define DPDK_REASS_MAX_WAIT_TIME (10 * ODP_TIME_SEC_IN_NS)
+
+/* Maximum number of IP reassembly flows per input queue */
+#define DPDK_REASS_MAX_FLOWS (64 * 1024)
+
+/* Number of flow table slots probed per fragment */
+#define DPDK_REASS_PROBE 4
+
+/* IP reassembly flow key size in 32-bit words */
+#define DPDK_REASS_KEY_WORDS 10
+
 /** DPDK runtime configuration options */
 typedef struct {
 	int multicast_enable;
 	int num_rx_desc;
 	int num_tx_desc;
 	int rx_drop_en;
+	int gro_max_flows;
+	int gro_max_pkts;
+	int rss_balance_interval;
+	int rss_balance_threshold;
+	int rx_free_thresh;
+	int tx_free_thresh;
+	int tx_rs_thresh;
+	int rx_ts_hw_en;
+	int rx_ts_calib_time;
+	int reass_max_flows;
 } dpdk_opt_t;
 
+/** RSS redirection table balancer */
+typedef struct {
+	odp_shm_t shm;
+	/* Serializes balancing rounds and redirection table updates */
+	odp_spinlock_t lock;
+	/* Automatic balancing interval in microseconds, 0 when disabled */
+	uint64_t interval;
+	/* Minimum queue load imbalance in percents of average load */
+	uint32_t threshold;
+	uint16_t reta_size;
+	uint16_t num_queues;
+	/* Input queue of each redirection table entry */
+	uint16_t *reta;
+	/* Packets received per input queue and redirection table entry.
+	 * A queue row is written only by the thread polling the queue. */
+	uint32_t *load;
+	/* Load counter values at the previous balancing round */
+	uint32_t *seen;
+} rss_balance_t;
+
+/** Device clock to global time conversion */
+typedef struct {
+	/* Device clock value and global time at calibration */
+	uint64_t ref_clk;
+	uint64_t ref_time;
+	/* Global time units per device clock tick in 32.32 fixed point */
+	uint64_t mult_int;
+	uint64_t mult_frac;
+} rx_ts_conv_t;
+
+/** Packet input timestamping */
+typedef struct {
+	/* Timestamping enabled */
+	uint8_t ena;
+	/* Hardware timestamps enabled */
+	uint8_t hw;
+#if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 0, 0)
+	/* Timestamp dynamic field offset and flag */
+	int dyn_offset;
+	uint64_t dyn_flag;
+#endif
+	/* Device clock to global time conversions. Recalibration updates the
+	 * one not in use and then switches conv_idx to it. */
+	rx_ts_conv_t conv[2];
+	uint32_t conv_idx;
+	/* Device clock frequency in hertz */
+	uint64_t clk_hz;
+	/* Global time units per wire byte in 16.16 fixed point, zero when
+	 * link speed is unknown */
+	uint64_t byte_time;
+	/* Global time of the previous poll per input queue */
+	uint64_t prev[PKTIO_MAX_QUEUES];
+} rx_ts_t;
+
+/** IP reassembly fragment */
+typedef struct {
+	odp_packet_t pkt;
+	/* Fragment offset and payload length in bytes */
+	uint16_t offset;
+	uint16_t len;
+	/* Length of headers preceding the payload */
+	uint16_t hdr_len;
+} reass_frag_t;
+
+/** IP reassembly flow */
+typedef struct {
+	uint32_t key[DPDK_REASS_KEY_WORDS];
+	/* Arrival of the first fragment in timer cycles */
+	uint64_t start;
+	/* Reassembled payload length, 0 until the last fragment arrives */
+	uint32_t total_len;
+	/* Received payload bytes */
+	uint32_t recv_len;
+	uint16_t l3_offset;
+	uint8_t ipv4;
+	/* Number of held fragments, 0 when the table slot is free */
+	uint8_t num_frags;
+	/* Held fragments sorted by offset */
+	reass_frag_t frag[DPDK_REASS_MAX_FRAGS];
+} reass_flow_t;
+
+/** IP reassembly flow table of an input queue */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Serializes eventdev and MT safe packet input */
+	odp_spinlock_t lock;
+	uint32_t num_flows;
+	/* Next flow timeout check in timer cycles */
+	uint64_t next_check;
+	reass_flow_t *flow;
+} reass_queue_t;
+
+/** IP reassembly */
+typedef struct {
+	odp_shm_t shm;
+	/* Maximum wait time in timer cycles */
+	uint64_t max_wait;
+	uint32_t flow_mask;
+	uint16_t max_frags;
+	uint16_t num_queues;
+	uint8_t ipv4;
+	uint8_t ipv6;
+	reass_queue_t queue[PKTIO_MAX_QUEUES];
+} reass_t;
+
 /** Packet socket using dpdk mmaped rings for both Rx and Tx */
 typedef struct ODP_ALIGNED_CACHE {
+	/* Packet metadata template for received packets */
+	packet_init_tmpl_t init_tmpl;
 	uint16_t port_id;		  /**< DPDK port identifier */
 	uint16_t mtu;			  /**< maximum transmission unit */
 	uint8_t lockless_rx;		  /**< no locking for rx */
@@ -92,7 +284,25 @@ typedef struct ODP_ALIGNED_CACHE {
 	odp_pktin_hash_proto_t hash;	  /**< Packet input hash protocol */
 	/* Supported RTE_PTYPE_XXX flags in a mask */
 	uint32_t supported_ptypes;
+	/* Enabled DEV_TX_OFFLOAD_XXX flags */
+	uint64_t tx_offloads;
+	/* RSS redirection table balancer, NULL when not in use */
+	rss_balance_t *rss_bal;
+	/* IP reassembly, NULL when not in use */
+	reass_t *reass;
+	/* Packet output timestamp capture enabled */
+	uint8_t tx_ts_ena;
+	/* Global time minus device PTP clock time in nanoseconds */
+	int64_t tx_ts_offset;
+	/* Global time of the previous offset calibration in nanoseconds */
+	uint64_t tx_ts_calib_ns;
+	/* Requested RX/TX ring sizes per queue, 0 for default */
+	uint16_t rx_queue_size[PKTIO_MAX_QUEUES];
+	uint16_t tx_queue_size[PKTIO_MAX_QUEUES];
+	/* GRO enabled per input queue */
+	uint8_t gro[PKTIO_MAX_QUEUES];
 	char ifname[32];
+	rx_ts_t rx_ts;
 	/** RX queue locks */
 	odp_ticketlock_t ODP_ALIGNED_CACHE rx_lock[PKTIO_MAX_QUEUES];
 	odp_ticketlock_t tx_lock[PKTIO_MAX_QUEUES];  /**< TX queue locks */
@@ -194,12 +404,95 @@ static int init_options(pktio_entry_t *pktio_entry,
 		return -1;
 	opt->multicast_enable = !!opt->multicast_enable;
 
+	if (!lookup_opt("gro_max_flows", dev_info->driver_name,
+			&opt->gro_max_flows))
+		return -1;
+	if (opt->gro_max_flows < 1 ||
+	    opt->gro_max_flows > DPDK_GRO_MAX_FLOWS) {
+		ODP_ERR("Invalid number of GRO flows\n");
+		return -1;
+	}
+
+	if (!lookup_opt("gro_max_pkts", dev_info->driver_name,
+			&opt->gro_max_pkts))
+		return -1;
+	if (opt->gro_max_pkts < 1 || opt->gro_max_pkts > UINT8_MAX) {
+		ODP_ERR("Invalid number of GRO packets\n");
+		return -1;
+	}
+
+	if (!lookup_opt("rss_balance_interval", dev_info->driver_name,
+			&opt->rss_balance_interval))
+		return -1;
+	if (opt->rss_balance_interval < 0) {
+		ODP_ERR("Invalid RSS balance interval\n");
+		return -1;
+	}
+
+	if (!lookup_opt("rss_balance_threshold", dev_info->driver_name,
+			&opt->rss_balance_threshold))
+		return -1;
+	if (opt->rss_balance_threshold < 0) {
+		ODP_ERR("Invalid RSS balance threshold\n");
+		return -1;
+	}
+
+	if (!lookup_opt("rx_free_thresh", dev_info->driver_name,
+			&opt->rx_free_thresh))
+		return -1;
+	if (!lookup_opt("tx_free_thresh", dev_info->driver_name,
+			&opt->tx_free_thresh))
+		return -1;
+	if (!lookup_opt("tx_rs_thresh", dev_info->driver_name,
+			&opt->tx_rs_thresh))
+		return -1;
+	if (opt->rx_free_thresh < 0 || opt->rx_free_thresh > UINT16_MAX ||
+	    opt->tx_free_thresh < 0 || opt->tx_free_thresh > UINT16_MAX ||
+	    opt->tx_rs_thresh < 0 || opt->tx_rs_thresh > UINT16_MAX) {
+		ODP_ERR("Invalid descriptor threshold\n");
+		return -1;
+	}
+
+	if (!lookup_opt("rx_ts_hw_en", dev_info->driver_name,
+			&opt->rx_ts_hw_en))
+		return -1;
+	opt->rx_ts_hw_en = !!opt->rx_ts_hw_en;
+
+	if (!lookup_opt("rx_ts_calib_time", dev_info->driver_name,
+			&opt->rx_ts_calib_time))
+		return -1;
+	if (opt->rx_ts_calib_time < 1 ||
+	    opt->rx_ts_calib_time > DPDK_RX_TS_MAX_CALIB_TIME) {
+		ODP_ERR("Invalid RX timestamp calibration time\n");
+		return -1;
+	}
+
+	if (!lookup_opt("reass_max_flows", dev_info->driver_name,
+			&opt->reass_max_flows))
+		return -1;
+	if (opt->reass_max_flows < 1 ||
+	    opt->reass_max_flows > DPDK_REASS_MAX_FLOWS ||
+	    (opt->reass_max_flows & (opt->reass_max_flows - 1))) {
+		ODP_ERR("Invalid number of IP reassembly flows\n");
+		return -1;
+	}
+
 	ODP_PRINT("DPDK interface (%s): %" PRIu16 "\n", dev_info->driver_name,
 		  pkt_priv(pktio_entry)->port_id);
 	ODP_PRINT("  multicast:   %d\n", opt->multicast_enable);
 	ODP_PRINT("  num_rx_desc: %d\n", opt->num_rx_desc);
 	ODP_PRINT("  num_tx_desc: %d\n", opt->num_tx_desc);
 	ODP_PRINT("  rx_drop_en:  %d\n", opt->rx_drop_en);
+	ODP_PRINT("  gro_max_flows: %d\n", opt->gro_max_flows);
+	ODP_PRINT("  gro_max_pkts:  %d\n", opt->gro_max_pkts);
+	ODP_PRINT("  rss_balance_interval:  %d\n", opt->rss_balance_interval);
+	ODP_PRINT("  rss_balance_threshold: %d\n", opt->rss_balance_threshold);
+	ODP_PRINT("  rx_free_thresh: %d\n", opt->rx_free_thresh);
+	ODP_PRINT("  tx_free_thresh: %d\n", opt->tx_free_thresh);
+	ODP_PRINT("  tx_rs_thresh:   %d\n", opt->tx_rs_thresh);
+	ODP_PRINT("  rx_ts_hw_en:      %d\n", opt->rx_ts_hw_en);
+	ODP_PRINT("  rx_ts_calib_time: %d\n", opt->rx_ts_calib_time);
+	ODP_PRINT("  reass_max_flows:  %d\n", opt->reass_max_flows);
 
 	return 0;
 }
@@ -239,6 +532,23 @@ static void rss_conf_to_hash_proto(struct rte_eth_rss_conf *rss_conf,
 	rss_conf->rss_key = NULL;
 }
 
+/* Report RSS hash fields to the classifier, which may then reuse RSS hash
+ * values for CoS queue selection */
+static void cls_input_hash_set(pktio_entry_t *pktio_entry, uint64_t rss_hf)
+{
+	odp_pktin_hash_proto_t hash_proto;
+
+	hash_proto.all_bits = 0;
+	hash_proto.proto.ipv4_udp = !!(rss_hf & ETH_RSS_NONFRAG_IPV4_UDP);
+	hash_proto.proto.ipv4_tcp = !!(rss_hf & ETH_RSS_NONFRAG_IPV4_TCP);
+	hash_proto.proto.ipv4 = !!(rss_hf & ETH_RSS_IPV4);
+	hash_proto.proto.ipv6_udp = !!(rss_hf & ETH_RSS_NONFRAG_IPV6_UDP);
+	hash_proto.proto.ipv6_tcp = !!(rss_hf & ETH_RSS_NONFRAG_IPV6_TCP);
+	hash_proto.proto.ipv6 = !!(rss_hf & ETH_RSS_IPV6);
+
+	_odp_cls_input_hash_proto_set(pktio_entry, &hash_proto);
+}
+
 static int dpdk_setup_eth_dev(pktio_entry_t *pktio_entry,
 			      const struct rte_eth_dev_info *dev_info)
 {
@@ -262,6 +572,7 @@ static int dpdk_setup_eth_dev(pktio_entry_t *pktio_entry,
 
 	/* Filter out unsupported flags */
 	rss_conf.rss_hf &= rss_hf_capa;
+	cls_input_hash_set(pktio_entry, rss_conf.rss_hf);
 
 	memset(&eth_conf, 0, sizeof(eth_conf));
 
@@ -279,6 +590,19 @@ static int dpdk_setup_eth_dev(pktio_entry_t *pktio_entry,
 	if (pktio_entry->s.config.pktin.bit.tcp_chksum)
 		rx_offloads |= DEV_RX_OFFLOAD_TCP_CKSUM;
 
+	/* Hardware timestamps are used when supported. Otherwise, packets are
+	 * timestamped in software. */
+	pkt_dpdk->rx_ts.ena = pktio_entry->s.config.pktin.bit.ts_all ||
+			      pktio_entry->s.config.pktin.bit.ts_ptp;
+	pkt_dpdk->rx_ts.hw = 0;
+#ifdef DPDK_RX_HW_TS
+	if (pkt_dpdk->rx_ts.ena && pkt_dpdk->opt.rx_ts_hw_en &&
+	    (dev_info->rx_offload_capa & DEV_RX_OFFLOAD_TIMESTAMP)) {
+		rx_offloads |= DEV_RX_OFFLOAD_TIMESTAMP;
+		pkt_dpdk->rx_ts.hw = 1;
+	}
+#endif
+
 	eth_conf.rxmode.offloads = rx_offloads;
 
 	/* Setup TX checksum offloads */
@@ -294,11 +618,24 @@ static int dpdk_setup_eth_dev(pktio_entry_t *pktio_entry,
 	if (pktio_entry->s.config.pktout.bit.sctp_chksum_ena)
 		tx_offloads |= DEV_TX_OFFLOAD_SCTP_CKSUM;
 
-	eth_conf.txmode.offloads = tx_offloads;
-
 	if (tx_offloads)
 		pktio_entry->s.chksum_insert_ena = 1;
 
+	/* LSO uses TSO when available. Otherwise, packets are segmented in
+	 * software and checksum offloads are used when available. */
+	if (pktio_entry->s.config.enable_lso) {
+		if ((dev_info->tx_offload_capa & DPDK_TSO_OFFLOADS) ==
+		    DPDK_TSO_OFFLOADS)
+			tx_offloads |= DPDK_TSO_OFFLOADS;
+		else
+			tx_offloads |= dev_info->tx_offload_capa &
+				(DEV_TX_OFFLOAD_IPV4_CKSUM |
+				 DEV_TX_OFFLOAD_TCP_CKSUM);
+	}
+
+	eth_conf.txmode.offloads = tx_offloads;
+	pkt_dpdk->tx_offloads = tx_offloads;
+
 	/* RX packet len same size as pool segment minus headroom and double
 	 * VLAN tag
 	 */
@@ -335,7 +672,7 @@ static void _dpdk_print_port_mac(uint16_t port_id)
 }
 
 static int check_hash_proto(pktio_entry_t *pktio_entry,
-			    const odp_pktin_queue_param_t *p)
+			    const odp_pktin_hash_proto_t *hash_proto)
 {
 	struct rte_eth_dev_info dev_info;
 	uint64_t rss_hf_capa;
@@ -345,41 +682,41 @@ static int check_hash_proto(pktio_entry_t *pktio_entry,
 	rte_eth_dev_info_get(port_id, &dev_info);
 	rss_hf_capa = dev_info.flow_type_rss_offloads;
 
-	if (p->hash_proto.proto.ipv4 &&
+	if (hash_proto->proto.ipv4 &&
 	    ((rss_hf_capa & ETH_RSS_IPV4) == 0)) {
 		ODP_ERR("hash_proto.ipv4 not supported\n");
 		return -1;
 	}
 
-	if (p->hash_proto.proto.ipv4_udp &&
+	if (hash_proto->proto.ipv4_udp &&
 	    ((rss_hf_capa & ETH_RSS_NONFRAG_IPV4_UDP) == 0)) {
 		ODP_ERR("hash_proto.ipv4_udp not supported. "
 			"rss_hf_capa 0x%" PRIx64 "\n", rss_hf_capa);
 		return -1;
 	}
 
-	if (p->hash_proto.proto.ipv4_tcp &&
+	if (hash_proto->proto.ipv4_tcp &&
 	    ((rss_hf_capa & ETH_RSS_NONFRAG_IPV4_TCP) == 0)) {
 		ODP_ERR("hash_proto.ipv4_tcp not supported. "
 			"rss_hf_capa 0x%" PRIx64 "\n", rss_hf_capa);
 		return -1;
 	}
 
-	if (p->hash_proto.proto.ipv6 &&
+	if (hash_proto->proto.ipv6 &&
 	    ((rss_hf_capa & ETH_RSS_IPV6) == 0)) {
 		ODP_ERR("hash_proto.ipv6 not supported. "
 			"rss_hf_capa 0x%" PRIx64 "\n", rss_hf_capa);
 		return -1;
 	}
 
-	if (p->hash_proto.proto.ipv6_udp &&
+	if (hash_proto->proto.ipv6_udp &&
 	    ((rss_hf_capa & ETH_RSS_NONFRAG_IPV6_UDP) == 0)) {
 		ODP_ERR("hash_proto.ipv6_udp not supported. "
 			"rss_hf_capa 0x%" PRIx64 "\n", rss_hf_capa);
 		return -1;
 	}
 
-	if (p->hash_proto.proto.ipv6_tcp &&
+	if (hash_proto->proto.ipv6_tcp &&
 	    ((rss_hf_capa & ETH_RSS_NONFRAG_IPV6_TCP) == 0)) {
 		ODP_ERR("hash_proto.ipv6_tcp not supported. "
 			"rss_hf_capa 0x%" PRIx64 "\n", rss_hf_capa);
@@ -393,10 +730,11 @@ static int dpdk_input_queues_config(pktio_entry_t *pktio_entry,
 				    const odp_pktin_queue_param_t *p)
 {
 	odp_pktin_mode_t mode = pktio_entry->s.param.in_mode;
+	uint32_t i;
 	uint8_t lockless;
 
 	if (p->hash_enable && p->num_queues > 1 &&
-	    check_hash_proto(pktio_entry, p))
+	    check_hash_proto(pktio_entry, &p->hash_proto))
 		return -1;
 
 	/**
@@ -413,6 +751,15 @@ static int dpdk_input_queues_config(pktio_entry_t *pktio_entry,
 
 	pkt_priv(pktio_entry)->lockless_rx = lockless;
 
+	/* Sizes have been checked against capability */
+	for (i = 0; i < PKTIO_MAX_QUEUES; i++)
+		pkt_priv(pktio_entry)->rx_queue_size[i] = i < p->num_queues ?
+			p->queue_size[i] : 0;
+
+	for (i = 0; i < PKTIO_MAX_QUEUES; i++)
+		pkt_priv(pktio_entry)->gro[i] = i < p->num_queues ?
+			p->enable_gro[i] : 0;
+
 	return 0;
 }
 
@@ -420,6 +767,7 @@ static int dpdk_output_queues_config(pktio_entry_t *pktio_entry,
 				     const odp_pktout_queue_param_t *p)
 {
 	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	uint32_t i;
 	uint8_t lockless;
 
 	if (p->op_mode == ODP_PKTIO_OP_MT_UNSAFE)
@@ -429,6 +777,11 @@ static int dpdk_output_queues_config(pktio_entry_t *pktio_entry,
 
 	pkt_dpdk->lockless_tx = lockless;
 
+	/* Sizes have been checked against capability */
+	for (i = 0; i < PKTIO_MAX_QUEUES; i++)
+		pkt_dpdk->tx_queue_size[i] = i < p->num_queues ?
+			p->queue_size[i] : 0;
+
 	return 0;
 }
 
@@ -516,6 +869,16 @@ static int dpdk_init_capability(pktio_entry_t *pktio_entry,
 
 	capa->max_output_queues = RTE_MIN(dev_info->max_tx_queues,
 					  PKTIO_MAX_QUEUES);
+
+	/* Ring pmd has fixed size rings */
+	if (!pkt_dpdk->loopback) {
+		capa->min_input_queue_size =
+			RTE_MAX(dev_info->rx_desc_lim.nb_min, 1);
+		capa->max_input_queue_size = dev_info->rx_desc_lim.nb_max;
+		capa->min_output_queue_size =
+			RTE_MAX(dev_info->tx_desc_lim.nb_min, 1);
+		capa->max_output_queue_size = dev_info->tx_desc_lim.nb_max;
+	}
 	capa->set_op.op.promisc_mode = 1;
 
 	/* Ring pmd doesn't support setting MAC or enabling promisc mode */
@@ -596,6 +959,57 @@ static int dpdk_init_capability(pktio_entry_t *pktio_entry,
 	capa->config.pktout.bit.tcp_chksum_ena =
 		capa->config.pktout.bit.tcp_chksum;
 
+	/* Packet output timestamps are captured with IEEE1588 timesync */
+	if (!pkt_dpdk->loopback &&
+	    rte_eth_timesync_enable(pkt_dpdk->port_id) == 0) {
+		rte_eth_timesync_disable(pkt_dpdk->port_id);
+		capa->config.pktout.bit.ts_ena = 1;
+	}
+
+	/* LSO falls back to software segmentation when TSO is not
+	 * supported */
+	capa->config.enable_lso = 1;
+	capa->lso.tcp_ipv4 = 1;
+	capa->lso.tcp_ipv6 = 1;
+	capa->lso.max_payload_offset = DPDK_LSO_MAX_HDR_LEN;
+	capa->lso.max_segments = DPDK_LSO_MAX_SEGS;
+
+	/* IP fragments are built in software */
+	capa->config.enable_frag = 1;
+	capa->frag.ipv4 = 1;
+	capa->frag.ipv6 = 1;
+	capa->frag.max_frags = DPDK_FRAG_MAX_FRAGS;
+
+	capa->stats.pktin_queue.counter.octets = 1;
+	capa->stats.pktin_queue.counter.packets = 1;
+	capa->stats.pktin_queue.counter.errors = 1;
+	capa->stats.pktout_queue.counter.octets = 1;
+	capa->stats.pktout_queue.counter.packets = 1;
+
+	/* Segments with unknown checksum status (e.g. loopback) are coalesced
+	 * and the status stays unknown */
+	capa->config.enable_gro = 1;
+
+	capa->reassembly.ipv4 = 1;
+	capa->reassembly.ipv6 = 1;
+	capa->reassembly.max_wait_time = DPDK_REASS_MAX_WAIT_TIME;
+	capa->reassembly.max_num_frags = DPDK_REASS_MAX_FRAGS;
+
+	/* Ring pmd doesn't support RSS */
+	if (!pkt_dpdk->loopback && dev_info->flow_type_rss_offloads) {
+		capa->hash.proto_update = 1;
+		if (dev_info->hash_key_size) {
+			capa->hash.key_update = 1;
+			capa->hash.key_size = dev_info->hash_key_size;
+		}
+		/* Balancer maps hash values to entries with a mask */
+		if (dev_info->reta_size &&
+		    rte_is_power_of_2(dev_info->reta_size)) {
+			capa->hash.reta_update = 1;
+			capa->hash.reta_size = dev_info->reta_size;
+		}
+	}
+
 	return 0;
 }
 
@@ -663,7 +1077,7 @@ static void promisc_mode_check(pkt_dpdk_t *pkt_dpdk)
 #endif
 }
 
-static int setup_pkt_dpdk(odp_pktio_t pktio ODP_UNUSED,
+static int setup_pkt_dpdk(odp_pktio_t pktio,
 			  pktio_entry_t *pktio_entry,
 			  const char *netdev, odp_pool_t pool ODP_UNUSED)
 {
@@ -696,6 +1110,8 @@ static int setup_pkt_dpdk(odp_pktio_t pktio ODP_UNUSED,
 		return -1;
 	}
 
+	packet_init_tmpl_set(&pkt_dpdk->init_tmpl, pktio);
+
 	/* Drivers requiring minimum burst size. Supports also *_vf versions
 	 * of the drivers. */
 	if (!strncmp(dev_info.driver_name, IXGBE_DRV_NAME,
@@ -725,14 +1141,63 @@ static int setup_pkt_dpdk(odp_pktio_t pktio ODP_UNUSED,
 	for (i = 0; i < PKTIO_MAX_QUEUES; i++) {
 		odp_ticketlock_init(&pkt_dpdk->rx_lock[i]);
 		odp_ticketlock_init(&pkt_dpdk->tx_lock[i]);
+		pkt_dpdk->rx_queue_size[i] = 0;
+		pkt_dpdk->tx_queue_size[i] = 0;
+		pkt_dpdk->gro[i] = 0;
 	}
 
+	pkt_dpdk->rss_bal = NULL;
+	pkt_dpdk->reass = NULL;
+
 	if (pkt_dpdk->loopback)
 		dpdk_glb->loopback_in_use = 1;
 
 	return 0;
 }
 
+static void rss_balance_alarm(void *arg);
+
+static void rss_balance_term(pkt_dpdk_t *pkt_dpdk)
+{
+	rss_balance_t *bal = pkt_dpdk->rss_bal;
+
+	if (bal == NULL)
+		return;
+
+	/* Waits for a running balancing round to complete */
+	if (bal->interval)
+		rte_eal_alarm_cancel(rss_balance_alarm, pkt_dpdk);
+
+	pkt_dpdk->rss_bal = NULL;
+	if (odp_shm_free(bal->shm))
+		ODP_ERR("Failed to free RSS balancer data\n");
+}
+
+/* Free IP reassembly tables and the fragments held in them */
+static void reass_term(pkt_dpdk_t *pkt_dpdk)
+{
+	reass_t *reass = pkt_dpdk->reass;
+	uint32_t i, j;
+	int k;
+
+	if (reass == NULL)
+		return;
+
+	pkt_dpdk->reass = NULL;
+
+	for (i = 0; i < reass->num_queues; i++) {
+		for (j = 0; j <= reass->flow_mask; j++) {
+			reass_flow_t *flow = &reass->queue[i].flow[j];
+
+			for (k = 0; k < flow->num_frags; k++)
+				odp_packet_free(flow->frag[k].pkt);
+		}
+	}
+
+	if (odp_shm_free(reass->shm))
+		ODP_ERR("Failed to free IP reassembly data\n");
+}
+
 static int close_pkt_dpdk(pktio_entry_t *pktio_entry)
 {
 	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
@@ -746,22 +1211,52 @@ static int close_pkt_dpdk(pktio_entry_t *pktio_entry)
 	if (pkt_dpdk->loopback)
 		dpdk_glb->loopback_in_use = 0;
 
+	rss_balance_term(pkt_dpdk);
+	reass_term(pkt_dpdk);
+
 	return 0;
 }
 
+/* Number of ring descriptors for a queue. Requested size is rounded up to
+ * the descriptor alignment of the device. */
+static uint16_t queue_desc_num(uint16_t size, int default_size,
+			       const struct rte_eth_desc_lim *lim)
+{
+	uint32_t num;
+
+	if (size == 0)
+		return default_size;
+
+	num = RTE_ALIGN_CEIL(size, RTE_MAX(lim->nb_align, 1));
+	num = RTE_MIN(RTE_MAX(num, lim->nb_min), lim->nb_max);
+
+	return num;
+}
+
 static int dpdk_setup_eth_tx(pktio_entry_t *pktio_entry,
 			     const pkt_dpdk_t *pkt_dpdk,
 			     const struct rte_eth_dev_info *dev_info)
 {
+	struct rte_eth_txconf txconf;
 	uint32_t i;
 	int ret;
 	uint16_t port_id = pkt_dpdk->port_id;
 
+	txconf = dev_info->default_txconf;
+
+	if (pkt_dpdk->opt.tx_free_thresh)
+		txconf.tx_free_thresh = pkt_dpdk->opt.tx_free_thresh;
+	if (pkt_dpdk->opt.tx_rs_thresh)
+		txconf.tx_rs_thresh = pkt_dpdk->opt.tx_rs_thresh;
+
 	for (i = 0; i < pktio_entry->s.num_out_queue; i++) {
-		ret = rte_eth_tx_queue_setup(port_id, i,
-					     pkt_dpdk->opt.num_tx_desc,
+		uint16_t num_desc = queue_desc_num(pkt_dpdk->tx_queue_size[i],
+						   pkt_dpdk->opt.num_tx_desc,
+						   &dev_info->tx_desc_lim);
+
+		ret = rte_eth_tx_queue_setup(port_id, i, num_desc,
 					     rte_eth_dev_socket_id(port_id),
-					     &dev_info->default_txconf);
+					     &txconf);
 		if (ret < 0) {
 			ODP_ERR("Queue setup failed: err=%d, port=%" PRIu8 "\n",
 				ret, port_id);
@@ -784,11 +1279,21 @@ static int dpdk_setup_eth_rx(const pktio_entry_t *pktio_entry,
 
 	rxconf = dev_info->default_rxconf;
 
-	rxconf.rx_drop_en = pkt_dpdk->opt.rx_drop_en;
+	/* With back-pressure enabled, input queues may not be polled for a
+	 * while. Drop packets of a full RX ring instead of stalling the
+	 * other rings of the port. */
+	rxconf.rx_drop_en = pkt_dpdk->opt.rx_drop_en ||
+			    pktio_entry->s.in_backpressure;
+
+	if (pkt_dpdk->opt.rx_free_thresh)
+		rxconf.rx_free_thresh = pkt_dpdk->opt.rx_free_thresh;
 
 	for (i = 0; i < pktio_entry->s.num_in_queue; i++) {
-		ret = rte_eth_rx_queue_setup(port_id, i,
-					     pkt_dpdk->opt.num_rx_desc,
+		uint16_t num_desc = queue_desc_num(pkt_dpdk->rx_queue_size[i],
+						   pkt_dpdk->opt.num_rx_desc,
+						   &dev_info->rx_desc_lim);
+
+		ret = rte_eth_rx_queue_setup(port_id, i, num_desc,
 					     rte_eth_dev_socket_id(port_id),
 					     &rxconf, pool->rte_mempool);
 		if (ret < 0) {
@@ -823,7 +1328,7 @@ static void dpdk_ptype_support_set(pktio_entry_t *pktio_entry, uint16_t port_id)
 	int max_num, num, i;
 	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
 	uint32_t mask = RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK |
-			RTE_PTYPE_L4_MASK;
+			RTE_PTYPE_L4_MASK | RTE_PTYPE_TUNNEL_MASK;
 
 	pkt_dpdk->supported_ptypes = 0;
 
@@ -858,184 +1363,1655 @@ static void dpdk_ptype_support_set(pktio_entry_t *pktio_entry, uint16_t port_id)
 			pkt_dpdk->supported_ptypes |= PTYPE_UDP;
 		else if (ptype[i] == RTE_PTYPE_L4_TCP)
 			pkt_dpdk->supported_ptypes |= PTYPE_TCP;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_VXLAN)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_VXLAN;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GENEVE)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GENEVE;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GRE)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GRE;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GTPU)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GTPU;
 	}
 }
 
-static int dpdk_start(pktio_entry_t *pktio_entry)
+/* Map queues to per queue statistics counters. Only some drivers require
+ * the mapping, so failures are not fatal. */
+static void dpdk_queue_stats_map(pktio_entry_t *pktio_entry, uint16_t port_id)
 {
-	struct rte_eth_dev_info dev_info;
-	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
-	uint16_t port_id = pkt_dpdk->port_id;
+	unsigned int i;
 	int ret;
 
-	if (pktio_entry->s.state == PKTIO_STATE_STOPPED ||
-	    pktio_entry->s.state == PKTIO_STATE_STOP_PENDING)
-		rte_eth_dev_stop(pkt_dpdk->port_id);
+	for (i = 0; i < pktio_entry->s.num_in_queue &&
+	     i < RTE_ETHDEV_QUEUE_STAT_CNTRS; i++) {
+		ret = rte_eth_dev_set_rx_queue_stats_mapping(port_id, i, i);
+		if (ret) {
+			ODP_DBG("No RX queue stats mapping: %d\n", ret);
+			break;
+		}
+	}
 
-	/* DPDK doesn't support nb_rx_q/nb_tx_q being 0 */
-	if (!pktio_entry->s.num_in_queue)
-		pktio_entry->s.num_in_queue = 1;
-	if (!pktio_entry->s.num_out_queue)
-		pktio_entry->s.num_out_queue = 1;
+	for (i = 0; i < pktio_entry->s.num_out_queue &&
+	     i < RTE_ETHDEV_QUEUE_STAT_CNTRS; i++) {
+		ret = rte_eth_dev_set_tx_queue_stats_mapping(port_id, i, i);
+		if (ret) {
+			ODP_DBG("No TX queue stats mapping: %d\n", ret);
+			break;
+		}
+	}
+}
 
-	rte_eth_dev_info_get(port_id, &dev_info);
+static int reta_read(uint16_t port_id, uint16_t reta[], uint16_t reta_size)
+{
+	struct rte_eth_rss_reta_entry64 conf[(reta_size + RTE_RETA_GROUP_SIZE -
+					      1) / RTE_RETA_GROUP_SIZE];
+	uint16_t i;
+	int ret;
 
-	/* Setup device */
-	if (dpdk_setup_eth_dev(pktio_entry, &dev_info)) {
-		ODP_ERR("Failed to configure device\n");
-		return -1;
-	}
+	memset(conf, 0, sizeof(conf));
+	for (i = 0; i < reta_size; i++)
+		conf[i / RTE_RETA_GROUP_SIZE].mask |=
+			1ULL << (i % RTE_RETA_GROUP_SIZE);
 
-	/* Setup TX queues */
-	if (dpdk_setup_eth_tx(pktio_entry, pkt_dpdk, &dev_info))
+	ret = rte_eth_dev_rss_reta_query(port_id, conf, reta_size);
+	if (ret) {
+		ODP_ERR("RETA query failed: %d\n", ret);
 		return -1;
+	}
 
-	/* Setup RX queues */
-	if (dpdk_setup_eth_rx(pktio_entry, pkt_dpdk, &dev_info))
-		return -1;
+	for (i = 0; i < reta_size; i++)
+		reta[i] = conf[i / RTE_RETA_GROUP_SIZE].reta[i %
+			RTE_RETA_GROUP_SIZE];
 
-	/* Add callback for loopback interface */
-	if (pkt_dpdk->loopback) {
-		unsigned int i;
+	return 0;
+}
 
-		for (i = 0; i < pktio_entry->s.num_in_queue; i++) {
-#if RTE_VERSION < RTE_VERSION_NUM(18, 05, 0, 0)
-			struct rte_eth_rxtx_callback *callback;
-#else
-			const struct rte_eth_rxtx_callback *callback;
-#endif
+static int reta_write(uint16_t port_id, const uint16_t reta[],
+		      uint16_t reta_size)
+{
+	struct rte_eth_rss_reta_entry64 conf[(reta_size + RTE_RETA_GROUP_SIZE -
+					      1) / RTE_RETA_GROUP_SIZE];
+	uint16_t i;
+	int ret;
 
-			callback = rte_eth_add_rx_callback(port_id, i,
-							   dpdk_rx_cb, NULL);
-			if (callback == NULL) {
-				ODP_ERR("Failed setting RX callback\n");
-				return -1;
-			}
-			pkt_dpdk->rx_callback[i] = callback;
-		}
+	memset(conf, 0, sizeof(conf));
+	for (i = 0; i < reta_size; i++) {
+		conf[i / RTE_RETA_GROUP_SIZE].mask |=
+			1ULL << (i % RTE_RETA_GROUP_SIZE);
+		conf[i / RTE_RETA_GROUP_SIZE].reta[i % RTE_RETA_GROUP_SIZE] =
+			reta[i];
 	}
 
-	/* Start device */
-	ret = rte_eth_dev_start(port_id);
-	if (ret < 0) {
-		ODP_ERR("Device start failed: err=%d, port=%" PRIu8 "\n",
-			ret, port_id);
+	ret = rte_eth_dev_rss_reta_update(port_id, conf, reta_size);
+	if (ret) {
+		ODP_ERR("RETA update failed: %d\n", ret);
 		return -1;
 	}
 
-	/* Record supported parser ptype flags */
-	dpdk_ptype_support_set(pktio_entry, port_id);
-
 	return 0;
 }
 
-static int stop_pkt_dpdk(pktio_entry_t *pktio_entry)
+/* Allocate IP reassembly flow tables for all input queues. Called when
+ * packet input is not active. */
+static int reass_init(pktio_entry_t *pktio_entry)
 {
 	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
-	unsigned int i;
-	uint16_t port_id = pkt_dpdk->port_id;
+	const odp_pktio_reass_config_t *cfg =
+		&pktio_entry->s.config.reassembly;
+	uint32_t num_queues = pktio_entry->s.num_in_queue;
+	uint32_t max_flows = pkt_dpdk->opt.reass_max_flows;
+	char name[ODP_SHM_NAME_LEN];
+	reass_flow_t *flow;
+	reass_t *reass;
+	odp_shm_t shm;
+	uint64_t size;
+	uint32_t i;
 
-	for (i = 0; i < pktio_entry->s.num_in_queue; i++)
-		rte_eth_dev_rx_queue_stop(port_id, i);
-	for (i = 0; i < pktio_entry->s.num_out_queue; i++)
-		rte_eth_dev_tx_queue_stop(port_id, i);
+	size = sizeof(reass_t) +
+	       (uint64_t)num_queues * max_flows * sizeof(reass_flow_t);
+	snprintf(name, sizeof(name), "_odp_dpdk_reass_%" PRIu16,
+		 pkt_dpdk->port_id);
 
-	if (!pkt_dpdk->loopback)
-		return 0;
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODP_ERR("Failed to reserve IP reassembly data\n");
+		return -1;
+	}
 
-	for (i = 0; i < pktio_entry->s.num_in_queue; i++) {
-		if (rte_eth_remove_rx_callback(port_id, i,
-					       pkt_dpdk->rx_callback[i])) {
-			ODP_ERR("Failed removing RX callback\n");
-			return -1;
-		}
+	reass = odp_shm_addr(shm);
+	memset(reass, 0, size);
+	reass->shm = shm;
+	reass->max_wait = cfg->max_wait_time *
+			  (rte_get_timer_hz() / 1000000) / 1000;
+	reass->flow_mask = max_flows - 1;
+	reass->max_frags = cfg->max_num_frags;
+	reass->num_queues = num_queues;
+	reass->ipv4 = cfg->en_ipv4;
+	reass->ipv6 = cfg->en_ipv6;
+
+	flow = (reass_flow_t *)(uintptr_t)(reass + 1);
+	for (i = 0; i < num_queues; i++) {
+		odp_spinlock_init(&reass->queue[i].lock);
+		reass->queue[i].flow = &flow[i * max_flows];
 	}
+
+	pkt_dpdk->reass = reass;
+
 	return 0;
 }
 
-static inline void prefetch_pkt(odp_packet_t pkt)
+/* Start RETA load sampling. Called when packet input is not active or
+ * with pktio entry locked. */
+static int rss_balance_init(pktio_entry_t *pktio_entry)
 {
-	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	uint16_t reta_size = pktio_entry->s.capa.hash.reta_size;
+	uint32_t num_load = pktio_entry->s.num_in_queue * reta_size;
+	rss_balance_t *bal;
+	char name[ODP_SHM_NAME_LEN];
+	odp_shm_t shm;
+	uint32_t size;
 
-	odp_prefetch(&pkt_hdr->p);
-}
+	if (!pktio_entry->s.capa.hash.reta_update ||
+	    pktio_entry->s.num_in_queue < 2)
+		return -1;
 
-int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], int num)
-{
-	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
-	uint16_t i;
-	odp_pktin_config_opt_t pktin_cfg = pktio_entry->s.config.pktin;
-	odp_proto_layer_t parse_layer = pktio_entry->s.config.parser.layer;
-	odp_pktio_t input = pktio_entry->s.handle;
-	odp_time_t ts_val;
-	odp_time_t *ts = NULL;
-	uint16_t num_prefetch = RTE_MIN(num, NUM_RX_PREFETCH);
+	size = sizeof(rss_balance_t) + 2 * num_load * sizeof(uint32_t) +
+	       reta_size * sizeof(uint16_t);
+	snprintf(name, sizeof(name), "_odp_dpdk_rss_%" PRIu16,
+		 pkt_dpdk->port_id);
 
-	for (i = 0; i < num_prefetch; i++)
-		prefetch_pkt(pkt_table[i]);
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODP_ERR("Failed to reserve RSS balancer data\n");
+		return -1;
+	}
 
-	if (pktio_entry->s.config.pktin.bit.ts_all ||
-	    pktio_entry->s.config.pktin.bit.ts_ptp) {
-		ts_val = odp_time_global();
-		ts = &ts_val;
+	bal = odp_shm_addr(shm);
+	memset(bal, 0, size);
+	bal->shm = shm;
+	bal->load = (uint32_t *)(uintptr_t)(bal + 1);
+	bal->seen = bal->load + num_load;
+	bal->reta = (uint16_t *)(uintptr_t)(bal->seen + num_load);
+	bal->reta_size = reta_size;
+	bal->num_queues = pktio_entry->s.num_in_queue;
+	bal->threshold = pkt_dpdk->opt.rss_balance_threshold;
+	bal->interval = 1000 * (uint64_t)pkt_dpdk->opt.rss_balance_interval;
+	odp_spinlock_init(&bal->lock);
+
+	if (reta_read(pkt_dpdk->port_id, bal->reta, reta_size)) {
+		odp_shm_free(shm);
+		return -1;
 	}
 
-	for (i = 0; i < num; ++i) {
-		odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt_table[i]);
-		struct rte_mbuf *mbuf = pkt_to_mbuf(pkt_table[i]);
+	/* Sampling starts on packet input when the pointer is visible */
+	__atomic_store_n(&pkt_dpdk->rss_bal, bal, __ATOMIC_RELEASE);
 
-		if (odp_likely(i + num_prefetch < num))
-			prefetch_pkt(pkt_table[i + num_prefetch]);
+	/* Automatic balancing rounds run in the DPDK interrupt thread, so
+	 * that redirection table updates stay out of the receive path */
+	if (bal->interval &&
+	    rte_eal_alarm_set(bal->interval, rss_balance_alarm, pkt_dpdk)) {
+		ODP_ERR("RSS balancer alarm set failed\n");
+		bal->interval = 0;
+	}
 
-		packet_init(pkt_hdr, input);
+	return 0;
+}
 
-		if (!pktio_cls_enabled(pktio_entry) &&
-		    parse_layer != ODP_PROTO_LAYER_NONE) {
-			uint32_t ptypes = pkt_dpdk->supported_ptypes;
+/* Move redirection table entries from the most loaded input queue to the
+ * least loaded one until the load difference falls below the threshold.
+ * Called with balancer lock held. Returns number of entries moved. */
+static int rss_balance_run(pkt_dpdk_t *pkt_dpdk, rss_balance_t *bal)
+{
+	uint16_t reta_size = bal->reta_size;
+	uint16_t num_queues = bal->num_queues;
+	uint64_t queue_load[num_queues];
+	uint32_t load[reta_size];
+	uint64_t total = 0;
+	uint64_t limit;
+	int moved = 0;
+	uint16_t q;
+	int i;
 
-			/* DPDK ring pmd doesn't support packet parsing */
-			if (pkt_dpdk->loopback) {
-				packet_parse_layer(pkt_hdr, parse_layer,
-						   pktio_entry->s.in_chksums);
-			} else {
-				if (_odp_dpdk_packet_parse_layer(pkt_hdr, mbuf,
-								 parse_layer,
-								 ptypes,
-								 pktin_cfg)) {
-					odp_packet_free(pkt_table[i]);
-					continue;
-				}
-			}
+	memset(queue_load, 0, sizeof(queue_load));
+	memset(load, 0, sizeof(load));
+
+	/* Entry load since the previous round, summed over the queues which
+	 * received packets of the entry */
+	for (q = 0; q < num_queues; q++) {
+		const uint32_t *cnt = &bal->load[q * reta_size];
+		uint32_t *seen = &bal->seen[q * reta_size];
+
+		for (i = 0; i < reta_size; i++) {
+			uint32_t cur = __atomic_load_n(&cnt[i],
+						       __ATOMIC_RELAXED);
+
+			load[i] += cur - seen[i];
+			seen[i] = cur;
 		}
-		packet_set_ts(pkt_hdr, ts);
+	}
 
-		odp_prefetch(rte_pktmbuf_mtod(mbuf, char *));
+	for (i = 0; i < reta_size; i++) {
+		queue_load[bal->reta[i]] += load[i];
+		total += load[i];
 	}
 
-	if (pktio_cls_enabled(pktio_entry)) {
-		int failed = 0, success = 0;
+	if (total == 0)
+		return 0;
 
-		for (i = 0; i < num; i++) {
-			odp_packet_t new_pkt;
-			odp_packet_t pkt = pkt_table[i];
+	limit = total / num_queues * bal->threshold / 100;
+
+	while (moved < DPDK_RSS_BALANCE_MAX_MOVES) {
+		uint16_t max_q = 0;
+		uint16_t min_q = 0;
+		uint64_t diff;
+		int best = -1;
+
+		for (q = 1; q < num_queues; q++) {
+			if (queue_load[q] > queue_load[max_q])
+				max_q = q;
+			if (queue_load[q] < queue_load[min_q])
+				min_q = q;
+		}
+
+		diff = queue_load[max_q] - queue_load[min_q];
+		if (diff <= limit)
+			break;
+
+		/* Move the largest entry, which still reduces the difference.
+		 * A single elephant flow entry stays put, but other entries
+		 * are moved away from its queue. */
+		for (i = 0; i < reta_size; i++) {
+			if (bal->reta[i] != max_q || load[i] == 0 ||
+			    load[i] >= diff)
+				continue;
+			if (best < 0 || load[i] > load[best])
+				best = i;
+		}
+
+		if (best < 0)
+			break;
+
+		bal->reta[best] = min_q;
+		queue_load[max_q] -= load[best];
+		queue_load[min_q] += load[best];
+		moved++;
+	}
+
+	if (moved == 0)
+		return 0;
+
+	if (reta_write(pkt_dpdk->port_id, bal->reta, reta_size)) {
+		/* Resync with the device */
+		reta_read(pkt_dpdk->port_id, bal->reta, reta_size);
+		return -1;
+	}
+
+	return moved;
+}
+
+/* Automatic balancing round. Runs in the DPDK interrupt thread. */
+static void rss_balance_alarm(void *arg)
+{
+	pkt_dpdk_t *pkt_dpdk = arg;
+	rss_balance_t *bal = pkt_dpdk->rss_bal;
+
+	odp_spinlock_lock(&bal->lock);
+	rss_balance_run(pkt_dpdk, bal);
+	odp_spinlock_unlock(&bal->lock);
+
+	if (rte_eal_alarm_set(bal->interval, rss_balance_alarm, pkt_dpdk))
+		ODP_ERR("RSS balancer alarm set failed\n");
+}
+
+/* Count received packets per redirection table entry. Called by the single
+ * thread polling the input queue. */
+static inline void rss_balance_sample(rss_balance_t *bal, int index,
+				      odp_packet_t pkt_table[], uint16_t num)
+{
+	uint32_t mask = bal->reta_size - 1;
+	uint32_t *cnt = &bal->load[index * bal->reta_size];
+	uint16_t i;
+
+	for (i = 0; i < num; i++) {
+		struct rte_mbuf *mbuf = pkt_to_mbuf(pkt_table[i]);
+		uint32_t *load, val;
+
+		if (!(mbuf->ol_flags & PKT_RX_RSS_HASH))
+			continue;
+
+		load = &cnt[mbuf->hash.rss & mask];
+		val = __atomic_load_n(load, __ATOMIC_RELAXED);
+		__atomic_store_n(load, val + 1, __ATOMIC_RELAXED);
+	}
+}
+
+static int dpdk_hash_proto_set(pktio_entry_t *pktio_entry,
+			       const odp_pktin_hash_proto_t *hash_proto)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_rss_conf rss_conf;
+	int ret;
+
+	if (!pktio_entry->s.capa.hash.proto_update)
+		return -1;
+
+	if (check_hash_proto(pktio_entry, hash_proto))
+		return -1;
+
+	rte_eth_dev_info_get(pkt_dpdk->port_id, &dev_info);
+	memset(&rss_conf, 0, sizeof(struct rte_eth_rss_conf));
+
+	if (hash_proto->all_bits == 0)
+		rss_conf.rss_hf = ETH_RSS_IP | ETH_RSS_TCP | ETH_RSS_UDP;
+	else
+		rss_conf_to_hash_proto(&rss_conf, hash_proto);
+	rss_conf.rss_hf &= dev_info.flow_type_rss_offloads;
+
+	ret = rte_eth_dev_rss_hash_update(pkt_dpdk->port_id, &rss_conf);
+	if (ret) {
+		ODP_ERR("RSS hash update failed: %d\n", ret);
+		return -1;
+	}
+
+	pkt_dpdk->hash = *hash_proto;
+	cls_input_hash_set(pktio_entry, rss_conf.rss_hf);
+
+	return 0;
+}
+
+static int dpdk_hash_key_set(pktio_entry_t *pktio_entry, const uint8_t key[],
+			     uint32_t len)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	struct rte_eth_rss_conf rss_conf;
+	uint8_t rss_key[len];
+	int ret;
+
+	if (!pktio_entry->s.capa.hash.key_update ||
+	    len != pktio_entry->s.capa.hash.key_size) {
+		ODP_ERR("Bad hash key length %" PRIu32 "\n", len);
+		return -1;
+	}
+
+	/* Keep current hash functions */
+	memset(&rss_conf, 0, sizeof(struct rte_eth_rss_conf));
+	ret = rte_eth_dev_rss_hash_conf_get(pkt_dpdk->port_id, &rss_conf);
+	if (ret) {
+		ODP_ERR("RSS hash conf get failed: %d\n", ret);
+		return -1;
+	}
+
+	memcpy(rss_key, key, len);
+	rss_conf.rss_key = rss_key;
+	rss_conf.rss_key_len = len;
+
+	ret = rte_eth_dev_rss_hash_update(pkt_dpdk->port_id, &rss_conf);
+	if (ret) {
+		ODP_ERR("RSS key update failed: %d\n", ret);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int dpdk_hash_reta(pktio_entry_t *pktio_entry, uint32_t reta[],
+			  uint32_t num)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	uint16_t reta_size = pktio_entry->s.capa.hash.reta_size;
+	uint16_t tmp[reta_size];
+	uint32_t i;
+
+	if (!pktio_entry->s.capa.hash.reta_update)
+		return -1;
+
+	if (reta_read(pkt_dpdk->port_id, tmp, reta_size))
+		return -1;
+
+	for (i = 0; i < num && i < reta_size; i++)
+		reta[i] = tmp[i];
+
+	return reta_size;
+}
+
+static int dpdk_hash_reta_set(pktio_entry_t *pktio_entry,
+			      const uint32_t reta[], uint32_t num)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	rss_balance_t *bal = pkt_dpdk->rss_bal;
+	uint16_t reta_size = pktio_entry->s.capa.hash.reta_size;
+	uint16_t tmp[reta_size];
+	uint32_t i;
+	int ret;
+
+	if (!pktio_entry->s.capa.hash.reta_update || num != reta_size) {
+		ODP_ERR("Bad redirection table size %" PRIu32 "\n", num);
+		return -1;
+	}
+
+	for (i = 0; i < num; i++)
+		tmp[i] = reta[i];
+
+	if (bal == NULL)
+		return reta_write(pkt_dpdk->port_id, tmp, reta_size);
+
+	odp_spinlock_lock(&bal->lock);
+	ret = reta_write(pkt_dpdk->port_id, tmp, reta_size);
+	if (ret == 0)
+		memcpy(bal->reta, tmp, sizeof(tmp));
+	odp_spinlock_unlock(&bal->lock);
+
+	return ret;
+}
+
+static int dpdk_hash_balance(pktio_entry_t *pktio_entry)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	rss_balance_t *bal = pkt_dpdk->rss_bal;
+	int ret;
+
+	/* First call starts load sampling */
+	if (bal == NULL)
+		return rss_balance_init(pktio_entry) ? -1 : 0;
+
+	odp_spinlock_lock(&bal->lock);
+	ret = rss_balance_run(pkt_dpdk, bal);
+	odp_spinlock_unlock(&bal->lock);
+
+	return ret;
+}
+
+/* Link speed in Mbps. Maximum supported speed is used when link is down. */
+static uint32_t link_speed_mbps(uint16_t port_id,
+				const struct rte_eth_dev_info *dev_info)
+{
+	static const struct {
+		uint32_t flag;
+		uint32_t speed;
+	} speed_tbl[] = {
+		{ETH_LINK_SPEED_100G, ETH_SPEED_NUM_100G},
+		{ETH_LINK_SPEED_56G, ETH_SPEED_NUM_56G},
+		{ETH_LINK_SPEED_50G, ETH_SPEED_NUM_50G},
+		{ETH_LINK_SPEED_40G, ETH_SPEED_NUM_40G},
+		{ETH_LINK_SPEED_25G, ETH_SPEED_NUM_25G},
+		{ETH_LINK_SPEED_20G, ETH_SPEED_NUM_20G},
+		{ETH_LINK_SPEED_10G, ETH_SPEED_NUM_10G},
+		{ETH_LINK_SPEED_5G, ETH_SPEED_NUM_5G},
+		{ETH_LINK_SPEED_2_5G, ETH_SPEED_NUM_2_5G},
+		{ETH_LINK_SPEED_1G, ETH_SPEED_NUM_1G},
+		{ETH_LINK_SPEED_100M, ETH_SPEED_NUM_100M},
+		{ETH_LINK_SPEED_10M, ETH_SPEED_NUM_10M}
+	};
+	struct rte_eth_link link;
+	uint32_t i;
+
+	memset(&link, 0, sizeof(struct rte_eth_link));
+	rte_eth_link_get_nowait(port_id, &link);
+
+	if (link.link_status == ETH_LINK_UP &&
+	    link.link_speed != ETH_SPEED_NUM_NONE)
+		return link.link_speed;
+
+	for (i = 0; i < sizeof(speed_tbl) / sizeof(speed_tbl[0]); i++)
+		if (dev_info->speed_capa & speed_tbl[i].flag)
+			return speed_tbl[i].speed;
+
+	return 0;
+}
+
+#ifdef DPDK_RX_HW_TS
+/* Set device clock to global time conversion from two samples. Clock
+ * difference is limited to 32 bits, so that the remainder and the frequency
+ * calculation don't overflow. */
+static int rx_ts_conv_set(rx_ts_t *rx_ts, rx_ts_conv_t *conv, uint64_t clk0,
+			  odp_time_t t0, uint64_t clk1, odp_time_t t1)
+{
+	uint64_t clk_diff, time_diff, ns;
+
+	clk_diff = clk1 - clk0;
+	time_diff = odp_time_diff(t1, t0).u64;
+	ns = odp_time_to_ns(odp_time_diff(t1, t0));
+	if (clk_diff == 0 || clk_diff > UINT32_MAX || time_diff == 0 ||
+	    ns == 0)
+		return -1;
+
+	conv->mult_int = time_diff / clk_diff;
+	conv->mult_frac = ((time_diff % clk_diff) << 32) / clk_diff;
+	conv->ref_clk = clk1;
+	conv->ref_time = t1.u64;
+	rx_ts->clk_hz = (clk_diff * ODP_TIME_SEC_IN_NS) / ns;
+
+	return 0;
+}
+
+/* Calibrate device clock against global time */
+static int rx_ts_calibrate(pkt_dpdk_t *pkt_dpdk)
+{
+	rx_ts_t *rx_ts = &pkt_dpdk->rx_ts;
+	uint64_t clk0, clk1;
+	odp_time_t t0, t1;
+
+#if RTE_VERSION >= RTE_VERSION_NUM(20, 11, 0, 0)
+	if (rte_mbuf_dyn_rx_timestamp_register(&rx_ts->dyn_offset,
+					       &rx_ts->dyn_flag))
+		return -1;
+#endif
+	if (rte_eth_read_clock(pkt_dpdk->port_id, &clk0))
+		return -1;
+	t0 = odp_time_global();
+
+	odp_time_wait_ns(pkt_dpdk->opt.rx_ts_calib_time * ODP_TIME_MSEC_IN_NS);
+
+	if (rte_eth_read_clock(pkt_dpdk->port_id, &clk1))
+		return -1;
+	t1 = odp_time_global();
+
+	rx_ts->conv_idx = 0;
+
+	return rx_ts_conv_set(rx_ts, &rx_ts->conv[0], clk0, t0, clk1, t1);
+}
+
+/* Recalibrate device clock against global time. Clock frequency is measured
+ * over the interval since the previous calibration, so that the error of the
+ * short initial calibration does not accumulate. Runs periodically in the
+ * DPDK interrupt thread. */
+static void rx_ts_recalibrate(void *arg)
+{
+	pkt_dpdk_t *pkt_dpdk = arg;
+	rx_ts_t *rx_ts = &pkt_dpdk->rx_ts;
+	uint32_t idx = rx_ts->conv_idx;
+	const rx_ts_conv_t *cur = &rx_ts->conv[idx & 1];
+	rx_ts_conv_t *next = &rx_ts->conv[(idx + 1) & 1];
+	odp_time_t t0, t1, prev;
+	uint64_t clk;
+
+	t0 = odp_time_global();
+	if (rte_eth_read_clock(pkt_dpdk->port_id, &clk) == 0) {
+		t1 = odp_time_global();
+		t1.u64 = t0.u64 + (t1.u64 - t0.u64) / 2;
+		prev.u64 = cur->ref_time;
+
+		/* Too long interval, move the reference point only */
+		if (rx_ts_conv_set(rx_ts, next, cur->ref_clk, prev, clk, t1)) {
+			*next = *cur;
+			next->ref_clk = clk;
+			next->ref_time = t1.u64;
+		}
+
+		__atomic_store_n(&rx_ts->conv_idx, idx + 1, __ATOMIC_RELEASE);
+	}
+
+	if (rte_eal_alarm_set(DPDK_RX_TS_CALIB_INTERVAL, rx_ts_recalibrate,
+			      pkt_dpdk))
+		ODP_ERR("Device clock recalibration failed\n");
+}
+#endif
+
+static void rx_ts_stop(pkt_dpdk_t *pkt_dpdk)
+{
+#ifdef DPDK_RX_HW_TS
+	/* Waits for a running recalibration to complete */
+	if (pkt_dpdk->rx_ts.hw)
+		rte_eal_alarm_cancel(rx_ts_recalibrate, pkt_dpdk);
+#else
+	(void)pkt_dpdk;
+#endif
+}
+
+static void rx_ts_start(pktio_entry_t *pktio_entry,
+			const struct rte_eth_dev_info *dev_info)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	rx_ts_t *rx_ts = &pkt_dpdk->rx_ts;
+	uint32_t speed;
+
+	if (!rx_ts->ena)
+		return;
+
+	memset(rx_ts->prev, 0, sizeof(rx_ts->prev));
+
+	/* Wire time of a byte in global time units */
+	rx_ts->byte_time = 0;
+	speed = pkt_dpdk->loopback ? 0 : link_speed_mbps(pkt_dpdk->port_id,
+							 dev_info);
+	if (speed)
+		rx_ts->byte_time =
+			odp_time_global_from_ns((8000ULL << 16) / speed).u64;
+
+#ifdef DPDK_RX_HW_TS
+	if (rx_ts->hw && rx_ts_calibrate(pkt_dpdk)) {
+		ODP_DBG("Device clock calibration failed, using software "
+			"timestamps\n");
+		rx_ts->hw = 0;
+	}
+
+	if (rx_ts->hw && rte_eal_alarm_set(DPDK_RX_TS_CALIB_INTERVAL,
+					   rx_ts_recalibrate, pkt_dpdk))
+		ODP_ERR("Device clock recalibration start failed\n");
+#endif
+}
+
+/* Update offset between device PTP clock and global time. Device clock is
+ * compared against the midpoint of global time read before and after it. */
+static int tx_ts_calibrate(pkt_dpdk_t *pkt_dpdk)
+{
+	struct timespec dev_time;
+	uint64_t t0, t1;
+	int64_t dev_ns;
+
+	t0 = odp_time_global_ns();
+	if (rte_eth_timesync_read_time(pkt_dpdk->port_id, &dev_time))
+		return -1;
+	t1 = odp_time_global_ns();
+
+	dev_ns = (int64_t)dev_time.tv_sec * ODP_TIME_SEC_IN_NS +
+		 dev_time.tv_nsec;
+	pkt_dpdk->tx_ts_offset = (int64_t)(t0 + (t1 - t0) / 2) - dev_ns;
+	pkt_dpdk->tx_ts_calib_ns = t1;
+
+	return 0;
+}
+
+static void tx_ts_start(pktio_entry_t *pktio_entry)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+
+	pkt_dpdk->tx_ts_ena = 0;
+
+	if (!pktio_entry->s.config.pktout.bit.ts_ena)
+		return;
+
+	if (rte_eth_timesync_enable(pkt_dpdk->port_id) ||
+	    tx_ts_calibrate(pkt_dpdk)) {
+		ODP_ERR("Enabling packet output timestamps failed\n");
+		return;
+	}
+
+	pkt_dpdk->tx_ts_ena = 1;
+}
+
+static int dpdk_start(pktio_entry_t *pktio_entry)
+{
+	struct rte_eth_dev_info dev_info;
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	uint16_t port_id = pkt_dpdk->port_id;
+	int ret;
+
+	if (pktio_entry->s.state == PKTIO_STATE_STOPPED ||
+	    pktio_entry->s.state == PKTIO_STATE_STOP_PENDING)
+		rte_eth_dev_stop(pkt_dpdk->port_id);
+
+	/* DPDK doesn't support nb_rx_q/nb_tx_q being 0 */
+	if (!pktio_entry->s.num_in_queue)
+		pktio_entry->s.num_in_queue = 1;
+	if (!pktio_entry->s.num_out_queue)
+		pktio_entry->s.num_out_queue = 1;
+
+	rte_eth_dev_info_get(port_id, &dev_info);
+
+	/* Setup device */
+	if (dpdk_setup_eth_dev(pktio_entry, &dev_info)) {
+		ODP_ERR("Failed to configure device\n");
+		return -1;
+	}
+
+	/* Setup TX queues */
+	if (dpdk_setup_eth_tx(pktio_entry, pkt_dpdk, &dev_info))
+		return -1;
+
+	/* Setup RX queues */
+	if (dpdk_setup_eth_rx(pktio_entry, pkt_dpdk, &dev_info))
+		return -1;
+
+	dpdk_queue_stats_map(pktio_entry, port_id);
+
+	/* Add callback for loopback interface */
+	if (pkt_dpdk->loopback) {
+		unsigned int i;
+
+		for (i = 0; i < pktio_entry->s.num_in_queue; i++) {
+#if RTE_VERSION < RTE_VERSION_NUM(18, 05, 0, 0)
+			struct rte_eth_rxtx_callback *callback;
+#else
+			const struct rte_eth_rxtx_callback *callback;
+#endif
+
+			callback = rte_eth_add_rx_callback(port_id, i,
+							   dpdk_rx_cb, NULL);
+			if (callback == NULL) {
+				ODP_ERR("Failed setting RX callback\n");
+				return -1;
+			}
+			pkt_dpdk->rx_callback[i] = callback;
+		}
+	}
+
+	/* Fragments held over a restart are dropped */
+	reass_term(pkt_dpdk);
+	if ((pktio_entry->s.config.reassembly.en_ipv4 ||
+	     pktio_entry->s.config.reassembly.en_ipv6) &&
+	    reass_init(pktio_entry))
+		return -1;
+
+	/* Start device */
+	ret = rte_eth_dev_start(port_id);
+	if (ret < 0) {
+		ODP_ERR("Device start failed: err=%d, port=%" PRIu8 "\n",
+			ret, port_id);
+		return -1;
+	}
+
+	/* Record supported parser ptype flags */
+	dpdk_ptype_support_set(pktio_entry, port_id);
+
+	rx_ts_start(pktio_entry, &dev_info);
+	tx_ts_start(pktio_entry);
+
+	/* Device configure resets the redirection table */
+	rss_balance_term(pkt_dpdk);
+	if (pkt_dpdk->opt.rss_balance_interval &&
+	    pktio_entry->s.num_in_queue > 1 &&
+	    pktio_entry->s.capa.hash.reta_update &&
+	    rss_balance_init(pktio_entry))
+		ODP_ERR("RSS balancer init failed\n");
+
+	return 0;
+}
+
+static int stop_pkt_dpdk(pktio_entry_t *pktio_entry)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	unsigned int i;
+	uint16_t port_id = pkt_dpdk->port_id;
+
+	for (i = 0; i < pktio_entry->s.num_in_queue; i++)
+		rte_eth_dev_rx_queue_stop(port_id, i);
+	for (i = 0; i < pktio_entry->s.num_out_queue; i++)
+		rte_eth_dev_tx_queue_stop(port_id, i);
+
+	if (pkt_dpdk->tx_ts_ena) {
+		rte_eth_timesync_disable(port_id);
+		pkt_dpdk->tx_ts_ena = 0;
+	}
+
+	rx_ts_stop(pkt_dpdk);
+
+	if (!pkt_dpdk->loopback)
+		return 0;
+
+	for (i = 0; i < pktio_entry->s.num_in_queue; i++) {
+		if (rte_eth_remove_rx_callback(port_id, i,
+					       pkt_dpdk->rx_callback[i])) {
+			ODP_ERR("Failed removing RX callback\n");
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/* Prefetch packet metadata and the first cache line of packet data. Mbuf
+ * header has been just written by the driver and is likely in cache. */
+static inline void prefetch_pkt(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
+
+	odp_prefetch(&pkt_hdr->p);
+	odp_prefetch(rte_pktmbuf_mtod(mbuf, char *));
+}
+
+/* GRO packet info */
+typedef struct {
+	uint16_t l3_offset;
+	uint16_t l4_offset;
+	uint16_t hdr_len;
+	uint8_t ipv4;
+} gro_info_t;
+
+/* GRO flow */
+typedef struct {
+	struct rte_mbuf *head;	/* First packet of the flow */
+	struct rte_mbuf *tail;	/* Last segment of the first packet */
+	gro_info_t info;	/* First packet info */
+	uint32_t next_seq;	/* Next expected TCP sequence number */
+	uint8_t num;		/* Number of coalesced packets */
+	uint8_t closed;		/* PSH received */
+} gro_flow_t;
+
+#define GRO_CKSUM_MASK (PKT_RX_IP_CKSUM_MASK | PKT_RX_L4_CKSUM_MASK)
+
+static inline int gro_cksum_ok(uint64_t ol_flags)
+{
+	uint64_t ip = ol_flags & PKT_RX_IP_CKSUM_MASK;
+	uint64_t l4 = ol_flags & PKT_RX_L4_CKSUM_MASK;
+
+	return (ip == PKT_RX_IP_CKSUM_GOOD || ip == PKT_RX_IP_CKSUM_UNKNOWN) &&
+	       (l4 == PKT_RX_L4_CKSUM_GOOD || l4 == PKT_RX_L4_CKSUM_UNKNOWN);
+}
+
+/* Check if packet is a TCP segment that can be coalesced. Headers must be
+ * in the first segment and followed by payload. */
+static inline int gro_parse(struct rte_mbuf *mbuf, gro_info_t *info)
+{
+	const uint8_t *data = rte_pktmbuf_mtod(mbuf, const uint8_t *);
+	const _odp_ethhdr_t *eth = (const _odp_ethhdr_t *)(uintptr_t)data;
+	const struct rte_tcp_hdr *tcp;
+	uint32_t len = mbuf->data_len;
+	uint32_t offset = _ODP_ETHHDR_LEN;
+	uint32_t ip_len, tcp_len;
+	uint16_t ethtype;
+
+	if (!gro_cksum_ok(mbuf->ol_flags) || len < _ODP_ETHHDR_LEN)
+		return -1;
+
+	ethtype = odp_be_to_cpu_16(eth->type);
+	if (ethtype == _ODP_ETHTYPE_VLAN) {
+		const _odp_vlanhdr_t *vlan;
+
+		if (len < offset + _ODP_VLANHDR_LEN)
+			return -1;
+		vlan = (const _odp_vlanhdr_t *)(uintptr_t)(data + offset);
+		ethtype = odp_be_to_cpu_16(vlan->type);
+		offset += _ODP_VLANHDR_LEN;
+	}
+
+	info->l3_offset = offset;
+
+	if (ethtype == _ODP_ETHTYPE_IPV4) {
+		const struct rte_ipv4_hdr *ip;
+
+		ip = (const struct rte_ipv4_hdr *)(uintptr_t)(data + offset);
+		if (len < offset + sizeof(struct rte_ipv4_hdr) ||
+		    ip->version_ihl != 0x45 ||
+		    ip->next_proto_id != _ODP_IPPROTO_TCP ||
+		    rte_ipv4_frag_pkt_is_fragmented(ip))
+			return -1;
+		ip_len = odp_be_to_cpu_16(ip->total_length);
+		offset += sizeof(struct rte_ipv4_hdr);
+		info->ipv4 = 1;
+	} else if (ethtype == _ODP_ETHTYPE_IPV6) {
+		const struct rte_ipv6_hdr *ip;
+
+		ip = (const struct rte_ipv6_hdr *)(uintptr_t)(data + offset);
+		if (len < offset + sizeof(struct rte_ipv6_hdr) ||
+		    ip->proto != _ODP_IPPROTO_TCP)
+			return -1;
+		ip_len = odp_be_to_cpu_16(ip->payload_len) +
+			 sizeof(struct rte_ipv6_hdr);
+		offset += sizeof(struct rte_ipv6_hdr);
+		info->ipv4 = 0;
+	} else {
+		return -1;
+	}
+
+	info->l4_offset = offset;
+
+	if (len < offset + sizeof(struct rte_tcp_hdr))
+		return -1;
+
+	tcp = (const struct rte_tcp_hdr *)(uintptr_t)(data + offset);
+	tcp_len = (tcp->data_off >> 4) * 4;
+	info->hdr_len = offset + tcp_len;
+
+	/* Only ACK and PSH flags are allowed. Packets with L2 padding are not
+	 * coalesced. */
+	if (tcp_len < sizeof(struct rte_tcp_hdr) || len <= info->hdr_len ||
+	    (tcp->tcp_flags & ~(DPDK_TCP_FLAG_ACK | DPDK_TCP_FLAG_PSH)) ||
+	    mbuf->pkt_len != info->l3_offset + ip_len)
+		return -1;
+
+	return 0;
+}
+
+/* Check if packet belongs to the flow */
+static inline int gro_flow_match(const gro_flow_t *flow,
+				 struct rte_mbuf *mbuf, const gro_info_t *info)
+{
+	const uint8_t *a = rte_pktmbuf_mtod(flow->head, const uint8_t *);
+	const uint8_t *b = rte_pktmbuf_mtod(mbuf, const uint8_t *);
+	const struct rte_tcp_hdr *tcp_a, *tcp_b;
+
+	if (flow->info.l4_offset != info->l4_offset ||
+	    flow->info.ipv4 != info->ipv4 ||
+	    memcmp(a, b, info->l3_offset))
+		return 0;
+
+	if (info->ipv4) {
+		const struct rte_ipv4_hdr *ip_a, *ip_b;
+
+		ip_a = (const struct rte_ipv4_hdr *)(uintptr_t)
+			(a + info->l3_offset);
+		ip_b = (const struct rte_ipv4_hdr *)(uintptr_t)
+			(b + info->l3_offset);
+		if (ip_a->src_addr != ip_b->src_addr ||
+		    ip_a->dst_addr != ip_b->dst_addr)
+			return 0;
+	} else {
+		const struct rte_ipv6_hdr *ip_a, *ip_b;
+
+		ip_a = (const struct rte_ipv6_hdr *)(uintptr_t)
+			(a + info->l3_offset);
+		ip_b = (const struct rte_ipv6_hdr *)(uintptr_t)
+			(b + info->l3_offset);
+		if (memcmp(ip_a->src_addr, ip_b->src_addr,
+			   sizeof(ip_a->src_addr)) ||
+		    memcmp(ip_a->dst_addr, ip_b->dst_addr,
+			   sizeof(ip_a->dst_addr)))
+			return 0;
+	}
+
+	tcp_a = (const struct rte_tcp_hdr *)(uintptr_t)(a + info->l4_offset);
+	tcp_b = (const struct rte_tcp_hdr *)(uintptr_t)(b + info->l4_offset);
+
+	return tcp_a->src_port == tcp_b->src_port &&
+	       tcp_a->dst_port == tcp_b->dst_port;
+}
+
+/* Check if packet can be appended to the flow */
+static inline int gro_flow_mergeable(const gro_flow_t *flow,
+				     struct rte_mbuf *mbuf,
+				     const gro_info_t *info, int max_pkts)
+{
+	struct rte_mbuf *head = flow->head;
+	const struct rte_tcp_hdr *tcp_a, *tcp_b;
+	uint32_t hdr_len = info->hdr_len;
+
+	if (flow->closed || flow->num >= max_pkts ||
+	    flow->info.hdr_len != hdr_len ||
+	    ((head->ol_flags ^ mbuf->ol_flags) & GRO_CKSUM_MASK) ||
+	    head->nb_segs + mbuf->nb_segs > RTE_MBUF_MAX_NB_SEGS ||
+	    head->pkt_len + mbuf->pkt_len - hdr_len - info->l3_offset >
+	    UINT16_MAX)
+		return 0;
+
+	tcp_a = rte_pktmbuf_mtod_offset(head, const struct rte_tcp_hdr *,
+					info->l4_offset);
+	tcp_b = rte_pktmbuf_mtod_offset(mbuf, const struct rte_tcp_hdr *,
+					info->l4_offset);
+
+	/* In order segment with the same ACK and TCP options */
+	return rte_be_to_cpu_32(tcp_b->sent_seq) == flow->next_seq &&
+	       tcp_a->recv_ack == tcp_b->recv_ack &&
+	       !memcmp(tcp_a + 1, tcp_b + 1,
+		       hdr_len - info->l4_offset - sizeof(struct rte_tcp_hdr));
+}
+
+static inline void gro_flow_init(gro_flow_t *flow, struct rte_mbuf *mbuf,
+				 const gro_info_t *info)
+{
+	const struct rte_tcp_hdr *tcp;
+
+	tcp = rte_pktmbuf_mtod_offset(mbuf, const struct rte_tcp_hdr *,
+				      info->l4_offset);
+
+	flow->head = mbuf;
+	flow->tail = rte_pktmbuf_lastseg(mbuf);
+	flow->info = *info;
+	flow->next_seq = rte_be_to_cpu_32(tcp->sent_seq) + mbuf->pkt_len -
+			 info->hdr_len;
+	flow->num = 1;
+	flow->closed = !!(tcp->tcp_flags & DPDK_TCP_FLAG_PSH);
+}
+
+static inline void gro_flow_merge(gro_flow_t *flow, struct rte_mbuf *mbuf,
+				  const gro_info_t *info)
+{
+	struct rte_mbuf *head = flow->head;
+	const struct rte_tcp_hdr *tcp;
+	uint32_t payload_len = mbuf->pkt_len - info->hdr_len;
+
+	tcp = rte_pktmbuf_mtod_offset(mbuf, const struct rte_tcp_hdr *,
+				      info->l4_offset);
+
+	/* PSH is passed to the coalesced packet and ends the flow */
+	if (tcp->tcp_flags & DPDK_TCP_FLAG_PSH) {
+		rte_pktmbuf_mtod_offset(head, struct rte_tcp_hdr *,
+					info->l4_offset)->tcp_flags |=
+			DPDK_TCP_FLAG_PSH;
+		flow->closed = 1;
+	}
+
+	rte_pktmbuf_adj(mbuf, info->hdr_len);
+	flow->tail->next = mbuf;
+	flow->tail = rte_pktmbuf_lastseg(mbuf);
+	head->nb_segs += mbuf->nb_segs;
+	head->pkt_len += payload_len;
+	flow->next_seq += payload_len;
+	flow->num++;
+}
+
+/* Update IP length of a coalesced packet */
+static inline void gro_flow_flush(gro_flow_t *flow)
+{
+	struct rte_mbuf *head = flow->head;
+	uint32_t l3_offset = flow->info.l3_offset;
+
+	if (flow->num < 2)
+		return;
+
+	if (flow->info.ipv4) {
+		struct rte_ipv4_hdr *ip;
+
+		ip = rte_pktmbuf_mtod_offset(head, struct rte_ipv4_hdr *,
+					     l3_offset);
+		ip->total_length = rte_cpu_to_be_16(head->pkt_len - l3_offset);
+		ip->hdr_checksum = 0;
+		ip->hdr_checksum = rte_ipv4_cksum(ip);
+	} else {
+		struct rte_ipv6_hdr *ip;
+
+		ip = rte_pktmbuf_mtod_offset(head, struct rte_ipv6_hdr *,
+					     l3_offset);
+		ip->payload_len = rte_cpu_to_be_16(head->pkt_len - l3_offset -
+						   sizeof(struct rte_ipv6_hdr));
+	}
+}
+
+/* Coalesce TCP segments of a packet input burst. Returns the number of
+ * packets left in the table. */
+static int gro_pkts(pkt_dpdk_t *pkt_dpdk, odp_packet_t pkt_table[], int num)
+{
+	gro_flow_t flow_tbl[DPDK_GRO_MAX_FLOWS];
+	int max_flows = pkt_dpdk->opt.gro_max_flows;
+	int max_pkts = pkt_dpdk->opt.gro_max_pkts;
+	int num_flows = 0;
+	int num_out = 0;
+	int i, j;
+
+	for (i = 0; i < num; i++) {
+		struct rte_mbuf *mbuf = pkt_to_mbuf(pkt_table[i]);
+		gro_info_t info;
+
+		if (gro_parse(mbuf, &info)) {
+			pkt_table[num_out++] = pkt_table[i];
+			continue;
+		}
+
+		for (j = 0; j < num_flows; j++)
+			if (gro_flow_match(&flow_tbl[j], mbuf, &info))
+				break;
+
+		if (j < num_flows &&
+		    gro_flow_mergeable(&flow_tbl[j], mbuf, &info, max_pkts)) {
+			gro_flow_merge(&flow_tbl[j], mbuf, &info);
+			continue;
+		}
+
+		if (j < num_flows) {
+			/* Out of order or otherwise not mergeable. Restart
+			 * the flow from this packet. */
+			gro_flow_flush(&flow_tbl[j]);
+			gro_flow_init(&flow_tbl[j], mbuf, &info);
+		} else if (num_flows < max_flows) {
+			gro_flow_init(&flow_tbl[num_flows++], mbuf, &info);
+		}
+
+		pkt_table[num_out++] = pkt_table[i];
+	}
+
+	for (j = 0; j < num_flows; j++)
+		gro_flow_flush(&flow_tbl[j]);
+
+	return num_out;
+}
+
+/* IP fragment info */
+typedef struct {
+	uint32_t key[DPDK_REASS_KEY_WORDS];
+	uint16_t l3_offset;
+	uint16_t hdr_len;
+	uint16_t offset;
+	uint16_t len;
+	uint8_t last;
+	uint8_t ipv4;
+} reass_info_t;
+
+/* Check if packet is an IP fragment that can be reassembled. Fragments must
+ * be in a single segment. IPv6 fragment header must directly follow the
+ * fixed header. */
+static inline int reass_parse(const reass_t *reass, struct rte_mbuf *mbuf,
+			      reass_info_t *info)
+{
+	const uint8_t *data = rte_pktmbuf_mtod(mbuf, const uint8_t *);
+	const _odp_ethhdr_t *eth = (const _odp_ethhdr_t *)(uintptr_t)data;
+	uint32_t len = mbuf->data_len;
+	uint32_t offset = _ODP_ETHHDR_LEN;
+	uint32_t ip_len, max_len;
+	uint16_t ethtype;
+
+	if (mbuf->nb_segs != 1 || len < _ODP_ETHHDR_LEN)
+		return -1;
+
+	ethtype = odp_be_to_cpu_16(eth->type);
+	if (ethtype == _ODP_ETHTYPE_VLAN) {
+		const _odp_vlanhdr_t *vlan;
+
+		if (len < offset + _ODP_VLANHDR_LEN)
+			return -1;
+		vlan = (const _odp_vlanhdr_t *)(uintptr_t)(data + offset);
+		ethtype = odp_be_to_cpu_16(vlan->type);
+		offset += _ODP_VLANHDR_LEN;
+	}
+
+	info->l3_offset = offset;
+	memset(info->key, 0, sizeof(info->key));
+
+	if (ethtype == _ODP_ETHTYPE_IPV4 && reass->ipv4) {
+		const struct rte_ipv4_hdr *ip;
+		uint32_t ihl;
+		uint16_t frag;
+
+		ip = (const struct rte_ipv4_hdr *)(uintptr_t)(data + offset);
+		if (len < offset + sizeof(struct rte_ipv4_hdr) ||
+		    (ip->version_ihl >> 4) != 4)
+			return -1;
+
+		frag = odp_be_to_cpu_16(ip->fragment_offset);
+		if (!_ODP_IPV4HDR_IS_FRAGMENT(frag) ||
+		    (mbuf->ol_flags & PKT_RX_IP_CKSUM_MASK) ==
+		    PKT_RX_IP_CKSUM_BAD)
+			return -1;
+
+		ihl = (ip->version_ihl & 0xf) * 4;
+		ip_len = odp_be_to_cpu_16(ip->total_length);
+		if (ihl < sizeof(struct rte_ipv4_hdr) || ip_len <= ihl ||
+		    len < offset + ip_len)
+			return -1;
+
+		info->hdr_len = offset + ihl;
+		info->offset = _ODP_IPV4HDR_FRAG_OFFSET(frag) * 8;
+		info->len = ip_len - ihl;
+		info->last = !_ODP_IPV4HDR_FLAGS_MORE_FRAGS(frag);
+		info->ipv4 = 1;
+		max_len = UINT16_MAX - ihl;
+
+		info->key[0] = ip->src_addr;
+		info->key[1] = ip->dst_addr;
+		info->key[2] = ip->packet_id |
+			       (uint32_t)ip->next_proto_id << 16;
+		info->key[9] = 4;
+	} else if (ethtype == _ODP_ETHTYPE_IPV6 && reass->ipv6) {
+		const struct rte_ipv6_hdr *ip;
+		const _odp_ipv6hdr_frag_t *fh;
+		uint16_t frag;
+
+		ip = (const struct rte_ipv6_hdr *)(uintptr_t)(data + offset);
+		if (len < offset + sizeof(struct rte_ipv6_hdr) +
+		    sizeof(_odp_ipv6hdr_frag_t) ||
+		    ip->proto != _ODP_IPPROTO_FRAG)
+			return -1;
+
+		fh = (const _odp_ipv6hdr_frag_t *)(uintptr_t)(ip + 1);
+		frag = odp_be_to_cpu_16(fh->frag_offset);
+		ip_len = odp_be_to_cpu_16(ip->payload_len);
+		if (ip_len <= sizeof(_odp_ipv6hdr_frag_t) ||
+		    len < offset + sizeof(struct rte_ipv6_hdr) + ip_len)
+			return -1;
+
+		info->hdr_len = offset + sizeof(struct rte_ipv6_hdr) +
+				sizeof(_odp_ipv6hdr_frag_t);
+		info->offset = _ODP_IPV6HDR_FRAG_OFFSET(frag);
+		info->len = ip_len - sizeof(_odp_ipv6hdr_frag_t);
+		info->last = !_ODP_IPV6HDR_FRAG_MORE(frag);
+		info->ipv4 = 0;
+		max_len = UINT16_MAX;
+
+		/* Atomic fragments are passed as is */
+		if (info->offset == 0 && info->last)
+			return -1;
+
+		memcpy(info->key, &ip->src_addr, 32);
+		info->key[8] = fh->id;
+		info->key[9] = 6;
+	} else {
+		return -1;
+	}
+
+	/* All but the last fragment carry a multiple of eight bytes */
+	if ((!info->last && (info->len & 7)) ||
+	    (uint32_t)info->offset + info->len > max_len)
+		return -1;
+
+	return 0;
+}
+
+/* Find the flow of a fragment or allocate a new one. Returns NULL when all
+ * probed table slots are in use by other flows. */
+static inline reass_flow_t *reass_flow_lookup(const reass_t *reass,
+					      reass_queue_t *queue,
+					      const reass_info_t *info,
+					      uint64_t now)
+{
+	uint32_t hash = odp_hash_crc32c(info->key, sizeof(info->key), 0);
+	reass_flow_t *free_flow = NULL;
+	int i;
+
+	for (i = 0; i < DPDK_REASS_PROBE; i++) {
+		reass_flow_t *flow = &queue->flow[(hash + i) &
+						   reass->flow_mask];
+
+		if (flow->num_frags == 0) {
+			if (free_flow == NULL)
+				free_flow = flow;
+			continue;
+		}
+
+		if (!memcmp(flow->key, info->key, sizeof(info->key)))
+			return flow;
+	}
+
+	if (free_flow == NULL)
+		return NULL;
+
+	memcpy(free_flow->key, info->key, sizeof(info->key));
+	free_flow->start = now;
+	free_flow->total_len = 0;
+	free_flow->recv_len = 0;
+	free_flow->l3_offset = info->l3_offset;
+	free_flow->ipv4 = info->ipv4;
+
+	return free_flow;
+}
+
+/* Add fragment to the flow. Fails on overlapping and duplicate fragments,
+ * and when the flow cannot hold more fragments. */
+static inline int reass_flow_insert(reass_flow_t *flow, odp_packet_t pkt,
+				    const reass_info_t *info, int max_frags)
+{
+	uint32_t end = info->offset + info->len;
+	int num = flow->num_frags;
+	int i;
+
+	if (num >= max_frags || flow->l3_offset != info->l3_offset)
+		return -1;
+
+	if (info->last) {
+		if (flow->total_len || (num &&
+		    flow->frag[num - 1].offset + flow->frag[num - 1].len > end))
+			return -1;
+	} else if (flow->total_len && end > flow->total_len) {
+		return -1;
+	}
+
+	for (i = num; i > 0; i--)
+		if (flow->frag[i - 1].offset < info->offset)
+			break;
+
+	if ((i > 0 && flow->frag[i - 1].offset + flow->frag[i - 1].len >
+	     info->offset) || (i < num && end > flow->frag[i].offset))
+		return -1;
+
+	memmove(&flow->frag[i + 1], &flow->frag[i],
+		(num - i) * sizeof(reass_frag_t));
+	flow->frag[i].pkt = pkt;
+	flow->frag[i].offset = info->offset;
+	flow->frag[i].len = info->len;
+	flow->frag[i].hdr_len = info->hdr_len;
+	flow->num_frags++;
+	flow->recv_len += info->len;
+
+	if (info->last)
+		flow->total_len = end;
+
+	return 0;
+}
+
+/* Chain fragment payloads to the first fragment and update its headers.
+ * Returns the reassembled packet and frees the flow. */
+static inline odp_packet_t reass_flow_build(reass_flow_t *flow)
+{
+	odp_packet_t pkt = flow->frag[0].pkt;
+	struct rte_mbuf *head = pkt_to_mbuf(pkt);
+	struct rte_mbuf *tail = head;
+	uint32_t l3_offset = flow->l3_offset;
+	int i;
+
+	/* Remove L2 padding */
+	rte_pktmbuf_trim(head, head->pkt_len - flow->frag[0].hdr_len -
+			 flow->frag[0].len);
+
+	for (i = 1; i < flow->num_frags; i++) {
+		const reass_frag_t *frag = &flow->frag[i];
+		struct rte_mbuf *mbuf = pkt_to_mbuf(frag->pkt);
+
+		rte_pktmbuf_adj(mbuf, frag->hdr_len);
+		rte_pktmbuf_trim(mbuf, mbuf->pkt_len - frag->len);
+		tail->next = mbuf;
+		tail = mbuf;
+		head->nb_segs++;
+		head->pkt_len += frag->len;
+	}
+
+	if (flow->ipv4) {
+		struct rte_ipv4_hdr *ip;
+		uint16_t frag;
+
+		ip = rte_pktmbuf_mtod_offset(head, struct rte_ipv4_hdr *,
+					     l3_offset);
+		frag = odp_be_to_cpu_16(ip->fragment_offset);
+		ip->fragment_offset =
+			rte_cpu_to_be_16(_ODP_IPV4HDR_FLAGS_DONT_FRAG(frag));
+		ip->total_length = rte_cpu_to_be_16(head->pkt_len - l3_offset);
+		ip->hdr_checksum = 0;
+		ip->hdr_checksum = rte_ipv4_cksum(ip);
+	} else {
+		uint8_t *data = rte_pktmbuf_mtod(head, uint8_t *);
+		struct rte_ipv6_hdr *ip;
+		const _odp_ipv6hdr_frag_t *fh;
+
+		ip = (struct rte_ipv6_hdr *)(uintptr_t)(data + l3_offset);
+		fh = (const _odp_ipv6hdr_frag_t *)(uintptr_t)(ip + 1);
+		ip->proto = fh->next_hdr;
+		ip->payload_len = rte_cpu_to_be_16(head->pkt_len - l3_offset -
+						   sizeof(struct rte_ipv6_hdr) -
+						   sizeof(_odp_ipv6hdr_frag_t));
+
+		/* Remove fragment header */
+		memmove(data + sizeof(_odp_ipv6hdr_frag_t), data,
+			l3_offset + sizeof(struct rte_ipv6_hdr));
+		rte_pktmbuf_adj(head, sizeof(_odp_ipv6hdr_frag_t));
+	}
+
+	/* L4 type and checksum status of the first fragment are not valid
+	 * for the whole packet */
+	head->packet_type &= RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK;
+	head->ol_flags &= ~PKT_RX_L4_CKSUM_MASK;
+
+	packet_hdr(pkt)->reass_status = ODP_PACKET_REASS_COMPLETE;
+	flow->num_frags = 0;
+
+	return pkt;
+}
+
+/* Pass fragments of timed out flows as incomplete while there is room in
+ * the table. Returns the number of packets in the table. */
+static int reass_expire(const reass_t *reass, reass_queue_t *queue,
+			odp_packet_t pkt_table[], int num, int max_num,
+			uint64_t now)
+{
+	uint64_t next = UINT64_MAX;
+	uint32_t i;
+	int j;
+
+	for (i = 0; i <= reass->flow_mask; i++) {
+		reass_flow_t *flow = &queue->flow[i];
+		uint64_t end = flow->start + reass->max_wait;
+
+		if (flow->num_frags == 0)
+			continue;
+
+		if (end > now || num + flow->num_frags > max_num) {
+			next = RTE_MIN(next, end);
+			continue;
+		}
+
+		for (j = 0; j < flow->num_frags; j++) {
+			odp_packet_t pkt = flow->frag[j].pkt;
+
+			packet_hdr(pkt)->reass_status =
+				ODP_PACKET_REASS_INCOMPLETE;
+			pkt_table[num++] = pkt;
+		}
+
+		flow->num_frags = 0;
+		queue->num_flows--;
+	}
+
+	queue->next_check = next;
+
+	return num;
+}
+
+/* Reassemble IP fragments of a packet input burst. A reassembled packet
+ * replaces the fragment completing it. Fragments which cannot be held are
+ * passed as incomplete. Returns the number of packets in the table. */
+static int reass_pkts(reass_t *reass, int index, odp_packet_t pkt_table[],
+		      int num, int max_num)
+{
+	reass_queue_t *queue = &reass->queue[index < 0 ? 0 : index];
+	uint64_t now = rte_get_timer_cycles();
+	int num_out = 0;
+	int i;
+
+	/* Avoid locking on empty polls when nothing is due to expire. Flow
+	 * state is read without the lock, a stale value only delays expiry
+	 * until the next poll. */
+	if (num == 0 && (queue->num_flows == 0 || now < queue->next_check))
+		return 0;
+
+	odp_spinlock_lock(&queue->lock);
+
+	for (i = 0; i < num; i++) {
+		odp_packet_t pkt = pkt_table[i];
+		reass_flow_t *flow;
+		reass_info_t info;
+
+		if (odp_likely(reass_parse(reass, pkt_to_mbuf(pkt), &info))) {
+			pkt_table[num_out++] = pkt;
+			continue;
+		}
+
+		flow = reass_flow_lookup(reass, queue, &info, now);
+		if (flow == NULL ||
+		    reass_flow_insert(flow, pkt, &info, reass->max_frags)) {
+			packet_hdr(pkt)->reass_status =
+				ODP_PACKET_REASS_INCOMPLETE;
+			pkt_table[num_out++] = pkt;
+			continue;
+		}
+
+		if (flow->num_frags == 1 && queue->num_flows++ == 0)
+			queue->next_check = now + reass->max_wait;
+
+		if (flow->total_len && flow->recv_len == flow->total_len) {
+			pkt_table[num_out++] = reass_flow_build(flow);
+			queue->num_flows--;
+		}
+	}
+
+	if (queue->num_flows && now >= queue->next_check)
+		num_out = reass_expire(reass, queue, pkt_table, num_out,
+				       max_num, now);
+
+	odp_spinlock_unlock(&queue->lock);
+
+	return num_out;
+}
+
+#ifdef DPDK_RX_HW_TS
+/* Read hardware timestamp of a received packet */
+static inline int mbuf_rx_ts(const rx_ts_t *rx_ts, struct rte_mbuf *mbuf,
+			     uint64_t *clk)
+{
+#if RTE_VERSION < RTE_VERSION_NUM(20, 11, 0, 0)
+	(void)rx_ts;
+
+	if (!(mbuf->ol_flags & PKT_RX_TIMESTAMP))
+		return 0;
+
+	*clk = mbuf->timestamp;
+#else
+	if (!(mbuf->ol_flags & rx_ts->dyn_flag))
+		return 0;
+
+	*clk = *RTE_MBUF_DYNFIELD(mbuf, rx_ts->dyn_offset,
+				  rte_mbuf_timestamp_t *);
+#endif
+	return 1;
+}
+
+/* Convert device clock difference to global time units */
+static inline uint64_t rx_ts_conv_diff(const rx_ts_conv_t *conv,
+				       uint64_t diff)
+{
+	return diff * conv->mult_int + (diff >> 32) * conv->mult_frac +
+	       (((diff & UINT32_MAX) * conv->mult_frac) >> 32);
+}
+
+/* Convert device clock value to global time */
+static inline uint64_t rx_ts_hw_time(const rx_ts_t *rx_ts, uint64_t clk)
+{
+	uint32_t idx = __atomic_load_n(&rx_ts->conv_idx, __ATOMIC_ACQUIRE);
+	const rx_ts_conv_t *conv = &rx_ts->conv[idx & 1];
+	uint64_t diff = clk - conv->ref_clk;
+	uint64_t time;
+
+	if (odp_likely((int64_t)diff >= 0))
+		return conv->ref_time + rx_ts_conv_diff(conv, diff);
+
+	/* Packet received before calibration */
+	time = rx_ts_conv_diff(conv, -diff);
+
+	return time < conv->ref_time ? conv->ref_time - time : 0;
+}
+#endif
+
+/* Timestamp received packets. Hardware timestamps are converted to global
+ * time. Otherwise, packets are assumed to have arrived back-to-back at link
+ * speed: timestamps are interpolated backwards from the current time by wire
+ * times of the following packets, but not beyond the previous poll of the
+ * queue. */
+static inline void rx_ts_burst(pkt_dpdk_t *pkt_dpdk, int index,
+			       odp_packet_t pkt_table[], int num)
+{
+	rx_ts_t *rx_ts = &pkt_dpdk->rx_ts;
+	uint64_t now = odp_time_global().u64;
+	uint64_t max_back = now;
+	uint64_t wire = 0;
+	odp_time_t ts;
+	int i;
+
+	if (index >= 0) {
+		max_back = now - rx_ts->prev[index];
+		rx_ts->prev[index] = now;
+	}
+
+	for (i = num - 1; i >= 0; i--) {
+		odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt_table[i]);
+		struct rte_mbuf *mbuf = pkt_to_mbuf(pkt_table[i]);
+#ifdef DPDK_RX_HW_TS
+		uint64_t clk;
+
+		if (rx_ts->hw && mbuf_rx_ts(rx_ts, mbuf, &clk)) {
+			ts.u64 = rx_ts_hw_time(rx_ts, clk);
+			packet_set_ts(pkt_hdr, &ts);
+			continue;
+		}
+#endif
+		ts.u64 = now - RTE_MIN(wire >> 16, max_back);
+		packet_set_ts(pkt_hdr, &ts);
+
+		wire += (uint64_t)(mbuf->pkt_len + DPDK_WIRE_OVERHEAD) *
+			rx_ts->byte_time;
+	}
+}
+
+/* Process a packet input burst. Up to 'max_num' packets may be returned when
+ * IP reassembly releases held fragments. */
+static inline int input_burst(pktio_entry_t *pktio_entry, int index,
+			      odp_packet_t pkt_table[], int num, int max_num)
+{
+	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
+	uint16_t i;
+	odp_pktin_config_opt_t pktin_cfg = pktio_entry->s.config.pktin;
+	odp_proto_layer_t parse_layer = pktio_entry->s.config.parser.layer;
+	const packet_init_tmpl_t *init_tmpl = &pkt_dpdk->init_tmpl;
+	uint8_t ts_ena = pkt_dpdk->rx_ts.ena;
+	uint16_t num_prefetch;
+
+	/* Index is valid when packets were received */
+	if (num > 1 && odp_unlikely(pkt_dpdk->gro[index]) &&
+	    pktio_entry->s.config.enable_gro)
+		num = gro_pkts(pkt_dpdk, pkt_table, num);
+
+	/* Packets are processed in stages over the whole burst, so that
+	 * memory accesses of a stage overlap with work on earlier packets.
+	 * Stage 1 prefetches metadata and data NUM_RX_PREFETCH packets ahead
+	 * of stage 2, which initializes metadata. */
+	num_prefetch = RTE_MIN(num, NUM_RX_PREFETCH);
+
+	for (i = 0; i < num_prefetch; i++)
+		prefetch_pkt(pkt_table[i]);
+
+	for (i = 0; i < num; ++i) {
+		odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt_table[i]);
+
+		if (odp_likely(i + num_prefetch < num))
+			prefetch_pkt(pkt_table[i + num_prefetch]);
+
+		packet_init(pkt_hdr, init_tmpl);
+	}
+
+	if (odp_unlikely(ts_ena))
+		rx_ts_burst(pkt_dpdk, index, pkt_table, num);
+
+	if (odp_unlikely(pkt_dpdk->reass != NULL))
+		num = reass_pkts(pkt_dpdk->reass, index, pkt_table, num,
+				 max_num);
+
+	/* Stage 3 parses packets, which have been prefetched by now. Packets
+	 * failing parsing are dropped. */
+	if (!pktio_cls_enabled(pktio_entry) &&
+	    parse_layer != ODP_PROTO_LAYER_NONE) {
+		uint32_t ptypes = pkt_dpdk->supported_ptypes;
+		uint16_t num_pkts = 0;
+
+		for (i = 0; i < num; ++i) {
+			odp_packet_t pkt = pkt_table[i];
+			odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+			struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
+
+			/* DPDK ring pmd doesn't support packet parsing */
+			if (pkt_dpdk->loopback) {
+				packet_parse_layer(pkt_hdr, parse_layer,
+						   pktio_entry->s.in_chksums);
+			} else if (_odp_dpdk_packet_parse_layer(pkt_hdr, mbuf,
+								parse_layer,
+								ptypes,
+								pktin_cfg)) {
+				odp_packet_free(pkt);
+				continue;
+			}
+
+			pkt_table[num_pkts++] = pkt;
+		}
+
+		num = num_pkts;
+	}
+
+	if (pktio_cls_enabled(pktio_entry)) {
+		int failed = 0, success = 0;
+
+		for (i = 0; i < num; i++) {
+			odp_packet_t new_pkt;
+			odp_packet_t pkt = pkt_table[i];
 			odp_pool_t new_pool;
 			uint8_t *data;
 			odp_packet_hdr_t parsed_hdr;
 			odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
 			struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
 			uint32_t pkt_len = odp_packet_len(pkt);
+			uint32_t seg_len = mbuf->data_len;
+			odp_time_t ts = pkt_hdr->timestamp;
 			uint32_t ptypes = pkt_dpdk->supported_ptypes;
 
 			data = odp_packet_data(pkt);
 			packet_parse_reset(&parsed_hdr, 1);
 			packet_set_len(&parsed_hdr, pkt_len);
 
+			/* Classifier may reuse RSS hash */
+			parsed_hdr.buf_hdr.mb.ol_flags = 0;
+			if (mbuf->ol_flags & PKT_RX_RSS_HASH)
+				packet_set_flow_hash(&parsed_hdr,
+						     mbuf->hash.rss);
+
 			if (!pkt_dpdk->loopback) {
 				int layer = ODP_PROTO_LAYER_ALL;
 
 				if (_odp_dpdk_packet_parse_common(&parsed_hdr.p,
 								  data, pkt_len,
-								  pkt_len, mbuf,
+								  seg_len, mbuf,
 								  layer, ptypes,
 								  pktin_cfg)) {
 					odp_packet_free(pkt);
@@ -1043,7 +3019,7 @@ int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], int num)
 				}
 			}
 			if (cls_classify_packet(pktio_entry, data, pkt_len,
-						pkt_len, &new_pool, &parsed_hdr,
+						seg_len, &new_pool, &parsed_hdr,
 						pkt_dpdk->loopback)) {
 				failed++;
 				odp_packet_free(pkt);
@@ -1061,9 +3037,10 @@ int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], int num)
 				pkt = new_pkt;
 				pkt_hdr = packet_hdr(pkt);
 			}
-			packet_set_ts(pkt_hdr, ts);
 			pktio_entry->s.stats.in_octets += odp_packet_len(pkt);
 			copy_packet_cls_metadata(&parsed_hdr, pkt_hdr);
+			if (ts_ena)
+				packet_set_ts(pkt_hdr, &ts);
 			if (success != i)
 				pkt_table[success] = pkt;
 			++success;
@@ -1076,10 +3053,26 @@ int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], int num)
 	return num;
 }
 
+int input_pkts(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt_table[],
+	       int num)
+{
+	return input_burst(pktio_entry, index, pkt_table, num, num);
+}
+
+int input_pkts_reass_expired(pktio_entry_t *pktio_entry,
+			     odp_packet_t pkt_table[], int num)
+{
+	if (pkt_priv(pktio_entry)->reass == NULL)
+		return 0;
+
+	return input_burst(pktio_entry, -1, pkt_table, 0, num);
+}
+
 static int recv_pkt_dpdk(pktio_entry_t *pktio_entry, int index,
 			 odp_packet_t pkt_table[], int num)
 {
 	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
+	rss_balance_t *bal;
 	uint16_t nb_rx;
 	uint8_t min = pkt_dpdk->min_rx_burst;
 
@@ -1110,126 +3103,548 @@ static int recv_pkt_dpdk(pktio_entry_t *pktio_entry, int index,
 		nb_rx = RTE_MIN(num, nb_rx);
 	}
 
-	if (!pkt_dpdk->lockless_rx)
-		odp_ticketlock_unlock(&pkt_dpdk->rx_lock[index]);
+	/* Sampled before unlock, since a queue row of the counters has a
+	 * single writer */
+	bal = __atomic_load_n(&pkt_dpdk->rss_bal, __ATOMIC_ACQUIRE);
+	if (odp_unlikely(bal != NULL) && nb_rx)
+		rss_balance_sample(bal, index, pkt_table, nb_rx);
+
+	if (!pkt_dpdk->lockless_rx)
+		odp_ticketlock_unlock(&pkt_dpdk->rx_lock[index]);
+
+	/* Packets may also me received through eventdev, so don't add any
+	 * processing here. Instead, perform all processing in input_burst()
+	 * which is also called by eventdev. Timed out IP fragments may be
+	 * returned also when no packets were received. */
+	if (nb_rx || pkt_dpdk->reass != NULL)
+		return input_burst(pktio_entry, index, pkt_table, nb_rx, num);
+	return 0;
+}
+
+static inline int check_proto(void *l3_hdr, odp_bool_t *l3_proto_v4,
+			      uint8_t *l4_proto)
+{
+	uint8_t l3_proto_ver = _ODP_IPV4HDR_VER(*(uint8_t *)l3_hdr);
+
+	if (l3_proto_ver == _ODP_IPV4) {
+		struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)l3_hdr;
+
+		*l3_proto_v4 = 1;
+		if (!rte_ipv4_frag_pkt_is_fragmented(ip))
+			*l4_proto = ip->next_proto_id;
+		else
+			*l4_proto = 0;
+
+		return 0;
+	} else if (l3_proto_ver == _ODP_IPV6) {
+		struct rte_ipv6_hdr *ipv6 = (struct rte_ipv6_hdr *)l3_hdr;
+
+		*l3_proto_v4 = 0;
+		*l4_proto = ipv6->proto;
+		return 0;
+	}
+
+	return -1;
+}
+
+static inline uint16_t phdr_csum(odp_bool_t ipv4, void *l3_hdr,
+				 uint64_t ol_flags)
+{
+	if (ipv4)
+		return rte_ipv4_phdr_cksum(l3_hdr, ol_flags);
+	else /*ipv6*/
+		return rte_ipv6_phdr_cksum(l3_hdr, ol_flags);
+}
+
+#define OL_TX_CHKSUM_PKT(_cfg, _capa, _proto, _ovr_set, _ovr) \
+	(_capa && _proto && (_ovr_set ? _ovr : _cfg))
+
+static inline void pkt_set_ol_tx(odp_pktout_config_opt_t *pktout_cfg,
+				 odp_pktout_config_opt_t *pktout_capa,
+				 odp_packet_hdr_t *pkt_hdr,
+				 struct rte_mbuf *mbuf,
+				 char *mbuf_data)
+{
+	void *l3_hdr, *l4_hdr;
+	uint8_t l4_proto;
+	odp_bool_t l3_proto_v4;
+	odp_bool_t ipv4_chksum_pkt, udp_chksum_pkt, tcp_chksum_pkt;
+	packet_parser_t *pkt_p = &pkt_hdr->p;
+
+	if (pkt_p->l3_offset == ODP_PACKET_OFFSET_INVALID)
+		return;
+
+	l3_hdr = (void *)(mbuf_data + pkt_p->l3_offset);
+
+	if (check_proto(l3_hdr, &l3_proto_v4, &l4_proto))
+		return;
+
+	ipv4_chksum_pkt = OL_TX_CHKSUM_PKT(pktout_cfg->bit.ipv4_chksum,
+					   pktout_capa->bit.ipv4_chksum,
+					   l3_proto_v4,
+					   pkt_p->flags.l3_chksum_set,
+					   pkt_p->flags.l3_chksum);
+	udp_chksum_pkt =  OL_TX_CHKSUM_PKT(pktout_cfg->bit.udp_chksum,
+					   pktout_capa->bit.udp_chksum,
+					   (l4_proto == _ODP_IPPROTO_UDP),
+					   pkt_p->flags.l4_chksum_set,
+					   pkt_p->flags.l4_chksum);
+	tcp_chksum_pkt =  OL_TX_CHKSUM_PKT(pktout_cfg->bit.tcp_chksum,
+					   pktout_capa->bit.tcp_chksum,
+					   (l4_proto == _ODP_IPPROTO_TCP),
+					   pkt_p->flags.l4_chksum_set,
+					   pkt_p->flags.l4_chksum);
+
+	if (!ipv4_chksum_pkt && !udp_chksum_pkt && !tcp_chksum_pkt)
+		return;
+
+	mbuf->l2_len = pkt_p->l3_offset - pkt_p->l2_offset;
+
+	if (l3_proto_v4)
+		mbuf->ol_flags = PKT_TX_IPV4;
+	else
+		mbuf->ol_flags = PKT_TX_IPV6;
+
+	if (ipv4_chksum_pkt) {
+		mbuf->ol_flags |=  PKT_TX_IP_CKSUM;
+
+		((struct rte_ipv4_hdr *)l3_hdr)->hdr_checksum = 0;
+		mbuf->l3_len = _ODP_IPV4HDR_IHL(*(uint8_t *)l3_hdr) * 4;
+	}
+
+	if (pkt_p->l4_offset == ODP_PACKET_OFFSET_INVALID)
+		return;
+
+	mbuf->l3_len = pkt_p->l4_offset - pkt_p->l3_offset;
+
+	l4_hdr = (void *)(mbuf_data + pkt_p->l4_offset);
+
+	if (udp_chksum_pkt) {
+		mbuf->ol_flags |= PKT_TX_UDP_CKSUM;
+
+		((struct rte_udp_hdr *)l4_hdr)->dgram_cksum =
+			phdr_csum(l3_proto_v4, l3_hdr, mbuf->ol_flags);
+	} else if (tcp_chksum_pkt) {
+		mbuf->ol_flags |= PKT_TX_TCP_CKSUM;
+
+		((struct rte_tcp_hdr *)l4_hdr)->cksum =
+			phdr_csum(l3_proto_v4, l3_hdr, mbuf->ol_flags);
+	}
+}
+
+static inline int tx_burst(pkt_dpdk_t *pkt_dpdk, int index,
+			   struct rte_mbuf *mbufs[], int num)
+{
+	int pkts;
+
+	if (!pkt_dpdk->lockless_tx)
+		odp_ticketlock_lock(&pkt_dpdk->tx_lock[index]);
+
+	pkts = rte_eth_tx_burst(pkt_dpdk->port_id, index, mbufs, num);
+
+	if (!pkt_dpdk->lockless_tx)
+		odp_ticketlock_unlock(&pkt_dpdk->tx_lock[index]);
+
+	return pkts;
+}
+
+static inline int tx_burst_error(pkt_dpdk_t *pkt_dpdk, odp_packet_t pkt)
+{
+	struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
+
+	if (odp_unlikely(rte_errno != 0))
+		return -1;
+
+	if (odp_unlikely(mbuf->pkt_len > pkt_dpdk->mtu &&
+			 !packet_hdr(pkt)->p.flags.lso)) {
+		__odp_errno = EMSGSIZE;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Check that LSO request can be processed. Returns the number of output
+ * packets, or 0 when the packet cannot be segmented. The number of output
+ * packets is limited only on the software segmentation path. */
+static inline uint32_t lso_check(odp_packet_hdr_t *pkt_hdr,
+				 struct rte_mbuf *mbuf, odp_bool_t *ipv4)
+{
+	packet_parser_t *pkt_p = &pkt_hdr->p;
+	uint32_t hdr_len = pkt_hdr->lso_payload_offset;
+	uint32_t mss = pkt_hdr->lso_max_payload;
+	uint32_t num;
+	uint8_t l4_proto;
+
+	if (pkt_p->l3_offset == ODP_PACKET_OFFSET_INVALID ||
+	    pkt_p->l4_offset == ODP_PACKET_OFFSET_INVALID ||
+	    pkt_p->l4_offset + sizeof(struct rte_tcp_hdr) > hdr_len ||
+	    hdr_len > DPDK_LSO_MAX_HDR_LEN || hdr_len > mbuf->data_len)
+		return 0;
+
+	if (check_proto(rte_pktmbuf_mtod_offset(mbuf, void *,
+						pkt_p->l3_offset),
+			ipv4, &l4_proto) || l4_proto != _ODP_IPPROTO_TCP)
+		return 0;
+
+	num = (mbuf->pkt_len - hdr_len + mss - 1) / mss;
+
+	return num ? num : 1;
+}
+
+/* Setup TSO offload flags */
+static inline void lso_set_ol_tso(odp_packet_hdr_t *pkt_hdr,
+				  struct rte_mbuf *mbuf, odp_bool_t ipv4)
+{
+	packet_parser_t *pkt_p = &pkt_hdr->p;
+	char *data = rte_pktmbuf_mtod(mbuf, char *);
+	void *l3_hdr = data + pkt_p->l3_offset;
+	struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)
+		(data + pkt_p->l4_offset);
+
+	mbuf->l2_len = pkt_p->l3_offset - pkt_p->l2_offset;
+	mbuf->l3_len = pkt_p->l4_offset - pkt_p->l3_offset;
+	mbuf->l4_len = pkt_hdr->lso_payload_offset - pkt_p->l4_offset;
+	mbuf->tso_segsz = pkt_hdr->lso_max_payload;
+	mbuf->ol_flags = PKT_TX_TCP_SEG | PKT_TX_TCP_CKSUM;
+
+	if (ipv4) {
+		mbuf->ol_flags |= PKT_TX_IPV4 | PKT_TX_IP_CKSUM;
+		((struct rte_ipv4_hdr *)l3_hdr)->hdr_checksum = 0;
+	} else {
+		mbuf->ol_flags |= PKT_TX_IPV6;
+	}
+
+	tcp->cksum = phdr_csum(ipv4, l3_hdr, mbuf->ol_flags);
+}
 
-	/* Packets may also me received through eventdev, so don't add any
-	 * processing here. Instead, perform all processing in input_pkts()
-	 * which is also called by eventdev. */
-	if (nb_rx)
-		return input_pkts(pktio_entry, pkt_table, nb_rx);
-	return 0;
+static inline uint16_t lso_tcp_cksum(struct rte_mbuf *seg, odp_bool_t ipv4,
+				     void *l3_hdr, uint32_t l4_offset)
+{
+	uint16_t raw = 0;
+	uint32_t sum;
+
+	rte_raw_cksum_mbuf(seg, l4_offset, seg->pkt_len - l4_offset, &raw);
+
+	sum = (uint32_t)raw + phdr_csum(ipv4, l3_hdr, 0);
+	sum = ((sum & 0xffff0000) >> 16) + (sum & 0xffff);
+	sum = (~sum) & 0xffff;
+	if (sum == 0)
+		sum = 0xffff;
+
+	return sum;
 }
 
-static inline int check_proto(void *l3_hdr, odp_bool_t *l3_proto_v4,
-			      uint8_t *l4_proto)
+/* Update headers of an LSO output packet */
+static inline void lso_update_hdr(pkt_dpdk_t *pkt_dpdk,
+				  const packet_parser_t *pkt_p,
+				  struct rte_mbuf *seg, odp_bool_t ipv4,
+				  uint32_t seq, uint16_t ip_id, int last)
 {
-	uint8_t l3_proto_ver = _ODP_IPV4HDR_VER(*(uint8_t *)l3_hdr);
+	char *data = rte_pktmbuf_mtod(seg, char *);
+	void *l3_hdr = data + pkt_p->l3_offset;
+	struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)
+		(data + pkt_p->l4_offset);
 
-	if (l3_proto_ver == _ODP_IPV4) {
+	tcp->sent_seq = rte_cpu_to_be_32(seq);
+	if (!last)
+		tcp->tcp_flags &= ~DPDK_LSO_TCP_FLAGS_LAST;
+	tcp->cksum = 0;
+
+	seg->l2_len = pkt_p->l3_offset - pkt_p->l2_offset;
+	seg->l3_len = pkt_p->l4_offset - pkt_p->l3_offset;
+
+	if (ipv4) {
 		struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)l3_hdr;
 
-		*l3_proto_v4 = 1;
-		if (!rte_ipv4_frag_pkt_is_fragmented(ip))
-			*l4_proto = ip->next_proto_id;
+		ip->total_length = rte_cpu_to_be_16(seg->pkt_len -
+						    pkt_p->l3_offset);
+		ip->packet_id = rte_cpu_to_be_16(ip_id);
+		ip->hdr_checksum = 0;
+		seg->ol_flags = PKT_TX_IPV4;
+
+		if (pkt_dpdk->tx_offloads & DEV_TX_OFFLOAD_IPV4_CKSUM)
+			seg->ol_flags |= PKT_TX_IP_CKSUM;
 		else
-			*l4_proto = 0;
+			ip->hdr_checksum = rte_ipv4_cksum(ip);
+	} else {
+		struct rte_ipv6_hdr *ip = (struct rte_ipv6_hdr *)l3_hdr;
 
-		return 0;
-	} else if (l3_proto_ver == _ODP_IPV6) {
-		struct rte_ipv6_hdr *ipv6 = (struct rte_ipv6_hdr *)l3_hdr;
+		ip->payload_len = rte_cpu_to_be_16(seg->pkt_len -
+						   pkt_p->l3_offset -
+						   sizeof(struct rte_ipv6_hdr));
+		seg->ol_flags = PKT_TX_IPV6;
+	}
 
-		*l3_proto_v4 = 0;
-		*l4_proto = ipv6->proto;
-		return 0;
+	if (pkt_dpdk->tx_offloads & DEV_TX_OFFLOAD_TCP_CKSUM) {
+		seg->ol_flags |= PKT_TX_TCP_CKSUM;
+		tcp->cksum = phdr_csum(ipv4, l3_hdr, seg->ol_flags);
+	} else {
+		tcp->cksum = lso_tcp_cksum(seg, ipv4, l3_hdr, pkt_p->l4_offset);
 	}
+}
 
-	return -1;
+static inline void free_mbufs(struct rte_mbuf *mbufs[], int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++)
+		rte_pktmbuf_free(mbufs[i]);
 }
 
-static inline uint16_t phdr_csum(odp_bool_t ipv4, void *l3_hdr,
-				 uint64_t ol_flags)
+/* Software segmentation. Headers are copied into a new buffer for each
+ * output packet and payload is attached from the original packet without
+ * copying (indirect mbufs). */
+static int lso_segment(pkt_dpdk_t *pkt_dpdk, odp_packet_hdr_t *pkt_hdr,
+		       struct rte_mbuf *mbuf, odp_bool_t ipv4,
+		       struct rte_mbuf *segs[], uint32_t num)
 {
+	const packet_parser_t *pkt_p = &pkt_hdr->p;
+	uint32_t hdr_len = pkt_hdr->lso_payload_offset;
+	uint32_t mss = pkt_hdr->lso_max_payload;
+	uint32_t payload_len = mbuf->pkt_len - hdr_len;
+	const char *hdr = rte_pktmbuf_mtod(mbuf, const char *);
+	const struct rte_tcp_hdr *tcp = (const struct rte_tcp_hdr *)
+		(hdr + pkt_p->l4_offset);
+	uint32_t seq = rte_be_to_cpu_32(tcp->sent_seq);
+	struct rte_mbuf *src = mbuf;
+	uint32_t src_off = hdr_len;
+	uint16_t ip_id = 0;
+	uint32_t i;
+
 	if (ipv4)
-		return rte_ipv4_phdr_cksum(l3_hdr, ol_flags);
-	else /*ipv6*/
-		return rte_ipv6_phdr_cksum(l3_hdr, ol_flags);
+		ip_id = rte_be_to_cpu_16(((const struct rte_ipv4_hdr *)
+					  (hdr + pkt_p->l3_offset))->packet_id);
+
+	if (odp_unlikely(rte_pktmbuf_alloc_bulk(mbuf->pool, segs, num)))
+		return -1;
+
+	for (i = 0; i < num; i++) {
+		struct rte_mbuf *seg = segs[i];
+		struct rte_mbuf *last = seg;
+		uint32_t len = RTE_MIN(mss, payload_len - i * mss);
+
+		memcpy(rte_pktmbuf_mtod(seg, char *), hdr, hdr_len);
+		seg->data_len = hdr_len;
+		seg->pkt_len = hdr_len + len;
+
+		while (len) {
+			struct rte_mbuf *ind;
+			uint32_t n;
+
+			if (src_off == src->data_len) {
+				src = src->next;
+				src_off = 0;
+				continue;
+			}
+
+			ind = rte_pktmbuf_alloc(mbuf->pool);
+			if (odp_unlikely(ind == NULL)) {
+				free_mbufs(segs, num);
+				return -1;
+			}
+
+			n = RTE_MIN(len, src->data_len - src_off);
+			rte_pktmbuf_attach(ind, src);
+			ind->data_off += src_off;
+			ind->data_len = n;
+			ind->pkt_len = n;
+
+			last->next = ind;
+			last = ind;
+			seg->nb_segs++;
+			src_off += n;
+			len -= n;
+		}
+
+		lso_update_hdr(pkt_dpdk, pkt_p, seg, ipv4, seq + i * mss,
+			       ip_id + i, i == num - 1);
+	}
+
+	return 0;
 }
 
-#define OL_TX_CHKSUM_PKT(_cfg, _capa, _proto, _ovr_set, _ovr) \
-	(_capa && _proto && (_ovr_set ? _ovr : _cfg))
+/* L3 offset of an output packet. Packets without L3 offset metadata are
+ * expected to start with an Ethernet header. */
+static inline uint32_t frag_l3_offset(const odp_packet_hdr_t *pkt_hdr,
+				      struct rte_mbuf *mbuf)
+{
+	const _odp_ethhdr_t *eth;
 
-static inline void pkt_set_ol_tx(odp_pktout_config_opt_t *pktout_cfg,
-				 odp_pktout_config_opt_t *pktout_capa,
-				 odp_packet_hdr_t *pkt_hdr,
-				 struct rte_mbuf *mbuf,
-				 char *mbuf_data)
+	if (pkt_hdr->p.l3_offset != ODP_PACKET_OFFSET_INVALID)
+		return pkt_hdr->p.l3_offset;
+
+	eth = rte_pktmbuf_mtod(mbuf, const _odp_ethhdr_t *);
+	if (mbuf->data_len >= _ODP_ETHHDR_LEN + _ODP_VLANHDR_LEN &&
+	    odp_be_to_cpu_16(eth->type) == _ODP_ETHTYPE_VLAN)
+		return _ODP_ETHHDR_LEN + _ODP_VLANHDR_LEN;
+
+	return _ODP_ETHHDR_LEN;
+}
+
+/* Insert L4 checksum in software before fragmentation. Checksum field
+ * contains the pseudo header checksum set up for checksum offload. L4 header
+ * may be located in any segment of the packet. */
+static inline int frag_l4_cksum(odp_packet_t pkt, struct rte_mbuf *mbuf)
 {
-	void *l3_hdr, *l4_hdr;
-	uint8_t l4_proto;
-	odp_bool_t l3_proto_v4;
-	odp_bool_t ipv4_chksum_pkt, udp_chksum_pkt, tcp_chksum_pkt;
-	packet_parser_t *pkt_p = &pkt_hdr->p;
+	uint64_t l4 = mbuf->ol_flags & PKT_TX_L4_MASK;
+	uint32_t l4_offset = mbuf->l2_len + mbuf->l3_len;
+	uint32_t cksum_offset;
+	uint16_t cksum;
+	uint16_t raw = 0;
+
+	if (l4 == PKT_TX_TCP_CKSUM)
+		cksum_offset = l4_offset + offsetof(struct rte_tcp_hdr, cksum);
+	else if (l4 == PKT_TX_UDP_CKSUM)
+		cksum_offset = l4_offset + offsetof(struct rte_udp_hdr,
+						    dgram_cksum);
+	else
+		return 0;
 
-	if (pkt_p->l3_offset == ODP_PACKET_OFFSET_INVALID)
-		return;
+	if (odp_unlikely(cksum_offset + sizeof(cksum) > mbuf->pkt_len ||
+			 rte_raw_cksum_mbuf(mbuf, l4_offset,
+					    mbuf->pkt_len - l4_offset, &raw)))
+		return -1;
 
-	l3_hdr = (void *)(mbuf_data + pkt_p->l3_offset);
+	cksum = raw == 0xffff ? raw : (uint16_t)~raw;
+	if (odp_packet_copy_from_mem(pkt, cksum_offset, sizeof(cksum),
+				     &cksum))
+		return -1;
 
-	if (check_proto(l3_hdr, &l3_proto_v4, &l4_proto))
-		return;
+	mbuf->ol_flags &= ~PKT_TX_L4_MASK;
 
-	ipv4_chksum_pkt = OL_TX_CHKSUM_PKT(pktout_cfg->bit.ipv4_chksum,
-					   pktout_capa->bit.ipv4_chksum,
-					   l3_proto_v4,
-					   pkt_p->flags.l3_chksum_set,
-					   pkt_p->flags.l3_chksum);
-	udp_chksum_pkt =  OL_TX_CHKSUM_PKT(pktout_cfg->bit.udp_chksum,
-					   pktout_capa->bit.udp_chksum,
-					   (l4_proto == _ODP_IPPROTO_UDP),
-					   pkt_p->flags.l4_chksum_set,
-					   pkt_p->flags.l4_chksum);
-	tcp_chksum_pkt =  OL_TX_CHKSUM_PKT(pktout_cfg->bit.tcp_chksum,
-					   pktout_capa->bit.tcp_chksum,
-					   (l4_proto == _ODP_IPPROTO_TCP),
-					   pkt_p->flags.l4_chksum_set,
-					   pkt_p->flags.l4_chksum);
+	return 0;
+}
 
-	if (!ipv4_chksum_pkt && !udp_chksum_pkt && !tcp_chksum_pkt)
-		return;
+/* Split packet into IP fragments. Returns the number of fragments, or 0
+ * when the packet cannot be fragmented. */
+static inline uint32_t frag_pkt(pkt_dpdk_t *pkt_dpdk, odp_packet_t pkt,
+				struct rte_mbuf *segs[])
+{
+	struct rte_mbuf *mbuf = pkt_to_mbuf(pkt);
+	uint32_t l3_offset = frag_l3_offset(packet_hdr(pkt), mbuf);
+	int num;
 
-	mbuf->l2_len = pkt_p->l3_offset - pkt_p->l2_offset;
+	if (l3_offset >= pkt_dpdk->mtu)
+		return 0;
 
-	if (l3_proto_v4)
-		mbuf->ol_flags = PKT_TX_IPV4;
-	else
-		mbuf->ol_flags = PKT_TX_IPV6;
+	if (odp_unlikely(frag_l4_cksum(pkt, mbuf)))
+		return 0;
 
-	if (ipv4_chksum_pkt) {
-		mbuf->ol_flags |=  PKT_TX_IP_CKSUM;
+	num = _odp_packet_ip_fragment(pkt, l3_offset,
+				      pkt_dpdk->mtu - l3_offset,
+				      (odp_packet_t *)segs,
+				      DPDK_FRAG_MAX_FRAGS);
 
-		((struct rte_ipv4_hdr *)l3_hdr)->hdr_checksum = 0;
-		mbuf->l3_len = _ODP_IPV4HDR_IHL(*(uint8_t *)l3_hdr) * 4;
-	}
+	return num > 0 ? (uint32_t)num : 0;
+}
 
-	if (pkt_p->l4_offset == ODP_PACKET_OFFSET_INVALID)
-		return;
+/* Send packets which need LSO segmentation or IP fragmentation in
+ * software */
+static int send_pkt_dpdk_sw(pktio_entry_t *pktio_entry, int index,
+			    const odp_packet_t pkt_table[], int num)
+{
+	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
+	struct rte_mbuf *segs[DPDK_LSO_MAX_SEGS];
+	int tso = (pkt_dpdk->tx_offloads & DPDK_TSO_OFFLOADS) ==
+		  DPDK_TSO_OFFLOADS;
+	int lso_ena = pktio_entry->s.config.enable_lso;
+	int frag_ena = pktio_entry->s.config.enable_frag;
+	int sent = 0;
+	int i = 0;
+	int retry;
+
+	while (i < num) {
+		odp_packet_hdr_t *pkt_hdr = NULL;
+		struct rte_mbuf *mbuf = NULL;
+		odp_bool_t ipv4 = 0;
+		uint32_t nb_segs = 0;
+		int frag = 0;
+		int first = i;
+		int ret;
+
+		/* Pass packets to the driver until a packet needs software
+		 * segmentation or fragmentation */
+		for (; i < num; i++) {
+			pkt_hdr = packet_hdr(pkt_table[i]);
+			mbuf = pkt_to_mbuf(pkt_table[i]);
+
+			if (odp_unlikely(lso_ena && pkt_hdr->p.flags.lso)) {
+				nb_segs = lso_check(pkt_hdr, mbuf, &ipv4);
+				if (tso && nb_segs) {
+					lso_set_ol_tso(pkt_hdr, mbuf, ipv4);
+					continue;
+				}
+				if (nb_segs > DPDK_LSO_MAX_SEGS)
+					nb_segs = 0;
+				break;
+			}
 
-	mbuf->l3_len = pkt_p->l4_offset - pkt_p->l3_offset;
+			if (odp_unlikely(frag_ena &&
+					 mbuf->pkt_len > pkt_dpdk->mtu)) {
+				frag = 1;
+				break;
+			}
+		}
 
-	l4_hdr = (void *)(mbuf_data + pkt_p->l4_offset);
+		if (i > first) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-qual"
+			ret = tx_burst(pkt_dpdk, index,
+				       (struct rte_mbuf **)&pkt_table[first],
+				       i - first);
+#pragma GCC diagnostic pop
+			sent += ret;
+			if (ret < i - first || i == num)
+				break;
+		}
 
-	if (udp_chksum_pkt) {
-		mbuf->ol_flags |= PKT_TX_UDP_CKSUM;
+		if (frag)
+			nb_segs = frag_pkt(pkt_dpdk, pkt_table[i], segs);
 
-		((struct rte_udp_hdr *)l4_hdr)->dgram_cksum =
-			phdr_csum(l3_proto_v4, l3_hdr, mbuf->ol_flags);
-	} else if (tcp_chksum_pkt) {
-		mbuf->ol_flags |= PKT_TX_TCP_CKSUM;
+		if (odp_unlikely(nb_segs == 0)) {
+			if (frag)
+				ODP_DBG("IP fragmentation failed, packet "
+					"dropped\n");
+			else
+				ODP_DBG("Bad LSO request, packet dropped\n");
+			rte_pktmbuf_free(mbuf);
+			sent++;
+			i++;
+			continue;
+		}
 
-		((struct rte_tcp_hdr *)l4_hdr)->cksum =
-			phdr_csum(l3_proto_v4, l3_hdr, mbuf->ol_flags);
+		if (!frag && odp_unlikely(lso_segment(pkt_dpdk, pkt_hdr, mbuf,
+						      ipv4, segs, nb_segs)))
+			break;
+
+		/* Packet is consumed only when all output packets were sent.
+		 * Otherwise, it is left to the application, which may send it
+		 * again. Output packets already sent are then duplicated, which
+		 * TCP and IP reassembly tolerate. */
+		ret = tx_burst(pkt_dpdk, index, segs, nb_segs);
+		for (retry = 0; ret > 0 && ret < (int)nb_segs &&
+		     retry < DPDK_SW_TX_RETRIES; retry++) {
+			odp_cpu_pause();
+			ret += tx_burst(pkt_dpdk, index, &segs[ret],
+					nb_segs - ret);
+		}
+
+		if (odp_unlikely(ret < (int)nb_segs)) {
+			free_mbufs(&segs[ret], nb_segs - ret);
+			break;
+		}
+
+		rte_pktmbuf_free(mbuf);
+		sent++;
+		i++;
 	}
+
+	if (odp_unlikely(sent == 0))
+		return tx_burst_error(pkt_dpdk, pkt_table[0]);
+
+	rte_errno = 0;
+	return sent;
 }
 
 static int send_pkt_dpdk(pktio_entry_t *pktio_entry, int index,
@@ -1254,30 +3669,41 @@ static int send_pkt_dpdk(pktio_entry_t *pktio_entry, int index,
 		}
 	}
 
-	if (!pkt_dpdk->lockless_tx)
-		odp_ticketlock_lock(&pkt_dpdk->tx_lock[index]);
+	if (odp_unlikely(pkt_dpdk->tx_ts_ena)) {
+		int i;
+
+		for (i = 0; i < num; i++)
+			if (packet_hdr(pkt_table[i])->p.flags.ts_set)
+				pkt_to_mbuf(pkt_table[i])->ol_flags |=
+					PKT_TX_IEEE1588_TMST;
+	}
 
+	if (odp_unlikely(pktio_entry->s.config.enable_lso ||
+			 pktio_entry->s.config.enable_frag)) {
+		pkts = send_pkt_dpdk_sw(pktio_entry, index, pkt_table, num);
+	} else {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-qual"
-	pkts = rte_eth_tx_burst(pkt_dpdk->port_id, index,
+		pkts = tx_burst(pkt_dpdk, index,
 				(struct rte_mbuf **)pkt_table, num);
 #pragma GCC diagnostic pop
 
-	if (!pkt_dpdk->lockless_tx)
-		odp_ticketlock_unlock(&pkt_dpdk->tx_lock[index]);
-
-	if (pkts == 0) {
-		struct rte_mbuf *mbuf = pkt_to_mbuf(pkt_table[0]);
+		if (pkts == 0)
+			pkts = tx_burst_error(pkt_dpdk, pkt_table[0]);
+		else
+			rte_errno = 0;
+	}
 
-		if (odp_unlikely(rte_errno != 0))
-			return -1;
+	/* Packets not sent stay with the application, which may send them
+	 * later without a timestamp request */
+	if (odp_unlikely(pkt_dpdk->tx_ts_ena && pkts < num)) {
+		int i;
 
-		if (odp_unlikely(mbuf->pkt_len > pkt_dpdk->mtu)) {
-			__odp_errno = EMSGSIZE;
-			return -1;
-		}
+		for (i = pkts > 0 ? pkts : 0; i < num; i++)
+			pkt_to_mbuf(pkt_table[i])->ol_flags &=
+				~PKT_TX_IEEE1588_TMST;
 	}
-	rte_errno = 0;
+
 	return pkts;
 }
 
@@ -1545,9 +3971,179 @@ static int stats_pkt_dpdk(pktio_entry_t *pktio_entry, odp_pktio_stats_t *stats)
 		return ret;
 }
 
+static uint64_t dpdk_pktin_ts_res(pktio_entry_t *pktio_entry)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	uint64_t res = odp_time_global_res();
+
+	/* Hardware timestamps are converted to global time, but their
+	 * resolution is limited by the device clock */
+	if (pkt_dpdk->rx_ts.hw && pkt_dpdk->rx_ts.clk_hz < res)
+		return pkt_dpdk->rx_ts.clk_hz;
+
+	return res;
+}
+
+static int dpdk_pktout_ts_read(pktio_entry_t *pktio_entry, odp_time_t *ts)
+{
+	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
+	struct timespec dev_time;
+	int64_t ns;
+	int ret;
+
+	if (!pkt_dpdk->tx_ts_ena)
+		return -1;
+
+	ret = rte_eth_timesync_read_tx_timestamp(pkt_dpdk->port_id,
+						 &dev_time);
+	/* No timestamp has been captured */
+	if (ret == -EINVAL)
+		return 1;
+	if (ret)
+		return -1;
+
+	/* Device clock drifts against global time, recalibrate the offset
+	 * periodically */
+	if (odp_time_global_ns() - pkt_dpdk->tx_ts_calib_ns >
+	    DPDK_TX_TS_CALIB_INTERVAL)
+		tx_ts_calibrate(pkt_dpdk);
+
+	ns = (int64_t)dev_time.tv_sec * ODP_TIME_SEC_IN_NS +
+	     dev_time.tv_nsec + pkt_dpdk->tx_ts_offset;
+	*ts = odp_time_global_from_ns(ns > 0 ? (uint64_t)ns : 0);
+
+	return 0;
+}
+
 static int stats_reset_pkt_dpdk(pktio_entry_t *pktio_entry)
 {
-	rte_eth_stats_reset(pkt_priv(pktio_entry)->port_id);
+	uint16_t port_id = pkt_priv(pktio_entry)->port_id;
+
+	rte_eth_stats_reset(port_id);
+	rte_eth_xstats_reset(port_id);
+	return 0;
+}
+
+static int dpdk_pktin_stats(pktio_entry_t *pktio_entry, uint32_t index,
+			    odp_pktin_queue_stats_t *pktin_stats)
+{
+	struct rte_eth_stats rte_stats;
+	int ret;
+
+	memset(pktin_stats, 0, sizeof(odp_pktin_queue_stats_t));
+
+	/* Queues without statistics counters */
+	if (index >= RTE_ETHDEV_QUEUE_STAT_CNTRS)
+		return 0;
+
+	ret = rte_eth_stats_get(pkt_priv(pktio_entry)->port_id, &rte_stats);
+	if (odp_unlikely(ret)) {
+		ODP_ERR("Failed to read DPDK pktio stats: %d\n", ret);
+		return -1;
+	}
+
+	pktin_stats->octets = rte_stats.q_ibytes[index];
+	pktin_stats->packets = rte_stats.q_ipackets[index];
+	pktin_stats->errors = rte_stats.q_errors[index];
+
+	return 0;
+}
+
+static int dpdk_pktout_stats(pktio_entry_t *pktio_entry, uint32_t index,
+			     odp_pktout_queue_stats_t *pktout_stats)
+{
+	struct rte_eth_stats rte_stats;
+	int ret;
+
+	memset(pktout_stats, 0, sizeof(odp_pktout_queue_stats_t));
+
+	if (index >= RTE_ETHDEV_QUEUE_STAT_CNTRS)
+		return 0;
+
+	ret = rte_eth_stats_get(pkt_priv(pktio_entry)->port_id, &rte_stats);
+	if (odp_unlikely(ret)) {
+		ODP_ERR("Failed to read DPDK pktio stats: %d\n", ret);
+		return -1;
+	}
+
+	pktout_stats->octets = rte_stats.q_obytes[index];
+	pktout_stats->packets = rte_stats.q_opackets[index];
+
+	return 0;
+}
+
+static int dpdk_extra_stat_info(pktio_entry_t *pktio_entry,
+				odp_pktio_extra_stat_info_t info[], int num)
+{
+	uint16_t port_id = pkt_priv(pktio_entry)->port_id;
+	int num_stats, ret, i;
+
+	num_stats = rte_eth_xstats_get_names(port_id, NULL, 0);
+	if (num_stats < 0) {
+		ODP_ERR("rte_eth_xstats_get_names() failed: %d\n", num_stats);
+		return num_stats;
+	} else if (info == NULL || num == 0 || num_stats == 0) {
+		return num_stats;
+	}
+
+	struct rte_eth_xstat_name xstats_names[num_stats];
+
+	ret = rte_eth_xstats_get_names(port_id, xstats_names, num_stats);
+	if (ret < 0 || ret > num_stats) {
+		ODP_ERR("rte_eth_xstats_get_names() failed: %d\n", ret);
+		return -1;
+	}
+	num_stats = ret;
+
+	for (i = 0; i < num && i < num_stats; i++)
+		snprintf(info[i].name, ODP_PKTIO_STATS_EXTRA_NAME_LEN, "%s",
+			 xstats_names[i].name);
+
+	return num_stats;
+}
+
+static int dpdk_extra_stats(pktio_entry_t *pktio_entry, uint64_t stats[],
+			    int num)
+{
+	uint16_t port_id = pkt_priv(pktio_entry)->port_id;
+	int num_stats, ret, i;
+
+	num_stats = rte_eth_xstats_get(port_id, NULL, 0);
+	if (num_stats < 0) {
+		ODP_ERR("rte_eth_xstats_get() failed: %d\n", num_stats);
+		return num_stats;
+	} else if (stats == NULL || num == 0 || num_stats == 0) {
+		return num_stats;
+	}
+
+	struct rte_eth_xstat xstats[num_stats];
+
+	ret = rte_eth_xstats_get(port_id, xstats, num_stats);
+	if (ret < 0 || ret > num_stats) {
+		ODP_ERR("rte_eth_xstats_get() failed: %d\n", ret);
+		return -1;
+	}
+	num_stats = ret;
+
+	for (i = 0; i < num && i < num_stats; i++)
+		stats[i] = xstats[i].value;
+
+	return num_stats;
+}
+
+static int dpdk_extra_stat_counter(pktio_entry_t *pktio_entry, uint32_t id,
+				   uint64_t *stat)
+{
+	uint16_t port_id = pkt_priv(pktio_entry)->port_id;
+	uint64_t xstat_id = id;
+	int ret;
+
+	ret = rte_eth_xstats_get_by_id(port_id, &xstat_id, stat, 1);
+	if (ret != 1) {
+		ODP_ERR("rte_eth_xstats_get_by_id() failed: %d\n", ret);
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -1563,8 +4159,19 @@ const pktio_if_ops_t dpdk_pktio_ops = {
 	.stop = stop_pkt_dpdk,
 	.stats = stats_pkt_dpdk,
 	.stats_reset = stats_reset_pkt_dpdk,
-	.pktin_ts_res = NULL,
+	.pktin_queue_stats = dpdk_pktin_stats,
+	.pktout_queue_stats = dpdk_pktout_stats,
+	.extra_stat_info = dpdk_extra_stat_info,
+	.extra_stats = dpdk_extra_stats,
+	.extra_stat_counter = dpdk_extra_stat_counter,
+	.hash_proto_set = dpdk_hash_proto_set,
+	.hash_key_set = dpdk_hash_key_set,
+	.hash_reta = dpdk_hash_reta,
+	.hash_reta_set = dpdk_hash_reta_set,
+	.hash_balance = dpdk_hash_balance,
+	.pktin_ts_res = dpdk_pktin_ts_res,
 	.pktin_ts_from_ns = NULL,
+	.pktout_ts_read = dpdk_pktout_ts_read,
 	.mtu_get = dpdk_frame_maxlen,
 	.promisc_mode_set = promisc_mode_set_pkt_dpdk,
 	.promisc_mode_get = promisc_mode_get_pkt_dpdk,
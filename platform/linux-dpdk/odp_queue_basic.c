@@ -27,6 +27,7 @@
 #include <odp_timer_internal.h>
 #include <odp/api/plat/queue_inline_types.h>
 #include <odp_global_data.h>
+#include <odp_trace_internal.h>
 
 #include <odp/api/plat/ticketlock_inlines.h>
 #define LOCK(queue_ptr)      odp_ticketlock_lock(&((queue_ptr)->s.lock))
@@ -55,6 +56,7 @@ static int queue_capa(odp_queue_capability_t *capa, int sched ODP_UNUSED)
 	capa->plain.max_size    = queue_glb->config.max_queue_size;
 	capa->plain.lockfree.max_num  = queue_glb->queue_lf_num;
 	capa->plain.lockfree.max_size = queue_glb->queue_lf_size;
+	capa->threshold         = 1;
 #if ODP_DEPRECATED_API
 	capa->sched.max_num     = CONFIG_MAX_SCHED_QUEUES;
 	capa->sched.max_size    = queue_glb->config.max_queue_size;
@@ -277,6 +279,9 @@ static odp_queue_t queue_create(const char *name,
 			return ODP_QUEUE_INVALID;
 		if (param->size > queue_glb->queue_lf_size)
 			return ODP_QUEUE_INVALID;
+		/* Congestion thresholds not supported */
+		if (param->threshold.high)
+			return ODP_QUEUE_INVALID;
 	} else {
 		/* Wait-free queues not supported */
 		return ODP_QUEUE_INVALID;
@@ -461,6 +466,11 @@ static odp_queue_t queue_lookup(const char *name)
 	return ODP_QUEUE_INVALID;
 }
 
+static uint32_t plain_queue_depth(queue_entry_t *queue)
+{
+	return ring_mpmc_length(queue->s.ring_mpmc);
+}
+
 static inline int _plain_queue_enq_multi(odp_queue_t handle,
 					 odp_buffer_hdr_t *buf_hdr[], int num)
 {
@@ -476,6 +486,9 @@ static inline int _plain_queue_enq_multi(odp_queue_t handle,
 
 	num_enq = ring_mpmc_enq_multi(ring_mpmc, (void **)buf_hdr, num);
 
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, plain_queue_depth);
+
 	return num_enq;
 }
 
@@ -491,6 +504,9 @@ static inline int _plain_queue_deq_multi(odp_queue_t handle,
 
 	num_deq = ring_mpmc_deq_multi(ring_mpmc, (void **)buf_hdr, num);
 
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, plain_queue_depth);
+
 	return num_deq;
 }
 
@@ -585,6 +601,8 @@ static void queue_param_init(odp_queue_param_t *params)
 	params->sched.prio  = odp_schedule_default_prio();
 	params->sched.sync  = ODP_SCHED_SYNC_PARALLEL;
 	params->sched.group = ODP_SCHED_GROUP_ALL;
+	params->threshold.notif_queue = ODP_QUEUE_INVALID;
+	params->threshold.notif_pool = ODP_POOL_INVALID;
 }
 
 static int queue_info(odp_queue_t handle, odp_queue_info_t *info)
@@ -701,6 +719,13 @@ static void queue_print(odp_queue_t handle)
 		  (queue->s.status == QUEUE_STATUS_NOTSCHED ? "not scheduled" :
 		   (queue->s.status == QUEUE_STATUS_SCHED ? "scheduled" : "unknown")));
 	ODP_PRINT("  param.size      %" PRIu32 "\n", queue->s.param.size);
+	if (queue->s.param.threshold.high) {
+		ODP_PRINT("  threshold       %" PRIu32 "/%" PRIu32 "\n",
+			  queue->s.param.threshold.low,
+			  queue->s.param.threshold.high);
+		ODP_PRINT("  congested       %" PRIu32 "\n",
+			  odp_atomic_load_u32(&queue->s.congested));
+	}
 	if (queue->s.queue_lf) {
 		ODP_PRINT("  implementation  queue_lf\n");
 		ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
@@ -733,6 +758,8 @@ static inline int _sched_queue_enq_multi(odp_queue_t handle,
 	int ret;
 	queue_entry_t *queue;
 	int num_enq;
+	int thr = -1;
+	uint32_t depth = 0;
 	ring_st_t ring_st;
 
 	queue = qentry_from_handle(handle);
@@ -755,12 +782,21 @@ static inline int _sched_queue_enq_multi(odp_queue_t handle,
 		sched = 1;
 	}
 
+	if (odp_unlikely(queue->s.param.threshold.high)) {
+		depth = ring_st_length(ring_st);
+		thr = queue_thr_update_locked(queue, depth);
+	}
+
 	UNLOCK(queue);
 
 	/* Add queue to scheduling */
 	if (sched && sched_fn->sched_queue(queue->s.index))
 		ODP_ABORT("schedule_queue failed\n");
 
+	/* Notification is sent outside of the queue lock */
+	if (odp_unlikely(thr >= 0))
+		queue_thr_notify(queue, thr, depth);
+
 	return num_enq;
 }
 
@@ -801,6 +837,16 @@ int sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int max_num,
 		return 0;
 	}
 
+	if (odp_unlikely(queue->s.param.threshold.high)) {
+		uint32_t depth = ring_st_length(ring_st);
+		int thr = queue_thr_update_locked(queue, depth);
+
+		UNLOCK(queue);
+		if (thr >= 0)
+			queue_thr_notify(queue, thr, depth);
+		return num_deq;
+	}
+
 	UNLOCK(queue);
 
 	return num_deq;
@@ -874,6 +920,7 @@ static int queue_init(queue_entry_t *queue, const char *name,
 
 	queue->s.type = queue_type;
 	odp_atomic_init_u64(&queue->s.num_timers, 0);
+	odp_atomic_init_u32(&queue->s.congested, 0);
 
 	queue->s.pktin = PKTIN_INVALID;
 	queue->s.pktout = PKTOUT_INVALID;
@@ -890,6 +937,14 @@ static int queue_init(queue_entry_t *queue, const char *name,
 		return -1;
 	}
 
+	if (param->threshold.high &&
+	    (param->threshold.high > queue_size ||
+	     param->threshold.low >= param->threshold.high)) {
+		ODP_ERR("Bad congestion thresholds %u/%u\n",
+			param->threshold.low, param->threshold.high);
+		return -1;
+	}
+
 	/* Ring size must larger than queue_size */
 	if (CHECK_IS_POWER2(queue_size))
 		queue_size++;
@@ -945,6 +1000,36 @@ static int queue_init(queue_entry_t *queue, const char *name,
 	return 0;
 }
 
+void queue_thr_notify(queue_entry_t *queue, int congested, uint32_t depth)
+{
+	odp_queue_threshold_t *thr = &queue->s.param.threshold;
+	odp_queue_threshold_notif_t *notif;
+	odp_buffer_t buf;
+
+	if (thr->notif_queue == ODP_QUEUE_INVALID)
+		return;
+
+	buf = odp_buffer_alloc(thr->notif_pool);
+	if (odp_unlikely(buf == ODP_BUFFER_INVALID))
+		return;
+
+	notif = odp_buffer_addr(buf);
+	notif->queue = queue->s.handle;
+	notif->depth = depth;
+	notif->congested = congested;
+
+	if (odp_unlikely(odp_queue_enq(thr->notif_queue,
+				       odp_buffer_to_event(buf))))
+		odp_buffer_free(buf);
+}
+
+static int queue_congested(odp_queue_t handle)
+{
+	queue_entry_t *queue = qentry_from_handle(handle);
+
+	return odp_atomic_load_u32(&queue->s.congested);
+}
+
 static uint64_t queue_to_u64(odp_queue_t hdl)
 {
 	return _odp_pri(hdl);
@@ -1013,6 +1098,7 @@ static int queue_api_enq_multi(odp_queue_t handle,
 			       const odp_event_t ev[], int num)
 {
 	queue_entry_t *queue = qentry_from_handle(handle);
+	int ret;
 
 	if (odp_unlikely(num == 0))
 		return 0;
@@ -1020,8 +1106,12 @@ static int queue_api_enq_multi(odp_queue_t handle,
 	if (num > QUEUE_MULTI_MAX)
 		num = QUEUE_MULTI_MAX;
 
-	return queue->s.enqueue_multi(handle,
-				      (odp_buffer_hdr_t **)(uintptr_t)ev, num);
+	_ODP_TRACE_BEGIN(_ODP_TRACE_QUEUE_ENQ, num);
+	ret = queue->s.enqueue_multi(handle,
+				     (odp_buffer_hdr_t **)(uintptr_t)ev, num);
+	_ODP_TRACE_END(_ODP_TRACE_QUEUE_ENQ, ret);
+
+	return ret;
 }
 
 static void queue_timer_add(odp_queue_t handle)
@@ -1041,9 +1131,13 @@ static void queue_timer_rem(odp_queue_t handle)
 static int queue_api_enq(odp_queue_t handle, odp_event_t ev)
 {
 	queue_entry_t *queue = qentry_from_handle(handle);
+	int ret;
 
-	return queue->s.enqueue(handle,
-				(odp_buffer_hdr_t *)(uintptr_t)ev);
+	_ODP_TRACE_BEGIN(_ODP_TRACE_QUEUE_ENQ, 1);
+	ret = queue->s.enqueue(handle, (odp_buffer_hdr_t *)(uintptr_t)ev);
+	_ODP_TRACE_END(_ODP_TRACE_QUEUE_ENQ, ret == 0);
+
+	return ret;
 }
 
 static int queue_api_deq_multi(odp_queue_t handle, odp_event_t ev[], int num)
@@ -1094,7 +1188,8 @@ _odp_queue_api_fn_t queue_basic_api = {
 	.queue_to_u64 = queue_to_u64,
 	.queue_param_init = queue_param_init,
 	.queue_info = queue_info,
-	.queue_print = queue_print
+	.queue_print = queue_print,
+	.queue_congested = queue_congested
 };
 
 /* Functions towards internal components */
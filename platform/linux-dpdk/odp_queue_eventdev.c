@@ -400,6 +400,7 @@ static int init_event_dev(void)
 	eventdev_gbl->rx_adapter.status = RX_ADAPTER_INIT;
 	odp_ticketlock_init(&eventdev_gbl->rx_adapter.lock);
 	odp_atomic_init_u32(&eventdev_gbl->num_started, 0);
+	odp_atomic_init_u32(&eventdev_gbl->num_reass_ports, 0);
 
 	odp_ticketlock_init(&eventdev_gbl->port_lock);
 	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
@@ -690,6 +691,10 @@ static odp_queue_t queue_create(const char *name,
 	if (param->nonblocking != ODP_BLOCKING)
 		return ODP_QUEUE_INVALID;
 
+	/* Congestion thresholds not supported */
+	if (param->threshold.high)
+		return ODP_QUEUE_INVALID;
+
 	/* First RTE_EVENT_MAX_QUEUES_PER_DEV IDs are mapped directly
 	 * to eventdev queue IDs */
 	if (type == ODP_QUEUE_TYPE_SCHED) {
@@ -941,6 +946,8 @@ static void queue_param_init(odp_queue_param_t *params)
 	params->sched.prio  = odp_schedule_default_prio();
 	params->sched.sync  = ODP_SCHED_SYNC_PARALLEL;
 	params->sched.group = ODP_SCHED_GROUP_ALL;
+	params->threshold.notif_queue = ODP_QUEUE_INVALID;
+	params->threshold.notif_pool = ODP_POOL_INVALID;
 }
 
 static int queue_info(odp_queue_t handle, odp_queue_info_t *info)
@@ -1214,6 +1221,12 @@ static int queue_init(queue_entry_t *queue, const char *name,
 	return 0;
 }
 
+static int queue_congested(odp_queue_t handle ODP_UNUSED)
+{
+	/* Congestion thresholds not supported */
+	return 0;
+}
+
 static uint64_t queue_to_u64(odp_queue_t hdl)
 {
 	return _odp_pri(hdl);
@@ -1363,7 +1376,8 @@ _odp_queue_api_fn_t queue_eventdev_api = {
 	.queue_to_u64 = queue_to_u64,
 	.queue_param_init = queue_param_init,
 	.queue_info = queue_info,
-	.queue_print = queue_print
+	.queue_print = queue_print,
+	.queue_congested = queue_congested
 };
 
 /* Functions towards internal components */
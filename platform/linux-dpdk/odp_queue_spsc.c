@@ -8,11 +8,17 @@
 
 #include <odp_debug_internal.h>
 
+static uint32_t spsc_queue_depth(queue_entry_t *queue)
+{
+	return ring_spsc_length(queue->s.ring_spsc);
+}
+
 static inline int spsc_enq_multi(odp_queue_t handle,
 				 odp_buffer_hdr_t *buf_hdr[], int num)
 {
 	queue_entry_t *queue;
 	ring_spsc_t ring_spsc;
+	int num_enq;
 
 	queue = qentry_from_handle(handle);
 	ring_spsc = queue->s.ring_spsc;
@@ -22,7 +28,12 @@ static inline int spsc_enq_multi(odp_queue_t handle,
 		return -1;
 	}
 
-	return ring_spsc_enq_multi(ring_spsc, (void **)buf_hdr, num);
+	num_enq = ring_spsc_enq_multi(ring_spsc, (void **)buf_hdr, num);
+
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, spsc_queue_depth);
+
+	return num_enq;
 }
 
 static inline int spsc_deq_multi(odp_queue_t handle,
@@ -30,6 +41,7 @@ static inline int spsc_deq_multi(odp_queue_t handle,
 {
 	queue_entry_t *queue;
 	ring_spsc_t ring_spsc;
+	int num_deq;
 
 	queue = qentry_from_handle(handle);
 	ring_spsc = queue->s.ring_spsc;
@@ -39,7 +51,12 @@ static inline int spsc_deq_multi(odp_queue_t handle,
 		return -1;
 	}
 
-	return ring_spsc_deq_multi(ring_spsc, (void **)buf_hdr, num);
+	num_deq = ring_spsc_deq_multi(ring_spsc, (void **)buf_hdr, num);
+
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, spsc_queue_depth);
+
+	return num_deq;
 }
 
 static int queue_spsc_enq_multi(odp_queue_t handle, odp_buffer_hdr_t *buf_hdr[],
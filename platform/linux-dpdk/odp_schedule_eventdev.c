@@ -312,6 +312,14 @@ void rx_adapter_port_stop(uint16_t port_id)
 {
 	uint8_t rx_adapter_id = eventdev_gbl->rx_adapter.id;
 
+	/* Stop expiry polling before reassembly tables are freed */
+	odp_ticketlock_lock(&eventdev_gbl->rx_adapter.lock);
+	if (eventdev_gbl->reass_port[port_id]) {
+		eventdev_gbl->reass_port[port_id] = 0;
+		odp_atomic_dec_u32(&eventdev_gbl->num_reass_ports);
+	}
+	odp_ticketlock_unlock(&eventdev_gbl->rx_adapter.lock);
+
 	if (rte_event_eth_rx_adapter_queue_del(rx_adapter_id, port_id, -1))
 		ODP_ERR("Failed to delete RX queue\n");
 
@@ -435,6 +443,13 @@ static void schedule_pktio_start(int pktio_index, int num_pktin,
 				  queue))
 		ODP_ABORT("Adding RX adapter queues failed\n");
 
+	if ((entry->s.config.reassembly.en_ipv4 ||
+	     entry->s.config.reassembly.en_ipv6) &&
+	    !eventdev_gbl->reass_port[port_id]) {
+		eventdev_gbl->reass_port[port_id] = 1;
+		odp_atomic_inc_u32(&eventdev_gbl->num_reass_ports);
+	}
+
 	if (eventdev_gbl->rx_adapter.status == RX_ADAPTER_STOPPED) {
 		uint32_t service_id = 0;
 		int ret;
@@ -563,7 +578,7 @@ static inline uint16_t event_input(struct rte_event ev[], odp_event_t out_ev[],
 	if (num_pkts) {
 		pktio_entry_t *entry = eventdev_gbl->pktio[pkt_table[0]->port];
 
-		num_pkts = input_pkts(entry, (odp_packet_t *)pkt_table,
+		num_pkts = input_pkts(entry, -1, (odp_packet_t *)pkt_table,
 				      num_pkts);
 
 		if (!odp_global_ro.init_param.not_used.feat.cls)
@@ -580,6 +595,52 @@ static inline uint16_t event_input(struct rte_event ev[], odp_event_t out_ev[],
 	return num_events;
 }
 
+/* The RX adapter passes only received packets to the scheduler, so IP
+ * fragments held for reassembly would not time out on an idle port. Output
+ * expired fragments into the first pktin event queue on scheduler polls.
+ * Only one thread polls at a time, others skip. */
+static void reass_run(void)
+{
+	uint16_t port_id;
+
+	if (odp_likely(!odp_atomic_load_u32(&eventdev_gbl->num_reass_ports)))
+		return;
+
+	if (!odp_ticketlock_trylock(&eventdev_gbl->rx_adapter.lock))
+		return;
+
+	for (port_id = 0; port_id < RTE_MAX_ETHPORTS; port_id++) {
+		pktio_entry_t *entry = eventdev_gbl->pktio[port_id];
+		odp_packet_t pkt_table[MAX_SCHED_BURST];
+		odp_event_t ev[MAX_SCHED_BURST];
+		int i, num, ret;
+
+		if (!eventdev_gbl->reass_port[port_id])
+			continue;
+
+		num = input_pkts_reass_expired(entry, pkt_table,
+					       MAX_SCHED_BURST);
+
+		if (num && !odp_global_ro.init_param.not_used.feat.cls)
+			num = classify_pkts(pkt_table, num);
+
+		if (num == 0)
+			continue;
+
+		for (i = 0; i < num; i++)
+			ev[i] = odp_packet_to_event(pkt_table[i]);
+
+		ret = odp_queue_enq_multi(entry->s.in_queue[0].queue, ev, num);
+		if (ret < 0)
+			ret = 0;
+
+		if (ret < num)
+			odp_event_free_multi(&ev[ret], num - ret);
+	}
+
+	odp_ticketlock_unlock(&eventdev_gbl->rx_adapter.lock);
+}
+
 /* Fetch consecutive events from the same queue from cache */
 static inline uint16_t input_cached(odp_event_t out_ev[], unsigned int max_num,
 				    odp_queue_t *out_queue)
@@ -640,6 +701,7 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 				num_deq = event_input(ev, out_ev, num_deq,
 						      out_queue);
 				timer_run(2);
+				reass_run();
 				/* Classifier may enqueue events back to
 				 * eventdev */
 				if (odp_unlikely(num_deq == 0))
@@ -647,6 +709,7 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 				break;
 			}
 			timer_run(1);
+			reass_run();
 
 			if (wait == ODP_SCHED_WAIT)
 				continue;
@@ -992,6 +1055,13 @@ static void order_unlock(void)
 {
 }
 
+/* Event device restores order on enqueue, order_lock() does not
+ * synchronize */
+static int schedule_ordered(void)
+{
+	return 0;
+}
+
 static int schedule_capability(odp_schedule_capability_t *capa)
 {
 	uint16_t max_sched;
@@ -1047,7 +1117,8 @@ const schedule_fn_t schedule_eventdev_fn = {
 	.order_lock = order_lock,
 	.order_unlock = order_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
-	.get_config = NULL
+	.get_config = NULL,
+	.ordered = schedule_ordered
 };
 
 /* Fill in scheduler API calls */
@@ -18,6 +18,7 @@
 #include <odp_queue_if.h>
 #include <odp_ring_u32_internal.h>
 #include <odp_timer_internal.h>
+#include <odp_trace_internal.h>
 
 #include <rte_cycles.h>
 #include <rte_timer.h>
@@ -239,7 +240,9 @@ void _timer_run_inline(int dec)
 	}
 
 	/* Check timer pools */
+	_ODP_TRACE_BEGIN(_ODP_TRACE_TIMER_RUN, 0);
 	rte_timer_manage();
+	_ODP_TRACE_END(_ODP_TRACE_TIMER_RUN, 0);
 }
 
 static inline uint64_t tmo_ticks_to_ns_round_up(uint64_t tmo_ticks)
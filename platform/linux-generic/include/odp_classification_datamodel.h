@@ -20,6 +20,7 @@ extern "C" {
 
 #include <odp/api/spinlock.h>
 #include <odp/api/classification.h>
+#include <odp/api/thread.h>
 #include <odp_pool_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
@@ -45,9 +46,13 @@ extern "C" {
 /* Max PMR Term size */
 #define MAX_PMR_TERM_SIZE		16
 /* Max queue per Class of service */
-#define CLS_COS_QUEUE_MAX		32
-/* Max number of implementation created queues */
-#define CLS_QUEUE_GROUP_MAX		(CLS_COS_MAX_ENTRY * CLS_COS_QUEUE_MAX)
+#define CLS_COS_QUEUE_MAX		4096
+/* Max number of implementation created queues. Queue group table entries
+ * are shared by all CoS. */
+#define CLS_QUEUE_GROUP_MAX		8192
+/* Number of rule sets. Each CoS with PMRs uses one, others are retired sets
+ * waiting for reclaim or free. */
+#define CLS_RULE_SET_MAX		(4 * CLS_COS_MAX_ENTRY)
 
 typedef union {
 	/* All proto fileds */
@@ -119,22 +124,38 @@ typedef struct pmr_term_value {
 
 } pmr_term_value_t;
 
+/*
+Rule set
+
+PMRs attached to a CoS and their destination CoS in matching order. A rule set
+is not modified after it has been published to readers. Updates publish a new
+set and retire the old one, which is reclaimed after all threads have left
+the epoch it was retired in.
+*/
+typedef struct cls_rule_set_s {
+	uint32_t num_rule;		/* Number of PMRs in the set */
+	uint32_t used;			/* Set is allocated */
+	uint64_t retire_epoch;		/* Epoch when retired, or 0 */
+	union pmr_u *pmr[CLS_PMR_PER_COS_MAX];	/* Chained PMR */
+	union cos_u *linked_cos[CLS_PMR_PER_COS_MAX]; /* Chained CoS with PMR*/
+} cls_rule_set_t;
+
 /*
 Class Of Service
 */
 struct cos_s {
 	odp_queue_t queue;			/* Associated Queue */
 	odp_pool_t pool;		/* Associated Buffer pool */
-	union pmr_u *pmr[CLS_PMR_PER_COS_MAX];	/* Chained PMR */
-	union cos_u *linked_cos[CLS_PMR_PER_COS_MAX]; /* Chained CoS with PMR*/
+	cls_rule_set_t *rules;		/* Attached PMRs, NULL when none */
+	uint64_t retire_epoch;		/* Epoch when destroyed, or 0 */
 	uint32_t valid;			/* validity Flag */
 	odp_cls_drop_t drop_policy;	/* Associated Drop Policy */
 	size_t headroom;		/* Headroom for this CoS */
 	odp_spinlock_t lock;		/* cos lock */
-	odp_atomic_u32_t num_rule;	/* num of PMRs attached with this CoS */
 	bool queue_group;
 	odp_cls_hash_proto_t hash_proto;
 	uint32_t num_queue;
+	uint32_t queue_grp_base;	/* First queue group table index */
 	odp_queue_param_t queue_param;
 	char name[ODP_COS_NAME_LEN];	/* name */
 	uint8_t index;
@@ -151,8 +172,9 @@ Packet Matching Rule
 **/
 struct pmr_s {
 	uint32_t valid;			/* Validity Flag */
-	odp_atomic_u32_t count;		/* num of packets matching this rule */
+	uint32_t index;			/* Index in PMR table */
 	uint32_t num_pmr;		/* num of PMR Term Values*/
+	uint64_t retire_epoch;		/* Epoch when destroyed, or 0 */
 	odp_spinlock_t lock;		/* pmr lock*/
 	cos_t *src_cos;			/* source CoS where PMR is attached */
 	pmr_term_value_t  pmr_term_value[CLS_PMRTERM_MAX];
@@ -166,6 +188,8 @@ typedef union pmr_u {
 
 typedef struct _cls_queue_grp_tbl_s {
 	odp_queue_t queue[CLS_QUEUE_GROUP_MAX];
+	uint8_t used[CLS_QUEUE_GROUP_MAX];	/* Entry reserved by a CoS */
+	odp_spinlock_t lock;			/* Protects used[] */
 } _cls_queue_grp_tbl_s;
 
 typedef union _cls_queue_grp_tbl_t {
@@ -209,8 +233,36 @@ typedef struct classifier {
 	pmr_l3_cos_t l3_cos_table;	/* L3 Qos-CoS table map */
 	size_t headroom;		/* Pktio Headroom */
 	size_t skip;			/* Pktio Skip Offset */
+	odp_cls_hash_proto_t input_hash_proto;	/* Pktin flow hash fields */
 } classifier_t;
 
+/**
+Per thread classification statistics
+
+Each thread updates only its own counters, reads sum up counters of all
+threads.
+**/
+typedef struct ODP_ALIGNED_CACHE cls_thr_stats_t {
+	struct {
+		uint64_t packets;
+		uint64_t octets;
+		uint64_t discards;
+	} cos[CLS_COS_MAX_ENTRY];
+
+	uint64_t pmr_hits[CLS_PMR_MAX_ENTRY];
+} cls_thr_stats_t;
+
+/**
+Per thread classification epoch
+
+Thread stores the current global epoch when it starts to classify a packet,
+and zero when done. Retired rule sets, PMRs and CoS may be reused when no
+thread is in the epoch they were retired in, or in an older one.
+**/
+typedef struct ODP_ALIGNED_CACHE cls_thr_epoch_t {
+	odp_atomic_u64_t epoch;
+} cls_thr_epoch_t;
+
 /**
 Class of Service Table
 **/
@@ -48,6 +48,27 @@ This function should be called during pktio initialization.
 **/
 int pktio_classifier_init(pktio_entry_t *pktio);
 
+/**
+Set packet input flow hash protocols
+
+Pktio drivers that store a flow hash (e.g. NIC RSS hash) into packets before
+classification report with this function which header fields the hash
+covers. The classifier uses the flow hash instead of calculating a software
+hash for CoS queue groups that hash over the same fields.
+**/
+void _odp_cls_input_hash_proto_set(pktio_entry_t *entry,
+				   const odp_pktin_hash_proto_t *hash_proto);
+
+/**
+Enter and leave packet input classification section
+
+Packet input calls these around receiving and enqueueing classified packets.
+Destination queues selected by the classifier remain valid until
+_odp_cls_input_end().
+**/
+void _odp_cls_input_begin(void);
+void _odp_cls_input_end(void);
+
 #ifdef __cplusplus
 }
 #endif
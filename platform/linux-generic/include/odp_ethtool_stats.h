@@ -19,6 +19,24 @@ extern "C" {
  */
 int ethtool_stats_get_fd(int fd, const char *name, odp_pktio_stats_t *stats);
 
+/**
+ * Get ethtool statistics counter names
+ */
+int ethtool_extra_stat_info_fd(int fd, const char *name,
+			       odp_pktio_extra_stat_info_t info[], int num);
+
+/**
+ * Get ethtool statistics counter values
+ */
+int ethtool_extra_stats_fd(int fd, const char *name, uint64_t stats[],
+			   int num);
+
+/**
+ * Get ethtool statistics counter value
+ */
+int ethtool_extra_stat_counter_fd(int fd, const char *name, uint32_t id,
+				  uint64_t *stat);
+
 #ifdef __cplusplus
 }
 #endif
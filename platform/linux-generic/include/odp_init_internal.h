@@ -99,6 +99,11 @@ int _odp_hash_term_global(void);
 int _odp_stash_init_global(void);
 int _odp_stash_term_global(void);
 
+int _odp_trace_init_global(void);
+int _odp_trace_term_global(void);
+int _odp_trace_init_local(void);
+int _odp_trace_term_local(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,9 +87,9 @@ int _odp_ipsec_status_send(odp_queue_t queue,
 #define IPSEC_ANTIREPLAY_WS	32
 
 /**
- * Maximum number of available SAs
+ * Maximum number of available SAs (must be power of 2)
  */
-#define ODP_CONFIG_IPSEC_SAS	8
+#define ODP_CONFIG_IPSEC_SAS	4096
 
 struct ipsec_sa_s {
 	odp_atomic_u32_t ODP_ALIGNED_CACHE state;
@@ -121,6 +121,9 @@ struct ipsec_sa_s {
 	uint32_t	ipsec_sa_idx;
 	odp_ipsec_sa_t	ipsec_sa_hdl;
 
+	/* Incremented on every create, tags per-thread SA state */
+	uint32_t	gen;
+
 	odp_ipsec_protocol_t proto;
 	uint32_t	spi;
 
@@ -271,6 +274,27 @@ int _odp_ipsec_sa_replay_precheck(ipsec_sa_t *ipsec_sa, uint32_t seq,
 int _odp_ipsec_sa_replay_update(ipsec_sa_t *ipsec_sa, uint32_t seq,
 				odp_ipsec_op_status_t *status);
 
+/**
+ * Allocate an outbound sequence number for a packet.
+ *
+ * Sequence numbers are taken from a thread-local block when one is
+ * available. Otherwise a new block is reserved from the SA.
+ */
+uint64_t _odp_ipsec_sa_next_seq(ipsec_sa_t *ipsec_sa);
+
+/**
+ * Start a burst of outbound packets to the SA.
+ *
+ * Sequence numbers for the next num packets of the calling thread are
+ * reserved at once when the next sequence number is allocated.
+ */
+void _odp_ipsec_sa_seq_burst_start(ipsec_sa_t *ipsec_sa, uint32_t num);
+
+/**
+ * End a burst of outbound packets to the SA.
+ */
+void _odp_ipsec_sa_seq_burst_end(ipsec_sa_t *ipsec_sa);
+
 /**
   * Allocate an IPv4 ID for an outgoing packet.
   */
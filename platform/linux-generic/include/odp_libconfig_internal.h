@@ -22,6 +22,8 @@ int _odp_libconfig_term_global(void);
 
 int _odp_libconfig_lookup_int(const char *path, int *value);
 int _odp_libconfig_lookup_array(const char *path, int value[], int max_num);
+int _odp_libconfig_lookup_str(const char *path, char *value,
+			      unsigned int str_size);
 
 int _odp_libconfig_lookup_ext_int(const char *base_path,
 				  const char *local_path,
@@ -30,6 +30,7 @@ extern "C" {
 #include <odp_ipsec_internal.h>
 #include <odp/api/abi/packet.h>
 #include <odp_queue_if.h>
+#include <odp_packet_tunnel_internal.h>
 
 #include <stdint.h>
 
@@ -60,6 +61,9 @@ typedef struct {
 
 	/* offset to L4 hdr (TCP, UDP, SCTP, also ICMP) */
 	uint16_t l4_offset;
+
+	/* Tunnel and inner headers, valid when input_flags.tunnel is set */
+	packet_tunnel_t tunnel;
 } packet_parser_t;
 
 /* Packet extra data length */
@@ -123,6 +127,10 @@ typedef struct odp_packet_hdr_t {
 	/* Flow hash value */
 	uint32_t flow_hash;
 
+	/* LSO options, valid when flags.lso is set */
+	uint16_t lso_payload_offset;
+	uint16_t lso_max_payload;
+
 	union {
 		struct {
 			/* Result for crypto packet op */
@@ -328,6 +336,16 @@ static inline void packet_set_flow_hash(odp_packet_hdr_t *pkt_hdr,
 	pkt_hdr->p.input_flags.flow_hash = 1;
 }
 
+static inline int packet_hdr_has_flow_hash(odp_packet_hdr_t *pkt_hdr)
+{
+	return pkt_hdr->p.input_flags.flow_hash;
+}
+
+static inline uint32_t packet_hdr_flow_hash(odp_packet_hdr_t *pkt_hdr)
+{
+	return pkt_hdr->flow_hash;
+}
+
 static inline void packet_set_ts(odp_packet_hdr_t *pkt_hdr, odp_time_t *ts)
 {
 	if (ts != NULL) {
@@ -353,6 +371,14 @@ int _odp_packet_tcp_chksum_insert(odp_packet_t pkt);
 int _odp_packet_udp_chksum_insert(odp_packet_t pkt);
 int _odp_packet_sctp_chksum_insert(odp_packet_t pkt);
 
+/* Split an IPv4 or IPv6 packet into fragments of at most 'mtu' bytes
+ * (counted from the IP header). Data preceding the IP header is copied into
+ * every fragment. Returns the number of fragments, or <0 when the packet
+ * cannot be fragmented into at most 'max_frags' fragments. The original
+ * packet is not modified and remains owned by the caller. */
+int _odp_packet_ip_fragment(odp_packet_t pkt, uint32_t l3_offset,
+			    uint32_t mtu, odp_packet_t frag[], int max_frags);
+
 #ifdef __cplusplus
 }
 #endif
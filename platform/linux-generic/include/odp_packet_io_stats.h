@@ -24,6 +24,14 @@ int sock_stats_reset_fd(pktio_entry_t *pktio_entry, int fd);
 
 pktio_stats_type_t sock_stats_type_fd(pktio_entry_t *pktio_entry, int fd);
 
+int sock_extra_stat_info_fd(pktio_entry_t *pktio_entry,
+			    odp_pktio_extra_stat_info_t info[], int num,
+			    int fd);
+int sock_extra_stats_fd(pktio_entry_t *pktio_entry, uint64_t stats[], int num,
+			int fd);
+int sock_extra_stat_counter_fd(pktio_entry_t *pktio_entry, uint32_t id,
+			       uint64_t *stat, int fd);
+
 #ifdef __cplusplus
 }
 #endif
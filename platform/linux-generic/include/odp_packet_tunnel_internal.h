@@ -0,0 +1,145 @@
+/* Copyright (c) 2020, Nokia
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP tunnel parser - implementation internal
+ */
+
+#ifndef ODP_PACKET_TUNNEL_INTERNAL_H_
+#define ODP_PACKET_TUNNEL_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/byteorder.h>
+#include <odp/api/plat/byteorder_inlines.h>
+#include <odp/api/plat/packet_inline_types.h>
+
+#include <protocols/ip.h>
+#include <protocols/tunnel.h>
+#include <protocols/udp.h>
+
+#include <stdint.h>
+
+/* Tunnel types */
+#define PACKET_TUNNEL_NONE   0
+#define PACKET_TUNNEL_VXLAN  1
+#define PACKET_TUNNEL_GENEVE 2
+#define PACKET_TUNNEL_GRE    3
+#define PACKET_TUNNEL_GTPU   4
+
+/**
+ * Tunnel parser metadata
+ *
+ * Valid only when outer input_flags.tunnel is set. Offsets are from the
+ * start of the packet.
+ */
+typedef struct {
+	/* Inner packet input flags */
+	_odp_packet_input_flags_t input_flags;
+
+	/* VXLAN/GENEVE VNI, NVGRE VSID, GRE key or GTP-U TEID */
+	uint32_t id;
+
+	/* Offset to inner L2 hdr. Equals l3_offset when there is no inner
+	 * Ethernet header (e.g. GTP-U). */
+	uint16_t l2_offset;
+
+	/* Offset to inner L3 hdr */
+	uint16_t l3_offset;
+
+	/* Offset to inner L4 hdr */
+	uint16_t l4_offset;
+
+	/* PACKET_TUNNEL_XXX */
+	uint8_t type;
+} packet_tunnel_t;
+
+/**
+ * Inner headers recognized by packet input HW
+ */
+typedef struct {
+	/* Inner L4 protocol, _ODP_IPPROTO_FRAG for an inner IP fragment, or 0
+	 * when not known. Given only when the inner IP header has no IPv6
+	 * extension headers. */
+	uint8_t l4;
+
+	/* Inner IP header length when it has no options or extension headers
+	 * (_ODP_IPV4HDR_LEN or _ODP_IPV6HDR_LEN), or 0 when not known */
+	uint8_t l3_len;
+
+	/* Inner Ethernet header recognized */
+	uint8_t eth;
+
+	/* Number of inner VLAN tags (0-2) after the inner Ethernet header */
+	uint8_t vlan;
+} packet_tunnel_hint_t;
+
+/**
+ * Detect tunnel type from outer IP protocol and UDP destination port
+ *
+ * @param l4            Pointer to outer L4 header
+ * @param len           Number of contiguous bytes available from 'l4'
+ * @param ip_proto      Outer IP protocol
+ *
+ * @return PACKET_TUNNEL_XXX
+ */
+static inline uint8_t _odp_packet_tunnel_detect(const uint8_t *l4,
+						uint32_t len, uint8_t ip_proto)
+{
+	const _odp_udphdr_t *udp;
+
+	if (ip_proto == _ODP_IPPROTO_GRE)
+		return PACKET_TUNNEL_GRE;
+
+	if (ip_proto != _ODP_IPPROTO_UDP || len < _ODP_UDPHDR_LEN)
+		return PACKET_TUNNEL_NONE;
+
+	udp = (const _odp_udphdr_t *)(uintptr_t)l4;
+
+	switch (odp_be_to_cpu_16(udp->dst_port)) {
+	case _ODP_UDP_VXLAN_PORT:
+		return PACKET_TUNNEL_VXLAN;
+	case _ODP_UDP_GENEVE_PORT:
+		return PACKET_TUNNEL_GENEVE;
+	case _ODP_UDP_GTPU_PORT:
+		return PACKET_TUNNEL_GTPU;
+	default:
+		return PACKET_TUNNEL_NONE;
+	}
+}
+
+/**
+ * Parse tunnel and inner packet headers
+ *
+ * Parses the tunnel header following the outer UDP or GRE header and the
+ * inner L2-L4 headers. Only the first 'len' bytes from 'l4' are read, so
+ * inner headers outside of the first segment are left unparsed.
+ *
+ * @param[out] tun      Tunnel metadata
+ * @param l4            Pointer to outer L4 (UDP/GRE) header
+ * @param l4_offset     Offset to outer L4 header from packet start
+ * @param len           Number of contiguous bytes available from 'l4'
+ * @param type          Tunnel type (PACKET_TUNNEL_XXX other than NONE)
+ * @param hint          Inner headers recognized by packet input HW, or NULL.
+ *                      When all inner headers are recognized, inner headers
+ *                      are not read.
+ *
+ * @retval 1 Tunnel and at least inner L3 header parsed
+ * @retval 0 Not a valid tunnel packet
+ */
+int _odp_packet_parse_tunnel(packet_tunnel_t *tun, const uint8_t *l4,
+			     uint32_t l4_offset, uint32_t len, uint8_t type,
+			     const packet_tunnel_hint_t *hint);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -52,6 +52,7 @@ typedef void (*schedule_order_unlock_lock_fn_t)(void);
 typedef void (*schedule_order_lock_start_fn_t)(void);
 typedef void (*schedule_order_lock_wait_fn_t)(void);
 typedef uint32_t (*schedule_max_ordered_locks_fn_t)(void);
+typedef int (*schedule_ordered_fn_t)(void);
 typedef void (*schedule_get_config_fn_t)(schedule_config_t *config);
 
 typedef struct schedule_fn_t {
@@ -74,6 +75,9 @@ typedef struct schedule_fn_t {
 	schedule_order_unlock_lock_fn_t  order_unlock_lock;
 	schedule_max_ordered_locks_fn_t max_ordered_locks;
 	schedule_get_config_fn_t        get_config;
+	/* Returns non-zero when the thread holds an ordered context, which
+	 * order_lock() synchronizes */
+	schedule_ordered_fn_t           ordered;
 
 } schedule_fn_t;
 
@@ -0,0 +1,120 @@
+/* Copyright (c) 2020, Nokia
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Datapath tracepoints
+ *
+ * Tracepoints store CPU cycle stamped events into per thread rings, which
+ * are written into a Chrome trace event format (JSON) file on global
+ * termination. Tracepoints are compiled in with --enable-trace configure
+ * option and enabled at runtime with the trace.enable config file option.
+ * When compiled out, tracepoint macros expand to nothing and their
+ * arguments are not evaluated. When compiled in but disabled at runtime,
+ * a tracepoint costs a thread local pointer check.
+ */
+
+#ifndef ODP_TRACE_INTERNAL_H_
+#define ODP_TRACE_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/autoheader_internal.h>
+#include <odp/api/cpu.h>
+#include <odp/api/hints.h>
+
+#include <stdint.h>
+
+/* Tracepoint identifiers. Update tracepoint names in odp_trace.c when
+ * adding new ones. */
+typedef enum {
+	_ODP_TRACE_SCHED_POLL_PKTIN = 0,
+	_ODP_TRACE_SCHED_ORDER_WAIT,
+	_ODP_TRACE_QUEUE_ENQ,
+	_ODP_TRACE_PKTIN_RECV,
+	_ODP_TRACE_PKTOUT_SEND,
+	_ODP_TRACE_TIMER_RUN,
+	_ODP_TRACE_CRYPTO_DEQ,
+	_ODP_TRACE_TM_ENQ,
+	_ODP_TRACE_TM_EGRESS,
+	_ODP_TRACE_NUM
+} _odp_trace_id_t;
+
+/* Event types */
+#define _ODP_TRACE_TYPE_BEGIN   0
+#define _ODP_TRACE_TYPE_END     1
+#define _ODP_TRACE_TYPE_INSTANT 2
+
+typedef struct {
+	uint64_t cycles;
+	uint16_t id;
+	uint8_t  type;
+	uint8_t  pad;
+	uint32_t arg;
+
+} _odp_trace_event_t;
+
+typedef struct {
+	/* Event ring of this thread, NULL when tracing is disabled */
+	_odp_trace_event_t *ev;
+
+	/* Number of events written. Stored in shared memory, so that ring
+	 * contents can be dumped after the thread has exited. */
+	uint64_t *idx;
+
+	uint32_t mask;
+
+} _odp_trace_local_t;
+
+extern __thread _odp_trace_local_t _odp_trace_local;
+
+static inline void _odp_trace_record(uint16_t id, uint8_t type, uint32_t arg)
+{
+	_odp_trace_event_t *ev;
+	uint64_t idx;
+
+	if (odp_likely(_odp_trace_local.ev == NULL))
+		return;
+
+	/* Single writer per ring, the oldest events are overwritten */
+	idx = *_odp_trace_local.idx;
+	ev = &_odp_trace_local.ev[idx & _odp_trace_local.mask];
+	ev->cycles = odp_cpu_cycles();
+	ev->id     = id;
+	ev->type   = type;
+	ev->arg    = arg;
+	*_odp_trace_local.idx = idx + 1;
+}
+
+#if defined(_ODP_TRACE) && _ODP_TRACE == 1
+
+/* Start and end of a traced code section */
+#define _ODP_TRACE_BEGIN(id, arg) \
+	_odp_trace_record(id, _ODP_TRACE_TYPE_BEGIN, arg)
+
+#define _ODP_TRACE_END(id, arg) \
+	_odp_trace_record(id, _ODP_TRACE_TYPE_END, arg)
+
+/* Single event without duration */
+#define _ODP_TRACE_EVENT(id, arg) \
+	_odp_trace_record(id, _ODP_TRACE_TYPE_INSTANT, arg)
+
+#else
+
+#define _ODP_TRACE_BEGIN(id, arg) do { } while (0)
+#define _ODP_TRACE_END(id, arg)   do { } while (0)
+#define _ODP_TRACE_EVENT(id, arg) do { } while (0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -19,6 +19,8 @@ extern "C" {
 
 #include <odp_api.h>
 
+#include <string.h>
+
 /** @addtogroup odp_header ODP HEADER
  *  @{
  */
@@ -65,6 +67,9 @@ extern "C" {
 /** @internal Returns IPv4 more fragments */
 #define _ODP_IPV4HDR_FLAGS_MORE_FRAGS(frag_offset)  ((frag_offset) & 0x2000)
 
+/** @internal IPv4 more fragments flag */
+#define _ODP_IPV4HDR_MORE_FRAGS 0x2000
+
 /** @internal Returns IPv4 fragment offset */
 #define _ODP_IPV4HDR_FRAG_OFFSET(frag_offset) ((frag_offset) & 0x1fff)
 
@@ -89,6 +94,53 @@ typedef struct ODP_PACKED {
 ODP_STATIC_ASSERT(sizeof(_odp_ipv4hdr_t) == _ODP_IPV4HDR_LEN,
 		  "_ODP_IPV4HDR_T__SIZE_ERROR");
 
+/** Max length of IPv4 options */
+#define _ODP_IPV4HDR_OPTS_MAX 40
+
+/** @internal IPv4 end of option list */
+#define _ODP_IPV4OPT_EOL 0
+
+/** @internal IPv4 no operation option */
+#define _ODP_IPV4OPT_NOP 1
+
+/** @internal Returns true if option is copied into all fragments */
+#define _ODP_IPV4OPT_COPIED(type) ((type) & 0x80)
+
+/**
+ * @internal Convert IPv4 options of the first fragment into options of
+ * the following fragments
+ *
+ * Options without the copied flag are replaced with NOP options, so that
+ * header length stays the same. Malformed options are replaced entirely.
+ */
+static inline void _odp_ipv4_opts_frag(uint8_t *opt, uint32_t len)
+{
+	uint32_t i = 0;
+
+	while (i < len) {
+		uint8_t type = opt[i];
+		uint32_t opt_len;
+
+		if (type == _ODP_IPV4OPT_EOL)
+			break;
+
+		if (type == _ODP_IPV4OPT_NOP) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 < len && opt[i + 1] >= 2 && i + opt[i + 1] <= len)
+			opt_len = opt[i + 1];
+		else
+			opt_len = len - i;
+
+		if (!_ODP_IPV4OPT_COPIED(type))
+			memset(&opt[i], _ODP_IPV4OPT_NOP, opt_len);
+
+		i += opt_len;
+	}
+}
+
 /** IPv6 version */
 #define _ODP_IPV6 6
 
@@ -153,6 +205,29 @@ typedef struct ODP_PACKED {
 	uint8_t    filler[6];    /**< Fill out first 8 byte segment */
 } _odp_ipv6hdr_ext_t;
 
+/** IPv6 fragment header length */
+#define _ODP_IPV6HDR_FRAG_LEN 8
+
+/** @internal Returns IPv6 fragment offset in bytes */
+#define _ODP_IPV6HDR_FRAG_OFFSET(frag_offset) ((frag_offset) & 0xfff8)
+
+/** @internal Returns IPv6 more fragments flag */
+#define _ODP_IPV6HDR_FRAG_MORE(frag_offset) ((frag_offset) & 0x1)
+
+/**
+ * IPv6 fragment extension header
+ */
+typedef struct ODP_PACKED {
+	uint8_t     next_hdr;    /**< Protocol of next header */
+	uint8_t     reserved;    /**< Reserved */
+	odp_u16be_t frag_offset; /**< Fragment offset and more fragments flag */
+	odp_u32be_t id;          /**< Identification */
+} _odp_ipv6hdr_frag_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(_odp_ipv6hdr_frag_t) == _ODP_IPV6HDR_FRAG_LEN,
+		  "_ODP_IPV6HDR_FRAG_T__SIZE_ERROR");
+
 /** @name
  * IP protocol values (IPv4:'proto' or IPv6:'next_hdr')
  * @{*/
@@ -164,6 +239,7 @@ typedef struct ODP_PACKED {
 #define _ODP_IPPROTO_IPV6    0x29 /**< IPv6 Routing header (41) */
 #define _ODP_IPPROTO_ROUTE   0x2B /**< IPv6 Routing header (43) */
 #define _ODP_IPPROTO_FRAG    0x2C /**< IPv6 Fragment (44) */
+#define _ODP_IPPROTO_GRE     0x2F /**< Generic Routing Encapsulation (47) */
 #define _ODP_IPPROTO_AH      0x33 /**< Authentication Header (51) */
 #define _ODP_IPPROTO_ESP     0x32 /**< Encapsulating Security Payload (50) */
 #define _ODP_IPPROTO_ICMPV6  0x3A /**< Internet Control Message Protocol (58) */
@@ -0,0 +1,125 @@
+/* Copyright (c) 2020, Nokia
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP tunnel (VXLAN, GENEVE, GRE, GTP-U) headers
+ */
+
+#ifndef ODP_TUNNEL_H_
+#define ODP_TUNNEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp_api.h>
+
+/** @addtogroup odp_header ODP HEADER
+ *  @{
+ */
+
+/** UDP destination ports of UDP based tunnels */
+#define _ODP_UDP_VXLAN_PORT  4789
+#define _ODP_UDP_GENEVE_PORT 6081
+#define _ODP_UDP_GTPU_PORT   2152
+
+/** VXLAN header length */
+#define _ODP_VXLANHDR_LEN 8
+
+/** VXLAN flags: VNI is valid */
+#define _ODP_VXLAN_FLAGS_VNI 0x08000000
+
+/** VXLAN header */
+typedef struct ODP_PACKED {
+	odp_u32be_t flags;   /**< Flags (I bit) and reserved bits */
+	odp_u32be_t vni;     /**< VNI in upper 24 bits, reserved lower 8 */
+} _odp_vxlanhdr_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(_odp_vxlanhdr_t) == _ODP_VXLANHDR_LEN,
+		  "_ODP_VXLANHDR_T__SIZE_ERROR");
+
+/** GENEVE header length (no options) */
+#define _ODP_GENEVEHDR_LEN 8
+
+/** GENEVE version number (upper two bits) */
+#define _ODP_GENEVEHDR_VER(ver_optlen) ((ver_optlen) >> 6)
+
+/** GENEVE options length in bytes */
+#define _ODP_GENEVEHDR_OPTLEN(ver_optlen) (((ver_optlen) & 0x3f) * 4)
+
+/** GENEVE header */
+typedef struct ODP_PACKED {
+	uint8_t     ver_optlen; /**< Version (2 bits), options length (6 bits) */
+	uint8_t     flags;      /**< O and C flags, reserved bits */
+	odp_u16be_t proto;      /**< Protocol type of the inner header */
+	odp_u32be_t vni;        /**< VNI in upper 24 bits, reserved lower 8 */
+} _odp_genevehdr_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(_odp_genevehdr_t) == _ODP_GENEVEHDR_LEN,
+		  "_ODP_GENEVEHDR_T__SIZE_ERROR");
+
+/** GRE header length (no optional fields) */
+#define _ODP_GREHDR_LEN 4
+
+/** GRE flags */
+#define _ODP_GRE_FLAG_CSUM 0x8000 /**< Checksum present */
+#define _ODP_GRE_FLAG_KEY  0x2000 /**< Key present */
+#define _ODP_GRE_FLAG_SEQ  0x1000 /**< Sequence number present */
+#define _ODP_GRE_VER_MASK  0x0007 /**< Version number */
+
+/** GRE protocol value for transparent Ethernet bridging (NVGRE) */
+#define _ODP_GRE_PROTO_TEB 0x6558
+
+/** GRE header */
+typedef struct ODP_PACKED {
+	odp_u16be_t flags_ver; /**< Flags and version */
+	odp_u16be_t proto;     /**< Protocol type of the inner header */
+} _odp_grehdr_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(_odp_grehdr_t) == _ODP_GREHDR_LEN,
+		  "_ODP_GREHDR_T__SIZE_ERROR");
+
+/** GTP-U header length (no optional fields) */
+#define _ODP_GTPUHDR_LEN 8
+
+/** GTP-U header length when any of E, S or PN flags is set */
+#define _ODP_GTPUHDR_OPT_LEN 12
+
+/** GTP-U flags */
+#define _ODP_GTPU_FLAG_VER_MASK 0xe0 /**< Version */
+#define _ODP_GTPU_FLAG_VER1     0x20 /**< Version 1 */
+#define _ODP_GTPU_FLAG_PT       0x10 /**< Protocol type GTP */
+#define _ODP_GTPU_FLAG_OPT      0x07 /**< E, S or PN flag */
+
+/** GTP-U message type of user data (G-PDU) */
+#define _ODP_GTPU_MSG_GPDU 0xff
+
+/** GTP-U header */
+typedef struct ODP_PACKED {
+	uint8_t     flags;    /**< Version, PT, E, S and PN flags */
+	uint8_t     msg_type; /**< Message type */
+	odp_u16be_t length;   /**< Length of payload after mandatory header */
+	odp_u32be_t teid;     /**< Tunnel endpoint identifier */
+} _odp_gtpuhdr_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(_odp_gtpuhdr_t) == _ODP_GTPUHDR_LEN,
+		  "_ODP_GTPUHDR_T__SIZE_ERROR");
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -21,6 +21,7 @@ AM_CONDITIONAL([ODP_PKTIO_PCAP], [test x$have_pcap = xyes])
 
 m4_include([platform/linux-generic/m4/odp_libconfig.m4])
 m4_include([platform/linux-generic/m4/odp_pcapng.m4])
+m4_include([platform/linux-generic/m4/odp_trace.m4])
 m4_include([platform/linux-generic/m4/odp_netmap.m4])
 m4_include([platform/linux-generic/m4/odp_dpdk.m4])
 ODP_SCHEDULER
@@ -32,6 +33,7 @@ AS_VAR_APPEND([PLAT_DEP_LIBS], ["${LIBCONFIG_LIBS} ${OPENSSL_LIBS} ${DPDK_LIBS_L
 AS_VAR_APPEND([PLAT_CFG_TEXT], ["
 	pcap:			${have_pcap}
 	pcapng:			${have_pcapng}
+	trace:			${have_trace}
 	default_config_path:	${default_config_path}"])
 
 AC_CONFIG_COMMANDS_PRE([dnl
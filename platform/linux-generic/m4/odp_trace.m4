@@ -0,0 +1,16 @@
+##########################################################################
+# Enable datapath tracepoints
+##########################################################################
+have_trace=no
+trace_support=0
+
+AC_ARG_ENABLE([trace],
+	[AS_HELP_STRING([--enable-trace],
+	[enable datapath tracepoints, see trace options in the config file [default=disabled]])],
+	have_trace=$enableval
+    [if test x$enableval = xyes; then
+        trace_support=1
+    fi])
+
+AC_DEFINE_UNQUOTED([_ODP_TRACE], [$trace_support],
+	[Define to 1 to enable datapath tracepoints])
@@ -5,10 +5,13 @@
  * SPDX-License-Identifier:     BSD-3-Clause
  */
 
+#include <odp_posix_extensions.h>
+
 #include <odp/api/classification.h>
 #include <odp/api/align.h>
 #include <odp/api/queue.h>
 #include <odp/api/debug.h>
+#include <odp_global_data.h>
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_packet_internal.h>
@@ -17,6 +20,8 @@
 #include <odp_classification_datamodel.h>
 #include <odp_classification_internal.h>
 #include <odp/api/shared_memory.h>
+#include <odp/api/thread.h>
+#include <odp/api/time.h>
 #include <protocols/eth.h>
 #include <protocols/ip.h>
 #include <protocols/ipsec.h>
@@ -26,12 +31,23 @@
 #include <string.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <inttypes.h>
 #include <odp/api/spinlock.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #define LOCK(a)      odp_spinlock_lock(a)
 #define UNLOCK(a)    odp_spinlock_unlock(a)
 #define LOCK_INIT(a)	odp_spinlock_init(a)
 
+/* Maximum time to wait for readers to release a rule set */
+#define CLS_RULE_SET_WAIT_NS (10 * ODP_TIME_MSEC_IN_NS)
+
+/* membarrier() commands, see linux/membarrier.h */
+#define CLS_MEMBARRIER_CMD_QUERY                       0
+#define CLS_MEMBARRIER_CMD_PRIVATE_EXPEDITED           (1 << 3)
+#define CLS_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED  (1 << 4)
+
 static cos_tbl_t *cos_tbl;
 static pmr_tbl_t	*pmr_tbl;
 static _cls_queue_grp_tbl_t *queue_grp_tbl;
@@ -40,6 +56,15 @@ typedef struct cls_global_t {
 	cos_tbl_t cos_tbl;
 	pmr_tbl_t pmr_tbl;
 	_cls_queue_grp_tbl_t queue_grp_tbl;
+	cls_rule_set_t rule_set[CLS_RULE_SET_MAX];
+	cls_thr_epoch_t thr_epoch[ODP_THREAD_COUNT_MAX];
+	cls_thr_stats_t thr_stats[ODP_THREAD_COUNT_MAX];
+	/* Global epoch, advanced when rule sets, PMRs or CoS are retired */
+	odp_atomic_u64_t epoch;
+	/* Serializes rule set updates */
+	odp_spinlock_t rule_lock;
+	/* Writers force a memory barrier on readers with membarrier() */
+	int sys_membarrier;
 	odp_shm_t shm;
 
 } cls_global_t;
@@ -88,6 +113,44 @@ pmr_t *get_pmr_entry_internal(odp_pmr_t pmr)
 	return &pmr_tbl->pmr[_odp_pmr_to_ndx(pmr)];
 }
 
+/* Register for expedited membarrier(). It interrupts all running threads of
+ * the process, so it is not usable when ODP threads are processes. */
+static int cls_membarrier_init(void)
+{
+#ifdef SYS_membarrier
+	long cmds;
+
+	if (odp_global_ro.init_param.mem_model != ODP_MEM_MODEL_THREAD)
+		return 0;
+
+	cmds = syscall(SYS_membarrier, CLS_MEMBARRIER_CMD_QUERY, 0);
+	if (cmds < 0 ||
+	    !(cmds & CLS_MEMBARRIER_CMD_PRIVATE_EXPEDITED) ||
+	    !(cmds & CLS_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED))
+		return 0;
+
+	if (syscall(SYS_membarrier,
+		    CLS_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0))
+		return 0;
+
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/* Full memory barrier on this thread, and on all threads which are
+ * classifying packets when membarrier() is used */
+static void cls_membarrier(void)
+{
+	odp_mb_full();
+#ifdef SYS_membarrier
+	if (cls_global->sys_membarrier &&
+	    syscall(SYS_membarrier, CLS_MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0))
+		ODP_ABORT("membarrier() failed\n");
+#endif
+}
+
 int _odp_classification_init_global(void)
 {
 	odp_shm_t shm;
@@ -105,6 +168,14 @@ int _odp_classification_init_global(void)
 	cos_tbl       = &cls_global->cos_tbl;
 	pmr_tbl       = &cls_global->pmr_tbl;
 	queue_grp_tbl = &cls_global->queue_grp_tbl;
+	LOCK_INIT(&queue_grp_tbl->s.lock);
+	LOCK_INIT(&cls_global->rule_lock);
+	cls_global->sys_membarrier = cls_membarrier_init();
+
+	/* Zero epoch marks threads outside of classification */
+	odp_atomic_init_u64(&cls_global->epoch, 1);
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		odp_atomic_init_u64(&cls_global->thr_epoch[i].epoch, 0);
 
 	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
 		/* init locks */
@@ -121,6 +192,152 @@ int _odp_classification_init_global(void)
 	return 0;
 }
 
+/* Enter classification. Rule sets, PMRs and CoS seen after this remain
+ * valid until cls_read_end(). */
+static inline void cls_read_begin(odp_atomic_u64_t *thr_epoch)
+{
+	uint64_t epoch = odp_atomic_load_u64(&cls_global->epoch);
+
+	odp_atomic_store_u64(thr_epoch, epoch);
+
+	/* Epoch store must be visible before rule sets are read. A full
+	 * barrier per packet is avoided when writers issue it on behalf of
+	 * readers with membarrier(). Then only compiler reordering needs to
+	 * be prevented here. */
+	if (odp_likely(cls_global->sys_membarrier))
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	else
+		odp_mb_full();
+}
+
+static inline void cls_read_end(odp_atomic_u64_t *thr_epoch)
+{
+	odp_atomic_store_rel_u64(thr_epoch, 0);
+}
+
+static inline cls_rule_set_t *cls_rules(cos_t *cos)
+{
+	return __atomic_load_n(&cos->s.rules, __ATOMIC_ACQUIRE);
+}
+
+/* Oldest epoch a thread is classifying packets in, or UINT64_MAX. Objects
+ * retired before this epoch are not referenced by any thread. */
+static uint64_t cls_min_epoch(void)
+{
+	uint64_t min = UINT64_MAX;
+	uint64_t epoch;
+	int i;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		cls_thr_epoch_t *thr = &cls_global->thr_epoch[i];
+
+		epoch = odp_atomic_load_acq_u64(&thr->epoch);
+		if (epoch && epoch < min)
+			min = epoch;
+	}
+
+	return min;
+}
+
+/* Advance global epoch after unlinking objects from readers. Returns the
+ * epoch the objects are retired in. */
+static uint64_t cls_epoch_retire(void)
+{
+	uint64_t epoch;
+
+	/* Rule updates must be visible before the new epoch, and the new
+	 * epoch before thread epochs are checked. Also epoch stores of
+	 * readers, which may still see old rules, must be visible to the
+	 * check. */
+	odp_mb_full();
+	epoch = odp_atomic_fetch_inc_u64(&cls_global->epoch);
+	cls_membarrier();
+
+	return epoch;
+}
+
+/* Wait until all threads have left epochs up to and including 'epoch' */
+static void cls_epoch_wait(uint64_t epoch)
+{
+	while (cls_min_epoch() <= epoch)
+		odp_cpu_pause();
+}
+
+/* Allocate a rule set. Called with rule_lock held. Waits for a grace period
+ * when all free sets are still in use by readers. Returns NULL when no set
+ * is released within CLS_RULE_SET_WAIT_NS. */
+static cls_rule_set_t *cls_rule_set_alloc(void)
+{
+	cls_rule_set_t *set;
+	uint64_t min_epoch;
+	odp_time_t end;
+	int i;
+
+	end = odp_time_sum(odp_time_local(),
+			   odp_time_local_from_ns(CLS_RULE_SET_WAIT_NS));
+
+	while (1) {
+		min_epoch = cls_min_epoch();
+
+		for (i = 0; i < CLS_RULE_SET_MAX; i++) {
+			set = &cls_global->rule_set[i];
+
+			if (!set->used || (set->retire_epoch &&
+					   set->retire_epoch < min_epoch)) {
+				set->used = 1;
+				set->retire_epoch = 0;
+				set->num_rule = 0;
+				return set;
+			}
+		}
+
+		if (odp_time_cmp(odp_time_local(), end) > 0) {
+			ODP_ERR("No free rule set\n");
+			return NULL;
+		}
+
+		odp_cpu_pause();
+	}
+}
+
+/* Publish new rules of a CoS and retire the old ones. Called with rule_lock
+ * held. Returns the retire epoch. */
+static uint64_t cls_rules_update(cos_t *cos, cls_rule_set_t *rules)
+{
+	cls_rule_set_t *old = cos->s.rules;
+	uint64_t epoch;
+
+	if (rules && rules->num_rule == 0) {
+		rules->used = 0;
+		rules = NULL;
+	}
+
+	__atomic_store_n(&cos->s.rules, rules, __ATOMIC_RELEASE);
+	epoch = cls_epoch_retire();
+
+	if (old)
+		old->retire_epoch = epoch;
+
+	return epoch;
+}
+
+static void cls_cos_stats_reset(uint32_t index)
+{
+	int i;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		memset(&cls_global->thr_stats[i].cos[index], 0,
+		       sizeof(cls_global->thr_stats[i].cos[index]));
+}
+
+static void cls_pmr_stats_reset(uint32_t index)
+{
+	int i;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		cls_global->thr_stats[i].pmr_hits[index] = 0;
+}
+
 int _odp_classification_term_global(void)
 {
 	if (cls_global && odp_shm_free(cls_global->shm)) {
@@ -148,6 +365,12 @@ void odp_cls_pmr_param_init(odp_pmr_param_t *param)
 int odp_cls_capability(odp_cls_capability_t *capability)
 {
 	unsigned count = 0;
+	odp_queue_capability_t queue_capa;
+
+	if (odp_queue_capability(&queue_capa)) {
+		ODP_ERR("Queue capability failed\n");
+		return -1;
+	}
 
 	for (int i = 0; i < CLS_PMR_MAX_ENTRY; i++)
 		if (!pmr_tbl->pmr[i].s.valid)
@@ -173,6 +396,7 @@ int odp_cls_capability(odp_cls_capability_t *capability)
 	capability->supported_terms.bit.dip_addr = 1;
 	capability->supported_terms.bit.sip6_addr = 1;
 	capability->supported_terms.bit.dip6_addr = 1;
+	capability->supported_terms.bit.ld_vni = 1;
 	capability->supported_terms.bit.custom_frame = 1;
 	capability->supported_terms.bit.custom_l3 = 1;
 	capability->random_early_detection = ODP_SUPPORT_NO;
@@ -180,22 +404,63 @@ int odp_cls_capability(odp_cls_capability_t *capability)
 	capability->threshold_red.all_bits = 0;
 	capability->threshold_bp.all_bits = 0;
 	capability->max_hash_queues = CLS_COS_QUEUE_MAX;
+	if (queue_capa.max_queues < capability->max_hash_queues)
+		capability->max_hash_queues = queue_capa.max_queues;
 	return 0;
 }
 
-static void _odp_cls_update_hash_proto(cos_t *cos,
+static void _odp_cls_update_hash_proto(odp_cls_hash_proto_t *cls_proto,
 				       odp_pktin_hash_proto_t hash_proto)
 {
+	cls_proto->all = 0;
+
 	if (hash_proto.proto.ipv4 || hash_proto.proto.ipv4_tcp ||
 	    hash_proto.proto.ipv4_udp)
-		cos->s.hash_proto.ipv4 = 1;
+		cls_proto->ipv4 = 1;
 	if (hash_proto.proto.ipv6 || hash_proto.proto.ipv6_tcp ||
 	    hash_proto.proto.ipv6_udp)
-		cos->s.hash_proto.ipv6 = 1;
+		cls_proto->ipv6 = 1;
 	if (hash_proto.proto.ipv4_tcp || hash_proto.proto.ipv6_tcp)
-		cos->s.hash_proto.tcp = 1;
+		cls_proto->tcp = 1;
 	if (hash_proto.proto.ipv4_udp || hash_proto.proto.ipv6_udp)
-		cos->s.hash_proto.udp = 1;
+		cls_proto->udp = 1;
+}
+
+/*
+ * Reserve 'num' consecutive queue group table entries. Returns index of the
+ * first entry, or -1 when there is no large enough free range.
+ */
+static int _cls_queue_grp_alloc(uint32_t num)
+{
+	uint32_t i;
+	uint32_t len = 0;
+	int base = -1;
+
+	LOCK(&queue_grp_tbl->s.lock);
+
+	for (i = 0; i < CLS_QUEUE_GROUP_MAX; i++) {
+		if (queue_grp_tbl->s.used[i]) {
+			len = 0;
+			continue;
+		}
+
+		if (++len == num) {
+			base = i + 1 - num;
+			memset(&queue_grp_tbl->s.used[base], 1, num);
+			break;
+		}
+	}
+
+	UNLOCK(&queue_grp_tbl->s.lock);
+
+	return base;
+}
+
+static void _cls_queue_grp_free(uint32_t base, uint32_t num)
+{
+	LOCK(&queue_grp_tbl->s.lock);
+	memset(&queue_grp_tbl->s.used[base], 0, num);
+	UNLOCK(&queue_grp_tbl->s.lock);
 }
 
 static inline void _cls_queue_unwind(uint32_t tbl_index, uint32_t j)
@@ -204,24 +469,62 @@ static inline void _cls_queue_unwind(uint32_t tbl_index, uint32_t j)
 		odp_queue_destroy(queue_grp_tbl->s.queue[tbl_index + --j]);
 }
 
+/* Destroy queue group queues of a CoS and free the table range. Destroyed
+ * queues are cleared from the table, so that a failed destroy (non-empty
+ * queue) can be retried. The range is not freed before all queues are
+ * destroyed. Called with CoS lock held. */
+static int _cls_queue_grp_destroy(cos_t *cos)
+{
+	uint32_t i;
+	uint32_t base = cos->s.queue_grp_base;
+	int ret = 0;
+
+	for (i = 0; i < cos->s.num_queue; i++) {
+		odp_queue_t *queue = &queue_grp_tbl->s.queue[base + i];
+
+		if (*queue == ODP_QUEUE_INVALID)
+			continue;
+
+		if (odp_queue_destroy(*queue)) {
+			ret = -1;
+			continue;
+		}
+
+		*queue = ODP_QUEUE_INVALID;
+	}
+
+	if (ret)
+		return -1;
+
+	_cls_queue_grp_free(base, cos->s.num_queue);
+	cos->s.queue_group = false;
+
+	return 0;
+}
+
 odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param)
 {
 	uint32_t i, j;
 	odp_queue_t queue;
 	odp_cls_drop_t drop_policy;
 	cos_t *cos;
-	uint32_t tbl_index;
+	int tbl_index;
+	uint64_t min_epoch;
 
 	/* num_queue should not be zero */
 	if (param->num_queue > CLS_COS_QUEUE_MAX || param->num_queue < 1)
 		return ODP_COS_INVALID;
 
 	drop_policy = param->drop_policy;
+	min_epoch = cls_min_epoch();
 
 	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
 		cos = &cos_tbl->cos_entry[i];
 		LOCK(&cos->s.lock);
-		if (0 == cos->s.valid) {
+		/* Destroyed CoS may still be referenced by readers. Queues
+		 * left over from a failed destroy are freed first. */
+		if (0 == cos->s.valid && cos->s.retire_epoch < min_epoch &&
+		    (!cos->s.queue_group || _cls_queue_grp_destroy(cos) == 0)) {
 			char *cos_name = cos->s.name;
 
 			if (name == NULL) {
@@ -230,34 +533,44 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param)
 				strncpy(cos_name, name, ODP_COS_NAME_LEN - 1);
 				cos_name[ODP_COS_NAME_LEN - 1] = 0;
 			}
-			for (j = 0; j < CLS_PMR_PER_COS_MAX; j++) {
-				cos->s.pmr[j] = NULL;
-				cos->s.linked_cos[j] = NULL;
-			}
+			cos->s.rules = NULL;
+			cos->s.retire_epoch = 0;
 
 			cos->s.num_queue = param->num_queue;
 
 			if (param->num_queue > 1) {
-				odp_queue_param_init(&cos->s.queue_param);
+				cos->s.queue_param = param->queue_param;
 				cos->s.queue_group = true;
 				cos->s.queue = ODP_QUEUE_INVALID;
-				_odp_cls_update_hash_proto(cos,
+				_odp_cls_update_hash_proto(&cos->s.hash_proto,
 							   param->hash_proto);
-				tbl_index = i * CLS_COS_QUEUE_MAX;
+				tbl_index = _cls_queue_grp_alloc(param->
+								 num_queue);
+				if (tbl_index < 0) {
+					ODP_ERR("Queue group table full\n");
+					UNLOCK(&cos->s.lock);
+					return ODP_COS_INVALID;
+				}
 				for (j = 0; j < param->num_queue; j++) {
 					queue = odp_queue_create(NULL, &cos->s.
 								 queue_param);
 					if (queue == ODP_QUEUE_INVALID) {
 						/* unwind the queues */
 						_cls_queue_unwind(tbl_index, j);
+						_cls_queue_grp_free(tbl_index,
+								    param->
+								    num_queue);
 						UNLOCK(&cos->s.lock);
 						return ODP_COS_INVALID;
 					}
 					queue_grp_tbl->s.queue[tbl_index + j] =
 							queue;
 				}
+				cos->s.queue_grp_base = tbl_index;
 
 			} else {
+				cos->s.queue_group = false;
+				cos->s.hash_proto.all = 0;
 				cos->s.queue = param->queue;
 			}
 
@@ -265,8 +578,8 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param)
 			cos->s.headroom = 0;
 			cos->s.valid = 1;
 			cos->s.drop_policy = drop_policy;
-			odp_atomic_init_u32(&cos->s.num_rule, 0);
 			cos->s.index = i;
+			cls_cos_stats_reset(i);
 			UNLOCK(&cos->s.lock);
 			return _odp_cos_from_ndx(i);
 		}
@@ -283,14 +596,19 @@ odp_cos_t odp_cls_cos_create(const char *name, const odp_cls_cos_param_t *param)
 static
 odp_pmr_t alloc_pmr(pmr_t **pmr)
 {
+	uint64_t min_epoch = cls_min_epoch();
 	int i;
 
 	for (i = 0; i < CLS_PMR_MAX_ENTRY; i++) {
 		LOCK(&pmr_tbl->pmr[i].s.lock);
-		if (0 == pmr_tbl->pmr[i].s.valid) {
+		/* Destroyed PMR may still be referenced by readers */
+		if (0 == pmr_tbl->pmr[i].s.valid &&
+		    pmr_tbl->pmr[i].s.retire_epoch < min_epoch) {
 			pmr_tbl->pmr[i].s.valid = 1;
-			odp_atomic_init_u32(&pmr_tbl->pmr[i].s.count, 0);
+			pmr_tbl->pmr[i].s.index = i;
 			pmr_tbl->pmr[i].s.num_pmr = 0;
+			pmr_tbl->pmr[i].s.retire_epoch = 0;
+			cls_pmr_stats_reset(i);
 			*pmr = &pmr_tbl->pmr[i];
 			/* return as locked */
 			return _odp_pmr_from_ndx(i);
@@ -335,7 +653,26 @@ int odp_cos_destroy(odp_cos_t cos_id)
 		return -1;
 	}
 
+	LOCK(&cos->s.lock);
+	LOCK(&cls_global->rule_lock);
 	cos->s.valid = 0;
+	cos->s.retire_epoch = cls_rules_update(cos, NULL);
+	UNLOCK(&cls_global->rule_lock);
+
+	/* Queue group queues were created by the implementation. Packet input
+	 * may have selected a queue before the CoS was retired and enqueue
+	 * into it until it leaves the epoch. */
+	if (cos->s.queue_group) {
+		cls_epoch_wait(cos->s.retire_epoch);
+
+		if (_cls_queue_grp_destroy(cos)) {
+			ODP_ERR("CoS queue destroy failed\n");
+			UNLOCK(&cos->s.lock);
+			return -1;
+		}
+	}
+
+	UNLOCK(&cos->s.lock);
 	return 0;
 }
 
@@ -410,7 +747,7 @@ uint32_t odp_cls_cos_queues(odp_cos_t cos_id, odp_queue_t queue[],
 	else
 		num_queues = cos->s.num_queue;
 
-	tbl_index = cos->s.index * CLS_COS_QUEUE_MAX;
+	tbl_index = cos->s.queue_grp_base;
 	for (i = 0; i < num_queues; i++)
 		queue[i] = queue_grp_tbl->s.queue[tbl_index + i];
 
@@ -576,6 +913,7 @@ static int pmr_create_term(pmr_term_value_t *value,
 	uint32_t size;
 	uint8_t i;
 	int custom = 0;
+	int inner = 0;
 	odp_cls_pmr_term_t term = param->term;
 
 	if (param->range_term) {
@@ -586,6 +924,12 @@ static int pmr_create_term(pmr_term_value_t *value,
 	value->term = term;
 	value->range_term = param->range_term;
 
+	/* Inner header terms are sized as the outer ones */
+	if (term > ODP_PMR_INNER_HDR_OFF) {
+		inner = 1;
+		term -= ODP_PMR_INNER_HDR_OFF;
+	}
+
 	switch (term) {
 	case ODP_PMR_IPPROTO:
 		size = 1;
@@ -643,6 +987,12 @@ static int pmr_create_term(pmr_term_value_t *value,
 		return -1;
 	}
 
+	if (inner && (custom || term == ODP_PMR_LEN ||
+		      term == ODP_PMR_IPSEC_SPI || term == ODP_PMR_LD_VNI)) {
+		ODP_ERR("Bad inner PMR term\n");
+		return -1;
+	}
+
 	if ((!custom && param->val_sz != size) ||
 	    (custom && param->val_sz > size)) {
 		ODP_ERR("Bad PMR value size: %u\n", param->val_sz);
@@ -665,30 +1015,41 @@ static int pmr_create_term(pmr_term_value_t *value,
 int odp_cls_pmr_destroy(odp_pmr_t pmr_id)
 {
 	cos_t *src_cos;
-	uint32_t loc;
+	cls_rule_set_t *old, *rules;
 	pmr_t *pmr;
-	uint8_t i;
+	uint64_t epoch;
+	uint32_t i;
 
 	pmr = get_pmr_entry(pmr_id);
 	if (pmr == NULL || pmr->s.src_cos == NULL)
 		return -1;
 
 	src_cos = pmr->s.src_cos;
-	LOCK(&src_cos->s.lock);
-	loc = odp_atomic_load_u32(&src_cos->s.num_rule);
-	if (loc == 0)
-		goto no_rule;
-	loc -= 1;
-	for (i = 0; i <= loc; i++)
-		if (src_cos->s.pmr[i] == pmr) {
-			src_cos->s.pmr[i] = src_cos->s.pmr[loc];
-			src_cos->s.linked_cos[i] = src_cos->s.linked_cos[loc];
+	LOCK(&cls_global->rule_lock);
+	old = src_cos->s.rules;
+	rules = NULL;
+
+	if (old) {
+		/* Copy remaining rules in the same order */
+		rules = cls_rule_set_alloc();
+		if (rules == NULL) {
+			UNLOCK(&cls_global->rule_lock);
+			return -1;
 		}
-	odp_atomic_dec_u32(&src_cos->s.num_rule);
 
-no_rule:
+		for (i = 0; i < old->num_rule; i++) {
+			if (old->pmr[i] == pmr)
+				continue;
+			rules->pmr[rules->num_rule] = old->pmr[i];
+			rules->linked_cos[rules->num_rule] = old->linked_cos[i];
+			rules->num_rule++;
+		}
+	}
+
+	epoch = cls_rules_update(src_cos, rules);
 	pmr->s.valid = 0;
-	UNLOCK(&src_cos->s.lock);
+	pmr->s.retire_epoch = epoch;
+	UNLOCK(&cls_global->rule_lock);
 	return 0;
 }
 
@@ -698,7 +1059,8 @@ odp_pmr_t odp_cls_pmr_create(const odp_pmr_param_t *terms, int num_terms,
 	pmr_t *pmr;
 	int i;
 	odp_pmr_t id;
-	uint32_t loc;
+	uint32_t num_rule;
+	cls_rule_set_t *old, *rules;
 	cos_t *cos_src = get_cos_entry(src_cos);
 	cos_t *cos_dst = get_cos_entry(dst_cos);
 
@@ -712,29 +1074,56 @@ odp_pmr_t odp_cls_pmr_create(const odp_pmr_param_t *terms, int num_terms,
 		return ODP_PMR_INVALID;
 	}
 
-	if (CLS_PMR_PER_COS_MAX == odp_atomic_load_u32(&cos_src->s.num_rule))
+	LOCK(&cls_global->rule_lock);
+	old = cos_src->s.rules;
+	num_rule = old ? old->num_rule : 0;
+
+	if (CLS_PMR_PER_COS_MAX == num_rule) {
+		UNLOCK(&cls_global->rule_lock);
+		return ODP_PMR_INVALID;
+	}
+
+	rules = cls_rule_set_alloc();
+	if (rules == NULL) {
+		UNLOCK(&cls_global->rule_lock);
 		return ODP_PMR_INVALID;
+	}
 
 	id = alloc_pmr(&pmr);
 	/*if alloc_pmr is successful it returns with the acquired lock*/
-	if (id == ODP_PMR_INVALID)
+	if (id == ODP_PMR_INVALID) {
+		rules->used = 0;
+		UNLOCK(&cls_global->rule_lock);
 		return id;
+	}
 
 	pmr->s.num_pmr = num_terms;
 	for (i = 0; i < num_terms; i++) {
 		if (pmr_create_term(&pmr->s.pmr_term_value[i], &terms[i])) {
 			pmr->s.valid = 0;
 			UNLOCK(&pmr->s.lock);
+			rules->used = 0;
+			UNLOCK(&cls_global->rule_lock);
 			return ODP_PMR_INVALID;
 		}
 	}
-
-	loc = odp_atomic_fetch_inc_u32(&cos_src->s.num_rule);
-	cos_src->s.pmr[loc] = pmr;
-	cos_src->s.linked_cos[loc] = cos_dst;
 	pmr->s.src_cos = cos_src;
-
 	UNLOCK(&pmr->s.lock);
+
+	/* New rule set with the PMR appended. PMR terms are complete before
+	 * readers may see the set. */
+	if (old) {
+		memcpy(rules->pmr, old->pmr, num_rule * sizeof(pmr_t *));
+		memcpy(rules->linked_cos, old->linked_cos,
+		       num_rule * sizeof(cos_t *));
+	}
+	rules->pmr[num_rule] = pmr;
+	rules->linked_cos[num_rule] = cos_dst;
+	rules->num_rule = num_rule + 1;
+
+	cls_rules_update(cos_src, rules);
+	UNLOCK(&cls_global->rule_lock);
+
 	return id;
 }
 
@@ -777,15 +1166,15 @@ static inline int verify_pmr_packet_len(odp_packet_hdr_t *pkt_hdr,
 }
 
 static inline int verify_pmr_ip_proto(const uint8_t *pkt_addr,
-				      odp_packet_hdr_t *pkt_hdr,
+				      const packet_parser_t *prs,
 				      pmr_term_value_t *term_value)
 {
 	const _odp_ipv4hdr_t *ip;
 	uint8_t proto;
 
-	if (!pkt_hdr->p.input_flags.ipv4)
+	if (!prs->input_flags.ipv4)
 		return 0;
-	ip = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ip = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
 	proto = ip->proto;
 	if (term_value->match.value == (proto & term_value->match.mask))
 		return 1;
@@ -794,15 +1183,15 @@ static inline int verify_pmr_ip_proto(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv4_saddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv4hdr_t *ip;
 	uint32_t ipaddr;
 
-	if (!pkt_hdr->p.input_flags.ipv4)
+	if (!prs->input_flags.ipv4)
 		return 0;
-	ip = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ip = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
 	ipaddr = ip->src_addr;
 	if (term_value->match.value == (ipaddr & term_value->match.mask))
 		return 1;
@@ -811,15 +1200,15 @@ static inline int verify_pmr_ipv4_saddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv4_daddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv4hdr_t *ip;
 	uint32_t ipaddr;
 
-	if (!pkt_hdr->p.input_flags.ipv4)
+	if (!prs->input_flags.ipv4)
 		return 0;
-	ip = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ip = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
 	ipaddr = ip->dst_addr;
 	if (term_value->match.value == (ipaddr & term_value->match.mask))
 		return 1;
@@ -828,15 +1217,15 @@ static inline int verify_pmr_ipv4_daddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_tcp_sport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t sport;
 	const _odp_tcphdr_t *tcp;
 
-	if (!pkt_hdr->p.input_flags.tcp)
+	if (!prs->input_flags.tcp)
 		return 0;
-	tcp = (const _odp_tcphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	tcp = (const _odp_tcphdr_t *)(pkt_addr + prs->l4_offset);
 	sport = tcp->src_port;
 	if (term_value->match.value == (sport & term_value->match.mask))
 		return 1;
@@ -845,15 +1234,15 @@ static inline int verify_pmr_tcp_sport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_tcp_dport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t dport;
 	const _odp_tcphdr_t *tcp;
 
-	if (!pkt_hdr->p.input_flags.tcp)
+	if (!prs->input_flags.tcp)
 		return 0;
-	tcp = (const _odp_tcphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	tcp = (const _odp_tcphdr_t *)(pkt_addr + prs->l4_offset);
 	dport = tcp->dst_port;
 	if (term_value->match.value == (dport & term_value->match.mask))
 		return 1;
@@ -862,15 +1251,15 @@ static inline int verify_pmr_tcp_dport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_udp_dport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t dport;
 	const _odp_udphdr_t *udp;
 
-	if (!pkt_hdr->p.input_flags.udp)
+	if (!prs->input_flags.udp)
 		return 0;
-	udp = (const _odp_udphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	udp = (const _odp_udphdr_t *)(pkt_addr + prs->l4_offset);
 	dport = udp->dst_port;
 	if (term_value->match.value == (dport & term_value->match.mask))
 		return 1;
@@ -879,15 +1268,15 @@ static inline int verify_pmr_udp_dport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_udp_sport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t sport;
 	const _odp_udphdr_t *udp;
 
-	if (!pkt_hdr->p.input_flags.udp)
+	if (!prs->input_flags.udp)
 		return 0;
-	udp = (const _odp_udphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	udp = (const _odp_udphdr_t *)(pkt_addr + prs->l4_offset);
 	sport = udp->src_port;
 	if (term_value->match.value == (sport & term_value->match.mask))
 		return 1;
@@ -896,7 +1285,7 @@ static inline int verify_pmr_udp_sport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_dmac(const uint8_t *pkt_addr,
-				  odp_packet_hdr_t *pkt_hdr,
+				  const packet_parser_t *prs,
 				  pmr_term_value_t *term_value)
 {
 	const _odp_ethhdr_t *eth;
@@ -904,10 +1293,10 @@ static inline int verify_pmr_dmac(const uint8_t *pkt_addr,
 	uint16_t *mask  = (uint16_t *)&term_value->match.mask;
 	uint16_t *value = (uint16_t *)&term_value->match.value;
 
-	if (!packet_hdr_has_eth(pkt_hdr))
+	if (!prs->input_flags.eth)
 		return 0;
 
-	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	eth = (const _odp_ethhdr_t *)(pkt_addr + prs->l2_offset);
 	memcpy(dmac, eth->dst.addr, _ODP_ETHADDR_LEN);
 	dmac[0] &= mask[0];
 	dmac[1] &= mask[1];
@@ -920,16 +1309,16 @@ static inline int verify_pmr_dmac(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv6_saddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv6hdr_t *ipv6;
 	uint64_t addr[2];
 
-	if (!packet_hdr_has_ipv6(pkt_hdr))
+	if (!prs->input_flags.ipv6)
 		return 0;
 
-	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + prs->l3_offset);
 	memcpy(addr, ipv6->src_addr.u64, _ODP_IPV6ADDR_LEN);
 
 	addr[0] = addr[0] & term_value->match.mask_u64[0];
@@ -943,16 +1332,16 @@ static inline int verify_pmr_ipv6_saddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv6_daddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv6hdr_t *ipv6;
 	uint64_t addr[2];
 
-	if (!packet_hdr_has_ipv6(pkt_hdr))
+	if (!prs->input_flags.ipv6)
 		return 0;
 
-	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + prs->l3_offset);
 	memcpy(addr, ipv6->dst_addr.u64, _ODP_IPV6ADDR_LEN);
 
 	addr[0] = addr[0] & term_value->match.mask_u64[0];
@@ -966,7 +1355,7 @@ static inline int verify_pmr_ipv6_daddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_vlan_id_0(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	const _odp_ethhdr_t *eth;
@@ -974,10 +1363,10 @@ static inline int verify_pmr_vlan_id_0(const uint8_t *pkt_addr,
 	uint16_t tci;
 	uint16_t vlan_id;
 
-	if (!packet_hdr_has_eth(pkt_hdr) || !pkt_hdr->p.input_flags.vlan)
+	if (!prs->input_flags.eth || !prs->input_flags.vlan)
 		return 0;
 
-	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	eth = (const _odp_ethhdr_t *)(pkt_addr + prs->l2_offset);
 	vlan = (const _odp_vlanhdr_t *)(eth + 1);
 	tci = vlan->tci;
 	vlan_id = tci & odp_cpu_to_be_16(0x0fff);
@@ -989,7 +1378,7 @@ static inline int verify_pmr_vlan_id_0(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_vlan_id_x(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	const _odp_ethhdr_t *eth;
@@ -997,13 +1386,13 @@ static inline int verify_pmr_vlan_id_x(const uint8_t *pkt_addr,
 	uint16_t tci;
 	uint16_t vlan_id;
 
-	if (!pkt_hdr->p.input_flags.vlan && !pkt_hdr->p.input_flags.vlan_qinq)
+	if (!prs->input_flags.vlan && !prs->input_flags.vlan_qinq)
 		return 0;
 
-	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	eth = (const _odp_ethhdr_t *)(pkt_addr + prs->l2_offset);
 	vlan = (const _odp_vlanhdr_t *)(eth + 1);
 
-	if (pkt_hdr->p.input_flags.vlan_qinq)
+	if (prs->input_flags.vlan_qinq)
 		vlan++;
 
 	tci = vlan->tci;
@@ -1016,18 +1405,18 @@ static inline int verify_pmr_vlan_id_x(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipsec_spi(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint32_t spi;
 
-	pkt_addr += pkt_hdr->p.l4_offset;
+	pkt_addr += prs->l4_offset;
 
-	if (pkt_hdr->p.input_flags.ipsec_ah) {
+	if (prs->input_flags.ipsec_ah) {
 		const _odp_ahhdr_t *ahhdr = (const _odp_ahhdr_t *)pkt_addr;
 
 		spi = odp_be_to_cpu_32(ahhdr->spi);
-	} else if (pkt_hdr->p.input_flags.ipsec_esp) {
+	} else if (prs->input_flags.ipsec_esp) {
 		const _odp_esphdr_t *esphdr = (const _odp_esphdr_t *)pkt_addr;
 
 		spi = odp_be_to_cpu_32(esphdr->spi);
@@ -1041,11 +1430,19 @@ static inline int verify_pmr_ipsec_spi(const uint8_t *pkt_addr,
 	return 0;
 }
 
-static inline int verify_pmr_ld_vni(const uint8_t *pkt_addr ODP_UNUSED,
-				    odp_packet_hdr_t *pkt_hdr ODP_UNUSED,
-				    pmr_term_value_t *term_value ODP_UNUSED)
+static inline int verify_pmr_ld_vni(const packet_parser_t *prs,
+				    pmr_term_value_t *term_value)
 {
-	ODP_UNIMPLEMENTED();
+	uint32_t vni;
+
+	if (!prs->input_flags.tunnel ||
+	    prs->tunnel.type == PACKET_TUNNEL_GTPU)
+		return 0;
+
+	vni = odp_cpu_to_be_32(prs->tunnel.id);
+	if (term_value->match.value == (vni & term_value->match.mask))
+		return 1;
+
 	return 0;
 }
 
@@ -1107,16 +1504,16 @@ static inline int verify_pmr_custom_l3(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_eth_type_0(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ethhdr_t *eth;
 	uint16_t ethtype;
 
-	if (!packet_hdr_has_eth(pkt_hdr))
+	if (!prs->input_flags.eth)
 		return 0;
 
-	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	eth = (const _odp_ethhdr_t *)(pkt_addr + prs->l2_offset);
 	ethtype = eth->type;
 
 	if (term_value->match.value == (ethtype & term_value->match.mask))
@@ -1126,20 +1523,20 @@ static inline int verify_pmr_eth_type_0(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_eth_type_x(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ethhdr_t *eth;
 	uint16_t ethtype;
 	const _odp_vlanhdr_t *vlan;
 
-	if (!pkt_hdr->p.input_flags.vlan && !pkt_hdr->p.input_flags.vlan_qinq)
+	if (!prs->input_flags.vlan && !prs->input_flags.vlan_qinq)
 		return 0;
 
-	eth = (const _odp_ethhdr_t *)(pkt_addr + pkt_hdr->p.l2_offset);
+	eth = (const _odp_ethhdr_t *)(pkt_addr + prs->l2_offset);
 	vlan = (const _odp_vlanhdr_t *)(eth + 1);
 
-	if (pkt_hdr->p.input_flags.vlan_qinq)
+	if (prs->input_flags.vlan_qinq)
 		vlan++;
 
 	ethtype = vlan->type;
@@ -1150,17 +1547,33 @@ static inline int verify_pmr_eth_type_x(const uint8_t *pkt_addr,
 	return 0;
 }
 
+/* Parser metadata view of the inner packet of a tunnel */
+static inline void inner_parser(packet_parser_t *inner,
+				const packet_parser_t *prs)
+{
+	inner->input_flags = prs->tunnel.input_flags;
+	inner->flags.all_flags = 0;
+	inner->l2_offset = prs->tunnel.l2_offset;
+	inner->l3_offset = prs->tunnel.l3_offset;
+	inner->l4_offset = prs->tunnel.l4_offset;
+}
+
 /*
  * This function goes through each PMR_TERM value in pmr_t structure and calls
  * verification function for each term.Returns 1 if PMR matches or 0 otherwise.
+ * Header terms with ODP_PMR_INNER_HDR_OFF are matched against the inner
+ * headers of a tunneled packet.
  */
 static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
-		      odp_packet_hdr_t *pkt_hdr)
+		      odp_packet_hdr_t *pkt_hdr, cls_thr_stats_t *stats)
 {
 	int pmr_failure = 0;
 	int num_pmr;
 	int i;
+	int term;
 	pmr_term_value_t *term_value;
+	const packet_parser_t *prs;
+	packet_parser_t inner;
 
 	/* Locking is not required as PMR rules for in-flight packets
 	delivery during a PMR change is indeterminate*/
@@ -1172,89 +1585,84 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
 	/* Iterate through list of PMR Term values in a pmr_t */
 	for (i = 0; i < num_pmr; i++) {
 		term_value = &pmr->s.pmr_term_value[i];
-		switch (term_value->term) {
+		term = term_value->term;
+		prs = &pkt_hdr->p;
+
+		if (term > ODP_PMR_INNER_HDR_OFF) {
+			if (!prs->input_flags.tunnel)
+				return 0;
+			inner_parser(&inner, prs);
+			prs = &inner;
+			term -= ODP_PMR_INNER_HDR_OFF;
+		}
+
+		switch (term) {
 		case ODP_PMR_LEN:
 			if (!verify_pmr_packet_len(pkt_hdr, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_ETHTYPE_0:
-			if (!verify_pmr_eth_type_0(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_eth_type_0(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_ETHTYPE_X:
-			if (!verify_pmr_eth_type_x(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_eth_type_x(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_VLAN_ID_0:
-			if (!verify_pmr_vlan_id_0(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_vlan_id_0(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_VLAN_ID_X:
-			if (!verify_pmr_vlan_id_x(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_vlan_id_x(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_DMAC:
-			if (!verify_pmr_dmac(pkt_addr, pkt_hdr,
-					     term_value))
+			if (!verify_pmr_dmac(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_IPPROTO:
-			if (!verify_pmr_ip_proto(pkt_addr, pkt_hdr,
-						 term_value))
+			if (!verify_pmr_ip_proto(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_UDP_DPORT:
-			if (!verify_pmr_udp_dport(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_udp_dport(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_TCP_DPORT:
-			if (!verify_pmr_tcp_dport(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_tcp_dport(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_UDP_SPORT:
-			if (!verify_pmr_udp_sport(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_udp_sport(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_TCP_SPORT:
-			if (!verify_pmr_tcp_sport(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_tcp_sport(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_SIP_ADDR:
-			if (!verify_pmr_ipv4_saddr(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_ipv4_saddr(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_DIP_ADDR:
-			if (!verify_pmr_ipv4_daddr(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_ipv4_daddr(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_SIP6_ADDR:
-			if (!verify_pmr_ipv6_saddr(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_ipv6_saddr(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_DIP6_ADDR:
-			if (!verify_pmr_ipv6_daddr(pkt_addr, pkt_hdr,
-						   term_value))
+			if (!verify_pmr_ipv6_daddr(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_IPSEC_SPI:
-			if (!verify_pmr_ipsec_spi(pkt_addr, pkt_hdr,
-						  term_value))
+			if (!verify_pmr_ipsec_spi(pkt_addr, prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_LD_VNI:
-			if (!verify_pmr_ld_vni(pkt_addr, pkt_hdr,
-					       term_value))
+			if (!verify_pmr_ld_vni(prs, term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_CUSTOM_FRAME:
@@ -1277,7 +1685,7 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
 		if (pmr_failure)
 			return 0;
 	}
-	odp_atomic_inc_u32(&pmr->s.count);
+	stats->pmr_hits[pmr->s.index]++;
 	return 1;
 }
 
@@ -1287,9 +1695,10 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
  * with the packet.
  */
 static cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, pmr_t *pmr,
-			    odp_packet_hdr_t *hdr)
+			    odp_packet_hdr_t *hdr, cls_thr_stats_t *stats)
 {
-	uint32_t i, num_rule;
+	cls_rule_set_t *rules;
+	uint32_t i;
 
 	if (cos == NULL || pmr == NULL)
 		return NULL;
@@ -1297,19 +1706,19 @@ static cos_t *match_pmr_cos(cos_t *cos, const uint8_t *pkt_addr, pmr_t *pmr,
 	if (!cos->s.valid)
 		return NULL;
 
-	if (verify_pmr(pmr, pkt_addr, hdr)) {
+	if (verify_pmr(pmr, pkt_addr, hdr, stats)) {
 		/* This gets called recursively. First matching leaf or branch
 		 * is returned. */
-		num_rule = odp_atomic_load_u32(&cos->s.num_rule);
+		rules = cls_rules(cos);
 
 		/* No more rules. This is the best match. */
-		if (num_rule == 0)
+		if (rules == NULL)
 			return cos;
 
-		for (i = 0; i < num_rule; i++) {
-			cos_t *retcos = match_pmr_cos(cos->s.linked_cos[i],
-						      pkt_addr, cos->s.pmr[i],
-						      hdr);
+		for (i = 0; i < rules->num_rule; i++) {
+			cos_t *retcos = match_pmr_cos(rules->linked_cos[i],
+						      pkt_addr, rules->pmr[i],
+						      hdr, stats);
 
 			/* Found a matching leaf */
 			if (retcos)
@@ -1335,10 +1744,18 @@ int pktio_classifier_init(pktio_entry_t *entry)
 	cls->default_cos = NULL;
 	cls->headroom = 0;
 	cls->skip = 0;
+	cls->input_hash_proto.all = 0;
 
 	return 0;
 }
 
+void _odp_cls_input_hash_proto_set(pktio_entry_t *entry,
+				   const odp_pktin_hash_proto_t *hash_proto)
+{
+	_odp_cls_update_hash_proto(&entry->s.cls.input_hash_proto,
+				   *hash_proto);
+}
+
 static
 cos_t *match_qos_cos(pktio_entry_t *entry, const uint8_t *pkt_addr,
 		     odp_packet_hdr_t *hdr);
@@ -1356,11 +1773,13 @@ Returns the error_cos if the packet has an error
 **/
 static inline cos_t *cls_select_cos(pktio_entry_t *entry,
 				    const uint8_t *pkt_addr,
-				    odp_packet_hdr_t *pkt_hdr)
+				    odp_packet_hdr_t *pkt_hdr,
+				    cls_thr_stats_t *stats)
 {
 	pmr_t *pmr;
 	cos_t *cos;
 	cos_t *default_cos;
+	cls_rule_set_t *rules;
 	uint32_t i;
 	classifier_t *cls;
 
@@ -1371,10 +1790,11 @@ static inline cos_t *cls_select_cos(pktio_entry_t *entry,
 	if (pkt_hdr->p.flags.all.error)
 		return cls->error_cos;
 	/* Calls all the PMRs attached at the PKTIO level*/
-	for (i = 0; i < odp_atomic_load_u32(&default_cos->s.num_rule); i++) {
-		pmr = default_cos->s.pmr[i];
-		cos = default_cos->s.linked_cos[i];
-		cos = match_pmr_cos(cos, pkt_addr, pmr, pkt_hdr);
+	rules = cls_rules(default_cos);
+	for (i = 0; rules && i < rules->num_rule; i++) {
+		pmr = rules->pmr[i];
+		cos = rules->linked_cos[i];
+		cos = match_pmr_cos(cos, pkt_addr, pmr, pkt_hdr, stats);
 		if (cos)
 			return cos;
 	}
@@ -1390,6 +1810,53 @@ static uint32_t packet_rss_hash(odp_packet_hdr_t *pkt_hdr,
 				odp_cls_hash_proto_t hash_proto,
 				const uint8_t *base);
 
+/* Select CoS and destination queue. Called within cls_read_begin() and
+ * cls_read_end(). */
+static inline int cls_select_dst(pktio_entry_t *entry, const uint8_t *base,
+				 uint16_t pkt_len, odp_pool_t *pool,
+				 odp_packet_hdr_t *pkt_hdr,
+				 cls_thr_stats_t *stats)
+{
+	cos_t *cos;
+	uint32_t tbl_index;
+	uint32_t hash;
+
+	cos = cls_select_cos(entry, base, pkt_hdr, stats);
+
+	if (cos == NULL)
+		return -EINVAL;
+
+	if ((cos->s.queue == ODP_QUEUE_INVALID && cos->s.num_queue == 1) ||
+	    cos->s.pool == ODP_POOL_INVALID) {
+		stats->cos[cos->s.index].discards++;
+		return -EFAULT;
+	}
+
+	stats->cos[cos->s.index].packets++;
+	stats->cos[cos->s.index].octets += pkt_len;
+
+	*pool = cos->s.pool;
+	pkt_hdr->p.input_flags.dst_queue = 1;
+
+	if (!cos->s.queue_group) {
+		pkt_hdr->dst_queue = cos->s.queue;
+		return 0;
+	}
+
+	/* Reuse flow hash from packet input when it covers the same header
+	 * fields. Both hashes are calculated per flow, so packets of a flow
+	 * map always to the same queue. */
+	if (packet_hdr_has_flow_hash(pkt_hdr) &&
+	    cos->s.hash_proto.all == entry->s.cls.input_hash_proto.all)
+		hash = packet_hdr_flow_hash(pkt_hdr);
+	else
+		hash = packet_rss_hash(pkt_hdr, cos->s.hash_proto, base);
+
+	tbl_index = cos->s.queue_grp_base + (hash % cos->s.num_queue);
+	pkt_hdr->dst_queue = queue_grp_tbl->s.queue[tbl_index];
+	return 0;
+}
+
 /**
  * Classify packet
  *
@@ -1410,9 +1877,9 @@ int cls_classify_packet(pktio_entry_t *entry, const uint8_t *base,
 			uint16_t pkt_len, uint32_t seg_len, odp_pool_t *pool,
 			odp_packet_hdr_t *pkt_hdr, odp_bool_t parse)
 {
-	cos_t *cos;
-	uint32_t tbl_index;
-	uint32_t hash;
+	int thr = odp_thread_id();
+	odp_atomic_u64_t *thr_epoch = &cls_global->thr_epoch[thr].epoch;
+	int ret;
 
 	if (parse) {
 		packet_parse_reset(pkt_hdr, 1);
@@ -1422,32 +1889,30 @@ int cls_classify_packet(pktio_entry_t *entry, const uint8_t *base,
 				    ODP_PROTO_LAYER_ALL,
 				    entry->s.in_chksums);
 	}
-	cos = cls_select_cos(entry, base, pkt_hdr);
 
-	if (cos == NULL)
-		return -EINVAL;
+	/* Rules may be updated concurrently. Readers take no locks but
+	 * announce the epoch they are in, so that rules they may see are not
+	 * reclaimed. Packet input may be in a read section already. */
+	if (odp_atomic_load_u64(thr_epoch))
+		return cls_select_dst(entry, base, pkt_len, pool, pkt_hdr,
+				      &cls_global->thr_stats[thr]);
 
-	if (cos->s.queue == ODP_QUEUE_INVALID && cos->s.num_queue == 1)
-		return -EFAULT;
+	cls_read_begin(thr_epoch);
+	ret = cls_select_dst(entry, base, pkt_len, pool, pkt_hdr,
+			     &cls_global->thr_stats[thr]);
+	cls_read_end(thr_epoch);
 
-	if (cos->s.pool == ODP_POOL_INVALID)
-		return -EFAULT;
-
-	*pool = cos->s.pool;
-	pkt_hdr->p.input_flags.dst_queue = 1;
+	return ret;
+}
 
-	if (!cos->s.queue_group) {
-		pkt_hdr->dst_queue = cos->s.queue;
-		return 0;
-	}
+void _odp_cls_input_begin(void)
+{
+	cls_read_begin(&cls_global->thr_epoch[odp_thread_id()].epoch);
+}
 
-	hash = packet_rss_hash(pkt_hdr, cos->s.hash_proto, base);
-	/* CLS_COS_QUEUE_MAX is a power of 2 */
-	hash = hash & (CLS_COS_QUEUE_MAX - 1);
-	tbl_index = (cos->s.index * CLS_COS_QUEUE_MAX) + (hash %
-							  cos->s.num_queue);
-	pkt_hdr->dst_queue = queue_grp_tbl->s.queue[tbl_index];
-	return 0;
+void _odp_cls_input_end(void)
+{
+	cls_read_end(&cls_global->thr_epoch[odp_thread_id()].epoch);
 }
 
 static uint32_t packet_rss_hash(odp_packet_hdr_t *pkt_hdr,
@@ -1595,6 +2060,111 @@ cos_t *match_qos_cos(pktio_entry_t *entry, const uint8_t *pkt_addr,
 	return NULL;
 }
 
+int odp_cls_cos_stats(odp_cos_t cos_id, odp_cls_cos_stats_t *stats)
+{
+	cos_t *cos = get_cos_entry(cos_id);
+	uint32_t index;
+	int i;
+
+	if (cos == NULL) {
+		ODP_ERR("Invalid odp_cos_t handle\n");
+		return -1;
+	}
+
+	index = cos->s.index;
+	memset(stats, 0, sizeof(odp_cls_cos_stats_t));
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		cls_thr_stats_t *thr_stats = &cls_global->thr_stats[i];
+
+		stats->packets += thr_stats->cos[index].packets;
+		stats->octets += thr_stats->cos[index].octets;
+		stats->discards += thr_stats->cos[index].discards;
+	}
+
+	return 0;
+}
+
+int odp_cls_pmr_stats(odp_pmr_t pmr_id, odp_cls_pmr_stats_t *stats)
+{
+	pmr_t *pmr = get_pmr_entry(pmr_id);
+	uint32_t index;
+	int i;
+
+	if (pmr == NULL) {
+		ODP_ERR("Invalid odp_pmr_t handle\n");
+		return -1;
+	}
+
+	index = pmr->s.index;
+	stats->hits = 0;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		stats->hits += cls_global->thr_stats[i].pmr_hits[index];
+
+	return 0;
+}
+
+void odp_cls_print_all(void)
+{
+	odp_cls_cos_stats_t cos_stats;
+	odp_cls_pmr_stats_t pmr_stats;
+	cls_rule_set_t *rules;
+	uint32_t i, j;
+
+	ODP_PRINT("\nClassifier info\n");
+	ODP_PRINT("---------------\n");
+	ODP_PRINT("  CoS                  queues  packets              "
+		  "octets               discards\n");
+
+	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
+		cos_t *cos = &cos_tbl->cos_entry[i];
+		odp_cos_t cos_id = _odp_cos_from_ndx(i);
+
+		if (!cos->s.valid || odp_cls_cos_stats(cos_id, &cos_stats))
+			continue;
+
+		ODP_PRINT("  %-3u %-16s %6u  %-20" PRIu64 " %-20" PRIu64
+			  " %" PRIu64 "\n", i, cos->s.name, cos->s.num_queue,
+			  cos_stats.packets, cos_stats.octets,
+			  cos_stats.discards);
+	}
+
+	ODP_PRINT("\n  PMR  src CoS  dst CoS  terms  hits\n");
+
+	/* Keep rule sets from being replaced while printing */
+	LOCK(&cls_global->rule_lock);
+
+	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
+		cos_t *cos = &cos_tbl->cos_entry[i];
+
+		if (!cos->s.valid)
+			continue;
+
+		/* PMRs are listed in the order they are matched */
+		rules = cos->s.rules;
+		for (j = 0; rules && j < rules->num_rule; j++) {
+			pmr_t *pmr = rules->pmr[j];
+			cos_t *dst = rules->linked_cos[j];
+
+			if (pmr == NULL || dst == NULL || !pmr->s.valid)
+				continue;
+
+			if (odp_cls_pmr_stats(_odp_pmr_from_ndx(pmr->s.index),
+					      &pmr_stats))
+				continue;
+
+			ODP_PRINT("  %-4u %-8u %-8u %-6u %" PRIu64 "\n",
+				  pmr->s.index, i, dst->s.index,
+				  pmr->s.num_pmr, pmr_stats.hits);
+		}
+	}
+
+	UNLOCK(&cls_global->rule_lock);
+
+	ODP_PRINT("\n");
+}
+
 uint64_t odp_cos_to_u64(odp_cos_t hdl)
 {
 	return _odp_pri(hdl);
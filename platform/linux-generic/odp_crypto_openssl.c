@@ -19,13 +19,20 @@
 #include <odp/api/plat/thread_inlines.h>
 #include <odp_packet_internal.h>
 #include <odp/api/plat/queue_inlines.h>
+#include <odp/api/init.h>
+#include <odp/api/cpu.h>
 #include <odp_global_data.h>
+#include <odp_libconfig_internal.h>
+#include <odp_ring_u32_internal.h>
 
 /* Inlined API functions */
 #include <odp/api/plat/event_inlines.h>
 
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
 
 #include <openssl/hmac.h>
 #include <openssl/cmac.h>
@@ -37,10 +44,56 @@
 #define _ODP_HAVE_CHACHA20_POLY1305 0
 #endif
 
+/* Multi-buffer AES-CBC encryption with AES-NI instructions. CPU support is
+ * checked at run time. Other algorithms, including AES-GCM, are processed
+ * per packet: OpenSSL AES-GCM already interleaves CTR blocks and GHASH
+ * within a packet, so there is no idle pipeline to fill across packets. */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define _ODP_HAVE_AESNI_MB 1
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+#else
+#define _ODP_HAVE_AESNI_MB 0
+#endif
+
 #define MAX_SESSIONS 32
 #define AES_BLOCK_SIZE 16
 #define AES_KEY_LENGTH 16
 
+/* Maximum number of packets processed in parallel by multi-buffer
+ * algorithms */
+#define MB_MAX_BURST 8
+
+/* Maximum number of AES rounds (AES-256) */
+#define AES_MAX_ROUNDS 14
+
+/* Maximum number of crypto service threads */
+#define ASYNC_MAX_THREADS 16
+
+/* Number of asynchronous operations in flight. Must be a power of two. */
+#define ASYNC_NUM_OPS 1024
+
+/* Operation index ring size. Rings must be larger than the number of
+ * indexes stored in them. */
+#define ASYNC_RING_SIZE (2 * ASYNC_NUM_OPS)
+
+/* Maximum number of operations a service thread processes at a time */
+#define ASYNC_BURST 32
+
+/* Maximum AAD length of an asynchronous operation */
+#define ASYNC_AAD_LEN 32
+
+/* Number of empty request polls before an idle service thread starts to
+ * sleep between polls */
+#define ASYNC_IDLE_POLLS 1000
+
+/* Initial and maximum sleep time of an idle service thread in nanoseconds.
+ * Sleep time doubles on each empty poll up to the maximum. */
+#define ASYNC_IDLE_SLEEP_MIN_NS 1000
+#define ASYNC_IDLE_SLEEP_MAX_NS 100000
+
 /*
  * Cipher algorithm capabilities
  *
@@ -218,6 +271,14 @@ struct odp_crypto_generic_session_t {
 		const EVP_CIPHER *evp_cipher;
 		crypto_func_t func;
 		crypto_init_func_t init;
+
+		/* Multi-buffer processing is used for packet bursts */
+		odp_bool_t mb;
+		int mb_rounds;
+
+		/* Expanded round keys for multi-buffer processing */
+		uint8_t mb_round_key[AES_MAX_ROUNDS + 1][AES_BLOCK_SIZE]
+			ODP_ALIGNED(16);
 	} cipher;
 
 	struct {
@@ -232,8 +293,54 @@ struct odp_crypto_generic_session_t {
 	} auth;
 
 	unsigned idx;
+
+	/* Asynchronous operations in flight in service threads */
+	odp_atomic_u32_t async_ops;
 };
 
+/* Asynchronous operation passed to a service thread */
+typedef struct {
+	odp_packet_t pkt_in;
+	odp_packet_t pkt_out;
+	odp_crypto_packet_op_param_t param;
+
+	/* Copies of per packet data that the application may reuse after
+	 * the enqueue call */
+	uint8_t cipher_iv[EVP_MAX_IV_LENGTH];
+	uint8_t auth_iv[EVP_MAX_IV_LENGTH];
+	uint8_t aad[ASYNC_AAD_LEN];
+} crypto_async_op_t;
+
+typedef struct ODP_ALIGNED_CACHE {
+	/* Ring header */
+	ring_u32_t ring;
+
+	/* Ring data: operation indexes */
+	uint32_t op_index[ASYNC_RING_SIZE];
+} crypto_async_ring_t;
+
+/* Crypto service thread pool */
+typedef struct {
+	/* Free operations */
+	crypto_async_ring_t free;
+
+	/* Operation request ring per service thread */
+	crypto_async_ring_t req[ASYNC_MAX_THREADS];
+
+	crypto_async_op_t op[ASYNC_NUM_OPS];
+
+	odp_spinlock_t lock;
+	int started;
+	int num_threads;
+	int num_cpus;
+	int cpu[ASYNC_MAX_THREADS];
+	pthread_t thread[ASYNC_MAX_THREADS];
+	odp_atomic_u32_t num_ready;
+	odp_atomic_u32_t num_failed;
+	odp_atomic_u32_t exit;
+	odp_shm_t shm;
+} crypto_async_t;
+
 typedef struct odp_crypto_global_s odp_crypto_global_t;
 
 struct odp_crypto_global_s {
@@ -241,6 +348,13 @@ struct odp_crypto_global_s {
 	odp_crypto_generic_session_t *free;
 	odp_crypto_generic_session_t  sessions[MAX_SESSIONS];
 
+	/* CPU supports AES-NI instructions */
+	odp_bool_t aesni;
+
+	/* Service thread pool for asynchronous operations. NULL when
+	 * operations are processed by the calling thread. */
+	crypto_async_t *async;
+
 	/* These flags are cleared at alloc_session() */
 	uint8_t ctx_valid[ODP_THREAD_COUNT_MAX][MAX_SESSIONS];
 
@@ -1078,6 +1192,233 @@ odp_crypto_alg_err_t cipher_decrypt(odp_packet_t pkt,
 			  ODP_CRYPTO_ALG_ERR_NONE;
 }
 
+/* Packet data of one multi-buffer lane */
+typedef struct {
+	uint8_t *data;
+	const uint8_t *iv;
+	uint32_t num_blk;
+} mb_lane_t;
+
+#if _ODP_HAVE_AESNI_MB
+#define AES_KGA(key, rcon, shuf) \
+	_mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, rcon), shuf)
+
+static inline AESNI_TARGET __m128i aes_key_mix(__m128i key, __m128i kga)
+{
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+
+	return _mm_xor_si128(key, kga);
+}
+
+static AESNI_TARGET void aesni_key_expand_128(const uint8_t *key,
+					      __m128i rk[])
+{
+	rk[0]  = _mm_loadu_si128((const __m128i *)key);
+	rk[1]  = aes_key_mix(rk[0], AES_KGA(rk[0], 0x01, 0xff));
+	rk[2]  = aes_key_mix(rk[1], AES_KGA(rk[1], 0x02, 0xff));
+	rk[3]  = aes_key_mix(rk[2], AES_KGA(rk[2], 0x04, 0xff));
+	rk[4]  = aes_key_mix(rk[3], AES_KGA(rk[3], 0x08, 0xff));
+	rk[5]  = aes_key_mix(rk[4], AES_KGA(rk[4], 0x10, 0xff));
+	rk[6]  = aes_key_mix(rk[5], AES_KGA(rk[5], 0x20, 0xff));
+	rk[7]  = aes_key_mix(rk[6], AES_KGA(rk[6], 0x40, 0xff));
+	rk[8]  = aes_key_mix(rk[7], AES_KGA(rk[7], 0x80, 0xff));
+	rk[9]  = aes_key_mix(rk[8], AES_KGA(rk[8], 0x1b, 0xff));
+	rk[10] = aes_key_mix(rk[9], AES_KGA(rk[9], 0x36, 0xff));
+}
+
+static AESNI_TARGET void aesni_key_expand_256(const uint8_t *key,
+					      __m128i rk[])
+{
+	rk[0]  = _mm_loadu_si128((const __m128i *)key);
+	rk[1]  = _mm_loadu_si128((const __m128i *)(key + AES_BLOCK_SIZE));
+	rk[2]  = aes_key_mix(rk[0],  AES_KGA(rk[1],  0x01, 0xff));
+	rk[3]  = aes_key_mix(rk[1],  AES_KGA(rk[2],  0x00, 0xaa));
+	rk[4]  = aes_key_mix(rk[2],  AES_KGA(rk[3],  0x02, 0xff));
+	rk[5]  = aes_key_mix(rk[3],  AES_KGA(rk[4],  0x00, 0xaa));
+	rk[6]  = aes_key_mix(rk[4],  AES_KGA(rk[5],  0x04, 0xff));
+	rk[7]  = aes_key_mix(rk[5],  AES_KGA(rk[6],  0x00, 0xaa));
+	rk[8]  = aes_key_mix(rk[6],  AES_KGA(rk[7],  0x08, 0xff));
+	rk[9]  = aes_key_mix(rk[7],  AES_KGA(rk[8],  0x00, 0xaa));
+	rk[10] = aes_key_mix(rk[8],  AES_KGA(rk[9],  0x10, 0xff));
+	rk[11] = aes_key_mix(rk[9],  AES_KGA(rk[10], 0x00, 0xaa));
+	rk[12] = aes_key_mix(rk[10], AES_KGA(rk[11], 0x20, 0xff));
+	rk[13] = aes_key_mix(rk[11], AES_KGA(rk[12], 0x00, 0xaa));
+	rk[14] = aes_key_mix(rk[12], AES_KGA(rk[13], 0x40, 0xff));
+}
+
+/* Encrypt multiple buffers in CBC mode. CBC encryption is serial within a
+ * buffer, so a single buffer leaves most of the AES unit pipeline idle.
+ * Rounds of up to MB_MAX_BURST independent buffers are interleaved to fill
+ * the pipeline. Lanes that run out of data are dropped and the remaining
+ * lanes continue. */
+static AESNI_TARGET void aesni_cbc_enc_mb(const uint8_t *round_key,
+					  int rounds, mb_lane_t lane[],
+					  int num)
+{
+	const __m128i *rk = (const __m128i *)(uintptr_t)round_key;
+	__m128i state[MB_MAX_BURST];
+	uint8_t *data[MB_MAX_BURST];
+	uint32_t left[MB_MAX_BURST];
+	uint32_t i, blk, min_blk;
+	uint32_t num_active = 0;
+	int r;
+
+	for (i = 0; i < (uint32_t)num; i++) {
+		if (lane[i].num_blk == 0)
+			continue;
+
+		state[num_active] = _mm_loadu_si128((const __m128i *)
+						    (uintptr_t)lane[i].iv);
+		data[num_active]  = lane[i].data;
+		left[num_active]  = lane[i].num_blk;
+		num_active++;
+	}
+
+	while (num_active) {
+		min_blk = left[0];
+		for (i = 1; i < num_active; i++)
+			if (left[i] < min_blk)
+				min_blk = left[i];
+
+		for (blk = 0; blk < min_blk; blk++) {
+			for (i = 0; i < num_active; i++) {
+				__m128i in;
+
+				in = _mm_loadu_si128((__m128i *)data[i]);
+				state[i] = _mm_xor_si128(state[i], in);
+				state[i] = _mm_xor_si128(state[i], rk[0]);
+			}
+
+			for (r = 1; r < rounds; r++) {
+				__m128i key = rk[r];
+
+				for (i = 0; i < num_active; i++)
+					state[i] = _mm_aesenc_si128(state[i],
+								    key);
+			}
+
+			for (i = 0; i < num_active; i++) {
+				state[i] = _mm_aesenclast_si128(state[i],
+								rk[rounds]);
+				_mm_storeu_si128((__m128i *)data[i], state[i]);
+				data[i] += AES_BLOCK_SIZE;
+			}
+		}
+
+		/* Drop completed lanes */
+		for (i = 0; i < num_active;) {
+			left[i] -= min_blk;
+
+			if (left[i]) {
+				i++;
+				continue;
+			}
+
+			num_active--;
+			state[i] = state[num_active];
+			data[i]  = data[num_active];
+			left[i]  = left[num_active];
+		}
+	}
+}
+
+static int aesni_supported(void)
+{
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return 0;
+
+	return (ecx & bit_AES) ? 1 : 0;
+}
+#endif
+
+static void process_cipher_mb_param(odp_crypto_generic_session_t *session)
+{
+	session->cipher.mb = false;
+
+#if _ODP_HAVE_AESNI_MB
+	if (!global->aesni || ODP_CRYPTO_OP_ENCODE != session->p.op)
+		return;
+
+	if (session->p.cipher_key.length == 16) {
+		aesni_key_expand_128(session->cipher.key_data,
+				     (__m128i *)session->cipher.mb_round_key);
+		session->cipher.mb_rounds = 10;
+	} else if (session->p.cipher_key.length == 32) {
+		aesni_key_expand_256(session->cipher.key_data,
+				     (__m128i *)session->cipher.mb_round_key);
+		session->cipher.mb_rounds = 14;
+	} else {
+		return;
+	}
+
+	session->cipher.mb = true;
+#endif
+}
+
+/* Check if packet cipher operation can be done in a multi-buffer lane. Cipher
+ * range must be contiguous in memory and consist of full blocks. */
+static int cipher_mb_lane(odp_packet_t pkt,
+			  const odp_crypto_packet_op_param_t *param,
+			  odp_crypto_generic_session_t *session,
+			  mb_lane_t *lane)
+{
+	uint32_t offset = param->cipher_range.offset;
+	uint32_t len = param->cipher_range.length;
+	uint32_t seglen = 0;
+	uint8_t *data;
+
+	if (len == 0 || len % AES_BLOCK_SIZE)
+		return 0;
+
+	if (param->cipher_iv_ptr)
+		lane->iv = param->cipher_iv_ptr;
+	else if (session->p.cipher_iv.data)
+		lane->iv = session->cipher.iv_data;
+	else
+		return 0;
+
+	data = odp_packet_offset(pkt, offset, &seglen, NULL);
+	if (data == NULL || seglen < len)
+		return 0;
+
+	lane->data    = data;
+	lane->num_blk = len / AES_BLOCK_SIZE;
+
+	return 1;
+}
+
+/* Cipher a burst of packets of the same session. Packets that cannot be
+ * processed with multi-buffer algorithm are processed one by one. */
+static void cipher_mb(odp_packet_t pkt[],
+		      const odp_crypto_packet_op_param_t param[],
+		      odp_crypto_generic_session_t *session,
+		      odp_crypto_alg_err_t rc[], int num)
+{
+	mb_lane_t lane[MB_MAX_BURST];
+	int i, num_lane = 0;
+
+	for (i = 0; i < num; i++) {
+		if (cipher_mb_lane(pkt[i], &param[i], session,
+				   &lane[num_lane])) {
+			rc[i] = ODP_CRYPTO_ALG_ERR_NONE;
+			num_lane++;
+			continue;
+		}
+
+		rc[i] = session->cipher.func(pkt[i], &param[i], session);
+	}
+
+#if _ODP_HAVE_AESNI_MB
+	if (num_lane)
+		aesni_cbc_enc_mb(&session->cipher.mb_round_key[0][0],
+				 session->cipher.mb_rounds, lane, num_lane);
+#endif
+}
+
 static int process_cipher_param(odp_crypto_generic_session_t *session,
 				const EVP_CIPHER *cipher)
 {
@@ -2075,6 +2416,11 @@ int odp_crypto_auth_capability(odp_auth_alg_t auth,
 	return num;
 }
 
+/* Crypto service thread pool functions */
+static int crypto_async_start(crypto_async_t *async);
+static int crypto_async_init_global(void);
+static int crypto_async_term_global(void);
+
 int
 odp_crypto_session_create(const odp_crypto_session_param_t *param,
 			  odp_crypto_session_t *session_out,
@@ -2102,6 +2448,8 @@ odp_crypto_session_create(const odp_crypto_session_param_t *param,
 
 	/* Copy parameters */
 	session->p = *param;
+	session->cipher.mb = false;
+	odp_atomic_init_u32(&session->async_ops, 0);
 
 	if (session->p.cipher_iv.length > EVP_MAX_IV_LENGTH) {
 		ODP_DBG("Maximum IV length exceeded\n");
@@ -2160,6 +2508,9 @@ odp_crypto_session_create(const odp_crypto_session_param_t *param,
 			rc = process_cipher_param(session, EVP_aes_256_cbc());
 		else
 			rc = -1;
+
+		if (rc == 0)
+			process_cipher_mb_param(session);
 		break;
 	case ODP_CIPHER_ALG_AES_CTR:
 		if (param->cipher_key.length == 16)
@@ -2413,6 +2764,18 @@ odp_crypto_session_create(const odp_crypto_session_param_t *param,
 		goto err;
 	}
 
+	if (ODP_CRYPTO_ASYNC == param->op_mode && global->async) {
+		if (param->auth_aad_len > ASYNC_AAD_LEN) {
+			*status = ODP_CRYPTO_SES_CREATE_ERR_INV_AUTH;
+			goto err;
+		}
+
+		if (crypto_async_start(global->async)) {
+			*status = ODP_CRYPTO_SES_CREATE_ERR_ENOMEM;
+			goto err;
+		}
+	}
+
 	/* We're happy */
 	*session_out = (intptr_t)session;
 	*status = ODP_CRYPTO_SES_CREATE_ERR_NONE;
@@ -2431,6 +2794,12 @@ int odp_crypto_session_destroy(odp_crypto_session_t session)
 	odp_crypto_generic_session_t *generic;
 
 	generic = (odp_crypto_generic_session_t *)(intptr_t)session;
+
+	/* Wait until service threads have completed all operations of the
+	 * session */
+	while (odp_atomic_load_acq_u32(&generic->async_ops))
+		odp_cpu_pause();
+
 	memset(generic, 0, sizeof(*generic));
 	free_session(generic);
 	return 0;
@@ -2542,6 +2911,10 @@ int _odp_crypto_init_global(void)
 	}
 	odp_spinlock_init(&global->lock);
 
+#if _ODP_HAVE_AESNI_MB
+	global->aesni = aesni_supported();
+#endif
+
 	if (nlocks > 0) {
 		for (idx = 0; idx < nlocks; idx++)
 			odp_ticketlock_init(&global->openssl_lock[idx]);
@@ -2552,6 +2925,11 @@ int _odp_crypto_init_global(void)
 #endif
 	}
 
+	if (crypto_async_init_global()) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -2565,6 +2943,9 @@ int _odp_crypto_term_global(void)
 	if (odp_global_ro.disable.crypto)
 		return 0;
 
+	if (crypto_async_term_global())
+		rc = -1;
+
 	for (session = global->free; session != NULL; session = session->next)
 		count++;
 	if (count != MAX_SESSIONS) {
@@ -2727,20 +3108,14 @@ int odp_crypto_result(odp_crypto_packet_result_t *result,
 	return 0;
 }
 
+/* Resolve output packet and copy input data into it */
 static
-int crypto_int(odp_packet_t pkt_in,
-	       odp_packet_t *pkt_out,
-	       const odp_crypto_packet_op_param_t *param)
+int crypto_int_output(odp_packet_t pkt_in,
+		      odp_packet_t *pkt_out,
+		      odp_crypto_generic_session_t *session)
 {
-	odp_crypto_alg_err_t rc_cipher = ODP_CRYPTO_ALG_ERR_NONE;
-	odp_crypto_alg_err_t rc_auth = ODP_CRYPTO_ALG_ERR_NONE;
-	odp_crypto_generic_session_t *session;
 	odp_bool_t allocated = false;
 	odp_packet_t out_pkt = *pkt_out;
-	odp_crypto_packet_result_t *op_result;
-	odp_packet_hdr_t *pkt_hdr;
-
-	session = (odp_crypto_generic_session_t *)(intptr_t)param->session;
 
 	/* Resolve output buffer */
 	if (ODP_PACKET_INVALID == out_pkt &&
@@ -2771,20 +3146,29 @@ int crypto_int(odp_packet_t pkt_in,
 		pkt_in = ODP_PACKET_INVALID;
 	}
 
-	crypto_init(session);
+	*pkt_out = out_pkt;
 
-	/* Invoke the functions */
-	if (session->do_cipher_first) {
-		rc_cipher = session->cipher.func(out_pkt, param, session);
-		rc_auth = session->auth.func(out_pkt, param, session);
-	} else {
-		rc_auth = session->auth.func(out_pkt, param, session);
-		rc_cipher = session->cipher.func(out_pkt, param, session);
+	return 0;
+
+err:
+	if (allocated) {
+		odp_packet_free(out_pkt);
+		*pkt_out = ODP_PACKET_INVALID;
 	}
 
-	/* Fill in result */
-	packet_subtype_set(out_pkt, ODP_EVENT_PACKET_CRYPTO);
-	op_result = get_op_result_from_packet(out_pkt);
+	return -1;
+}
+
+static
+void crypto_int_result(odp_packet_t pkt,
+		       odp_crypto_alg_err_t rc_cipher,
+		       odp_crypto_alg_err_t rc_auth)
+{
+	odp_crypto_packet_result_t *op_result;
+	odp_packet_hdr_t *pkt_hdr;
+
+	packet_subtype_set(pkt, ODP_EVENT_PACKET_CRYPTO);
+	op_result = get_op_result_from_packet(pkt);
 	op_result->cipher_status.alg_err = rc_cipher;
 	op_result->cipher_status.hw_err = ODP_CRYPTO_HW_ERR_NONE;
 	op_result->auth_status.alg_err = rc_auth;
@@ -2793,21 +3177,145 @@ int crypto_int(odp_packet_t pkt_in,
 		(rc_cipher == ODP_CRYPTO_ALG_ERR_NONE) &&
 		(rc_auth == ODP_CRYPTO_ALG_ERR_NONE);
 
-	pkt_hdr = packet_hdr(out_pkt);
+	pkt_hdr = packet_hdr(pkt);
 	pkt_hdr->p.flags.crypto_err = !op_result->ok;
+}
 
-	/* Synchronous, simply return results */
-	*pkt_out = out_pkt;
+/* Fill in result of an operation that could not be processed */
+static
+void crypto_int_error(odp_packet_t pkt, odp_crypto_hw_err_t hw_err)
+{
+	odp_crypto_packet_result_t *op_result;
+
+	packet_subtype_set(pkt, ODP_EVENT_PACKET_CRYPTO);
+	op_result = get_op_result_from_packet(pkt);
+	op_result->cipher_status.alg_err = ODP_CRYPTO_ALG_ERR_NONE;
+	op_result->cipher_status.hw_err = hw_err;
+	op_result->auth_status.alg_err = ODP_CRYPTO_ALG_ERR_NONE;
+	op_result->auth_status.hw_err = hw_err;
+	op_result->ok = false;
+
+	packet_hdr(pkt)->p.flags.crypto_err = 1;
+}
+
+static
+int crypto_int(odp_packet_t pkt_in,
+	       odp_packet_t *pkt_out,
+	       const odp_crypto_packet_op_param_t *param)
+{
+	odp_crypto_alg_err_t rc_cipher = ODP_CRYPTO_ALG_ERR_NONE;
+	odp_crypto_alg_err_t rc_auth = ODP_CRYPTO_ALG_ERR_NONE;
+	odp_crypto_generic_session_t *session;
+	odp_packet_t out_pkt;
+
+	session = (odp_crypto_generic_session_t *)(intptr_t)param->session;
+
+	if (crypto_int_output(pkt_in, pkt_out, session))
+		return -1;
+
+	out_pkt = *pkt_out;
+
+	crypto_init(session);
+
+	/* Invoke the functions */
+	if (session->do_cipher_first) {
+		rc_cipher = session->cipher.func(out_pkt, param, session);
+		rc_auth = session->auth.func(out_pkt, param, session);
+	} else {
+		rc_auth = session->auth.func(out_pkt, param, session);
+		rc_cipher = session->cipher.func(out_pkt, param, session);
+	}
+
+	/* Fill in result */
+	crypto_int_result(out_pkt, rc_cipher, rc_auth);
 
 	return 0;
+}
 
-err:
-	if (allocated) {
-		odp_packet_free(out_pkt);
-		*pkt_out = ODP_PACKET_INVALID;
+/* Process a burst of packets of the same multi-buffer capable session.
+ * Returns number of packets processed. */
+static
+int crypto_int_multi(const odp_packet_t pkt_in[],
+		     odp_packet_t pkt_out[],
+		     const odp_crypto_packet_op_param_t param[],
+		     int num)
+{
+	odp_crypto_alg_err_t rc_cipher[MB_MAX_BURST];
+	odp_crypto_alg_err_t rc_auth[MB_MAX_BURST];
+	odp_crypto_generic_session_t *session;
+	int i;
+
+	session = (odp_crypto_generic_session_t *)(intptr_t)param[0].session;
+
+	for (i = 0; i < num; i++) {
+		if (crypto_int_output(pkt_in[i], &pkt_out[i], session))
+			break;
 	}
 
-	return -1;
+	num = i;
+	if (odp_unlikely(num == 0))
+		return 0;
+
+	crypto_init(session);
+
+	if (!session->do_cipher_first)
+		for (i = 0; i < num; i++)
+			rc_auth[i] = session->auth.func(pkt_out[i], &param[i],
+							session);
+
+	cipher_mb(pkt_out, param, session, rc_cipher, num);
+
+	if (session->do_cipher_first)
+		for (i = 0; i < num; i++)
+			rc_auth[i] = session->auth.func(pkt_out[i], &param[i],
+							session);
+
+	for (i = 0; i < num; i++)
+		crypto_int_result(pkt_out[i], rc_cipher[i], rc_auth[i]);
+
+	return num;
+}
+
+/* Process a burst of packets. Returns number of packets processed. Used by
+ * odp_crypto_op() and odp_crypto_op_enq(). IPsec processes one packet per
+ * crypto operation and does not benefit from multi-buffer processing. */
+static int crypto_op_burst(const odp_packet_t pkt_in[],
+			   odp_packet_t pkt_out[],
+			   const odp_crypto_packet_op_param_t param[],
+			   int num_pkt)
+{
+	int i, rc, num;
+	odp_crypto_generic_session_t *session;
+
+	for (i = 0; i < num_pkt;) {
+		session = (odp_crypto_generic_session_t *)(intptr_t)
+			  param[i].session;
+
+		/* Consecutive packets of the same session are processed
+		 * together */
+		num = 1;
+		if (session->cipher.mb) {
+			while (i + num < num_pkt && num < MB_MAX_BURST &&
+			       param[i + num].session == param[i].session)
+				num++;
+		}
+
+		if (num > 1) {
+			rc = crypto_int_multi(&pkt_in[i], &pkt_out[i],
+					      &param[i], num);
+			i += rc;
+			if (rc < num)
+				break;
+			continue;
+		}
+
+		rc = crypto_int(pkt_in[i], &pkt_out[i], &param[i]);
+		if (rc < 0)
+			break;
+		i++;
+	}
+
+	return i;
 }
 
 int odp_crypto_op(const odp_packet_t pkt_in[],
@@ -2815,19 +3323,421 @@ int odp_crypto_op(const odp_packet_t pkt_in[],
 		  const odp_crypto_packet_op_param_t param[],
 		  int num_pkt)
 {
-	int i, rc;
 	odp_crypto_generic_session_t *session;
 
 	session = (odp_crypto_generic_session_t *)(intptr_t)param->session;
 	ODP_ASSERT(ODP_CRYPTO_SYNC == session->p.op_mode);
 
-	for (i = 0; i < num_pkt; i++) {
-		rc = crypto_int(pkt_in[i], &pkt_out[i], &param[i]);
-		if (rc < 0)
+	return crypto_op_burst(pkt_in, pkt_out, param, num_pkt);
+}
+
+/* Deliver completion events. Consecutive events to the same queue are
+ * enqueued together. */
+static void crypto_async_deliver(odp_packet_t pkt[],
+				 const odp_crypto_packet_op_param_t param[],
+				 int num)
+{
+	odp_crypto_generic_session_t *session;
+	odp_event_t ev[ASYNC_BURST];
+	odp_queue_t queue, next;
+	int i, num_ev, ret;
+
+	for (i = 0; i < num;) {
+		if (pkt[i] == ODP_PACKET_INVALID) {
+			i++;
+			continue;
+		}
+
+		session = (odp_crypto_generic_session_t *)(intptr_t)
+			  param[i].session;
+		queue = session->p.compl_queue;
+		num_ev = 0;
+
+		while (i < num) {
+			if (pkt[i] != ODP_PACKET_INVALID) {
+				session = (odp_crypto_generic_session_t *)
+					  (intptr_t)param[i].session;
+				next = session->p.compl_queue;
+
+				if (next != queue)
+					break;
+
+				ev[num_ev++] = odp_packet_to_event(pkt[i]);
+			}
+			i++;
+		}
+
+		ret = odp_queue_enq_multi(queue, ev, num_ev);
+		if (odp_unlikely(ret < 0))
+			ret = 0;
+
+		if (odp_unlikely(ret < num_ev)) {
+			ODP_DBG("Completion enqueue failed, %i events dropped\n",
+				num_ev - ret);
+			odp_event_free_multi(&ev[ret], num_ev - ret);
+		}
+	}
+}
+
+/* Process asynchronous operations in a service thread */
+static void crypto_async_process(crypto_async_t *async, uint32_t op_idx[],
+				 int num)
+{
+	odp_packet_t pkt_in[ASYNC_BURST];
+	odp_packet_t pkt_out[ASYNC_BURST];
+	odp_crypto_packet_op_param_t param[ASYNC_BURST];
+	odp_crypto_generic_session_t *session[ASYNC_BURST];
+	crypto_async_op_t *op;
+	int i, rc;
+
+	for (i = 0; i < num; i++) {
+		op = &async->op[op_idx[i]];
+		pkt_in[i]  = op->pkt_in;
+		pkt_out[i] = op->pkt_out;
+		param[i]   = op->param;
+		session[i] = (odp_crypto_generic_session_t *)(intptr_t)
+			     op->param.session;
+	}
+
+	for (i = 0; i < num;) {
+		rc = crypto_op_burst(&pkt_in[i], &pkt_out[i], &param[i],
+				     num - i);
+		i += rc;
+
+		if (i == num)
 			break;
+
+		/* Output packet could not be allocated or copied. Input
+		 * packet is returned with an error result, since the
+		 * operation was already accepted by odp_crypto_op_enq(). */
+		ODP_DBG("Crypto operation failed\n");
+		op = &async->op[op_idx[i]];
+		if (op->pkt_out != ODP_PACKET_INVALID &&
+		    op->pkt_out != op->pkt_in)
+			odp_packet_free(op->pkt_out);
+		crypto_int_error(op->pkt_in, ODP_CRYPTO_HW_ERR_BP_DEPLETED);
+		pkt_out[i] = op->pkt_in;
+		i++;
 	}
 
-	return i;
+	/* Operation data (e.g. IV copies) is not needed anymore */
+	ring_u32_enq_multi(&async->free.ring, ASYNC_RING_SIZE - 1, op_idx, num);
+
+	crypto_async_deliver(pkt_out, param, num);
+
+	for (i = 0; i < num; i++)
+		odp_atomic_sub_rel_u32(&session[i]->async_ops, 1);
+}
+
+static void *crypto_async_thread(void *arg)
+{
+	crypto_async_t *async = global->async;
+	crypto_async_ring_t *req = &async->req[(uintptr_t)arg];
+	uint32_t op_idx[ASYNC_BURST];
+	uint32_t num;
+	uint32_t idle = 0;
+	struct timespec ts = {0, ASYNC_IDLE_SLEEP_MIN_NS};
+
+	if (odp_init_local((odp_instance_t)odp_global_ro.main_pid,
+			   ODP_THREAD_CONTROL)) {
+		ODP_ERR("Crypto service thread local init failed\n");
+		odp_atomic_inc_u32(&async->num_failed);
+		return NULL;
+	}
+
+	odp_atomic_inc_u32(&async->num_ready);
+
+	while (1) {
+		num = ring_u32_deq_multi(&req->ring, ASYNC_RING_SIZE - 1, op_idx,
+					 ASYNC_BURST);
+
+		if (num == 0) {
+			/* Requests are drained before exit */
+			if (odp_atomic_load_acq_u32(&async->exit))
+				break;
+
+			/* Back off from busy polling when idle */
+			if (idle < ASYNC_IDLE_POLLS) {
+				idle++;
+				odp_cpu_pause();
+				continue;
+			}
+
+			nanosleep(&ts, NULL);
+			if (ts.tv_nsec < ASYNC_IDLE_SLEEP_MAX_NS)
+				ts.tv_nsec *= 2;
+			continue;
+		}
+
+		idle = 0;
+		ts.tv_nsec = ASYNC_IDLE_SLEEP_MIN_NS;
+		crypto_async_process(async, op_idx, num);
+	}
+
+	if (odp_term_local() < 0)
+		ODP_ERR("Crypto service thread local term failed\n");
+
+	return NULL;
+}
+
+static void crypto_async_stop(crypto_async_t *async)
+{
+	int i;
+
+	odp_atomic_store_rel_u32(&async->exit, 1);
+
+	for (i = 0; i < async->started; i++) {
+		if (pthread_join(async->thread[i], NULL))
+			ODP_ERR("Crypto service thread join failed\n");
+	}
+
+	async->started = 0;
+}
+
+/* Start service threads on first asynchronous session creation */
+static int crypto_async_start(crypto_async_t *async)
+{
+	pthread_attr_t attr;
+	cpu_set_t cpu_set;
+	int i, ret = 0;
+
+	odp_spinlock_lock(&async->lock);
+
+	if (async->started)
+		goto unlock;
+
+	odp_atomic_store_u32(&async->exit, 0);
+
+	for (i = 0; i < async->num_threads; i++) {
+		pthread_attr_init(&attr);
+
+		if (async->num_cpus) {
+			CPU_ZERO(&cpu_set);
+			CPU_SET(async->cpu[i % async->num_cpus], &cpu_set);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+						    &cpu_set);
+		}
+
+		ret = pthread_create(&async->thread[i], &attr,
+				     crypto_async_thread, (void *)(uintptr_t)i);
+		pthread_attr_destroy(&attr);
+
+		if (ret) {
+			ODP_ERR("Crypto service thread create failed: %i\n",
+				ret);
+			break;
+		}
+
+		async->started++;
+	}
+
+	/* Wait until all threads have been initialized */
+	while (odp_atomic_load_u32(&async->num_ready) +
+	       odp_atomic_load_u32(&async->num_failed) <
+	       (uint32_t)async->started)
+		odp_cpu_pause();
+
+	if (async->started < async->num_threads ||
+	    odp_atomic_load_u32(&async->num_failed)) {
+		crypto_async_stop(async);
+		odp_atomic_init_u32(&async->num_ready, 0);
+		odp_atomic_init_u32(&async->num_failed, 0);
+		ret = -1;
+	}
+
+unlock:
+	odp_spinlock_unlock(&async->lock);
+	return ret;
+}
+
+/* Pass operations to service threads. All operations of a session are
+ * processed by the same thread, which maintains operation order within
+ * a session. */
+static int crypto_async_enq(crypto_async_t *async,
+			    const odp_packet_t pkt_in[],
+			    const odp_packet_t pkt_out[],
+			    const odp_crypto_packet_op_param_t param[],
+			    int num_pkt)
+{
+	odp_crypto_generic_session_t *session;
+	const odp_crypto_packet_op_param_t *prm;
+	crypto_async_op_t *op;
+	uint32_t op_idx[ASYNC_BURST];
+	int i, j, first, num, thr, next_thr;
+	int num_enq = 0;
+
+	while (num_enq < num_pkt) {
+		num = num_pkt - num_enq;
+		if (num > ASYNC_BURST)
+			num = ASYNC_BURST;
+
+		num = ring_u32_deq_multi(&async->free.ring, ASYNC_RING_SIZE - 1,
+					 op_idx, num);
+		if (num == 0)
+			break;
+
+		for (i = 0; i < num; i++) {
+			prm = &param[num_enq + i];
+			session = (odp_crypto_generic_session_t *)(intptr_t)
+				  prm->session;
+			op = &async->op[op_idx[i]];
+
+			op->pkt_in  = pkt_in[num_enq + i];
+			op->pkt_out = pkt_out[num_enq + i];
+			op->param   = *prm;
+			odp_atomic_inc_u32(&session->async_ops);
+
+			if (prm->cipher_iv_ptr) {
+				memcpy(op->cipher_iv, prm->cipher_iv_ptr,
+				       session->p.cipher_iv.length);
+				op->param.cipher_iv_ptr = op->cipher_iv;
+			}
+
+			if (prm->auth_iv_ptr) {
+				memcpy(op->auth_iv, prm->auth_iv_ptr,
+				       session->p.auth_iv.length);
+				op->param.auth_iv_ptr = op->auth_iv;
+			}
+
+			if (prm->aad_ptr) {
+				memcpy(op->aad, prm->aad_ptr,
+				       session->p.auth_aad_len);
+				op->param.aad_ptr = op->aad;
+			}
+		}
+
+		/* Enqueue runs of operations to the same service thread */
+		for (i = 0; i < num;) {
+			session = (odp_crypto_generic_session_t *)(intptr_t)
+				  param[num_enq + i].session;
+			thr = session->idx % async->num_threads;
+			first = i;
+
+			for (j = i + 1; j < num; j++) {
+				session = (odp_crypto_generic_session_t *)
+					  (intptr_t)param[num_enq + j].session;
+				next_thr = session->idx % async->num_threads;
+
+				if (next_thr != thr)
+					break;
+			}
+
+			ring_u32_enq_multi(&async->req[thr].ring,
+					   ASYNC_RING_SIZE - 1, &op_idx[first],
+					   j - first);
+			i = j;
+		}
+
+		num_enq += num;
+	}
+
+	return num_enq;
+}
+
+static int read_config_file(crypto_async_t *async)
+{
+	const char *str;
+	int val = 0;
+	int i;
+
+	str = "crypto.async_threads";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > ASYNC_MAX_THREADS) {
+		ODP_ERR("Bad value %s = %i [min: 0, max: %i]\n", str, val,
+			ASYNC_MAX_THREADS);
+		return -1;
+	}
+
+	async->num_threads = val;
+
+	str = "crypto.async_cpus";
+	val = _odp_libconfig_lookup_array(str, async->cpu, ASYNC_MAX_THREADS);
+	if (val < 0) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	for (i = 0; i < val; i++) {
+		if (async->cpu[i] < 0 || async->cpu[i] >= CPU_SETSIZE) {
+			ODP_ERR("Bad CPU %i in %s\n", async->cpu[i], str);
+			return -1;
+		}
+	}
+
+	async->num_cpus = val;
+
+	return 0;
+}
+
+static int crypto_async_init_global(void)
+{
+	crypto_async_t async_cfg;
+	crypto_async_t *async;
+	odp_shm_t shm;
+	uint32_t i;
+
+	memset(&async_cfg, 0, sizeof(async_cfg));
+
+	if (read_config_file(&async_cfg))
+		return -1;
+
+	if (async_cfg.num_threads == 0)
+		return 0;
+
+	shm = odp_shm_reserve("_odp_crypto_async", sizeof(crypto_async_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODP_ERR("Crypto async shm reserve failed\n");
+		return -1;
+	}
+
+	async = odp_shm_addr(shm);
+	memset(async, 0, sizeof(crypto_async_t));
+
+	async->shm = shm;
+	async->num_threads = async_cfg.num_threads;
+	async->num_cpus = async_cfg.num_cpus;
+	memcpy(async->cpu, async_cfg.cpu, sizeof(async->cpu));
+
+	odp_spinlock_init(&async->lock);
+	odp_atomic_init_u32(&async->num_ready, 0);
+	odp_atomic_init_u32(&async->num_failed, 0);
+	odp_atomic_init_u32(&async->exit, 0);
+
+	ring_u32_init(&async->free.ring);
+	for (i = 0; i < ASYNC_MAX_THREADS; i++)
+		ring_u32_init(&async->req[i].ring);
+
+	for (i = 0; i < ASYNC_NUM_OPS; i++)
+		ring_u32_enq(&async->free.ring, ASYNC_RING_SIZE - 1, i);
+
+	global->async = async;
+
+	ODP_PRINT("Crypto service threads: %i\n", async->num_threads);
+
+	return 0;
+}
+
+static int crypto_async_term_global(void)
+{
+	crypto_async_t *async = global->async;
+
+	if (async == NULL)
+		return 0;
+
+	crypto_async_stop(async);
+	global->async = NULL;
+
+	if (odp_shm_free(async->shm)) {
+		ODP_ERR("Crypto async shm free failed\n");
+		return -1;
+	}
+
+	return 0;
 }
 
 int odp_crypto_op_enq(const odp_packet_t pkt_in[],
@@ -2835,26 +3745,32 @@ int odp_crypto_op_enq(const odp_packet_t pkt_in[],
 		      const odp_crypto_packet_op_param_t param[],
 		      int num_pkt)
 {
-	odp_packet_t pkt;
-	odp_event_t event;
+	odp_packet_t pkt[ASYNC_BURST];
 	odp_crypto_generic_session_t *session;
-	int i, rc;
+	int i, num, rc;
 
 	session = (odp_crypto_generic_session_t *)(intptr_t)param->session;
 	ODP_ASSERT(ODP_CRYPTO_ASYNC == session->p.op_mode);
 	ODP_ASSERT(ODP_QUEUE_INVALID != session->p.compl_queue);
 
-	for (i = 0; i < num_pkt; i++) {
-		pkt = pkt_out[i];
-		rc = crypto_int(pkt_in[i], &pkt, &param[i]);
-		if (rc < 0)
-			break;
+	if (global->async)
+		return crypto_async_enq(global->async, pkt_in, pkt_out, param,
+					num_pkt);
+
+	/* Process in bursts, so that multi-buffer algorithms are used also
+	 * without service threads */
+	for (i = 0; i < num_pkt;) {
+		num = num_pkt - i;
+		if (num > ASYNC_BURST)
+			num = ASYNC_BURST;
 
-		event = odp_packet_to_event(pkt);
-		if (odp_queue_enq(session->p.compl_queue, event)) {
-			odp_event_free(event);
+		memcpy(pkt, &pkt_out[i], num * sizeof(odp_packet_t));
+		rc = crypto_op_burst(&pkt_in[i], pkt, &param[i], num);
+		crypto_async_deliver(pkt, &param[i], rc);
+		i += rc;
+
+		if (rc < num)
 			break;
-		}
 	}
 
 	return i;
@@ -47,6 +47,9 @@ int odp_ipsec_capability(odp_ipsec_capability_t *capa)
 
 	capa->proto_ah = ODP_SUPPORT_YES;
 
+	capa->frag_after = ODP_SUPPORT_YES;
+	capa->frag_before = ODP_SUPPORT_YES;
+
 	capa->max_num_sa = ODP_CONFIG_IPSEC_SAS;
 
 	capa->max_antireplay_ws = IPSEC_ANTIREPLAY_WS;
@@ -814,7 +817,7 @@ err:
 static inline
 uint64_t ipsec_seq_no(ipsec_sa_t *ipsec_sa)
 {
-	return odp_atomic_fetch_add_u64(&ipsec_sa->hot.out.seq, 1);
+	return _odp_ipsec_sa_next_seq(ipsec_sa);
 }
 
 /* Helper for calculating encode length using data length and block size */
@@ -983,6 +986,9 @@ static int ipsec_out_tunnel_ipv6(odp_packet_t *pkt,
 
 #define IPSEC_RANDOM_BUF_SIZE 256
 
+/* Maximum number of fragments per packet in outbound fragmentation */
+#define IPSEC_OUT_MAX_FRAGS 32
+
 static int ipsec_random_data(uint8_t *data, uint32_t len)
 {
 	static __thread uint8_t buffer[IPSEC_RANDOM_BUF_SIZE];
@@ -1561,6 +1567,163 @@ err:
 	return ipsec_sa;
 }
 
+/* Upper bound of bytes added to an IP packet by outbound processing */
+static uint32_t ipsec_out_overhead(const ipsec_sa_t *ipsec_sa,
+				   const odp_ipsec_out_opt_t *opt)
+{
+	uint32_t len;
+
+	if (ODP_IPSEC_ESP == ipsec_sa->proto) {
+		uint32_t pad_block = ipsec_sa->esp_block_len;
+
+		if (pad_block < 4)
+			pad_block = 4;
+
+		len = _ODP_ESPHDR_LEN + ipsec_sa->esp_iv_len + pad_block - 1 +
+		      _ODP_ESPTRL_LEN + ipsec_sa->icv_len;
+		if (ipsec_sa->udp_encap)
+			len += _ODP_UDPHDR_LEN;
+		if (opt->flag.tfc_pad)
+			len += opt->tfc_pad_len;
+	} else {
+		len = _ODP_AHHDR_LEN + ipsec_sa->esp_iv_len + ipsec_sa->icv_len;
+	}
+
+	if (ODP_IPSEC_MODE_TUNNEL == ipsec_sa->mode)
+		len += ipsec_sa->tun_ipv4 ? _ODP_IPV4HDR_LEN : _ODP_IPV6HDR_LEN;
+
+	return len;
+}
+
+/* Fragment packet when its IP length exceeds MTU. On failure, the packet is
+ * output as is with MTU error status. Returns the number of packets
+ * written into 'pkt_out'. */
+static int ipsec_out_frag(odp_packet_t pkt, uint32_t mtu,
+			  odp_packet_t pkt_out[], int max_out,
+			  odp_ipsec_op_status_t *status)
+{
+	uint32_t l3_offset = odp_packet_l3_offset(pkt);
+	int num;
+
+	pkt_out[0] = pkt;
+
+	if (odp_packet_len(pkt) - l3_offset <= mtu)
+		return 1;
+
+	num = _odp_packet_ip_fragment(pkt, l3_offset, mtu, pkt_out, max_out);
+	if (num < 0) {
+		pkt_out[0] = pkt;
+		packet_hdr(pkt)->p.flags.ipsec_err = 1;
+		status->error.mtu = 1;
+		return 1;
+	}
+
+	odp_packet_free(pkt);
+
+	return num;
+}
+
+static void ipsec_out_result(odp_packet_t pkt, ipsec_sa_t *ipsec_sa,
+			     const odp_ipsec_op_status_t *status)
+{
+	odp_ipsec_packet_result_t *result;
+
+	packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
+	result = ipsec_pkt_result(pkt);
+	memset(result, 0, sizeof(*result));
+	result->status = *status;
+	result->sa = ipsec_sa->ipsec_sa_hdl;
+}
+
+/*
+ * Outbound processing of a packet including fragmentation offload. Inner
+ * packets are fragmented only in tunnel mode, in transport mode
+ * ODP_IPSEC_FRAG_BEFORE falls back to fragmenting the resulting packet.
+ * Result metadata is set for all output packets. Packets that do not fit
+ * into 'pkt_out' are output with MTU error status. Returns the number of
+ * output packets (1 ... max_out).
+ */
+static int ipsec_out_pkt(odp_packet_t pkt, odp_ipsec_sa_t sa,
+			 odp_packet_t pkt_out[], int max_out,
+			 const odp_ipsec_out_opt_t *opt,
+			 ipsec_sa_t **ipsec_sa_out)
+{
+	odp_packet_t frag[IPSEC_OUT_MAX_FRAGS];
+	odp_ipsec_op_status_t status;
+	odp_ipsec_frag_mode_t frag_mode;
+	ipsec_sa_t *ipsec_sa;
+	int max_frag = max_out;
+	int num_frag = 1;
+	int num_out = 0;
+	int i;
+
+	if (max_frag > IPSEC_OUT_MAX_FRAGS)
+		max_frag = IPSEC_OUT_MAX_FRAGS;
+
+	ipsec_sa = _odp_ipsec_sa_entry_from_hdl(sa);
+	ODP_ASSERT(NULL != ipsec_sa);
+	*ipsec_sa_out = ipsec_sa;
+
+	frag_mode = opt->flag.frag_mode ? opt->frag_mode :
+					  ipsec_sa->out.frag_mode;
+	frag[0] = pkt;
+
+	if (frag_mode == ODP_IPSEC_FRAG_BEFORE) {
+		uint32_t overhead = ipsec_out_overhead(ipsec_sa, opt);
+
+		if (ODP_IPSEC_MODE_TUNNEL != ipsec_sa->mode ||
+		    opt->flag.tfc_dummy) {
+			frag_mode = ODP_IPSEC_FRAG_AFTER;
+		} else {
+			memset(&status, 0, sizeof(status));
+			if (ipsec_sa->out.mtu > overhead)
+				num_frag = ipsec_out_frag(pkt,
+							  ipsec_sa->out.mtu -
+							  overhead, frag,
+							  max_frag, &status);
+			else
+				status.error.mtu = 1;
+
+			if (status.error.all) {
+				packet_hdr(pkt)->p.flags.ipsec_err = 1;
+				ipsec_out_result(pkt, ipsec_sa, &status);
+				pkt_out[0] = pkt;
+				return 1;
+			}
+		}
+	}
+
+	for (i = 0; i < num_frag && num_out < max_out; i++) {
+		odp_packet_t out;
+		int num, j;
+
+		memset(&status, 0, sizeof(status));
+
+		ipsec_out_single(frag[i], sa, &out, opt, &status);
+
+		if (frag_mode == ODP_IPSEC_FRAG_AFTER && !status.error.all) {
+			num = ipsec_out_frag(out, ipsec_sa->out.mtu,
+					     &pkt_out[num_out],
+					     max_out - num_out, &status);
+		} else {
+			pkt_out[num_out] = out;
+			num = 1;
+		}
+
+		for (j = 0; j < num; j++)
+			ipsec_out_result(pkt_out[num_out + j], ipsec_sa,
+					 &status);
+
+		num_out += num;
+	}
+
+	/* Inner fragments without room in the output array */
+	for (; i < num_frag; i++)
+		odp_packet_free(frag[i]);
+
+	return num_out;
+}
+
 int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in,
 		 odp_packet_t pkt_out[], int *num_out,
 		 const odp_ipsec_in_param_t *param)
@@ -1583,7 +1746,7 @@ int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in,
 		if (0 == param->num_sa) {
 			sa = ODP_IPSEC_SA_INVALID;
 		} else {
-			sa = param->sa[sa_idx++];
+			sa = param->sa[sa_idx];
 			ODP_ASSERT(ODP_IPSEC_SA_INVALID != sa);
 		}
 
@@ -1615,6 +1778,30 @@ int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in,
 
 static odp_ipsec_out_opt_t default_out_opt;
 
+/*
+ * Reserve sequence numbers for all packets of a single SA burst at once,
+ * instead of updating the SA sequence number counter for every packet.
+ */
+static ipsec_sa_t *ipsec_out_burst_start(const odp_ipsec_out_param_t *param,
+					 int num)
+{
+	ipsec_sa_t *ipsec_sa;
+
+	if (param->num_sa != 1 || num <= 1)
+		return NULL;
+
+	ipsec_sa = _odp_ipsec_sa_entry_from_hdl(param->sa[0]);
+	_odp_ipsec_sa_seq_burst_start(ipsec_sa, num);
+
+	return ipsec_sa;
+}
+
+static void ipsec_out_burst_end(ipsec_sa_t *ipsec_sa)
+{
+	if (ipsec_sa)
+		_odp_ipsec_sa_seq_burst_end(ipsec_sa);
+}
+
 int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in,
 		  odp_packet_t pkt_out[], int *num_out,
 		  const odp_ipsec_out_param_t *param)
@@ -1626,20 +1813,20 @@ int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in,
 	unsigned opt_idx = 0;
 	unsigned sa_inc = (param->num_sa > 1) ? 1 : 0;
 	unsigned opt_inc = (param->num_opt > 1) ? 1 : 0;
+	ipsec_sa_t *burst_sa;
 
 	ODP_ASSERT(param->num_sa != 0);
 
+	burst_sa = ipsec_out_burst_start(param, num_in < max_out ?
+					 num_in : max_out);
+
 	while (in_pkt < num_in && out_pkt < max_out) {
 		odp_packet_t pkt = pkt_in[in_pkt];
-		odp_ipsec_op_status_t status;
 		odp_ipsec_sa_t sa;
 		ipsec_sa_t *ipsec_sa;
-		odp_ipsec_packet_result_t *result;
 		const odp_ipsec_out_opt_t *opt;
 
-		memset(&status, 0, sizeof(status));
-
-		sa = param->sa[sa_idx++];
+		sa = param->sa[sa_idx];
 		ODP_ASSERT(ODP_IPSEC_SA_INVALID != sa);
 
 		if (0 == param->num_opt)
@@ -1647,22 +1834,17 @@ int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in,
 		else
 			opt = &param->opt[opt_idx];
 
-		ipsec_sa = ipsec_out_single(pkt, sa, &pkt, opt, &status);
+		out_pkt += ipsec_out_pkt(pkt, sa, &pkt_out[out_pkt],
+					 max_out - out_pkt, opt, &ipsec_sa);
 		ODP_ASSERT(NULL != ipsec_sa);
 
-		packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
-		result = ipsec_pkt_result(pkt);
-		memset(result, 0, sizeof(*result));
-		result->status = status;
-		result->sa = ipsec_sa->ipsec_sa_hdl;
-
-		pkt_out[out_pkt] = pkt;
 		in_pkt++;
-		out_pkt++;
 		sa_idx += sa_inc;
 		opt_idx += opt_inc;
 	}
 
+	ipsec_out_burst_end(burst_sa);
+
 	*num_out = out_pkt;
 
 	return in_pkt;
@@ -1688,7 +1870,7 @@ int odp_ipsec_in_enq(const odp_packet_t pkt_in[], int num_in,
 		if (0 == param->num_sa) {
 			sa = ODP_IPSEC_SA_INVALID;
 		} else {
-			sa = param->sa[sa_idx++];
+			sa = param->sa[sa_idx];
 			ODP_ASSERT(ODP_IPSEC_SA_INVALID != sa);
 		}
 
@@ -1729,21 +1911,23 @@ int odp_ipsec_out_enq(const odp_packet_t pkt_in[], int num_in,
 	unsigned opt_idx = 0;
 	unsigned sa_inc = (param->num_sa > 1) ? 1 : 0;
 	unsigned opt_inc = (param->num_opt > 1) ? 1 : 0;
+	ipsec_sa_t *burst_sa;
 
 	ODP_ASSERT(param->num_sa != 0);
 
+	burst_sa = ipsec_out_burst_start(param, num_in);
+
 	while (in_pkt < num_in) {
 		odp_packet_t pkt = pkt_in[in_pkt];
-		odp_ipsec_op_status_t status;
+		odp_packet_t out[IPSEC_OUT_MAX_FRAGS];
+		odp_event_t ev[IPSEC_OUT_MAX_FRAGS];
 		odp_ipsec_sa_t sa;
 		ipsec_sa_t *ipsec_sa;
-		odp_ipsec_packet_result_t *result;
 		const odp_ipsec_out_opt_t *opt;
 		odp_queue_t queue;
+		int num, ret;
 
-		memset(&status, 0, sizeof(status));
-
-		sa = param->sa[sa_idx++];
+		sa = param->sa[sa_idx];
 		ODP_ASSERT(ODP_IPSEC_SA_INVALID != sa);
 
 		if (0 == param->num_opt)
@@ -1751,25 +1935,27 @@ int odp_ipsec_out_enq(const odp_packet_t pkt_in[], int num_in,
 		else
 			opt = &param->opt[opt_idx];
 
-		ipsec_sa = ipsec_out_single(pkt, sa, &pkt, opt, &status);
+		num = ipsec_out_pkt(pkt, sa, out, IPSEC_OUT_MAX_FRAGS, opt,
+				    &ipsec_sa);
 		ODP_ASSERT(NULL != ipsec_sa);
-
-		packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
-		result = ipsec_pkt_result(pkt);
-		memset(result, 0, sizeof(*result));
-		result->status = status;
-		result->sa = ipsec_sa->ipsec_sa_hdl;
 		queue = ipsec_sa->queue;
 
-		if (odp_queue_enq(queue, odp_ipsec_packet_to_event(pkt))) {
-			odp_packet_free(pkt);
-			break;
+		odp_packet_to_event_multi(out, ev, num);
+		ret = odp_queue_enq_multi(queue, ev, num);
+		if (ret < num) {
+			if (ret < 0)
+				ret = 0;
+			odp_packet_free_multi(&out[ret], num - ret);
+			if (ret == 0)
+				break;
 		}
 		in_pkt++;
 		sa_idx += sa_inc;
 		opt_idx += opt_inc;
 	}
 
+	ipsec_out_burst_end(burst_sa);
+
 	return in_pkt;
 }
 
@@ -1819,25 +2005,27 @@ int odp_ipsec_out_inline(const odp_packet_t pkt_in[], int num_in,
 	unsigned opt_idx = 0;
 	unsigned sa_inc = (param->num_sa > 1) ? 1 : 0;
 	unsigned opt_inc = (param->num_opt > 1) ? 1 : 0;
+	ipsec_sa_t *burst_sa;
 
 	ODP_ASSERT(param->num_sa != 0);
 
+	burst_sa = ipsec_out_burst_start(param, num_in);
+
 	while (in_pkt < num_in) {
 		odp_packet_t pkt = pkt_in[in_pkt];
-		odp_ipsec_op_status_t status;
+		odp_packet_t out[IPSEC_OUT_MAX_FRAGS];
 		odp_ipsec_sa_t sa;
 		ipsec_sa_t *ipsec_sa;
-		odp_ipsec_packet_result_t *result;
 		const odp_ipsec_out_opt_t *opt;
-		uint32_t hdr_len, offset;
+		uint32_t hdr_len;
 		const void *ptr;
-
-		memset(&status, 0, sizeof(status));
+		int num, i;
+		int enq_err = 0;
 
 		if (0 == param->num_sa) {
 			sa = ODP_IPSEC_SA_INVALID;
 		} else {
-			sa = param->sa[sa_idx++];
+			sa = param->sa[sa_idx];
 			ODP_ASSERT(ODP_IPSEC_SA_INVALID != sa);
 		}
 
@@ -1846,72 +2034,92 @@ int odp_ipsec_out_inline(const odp_packet_t pkt_in[], int num_in,
 		else
 			opt = &param->opt[opt_idx];
 
-		ipsec_sa = ipsec_out_single(pkt, sa, &pkt, opt, &status);
+		num = ipsec_out_pkt(pkt, sa, out, IPSEC_OUT_MAX_FRAGS, opt,
+				    &ipsec_sa);
 		ODP_ASSERT(NULL != ipsec_sa);
 
 		hdr_len = inline_param[in_pkt].outer_hdr.len;
 		ptr = inline_param[in_pkt].outer_hdr.ptr;
-		offset = odp_packet_l3_offset(pkt);
-		if (odp_unlikely(offset == ODP_PACKET_OFFSET_INVALID))
-			offset = 0;
-		if (offset >= hdr_len) {
-			if (odp_packet_trunc_head(&pkt, offset - hdr_len,
-						  NULL, NULL) < 0)
-				status.error.alg = 1;
-
-		} else {
-			if (odp_packet_extend_head(&pkt, hdr_len - offset,
-						   NULL, NULL) < 0)
-				status.error.alg = 1;
-		}
-
-		odp_packet_l3_offset_set(pkt, hdr_len);
-
-		if (odp_packet_copy_from_mem(pkt, 0,
-					     hdr_len,
-					     ptr) < 0)
-			status.error.alg = 1;
 
-		packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
-		result = ipsec_pkt_result(pkt);
-		memset(result, 0, sizeof(*result));
-		result->sa = ipsec_sa->ipsec_sa_hdl;
-		result->status = status;
+		for (i = 0; i < num; i++) {
+			odp_ipsec_op_status_t status;
+			odp_ipsec_packet_result_t *result;
+			uint32_t offset;
+
+			pkt = out[i];
+			status = ipsec_pkt_result(pkt)->status;
+
+			offset = odp_packet_l3_offset(pkt);
+			if (odp_unlikely(offset == ODP_PACKET_OFFSET_INVALID))
+				offset = 0;
+			if (offset >= hdr_len) {
+				if (odp_packet_trunc_head(&pkt,
+							  offset - hdr_len,
+							  NULL, NULL) < 0)
+					status.error.alg = 1;
+
+			} else {
+				if (odp_packet_extend_head(&pkt,
+							   hdr_len - offset,
+							   NULL, NULL) < 0)
+					status.error.alg = 1;
+			}
 
-		if (!status.error.all) {
-			odp_pktout_queue_t pkqueue;
+			odp_packet_l3_offset_set(pkt, hdr_len);
 
-			if (odp_pktout_queue(inline_param[in_pkt].pktio,
-					     &pkqueue, 1) <= 0) {
+			if (odp_packet_copy_from_mem(pkt, 0,
+						     hdr_len,
+						     ptr) < 0)
 				status.error.alg = 1;
-				goto err;
-			}
 
-			if (odp_pktout_send(pkqueue, &pkt, 1) < 0) {
-				status.error.alg = 1;
-				goto err;
-			}
-		} else {
-			odp_queue_t queue;
-err:
 			packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
 			result = ipsec_pkt_result(pkt);
 			memset(result, 0, sizeof(*result));
 			result->sa = ipsec_sa->ipsec_sa_hdl;
 			result->status = status;
-			queue = ipsec_sa->queue;
 
-			if (odp_queue_enq(queue,
-					  odp_ipsec_packet_to_event(pkt))) {
-				odp_packet_free(pkt);
-				break;
+			if (!status.error.all) {
+				odp_pktout_queue_t pkqueue;
+
+				if (odp_pktout_queue(inline_param[in_pkt].pktio,
+						     &pkqueue, 1) <= 0) {
+					status.error.alg = 1;
+					goto err;
+				}
+
+				if (odp_pktout_send(pkqueue, &pkt, 1) < 0) {
+					status.error.alg = 1;
+					goto err;
+				}
+			} else {
+				odp_queue_t queue;
+				odp_event_t ev;
+err:
+				packet_subtype_set(pkt, ODP_EVENT_PACKET_IPSEC);
+				result = ipsec_pkt_result(pkt);
+				memset(result, 0, sizeof(*result));
+				result->sa = ipsec_sa->ipsec_sa_hdl;
+				result->status = status;
+				queue = ipsec_sa->queue;
+				ev = odp_ipsec_packet_to_event(pkt);
+
+				if (odp_queue_enq(queue, ev)) {
+					odp_packet_free(pkt);
+					enq_err = 1;
+				}
 			}
 		}
+
+		/* Stop if even the first packet could not be handled */
+		if (enq_err && num == 1)
+			break;
 		in_pkt++;
 		sa_idx += sa_inc;
 		opt_idx += opt_inc;
 	}
 
+	ipsec_out_burst_end(burst_sa);
+
 	return in_pkt;
 }
 
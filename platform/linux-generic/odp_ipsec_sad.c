@@ -12,7 +12,9 @@
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_ipsec_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_ring_mpmc_internal.h>
+#include <odp_schedule_if.h>
 #include <odp_global_data.h>
 
 #include <odp/api/plat/atomic_inlines.h>
@@ -40,6 +42,13 @@
 #warning IPV4_ID_RING_SIZE is too small for the maximum number of threads.
 #endif
 
+/* Free SA indexes are kept in a ring, so that SA create does not search */
+#define IPSEC_SA_RING_SIZE ODP_CONFIG_IPSEC_SAS /* must be power of 2 */
+#define IPSEC_SA_RING_MASK (IPSEC_SA_RING_SIZE - 1)
+
+ODP_STATIC_ASSERT((IPSEC_SA_RING_SIZE & IPSEC_SA_RING_MASK) == 0,
+		  "IPSEC_SA_RING_SIZE must be power of 2");
+
 /*
  * To avoid checking and updating the packet and byte counters in the
  * SA for every packet, we increment the global counters once for several
@@ -56,7 +65,50 @@
 #define SA_LIFE_PACKETS_PREALLOC  64
 #define SA_LIFE_BYTES_PREALLOC    4000
 
+/*
+ * Outbound sequence numbers may be reserved from the SA-global counter
+ * in blocks, so that the counter is not touched for every packet.
+ *
+ * A block reserved for a burst of packets given in a single IPsec
+ * operation call is consumed by that call only. Optionally
+ * (ipsec.out_seq_block config option) each thread may keep a larger block
+ * for its own use. Then packets of different threads get sequence numbers
+ * out of transmission order and the replay window of the receiver must be
+ * large enough to tolerate the reordering.
+ *
+ * In an ordered scheduling context, sequence numbers follow the context
+ * order. A block is reserved only when the context is in order (see
+ * order_lock() of the scheduler interface) and only for the current call.
+ * Per thread blocks are not used.
+ */
+#define SA_SEQ_BLOCK_MAX          1024
+
+/*
+ * Per-thread SA state is not kept for every SA in every thread. Each
+ * thread has a fixed number of state slots that are shared between SAs.
+ * Slots are organized in sets selected by SA index, and an SA may use any
+ * slot (way) of its set. Slots of a set are kept in most recently used
+ * order, so that the least recently used slot is replaced and SAs
+ * colliding in a set do not evict each other on every packet. A slot is
+ * tagged with the SA index and the SA generation number, which is
+ * incremented on every SA create. When a thread finds a slot tagged for
+ * an earlier incarnation of the same SA, it reinitializes the slot. This
+ * keeps memory usage independent of the number of SAs and SA creation
+ * free of per-thread work.
+ *
+ * Before a slot is taken over by another SA, unused quota is returned to
+ * the SA-global counters of the previous SA. Unused sequence numbers are
+ * returned when no other thread has reserved numbers after them, otherwise
+ * they are skipped.
+ */
+#define SA_THREAD_LOCAL_SLOTS     64 /* must be power of 2 */
+#define SA_THREAD_LOCAL_WAYS      4  /* must be power of 2 */
+#define SA_THREAD_LOCAL_SETS      (SA_THREAD_LOCAL_SLOTS / SA_THREAD_LOCAL_WAYS)
+
 typedef struct sa_thread_local_s {
+	/* SA index and generation of the SA this slot is used for */
+	uint32_t sa_idx;
+	uint32_t sa_gen;
 	/*
 	 * Packets that can be processed in this thread before looking at
 	 * the SA-global packet counter and checking hard and soft limits.
@@ -72,10 +124,20 @@ typedef struct sa_thread_local_s {
 	 * counter(s).
 	 */
 	odp_ipsec_op_status_t lifetime_status;
+	/*
+	 * Reserved outbound sequence numbers [seq_next, seq_end) that can
+	 * be used by this thread without accessing the SA-global counter.
+	 */
+	uint64_t seq_next;
+	uint64_t seq_end;
+	/* Number of packets left in the current burst of this thread */
+	uint32_t seq_burst;
+	/* Reserved sequence numbers are for the current ordered context */
+	uint8_t seq_ordered;
 } sa_thread_local_t;
 
 typedef struct ODP_ALIGNED_CACHE ipsec_thread_local_s {
-	sa_thread_local_t sa[ODP_CONFIG_IPSEC_SAS];
+	sa_thread_local_t sa[SA_THREAD_LOCAL_SLOTS];
 	uint16_t first_ipv4_id; /* first ID of current block of IDs */
 	uint16_t next_ipv4_id;  /* next ID to be used */
 } ipsec_thread_local_t;
@@ -87,6 +149,12 @@ typedef struct ipsec_sa_table_t {
 		ring_mpmc_t ipv4_id_ring;
 		uint32_t ODP_ALIGNED_CACHE ipv4_id_data[IPV4_ID_RING_SIZE];
 	} hot;
+	struct ODP_ALIGNED_CACHE {
+		ring_mpmc_t ring;
+		uint32_t ODP_ALIGNED_CACHE data[IPSEC_SA_RING_SIZE];
+	} free_sa;
+	/* Outbound sequence numbers reserved per thread at a time */
+	uint32_t out_seq_block;
 	odp_shm_t shm;
 } ipsec_sa_table_t;
 
@@ -113,22 +181,29 @@ ipsec_sa_t *_odp_ipsec_sa_entry_from_hdl(odp_ipsec_sa_t sa)
 	return ipsec_sa_entry_from_hdl(sa);
 }
 
-static inline sa_thread_local_t *ipsec_sa_thread_local(ipsec_sa_t *sa)
+static int read_config_file(ipsec_sa_table_t *tbl)
 {
-	return &ipsec_sa_tbl->per_thread[odp_thread_id()].sa[sa->ipsec_sa_idx];
-}
+	const char *str;
+	int val;
 
-static void init_sa_thread_local(ipsec_sa_t *sa)
-{
-	sa_thread_local_t *sa_tl;
-	int n;
+	ODP_PRINT("IPsec config:\n");
 
-	for (n = 0; n < ODP_THREAD_COUNT_MAX; n++) {
-		sa_tl = &ipsec_sa_tbl->per_thread[n].sa[sa->ipsec_sa_idx];
-		sa_tl->packet_quota = 0;
-		sa_tl->byte_quota = 0;
-		sa_tl->lifetime_status.all = 0;
+	str = "ipsec.out_seq_block";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > SA_SEQ_BLOCK_MAX) {
+		ODP_ERR("Bad value %s = %i [min: 0, max: %i]\n", str, val,
+			SA_SEQ_BLOCK_MAX);
+		return -1;
 	}
+
+	tbl->out_seq_block = val;
+	ODP_PRINT("  %s: %i\n\n", str, val);
+
+	return 0;
 }
 
 int _odp_ipsec_sad_init_global(void)
@@ -150,6 +225,11 @@ int _odp_ipsec_sad_init_global(void)
 	memset(ipsec_sa_tbl, 0, sizeof(ipsec_sa_table_t));
 	ipsec_sa_tbl->shm = shm;
 
+	if (read_config_file(ipsec_sa_tbl)) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
 	ring_mpmc_init(&ipsec_sa_tbl->hot.ipv4_id_ring);
 	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
 		/*
@@ -185,6 +265,17 @@ int _odp_ipsec_sad_init_global(void)
 		odp_atomic_init_u64(&ipsec_sa->hot.packets, 0);
 	}
 
+	ring_mpmc_init(&ipsec_sa_tbl->free_sa.ring);
+	for (i = 0; i < ODP_CONFIG_IPSEC_SAS; i++) {
+		uint32_t data = i;
+
+		ring_mpmc_enq_multi(&ipsec_sa_tbl->free_sa.ring,
+				    ipsec_sa_tbl->free_sa.data,
+				    IPSEC_SA_RING_MASK,
+				    &data,
+				    1);
+	}
+
 	return 0;
 }
 
@@ -221,25 +312,28 @@ int _odp_ipsec_sad_term_global(void)
 
 static ipsec_sa_t *ipsec_sa_reserve(void)
 {
-	int i;
+	uint32_t idx;
 	ipsec_sa_t *ipsec_sa;
 
-	for (i = 0; i < ODP_CONFIG_IPSEC_SAS; i++) {
-		uint32_t state = IPSEC_SA_STATE_FREE;
-
-		ipsec_sa = ipsec_sa_entry(i);
+	if (ring_mpmc_deq_multi(&ipsec_sa_tbl->free_sa.ring,
+				ipsec_sa_tbl->free_sa.data,
+				IPSEC_SA_RING_MASK, &idx, 1) != 1)
+		return NULL;
 
-		if (odp_atomic_cas_acq_u32(&ipsec_sa->state, &state,
-					   IPSEC_SA_STATE_RESERVED))
-			return ipsec_sa;
-	}
+	ipsec_sa = ipsec_sa_entry(idx);
+	odp_atomic_store_u32(&ipsec_sa->state, IPSEC_SA_STATE_RESERVED);
 
-	return NULL;
+	return ipsec_sa;
 }
 
 static void ipsec_sa_release(ipsec_sa_t *ipsec_sa)
 {
+	uint32_t idx = ipsec_sa->ipsec_sa_idx;
+
 	odp_atomic_store_rel_u32(&ipsec_sa->state, IPSEC_SA_STATE_FREE);
+	ring_mpmc_enq_multi(&ipsec_sa_tbl->free_sa.ring,
+			    ipsec_sa_tbl->free_sa.data,
+			    IPSEC_SA_RING_MASK, &idx, 1);
 }
 
 /* Mark reserved SA as available now */
@@ -408,7 +502,7 @@ odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param)
 	ipsec_sa->flags = 0;
 	if (param->opt.esn) {
 		ODP_ERR("ESN is not supported!\n");
-		return ODP_IPSEC_SA_INVALID;
+		goto error;
 	}
 	if (ODP_IPSEC_DIR_INBOUND == param->dir) {
 		ipsec_sa->lookup_mode = param->inbound.lookup_mode;
@@ -617,7 +711,8 @@ odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param)
 				      &ses_create_rc))
 		goto error;
 
-	init_sa_thread_local(ipsec_sa);
+	/* Invalidate per-thread state of the previous use of the SA */
+	ipsec_sa->gen++;
 
 	ipsec_sa_publish(ipsec_sa);
 
@@ -756,6 +851,92 @@ ipsec_sa_t *_odp_ipsec_sa_lookup(const ipsec_sa_lookup_t *lookup)
 	return best;
 }
 
+static void init_sa_thread_local(sa_thread_local_t *sa_tl, ipsec_sa_t *sa)
+{
+	sa_tl->sa_idx = sa->ipsec_sa_idx;
+	sa_tl->sa_gen = sa->gen;
+	sa_tl->packet_quota = 0;
+	sa_tl->byte_quota = 0;
+	sa_tl->lifetime_status.all = 0;
+	sa_tl->seq_next = 0;
+	sa_tl->seq_end = 0;
+	sa_tl->seq_burst = 0;
+	sa_tl->seq_ordered = 0;
+}
+
+/* Return unused quota and sequence numbers of a slot to its SA */
+static void sa_thread_local_write_back(sa_thread_local_t *sa_tl)
+{
+	ipsec_sa_t *sa = ipsec_sa_entry(sa_tl->sa_idx);
+	uint64_t seq_end = sa_tl->seq_end;
+
+	if (sa_tl->packet_quota == 0 && sa_tl->byte_quota == 0 &&
+	    sa_tl->seq_next >= seq_end)
+		return;
+
+	/* SA is being disabled or has been destroyed */
+	if (ipsec_sa_lock(sa) < 0)
+		return;
+
+	/* State of an earlier incarnation of the SA is not returned */
+	if (sa->gen == sa_tl->sa_gen) {
+		if (sa_tl->packet_quota)
+			odp_atomic_sub_u64(&sa->hot.packets,
+					   sa_tl->packet_quota);
+
+		if (sa_tl->byte_quota)
+			odp_atomic_sub_u64(&sa->hot.bytes, sa_tl->byte_quota);
+
+		if (sa_tl->seq_next < seq_end)
+			odp_atomic_cas_u64(&sa->hot.out.seq, &seq_end,
+					   sa_tl->seq_next);
+	}
+
+	_odp_ipsec_sa_unuse(sa);
+}
+
+/* Find the SA from other than the most recently used slot of a set, or
+ * replace the least recently used slot. The slot is moved to the front. */
+static sa_thread_local_t *sa_thread_local_miss(sa_thread_local_t set[],
+					       ipsec_sa_t *sa)
+{
+	sa_thread_local_t tmp;
+	uint32_t i;
+
+	for (i = 0; i < SA_THREAD_LOCAL_WAYS - 1; i++)
+		if (set[i].sa_idx == sa->ipsec_sa_idx)
+			break;
+
+	tmp = set[i];
+
+	if (tmp.sa_idx != sa->ipsec_sa_idx)
+		sa_thread_local_write_back(&tmp);
+
+	if (tmp.sa_idx != sa->ipsec_sa_idx || tmp.sa_gen != sa->gen)
+		init_sa_thread_local(&tmp, sa);
+
+	memmove(&set[1], &set[0], i * sizeof(sa_thread_local_t));
+	set[0] = tmp;
+
+	return &set[0];
+}
+
+/* Returned slot is valid until the next call */
+static inline sa_thread_local_t *ipsec_sa_thread_local(ipsec_sa_t *sa)
+{
+	ipsec_thread_local_t *tl = &ipsec_sa_tbl->per_thread[odp_thread_id()];
+	sa_thread_local_t *set;
+	uint32_t idx = sa->ipsec_sa_idx & (SA_THREAD_LOCAL_SETS - 1);
+
+	set = &tl->sa[idx * SA_THREAD_LOCAL_WAYS];
+
+	if (odp_likely(set[0].sa_idx == sa->ipsec_sa_idx &&
+		       set[0].sa_gen == sa->gen))
+		return &set[0];
+
+	return sa_thread_local_miss(set, sa);
+}
+
 int _odp_ipsec_sa_stats_precheck(ipsec_sa_t *ipsec_sa,
 				 odp_ipsec_op_status_t *status)
 {
@@ -872,6 +1053,81 @@ int _odp_ipsec_sa_replay_update(ipsec_sa_t *ipsec_sa, uint32_t seq,
 	return 0;
 }
 
+void _odp_ipsec_sa_seq_burst_start(ipsec_sa_t *ipsec_sa, uint32_t num)
+{
+	sa_thread_local_t *sa_tl = ipsec_sa_thread_local(ipsec_sa);
+
+	sa_tl->seq_burst = num;
+}
+
+void _odp_ipsec_sa_seq_burst_end(ipsec_sa_t *ipsec_sa)
+{
+	sa_thread_local_t *sa_tl = ipsec_sa_thread_local(ipsec_sa);
+
+	sa_tl->seq_burst = 0;
+
+	/*
+	 * Without per-thread blocks, and always in an ordered context,
+	 * sequence numbers left unused in the burst are skipped so that
+	 * the next burst of any thread gets sequence numbers after this one.
+	 */
+	if (ipsec_sa_tbl->out_seq_block <= 1 || sa_tl->seq_ordered) {
+		sa_tl->seq_next = sa_tl->seq_end;
+		sa_tl->seq_ordered = 0;
+	}
+}
+
+static uint64_t next_seq_ordered(ipsec_sa_t *ipsec_sa,
+				 sa_thread_local_t *sa_tl)
+{
+	uint32_t num = sa_tl->seq_burst + 1;
+	uint64_t seq;
+
+	if (sa_tl->seq_ordered && sa_tl->seq_next < sa_tl->seq_end)
+		return sa_tl->seq_next++;
+
+	/* Wait until earlier contexts have released their order. Later
+	 * contexts wait for this one, so numbers are reserved in context
+	 * order. */
+	sched_fn->order_lock();
+	seq = odp_atomic_fetch_add_u64(&ipsec_sa->hot.out.seq, num);
+	sched_fn->order_unlock();
+
+	sa_tl->seq_next = seq + 1;
+	sa_tl->seq_end = seq + num;
+	sa_tl->seq_ordered = 1;
+
+	return seq;
+}
+
+uint64_t _odp_ipsec_sa_next_seq(ipsec_sa_t *ipsec_sa)
+{
+	sa_thread_local_t *sa_tl = ipsec_sa_thread_local(ipsec_sa);
+	uint32_t num;
+	uint64_t seq;
+
+	if (sa_tl->seq_burst)
+		sa_tl->seq_burst--;
+
+	if (odp_unlikely(sched_fn->ordered()))
+		return next_seq_ordered(ipsec_sa, sa_tl);
+
+	if (odp_likely(sa_tl->seq_next < sa_tl->seq_end))
+		return sa_tl->seq_next++;
+
+	num = sa_tl->seq_burst + 1;
+	if (num < ipsec_sa_tbl->out_seq_block)
+		num = ipsec_sa_tbl->out_seq_block;
+
+	seq = odp_atomic_fetch_add_u64(&ipsec_sa->hot.out.seq, num);
+
+	sa_tl->seq_next = seq + 1;
+	sa_tl->seq_end = seq + num;
+	sa_tl->seq_ordered = 0;
+
+	return seq;
+}
+
 uint16_t _odp_ipsec_sa_alloc_ipv4_id(ipsec_sa_t *ipsec_sa)
 {
 	(void) ipsec_sa;
@@ -146,6 +146,38 @@ int _odp_libconfig_lookup_array(const char *path, int value[], int max_num)
 	return num_out;
 }
 
+int _odp_libconfig_lookup_str(const char *path, char *value,
+			      unsigned int str_size)
+{
+	const config_t *config;
+	const char *str;
+	unsigned int length;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		/* Runtime option overrides default value */
+		if (i == 0)
+			config = &odp_global_ro.libconfig_runtime;
+		else
+			config = &odp_global_ro.libconfig_default;
+
+		if (config_lookup_string(config, path, &str) == CONFIG_FALSE)
+			continue;
+
+		length = strlen(str) + 1;
+
+		if (length > str_size)
+			return 0;
+
+		memcpy(value, str, length);
+
+		/* Number of characters copied, including terminating null */
+		return length;
+	}
+
+	return 0;
+}
+
 static int lookup_int(config_t *cfg,
 		      const char *base_path,
 		      const char *local_path,
@@ -1137,6 +1137,40 @@ void odp_packet_l4_chksum_insert(odp_packet_t pkt, int insert)
 	pkt_hdr->p.flags.l4_chksum = insert;
 }
 
+int odp_packet_lso_request(odp_packet_t pkt,
+			   const odp_packet_lso_opt_t *lso_opt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	if (odp_unlikely(lso_opt->payload_offset == 0 ||
+			 lso_opt->payload_offset > UINT16_MAX ||
+			 lso_opt->max_payload_len == 0 ||
+			 lso_opt->max_payload_len > UINT16_MAX)) {
+		ODP_ERR("Bad LSO options\n");
+		return -1;
+	}
+
+	pkt_hdr->lso_payload_offset = lso_opt->payload_offset;
+	pkt_hdr->lso_max_payload = lso_opt->max_payload_len;
+	pkt_hdr->p.flags.lso = 1;
+
+	return 0;
+}
+
+void odp_packet_lso_request_clr(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	pkt_hdr->p.flags.lso = 0;
+}
+
+int odp_packet_has_lso_request(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	return pkt_hdr->p.flags.lso;
+}
+
 odp_packet_chksum_status_t odp_packet_l3_chksum_status(odp_packet_t pkt)
 {
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
@@ -1170,6 +1204,14 @@ void odp_packet_flow_hash_set(odp_packet_t pkt, uint32_t flow_hash)
 	packet_set_flow_hash(pkt_hdr, flow_hash);
 }
 
+odp_packet_reass_status_t odp_packet_reass_status(odp_packet_t pkt)
+{
+	(void)pkt;
+
+	/* IP reassembly is not supported on packet input */
+	return ODP_PACKET_REASS_NONE;
+}
+
 void odp_packet_ts_set(odp_packet_t pkt, odp_time_t timestamp)
 {
 	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
@@ -1177,6 +1219,11 @@ void odp_packet_ts_set(odp_packet_t pkt, odp_time_t timestamp)
 	packet_set_ts(pkt_hdr, &timestamp);
 }
 
+void odp_packet_ts_request(odp_packet_t pkt, int enable)
+{
+	packet_hdr(pkt)->p.flags.ts_set = !!enable;
+}
+
 /*
  *
  * Segment level
@@ -1718,6 +1765,8 @@ int _odp_packet_copy_md_to_packet(odp_packet_t srcpkt, odp_packet_t dstpkt)
 
 	dsthdr->input = srchdr->input;
 	dsthdr->dst_queue = srchdr->dst_queue;
+	dsthdr->lso_payload_offset = srchdr->lso_payload_offset;
+	dsthdr->lso_max_payload = srchdr->lso_max_payload;
 	dsthdr->buf_hdr.user_ptr = srchdr->buf_hdr.user_ptr;
 	if (dsthdr->buf_hdr.uarea_addr != NULL &&
 	    srchdr->buf_hdr.uarea_addr != NULL) {
@@ -2181,6 +2230,7 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 			      uint32_t *l4_part_sum)
 {
 	uint8_t  ip_proto;
+	const uint8_t *l4;
 
 	prs->l3_offset = offset;
 
@@ -2221,6 +2271,7 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 
 	/* Set l4 flag only for known ip_proto */
 	prs->input_flags.l4 = 1;
+	l4 = parseptr;
 
 	/* Parse Layer 4 headers */
 	switch (ip_proto) {
@@ -2275,6 +2326,19 @@ int packet_parse_common_l3_l4(packet_parser_t *prs, const uint8_t *parseptr,
 		break;
 	}
 
+	/* Parse tunnel and inner headers */
+	if (layer == ODP_PROTO_LAYER_ALL && !prs->input_flags.ipfrag &&
+	    prs->l4_offset < seg_len) {
+		uint32_t len = seg_len - prs->l4_offset;
+		uint8_t tunnel = _odp_packet_tunnel_detect(l4, len, ip_proto);
+
+		if (odp_unlikely(tunnel != PACKET_TUNNEL_NONE))
+			prs->input_flags.tunnel =
+				_odp_packet_parse_tunnel(&prs->tunnel, l4,
+							 prs->l4_offset, len,
+							 tunnel, NULL);
+	}
+
 	return prs->flags.all.error != 0;
 }
 
@@ -2486,6 +2550,167 @@ int _odp_packet_sctp_chksum_insert(odp_packet_t pkt)
 	return odp_packet_copy_from_mem(pkt, pkt_hdr->p.l4_offset + 8, 4, &sum);
 }
 
+/* IPv6 fragment identification, unique per thread */
+static __thread uint32_t ipv6_frag_id;
+
+/* Fragments are built by copying packet data */
+int _odp_packet_ip_fragment(odp_packet_t pkt, uint32_t l3_offset,
+			    uint32_t mtu, odp_packet_t frag[], int max_frags)
+{
+	odp_pool_t pool = odp_packet_pool(pkt);
+	uint32_t pkt_len = odp_packet_len(pkt);
+	uint32_t ip_hdr_len, hdr_len, payload_len, max_len;
+	uint32_t frag_hdr_len = 0;
+	uint32_t frag_base = 0;
+	uint32_t more = 0;
+	uint32_t id = 0;
+	uint32_t num, i;
+	_odp_ipv4hdr_t ip4;
+	_odp_ipv6hdr_t ip6;
+	uint8_t opts[_ODP_IPV4HDR_OPTS_MAX];
+	uint32_t opts_len = 0;
+	uint8_t ver;
+	int ipv4;
+
+	if (odp_packet_copy_to_mem(pkt, l3_offset, 1, &ver))
+		return -1;
+
+	ipv4 = _ODP_IPV4HDR_VER(ver) == _ODP_IPV4;
+
+	if (ipv4) {
+		uint16_t frag_offset;
+
+		if (odp_packet_copy_to_mem(pkt, l3_offset, sizeof(ip4),
+					   &ip4))
+			return -1;
+
+		frag_offset = odp_be_to_cpu_16(ip4.frag_offset);
+		if (_ODP_IPV4HDR_FLAGS_DONT_FRAG(frag_offset))
+			return -1;
+
+		ip_hdr_len = _ODP_IPV4HDR_IHL(ip4.ver_ihl) * 4;
+		frag_base = _ODP_IPV4HDR_FRAG_OFFSET(frag_offset) * 8;
+		more = _ODP_IPV4HDR_FLAGS_MORE_FRAGS(frag_offset);
+
+		/* Options of non-first fragments */
+		if (ip_hdr_len > _ODP_IPV4HDR_LEN) {
+			opts_len = ip_hdr_len - _ODP_IPV4HDR_LEN;
+			if (odp_packet_copy_to_mem(pkt, l3_offset +
+						   _ODP_IPV4HDR_LEN,
+						   opts_len, opts))
+				return -1;
+			_odp_ipv4_opts_frag(opts, opts_len);
+		}
+	} else if (_ODP_IPV4HDR_VER(ver) == _ODP_IPV6) {
+		if (odp_packet_copy_to_mem(pkt, l3_offset, sizeof(ip6),
+					   &ip6))
+			return -1;
+
+		/* Extension headers of the unfragmentable part are not
+		 * supported */
+		if (ip6.next_hdr == _ODP_IPPROTO_HOPOPTS ||
+		    ip6.next_hdr == _ODP_IPPROTO_ROUTE ||
+		    ip6.next_hdr == _ODP_IPPROTO_FRAG)
+			return -1;
+
+		ip_hdr_len = _ODP_IPV6HDR_LEN;
+		frag_hdr_len = _ODP_IPV6HDR_FRAG_LEN;
+		id = ((uint32_t)odp_thread_id() << 24) |
+		     (ipv6_frag_id++ & 0xffffff);
+	} else {
+		return -1;
+	}
+
+	hdr_len = l3_offset + ip_hdr_len;
+	if (ip_hdr_len < _ODP_IPV4HDR_LEN || pkt_len <= hdr_len ||
+	    mtu < ip_hdr_len + frag_hdr_len + 8)
+		return -1;
+
+	/* Fragment payload lengths are multiples of eight bytes */
+	payload_len = pkt_len - hdr_len;
+	max_len = (mtu - ip_hdr_len - frag_hdr_len) & ~7u;
+	num = (payload_len + max_len - 1) / max_len;
+	if (num > (uint32_t)max_frags)
+		return -1;
+
+	for (i = 0; i < num; i++) {
+		odp_packet_hdr_t *pkt_hdr;
+		uint32_t offset = i * max_len;
+		uint32_t len = max_len < payload_len - offset ?
+			       max_len : payload_len - offset;
+		int last_frag = i == num - 1;
+		int ret;
+
+		frag[i] = odp_packet_alloc(pool, hdr_len + frag_hdr_len + len);
+		if (odp_unlikely(frag[i] == ODP_PACKET_INVALID)) {
+			odp_packet_free_multi(frag, i);
+			return -1;
+		}
+
+		ret = odp_packet_copy_from_pkt(frag[i], 0, pkt, 0, hdr_len);
+		ret |= odp_packet_copy_from_pkt(frag[i],
+						hdr_len + frag_hdr_len, pkt,
+						hdr_len + offset, len);
+
+		if (ipv4) {
+			_odp_ipv4hdr_t ip = ip4;
+			uint16_t frag_offset = (frag_base + offset) / 8;
+
+			if (!last_frag || more)
+				frag_offset |= _ODP_IPV4HDR_MORE_FRAGS;
+
+			ip.tot_len = odp_cpu_to_be_16(ip_hdr_len + len);
+			ip.frag_offset = odp_cpu_to_be_16(frag_offset);
+			ret |= odp_packet_copy_from_mem(frag[i], l3_offset,
+							sizeof(ip), &ip);
+			if (i > 0 && opts_len)
+				ret |= odp_packet_copy_from_mem(frag[i],
+								l3_offset +
+								sizeof(ip),
+								opts_len,
+								opts);
+		} else {
+			_odp_ipv6hdr_t ip = ip6;
+			_odp_ipv6hdr_frag_t fh;
+			uint16_t frag_offset = offset;
+
+			if (!last_frag)
+				frag_offset |= 1;
+
+			fh.next_hdr = ip6.next_hdr;
+			fh.reserved = 0;
+			fh.frag_offset = odp_cpu_to_be_16(frag_offset);
+			fh.id = odp_cpu_to_be_32(id);
+			ip.next_hdr = _ODP_IPPROTO_FRAG;
+			ip.payload_len = odp_cpu_to_be_16(frag_hdr_len + len);
+			ret |= odp_packet_copy_from_mem(frag[i], l3_offset,
+							sizeof(ip), &ip);
+			ret |= odp_packet_copy_from_mem(frag[i], hdr_len,
+							sizeof(fh), &fh);
+		}
+
+		_odp_packet_copy_md_to_packet(pkt, frag[i]);
+
+		pkt_hdr = packet_hdr(frag[i]);
+		pkt_hdr->p.l3_offset = l3_offset;
+		pkt_hdr->p.input_flags.ipfrag = 1;
+		if (i > 0)
+			pkt_hdr->p.l4_offset = ODP_PACKET_OFFSET_INVALID;
+		else if (pkt_hdr->p.l4_offset != ODP_PACKET_OFFSET_INVALID)
+			pkt_hdr->p.l4_offset += frag_hdr_len;
+
+		if (ipv4)
+			ret |= _odp_packet_ipv4_chksum_insert(frag[i]);
+
+		if (odp_unlikely(ret)) {
+			odp_packet_free_multi(frag, i + 1);
+			return -1;
+		}
+	}
+
+	return num;
+}
+
 static int packet_l4_chksum(odp_packet_hdr_t *pkt_hdr,
 			    odp_proto_chksums_t chksums,
 			    uint32_t l4_part_sum)
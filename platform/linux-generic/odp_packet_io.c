@@ -29,6 +29,7 @@
 #include <odp_pcapng.h>
 #include <odp/api/plat/queue_inlines.h>
 #include <odp_libconfig_internal.h>
+#include <odp_trace_internal.h>
 
 #include <string.h>
 #include <inttypes.h>
@@ -48,6 +49,10 @@
 /* Max wait time supported to avoid potential overflow */
 #define MAX_WAIT_TIME (UINT64_MAX / 1024)
 
+ODP_STATIC_ASSERT(PKTIO_MAX_QUEUES <= ODP_PKTIN_MAX_QUEUES &&
+		  PKTIO_MAX_QUEUES <= ODP_PKTOUT_MAX_QUEUES,
+		  "Too many pktio queues");
+
 /* Global variables */
 static pktio_global_t *pktio_global;
 
@@ -552,6 +557,37 @@ int odp_pktio_config(odp_pktio_t hdl, const odp_pktio_config_t *config)
 		return -1;
 	}
 
+	if (config->enable_lso && !capa.config.enable_lso) {
+		ODP_ERR("LSO not supported\n");
+		return -1;
+	}
+
+	if (config->enable_gro && !capa.config.enable_gro) {
+		ODP_ERR("GRO not supported\n");
+		return -1;
+	}
+
+	if (config->enable_frag && !capa.config.enable_frag) {
+		ODP_ERR("IP fragmentation not supported\n");
+		return -1;
+	}
+
+	if ((config->reassembly.en_ipv4 && !capa.reassembly.ipv4) ||
+	    (config->reassembly.en_ipv6 && !capa.reassembly.ipv6)) {
+		ODP_ERR("IP reassembly not supported\n");
+		return -1;
+	}
+
+	if ((config->reassembly.en_ipv4 || config->reassembly.en_ipv6) &&
+	    (config->reassembly.max_wait_time >
+	     capa.reassembly.max_wait_time ||
+	     config->reassembly.max_num_frags >
+	     capa.reassembly.max_num_frags ||
+	     config->reassembly.max_num_frags == 1)) {
+		ODP_ERR("Bad IP reassembly configuration\n");
+		return -1;
+	}
+
 	lock_entry(entry);
 	if (entry->s.state == PKTIO_STATE_STARTED) {
 		unlock_entry(entry);
@@ -561,6 +597,14 @@ int odp_pktio_config(odp_pktio_t hdl, const odp_pktio_config_t *config)
 
 	entry->s.config = *config;
 
+	/* Zero selects maximum supported reassembly limits */
+	if (!config->reassembly.max_wait_time)
+		entry->s.config.reassembly.max_wait_time =
+			capa.reassembly.max_wait_time;
+	if (!config->reassembly.max_num_frags)
+		entry->s.config.reassembly.max_num_frags =
+			capa.reassembly.max_num_frags;
+
 	entry->s.in_chksums.all_chksum = 0;
 	entry->s.in_chksums.chksum.ipv4 = config->pktin.bit.ipv4_chksum;
 	entry->s.in_chksums.chksum.tcp = config->pktin.bit.tcp_chksum;
@@ -712,7 +756,7 @@ odp_pktio_t odp_pktio_lookup(const char *name)
 	return hdl;
 }
 
-static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
+static inline int pktin_recv_enq(pktio_entry_t *entry, int pktin_index,
 				 odp_buffer_hdr_t *buffer_hdrs[], int num)
 {
 	odp_packet_t pkt;
@@ -776,6 +820,14 @@ static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
 		else
 			num_enq = dst_idx[i + 1] - idx;
 
+		if (odp_unlikely(entry->s.in_backpressure &&
+				 odp_queue_congested(dst[i]))) {
+			odp_event_free_multi(&ev[idx], num_enq);
+			odp_atomic_add_u64(&entry->s.stats_extra.in_discards,
+					   num_enq);
+			continue;
+		}
+
 		ret = odp_queue_enq_multi(dst[i], &ev[idx], num_enq);
 
 		if (ret < 0)
@@ -788,6 +840,22 @@ static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
 	return num_rx;
 }
 
+static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
+				 odp_buffer_hdr_t *buffer_hdrs[], int num)
+{
+	int ret;
+
+	if (odp_likely(!pktio_cls_enabled(entry)))
+		return pktin_recv_enq(entry, pktin_index, buffer_hdrs, num);
+
+	/* CoS queues must not be destroyed before packets are enqueued */
+	_odp_cls_input_begin();
+	ret = pktin_recv_enq(entry, pktin_index, buffer_hdrs, num);
+	_odp_cls_input_end();
+
+	return ret;
+}
+
 static int pktout_enqueue(odp_queue_t queue, odp_buffer_hdr_t *buf_hdr)
 {
 	odp_packet_t pkt = packet_from_buf_hdr(buf_hdr);
@@ -916,9 +984,9 @@ int sched_cb_pktin_poll_one(int pktio_index,
 	pktio_entry_t *entry = pktio_entry_by_index(pktio_index);
 	odp_packet_t pkt;
 	odp_packet_hdr_t *pkt_hdr;
-	odp_buffer_hdr_t *buf_hdr;
 	odp_packet_t packets[QUEUE_MULTI_MAX];
 	odp_queue_t queue;
+	int cls;
 
 	if (odp_unlikely(entry->s.state != PKTIO_STATE_STARTED)) {
 		if (entry->s.state < PKTIO_STATE_ACTIVE ||
@@ -930,6 +998,12 @@ int sched_cb_pktin_poll_one(int pktio_index,
 	}
 
 	ODP_ASSERT((unsigned int)rx_queue < entry->s.num_in_queue);
+
+	/* CoS queues must not be destroyed before packets are enqueued */
+	cls = pktio_cls_enabled(entry);
+	if (odp_unlikely(cls))
+		_odp_cls_input_begin();
+
 	num_pkts = entry->s.ops->recv(entry, rx_queue,
 				      packets, QUEUE_MULTI_MAX);
 
@@ -938,14 +1012,16 @@ int sched_cb_pktin_poll_one(int pktio_index,
 		pkt = packets[i];
 		pkt_hdr = packet_hdr(pkt);
 		if (odp_unlikely(pkt_hdr->p.input_flags.dst_queue)) {
-			int num_enq;
+			int ret = -1;
 
 			queue = pkt_hdr->dst_queue;
-			buf_hdr = packet_to_buf_hdr(pkt);
-			num_enq = odp_queue_enq_multi(queue,
-						      (odp_event_t *)&buf_hdr,
-						      1);
-			if (num_enq < 0) {
+
+			/* Congested queue drops the packet early */
+			if (odp_likely(!entry->s.in_backpressure ||
+				       !odp_queue_congested(queue)))
+				ret = odp_queue_enq(queue,
+						    odp_packet_to_event(pkt));
+			if (ret < 0) {
 				/* Queue full? */
 				odp_packet_free(pkt);
 				odp_atomic_inc_u64(&entry->s.stats_extra.in_discards);
@@ -954,6 +1030,10 @@ int sched_cb_pktin_poll_one(int pktio_index,
 			evt_tbl[num_rx++] = odp_packet_to_event(pkt);
 		}
 	}
+
+	if (odp_unlikely(cls))
+		_odp_cls_input_end();
+
 	return num_rx;
 }
 
@@ -961,6 +1041,7 @@ int sched_cb_pktin_poll(int pktio_index, int pktin_index,
 			odp_buffer_hdr_t *hdr_tbl[], int num)
 {
 	pktio_entry_t *entry = pktio_entry_by_index(pktio_index);
+	odp_queue_t queue = entry->s.in_queue[pktin_index].queue;
 	int state = entry->s.state;
 
 	if (odp_unlikely(state != PKTIO_STATE_STARTED)) {
@@ -972,6 +1053,12 @@ int sched_cb_pktin_poll(int pktio_index, int pktin_index,
 		return 0;
 	}
 
+	/* Leave packets into the interface while the event queue is
+	 * congested */
+	if (odp_unlikely(entry->s.in_backpressure &&
+			 odp_queue_congested(queue)))
+		return 0;
+
 	return pktin_recv_buf(entry, pktin_index, hdr_tbl, num);
 }
 
@@ -1294,6 +1381,29 @@ odp_time_t odp_pktin_ts_from_ns(odp_pktio_t hdl, uint64_t ns)
 	return odp_time_global_from_ns(ns);
 }
 
+int odp_pktout_ts_read(odp_pktio_t hdl, odp_time_t *ts)
+{
+	pktio_entry_t *entry;
+
+	entry = get_pktio_entry(hdl);
+
+	if (entry == NULL) {
+		ODP_DBG("pktio entry %d does not exist\n", hdl);
+		return -1;
+	}
+
+	if (!entry->s.config.pktout.bit.ts_ena) {
+		ODP_DBG("pktio %s: output timestamps not enabled\n",
+			entry->s.name);
+		return -1;
+	}
+
+	if (entry->s.ops->pktout_ts_read)
+		return entry->s.ops->pktout_ts_read(entry, ts);
+
+	return -1;
+}
+
 void odp_pktio_print(odp_pktio_t hdl)
 {
 	pktio_entry_t *entry;
@@ -1513,6 +1623,322 @@ int odp_pktio_stats_reset(odp_pktio_t pktio)
 	return ret;
 }
 
+static int pktin_queue_stats(pktio_entry_t *entry, uint32_t index,
+			     odp_pktin_queue_stats_t *stats)
+{
+	if (entry->s.ops->pktin_queue_stats)
+		return entry->s.ops->pktin_queue_stats(entry, index, stats);
+
+	memset(stats, 0, sizeof(odp_pktin_queue_stats_t));
+	return 0;
+}
+
+static int pktout_queue_stats(pktio_entry_t *entry, uint32_t index,
+			      odp_pktout_queue_stats_t *stats)
+{
+	if (entry->s.ops->pktout_queue_stats)
+		return entry->s.ops->pktout_queue_stats(entry, index, stats);
+
+	memset(stats, 0, sizeof(odp_pktout_queue_stats_t));
+	return 0;
+}
+
+int odp_pktin_queue_stats(odp_pktin_queue_t queue,
+			  odp_pktin_queue_stats_t *stats)
+{
+	pktio_entry_t *entry;
+	odp_pktin_mode_t mode;
+	int ret;
+
+	entry = get_pktio_entry(queue.pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", queue.pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("pktio entry already freed\n");
+		return -1;
+	}
+
+	mode = entry->s.param.in_mode;
+	if (odp_unlikely(mode != ODP_PKTIN_MODE_DIRECT)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid packet input mode: %d\n", mode);
+		return -1;
+	}
+
+	if (odp_unlikely(queue.index < 0 ||
+			 (unsigned)queue.index >= entry->s.num_in_queue)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid input queue index: %d\n", queue.index);
+		return -1;
+	}
+
+	ret = pktin_queue_stats(entry, queue.index, stats);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktin_event_queue_stats(odp_pktio_t pktio, odp_queue_t queue,
+				odp_pktin_queue_stats_t *stats)
+{
+	pktio_entry_t *entry;
+	odp_pktin_mode_t mode;
+	unsigned int i;
+	int ret = -1;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("pktio entry already freed\n");
+		return -1;
+	}
+
+	mode = entry->s.param.in_mode;
+	if (odp_unlikely(mode != ODP_PKTIN_MODE_SCHED &&
+			 mode != ODP_PKTIN_MODE_QUEUE)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid packet input mode: %d\n", mode);
+		return -1;
+	}
+
+	for (i = 0; i < entry->s.num_in_queue; i++) {
+		if (entry->s.in_queue[i].queue == queue) {
+			ret = pktin_queue_stats(entry, i, stats);
+			break;
+		}
+	}
+
+	unlock_entry(entry);
+
+	if (i == entry->s.num_in_queue)
+		ODP_ERR("invalid input event queue\n");
+
+	return ret;
+}
+
+int odp_pktout_queue_stats(odp_pktout_queue_t queue,
+			   odp_pktout_queue_stats_t *stats)
+{
+	pktio_entry_t *entry;
+	odp_pktout_mode_t mode;
+	int ret;
+
+	entry = get_pktio_entry(queue.pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", queue.pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("pktio entry already freed\n");
+		return -1;
+	}
+
+	mode = entry->s.param.out_mode;
+	if (odp_unlikely(mode != ODP_PKTOUT_MODE_DIRECT)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid packet output mode: %d\n", mode);
+		return -1;
+	}
+
+	if (odp_unlikely(queue.index < 0 ||
+			 (unsigned)queue.index >= entry->s.num_out_queue)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid output queue index: %d\n", queue.index);
+		return -1;
+	}
+
+	ret = pktout_queue_stats(entry, queue.index, stats);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktout_event_queue_stats(odp_pktio_t pktio, odp_queue_t queue,
+				 odp_pktout_queue_stats_t *stats)
+{
+	pktio_entry_t *entry;
+	odp_pktout_mode_t mode;
+	unsigned int i;
+	int ret = -1;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("pktio entry already freed\n");
+		return -1;
+	}
+
+	mode = entry->s.param.out_mode;
+	if (odp_unlikely(mode != ODP_PKTOUT_MODE_QUEUE)) {
+		unlock_entry(entry);
+		ODP_ERR("invalid packet output mode: %d\n", mode);
+		return -1;
+	}
+
+	for (i = 0; i < entry->s.num_out_queue; i++) {
+		if (entry->s.out_queue[i].queue == queue) {
+			ret = pktout_queue_stats(entry, i, stats);
+			break;
+		}
+	}
+
+	unlock_entry(entry);
+
+	if (i == entry->s.num_out_queue)
+		ODP_ERR("invalid output event queue\n");
+
+	return ret;
+}
+
+int odp_pktio_extra_stat_info(odp_pktio_t pktio,
+			      odp_pktio_extra_stat_info_t info[], int num)
+{
+	pktio_entry_t *entry;
+	int ret = 0;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("already freed pktio\n");
+		return -1;
+	}
+
+	if (entry->s.ops->extra_stat_info)
+		ret = entry->s.ops->extra_stat_info(entry, info, num);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktio_extra_stats(odp_pktio_t pktio, uint64_t stats[], int num)
+{
+	pktio_entry_t *entry;
+	int ret = 0;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("already freed pktio\n");
+		return -1;
+	}
+
+	if (entry->s.ops->extra_stats)
+		ret = entry->s.ops->extra_stats(entry, stats, num);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktio_extra_stat_counter(odp_pktio_t pktio, uint32_t id,
+				 uint64_t *stat)
+{
+	pktio_entry_t *entry;
+	int ret = -1;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return -1;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("already freed pktio\n");
+		return -1;
+	}
+
+	if (entry->s.ops->extra_stat_counter)
+		ret = entry->s.ops->extra_stat_counter(entry, id, stat);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+void odp_pktio_extra_stats_print(odp_pktio_t pktio)
+{
+	int num_info, num_stats, i;
+
+	num_info = odp_pktio_extra_stat_info(pktio, NULL, 0);
+	if (num_info <= 0)
+		return;
+
+	num_stats = odp_pktio_extra_stats(pktio, NULL, 0);
+	if (num_stats <= 0)
+		return;
+
+	if (num_info != num_stats) {
+		ODP_ERR("extra statistics info counts not matching\n");
+		return;
+	}
+
+	odp_pktio_extra_stat_info_t stats_info[num_stats];
+	uint64_t extra_stats[num_stats];
+
+	num_info = odp_pktio_extra_stat_info(pktio, stats_info, num_stats);
+	if (num_info <= 0)
+		return;
+
+	num_stats = odp_pktio_extra_stats(pktio, extra_stats, num_stats);
+	if (num_stats <= 0)
+		return;
+
+	if (num_info != num_stats) {
+		ODP_ERR("extra statistics info counts not matching\n");
+		return;
+	}
+
+	ODP_PRINT("Pktio extra statistics\n----------------------\n");
+	for (i = 0; i < num_stats; i++)
+		ODP_PRINT("  %s=%" PRIu64 "\n", stats_info[i].name,
+			  extra_stats[i]);
+	ODP_PRINT("\n");
+}
+
 int odp_pktin_queue_config(odp_pktio_t pktio,
 			   const odp_pktin_queue_param_t *param)
 {
@@ -1562,12 +1988,27 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 	}
 
 	pktio_cls_enabled_set(entry, param->classifier_enable);
+	entry->s.in_backpressure = param->backpressure;
 
 	if (num_queues > capa.max_input_queues) {
 		ODP_DBG("pktio %s: too many input queues\n", entry->s.name);
 		return -1;
 	}
 
+	for (i = 0; i < num_queues; i++) {
+		uint32_t size = param->queue_size[i];
+
+		if (size == 0)
+			continue;
+
+		if (size < capa.min_input_queue_size ||
+		    size > capa.max_input_queue_size) {
+			ODP_DBG("pktio %s: bad input queue size %" PRIu32 "\n",
+				entry->s.name, size);
+			return -1;
+		}
+	}
+
 	/* If re-configuring, destroy old queues */
 	if (entry->s.num_in_queue)
 		destroy_in_queues(entry, entry->s.num_in_queue);
@@ -1695,6 +2136,20 @@ int odp_pktout_queue_config(odp_pktio_t pktio,
 		return -1;
 	}
 
+	for (i = 0; i < num_queues; i++) {
+		uint32_t size = param->queue_size[i];
+
+		if (size == 0)
+			continue;
+
+		if (size < capa.min_output_queue_size ||
+		    size > capa.max_output_queue_size) {
+			ODP_DBG("pktio %s: bad output queue size %" PRIu32
+				"\n", entry->s.name, size);
+			return -1;
+		}
+	}
+
 	/* If re-configuring, destroy old queues */
 	if (entry->s.num_out_queue) {
 		destroy_out_queues(entry, entry->s.num_out_queue);
@@ -1752,6 +2207,139 @@ int odp_pktout_queue_config(odp_pktio_t pktio,
 	return 0;
 }
 
+/* Lock an active pktio entry for input hash configuration. Returns NULL on
+ * failure. */
+static pktio_entry_t *hash_config_lock(odp_pktio_t pktio)
+{
+	pktio_entry_t *entry;
+
+	entry = get_pktio_entry(pktio);
+	if (entry == NULL) {
+		ODP_ERR("pktio entry %d does not exist\n", pktio);
+		return NULL;
+	}
+
+	lock_entry(entry);
+
+	if (odp_unlikely(is_free(entry))) {
+		unlock_entry(entry);
+		ODP_ERR("already freed pktio\n");
+		return NULL;
+	}
+
+	if (entry->s.state != PKTIO_STATE_STARTED) {
+		unlock_entry(entry);
+		ODP_DBG("pktio %s: not started\n", entry->s.name);
+		return NULL;
+	}
+
+	if (entry->s.num_in_queue < 2) {
+		unlock_entry(entry);
+		ODP_DBG("pktio %s: flow hashing not in use\n", entry->s.name);
+		return NULL;
+	}
+
+	return entry;
+}
+
+int odp_pktin_hash_proto_set(odp_pktio_t pktio,
+			     const odp_pktin_hash_proto_t *hash_proto)
+{
+	pktio_entry_t *entry;
+	int ret = -1;
+
+	entry = hash_config_lock(pktio);
+	if (entry == NULL)
+		return -1;
+
+	if (entry->s.ops->hash_proto_set)
+		ret = entry->s.ops->hash_proto_set(entry, hash_proto);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktin_hash_key_set(odp_pktio_t pktio, const uint8_t key[],
+			   uint32_t len)
+{
+	pktio_entry_t *entry;
+	int ret = -1;
+
+	entry = hash_config_lock(pktio);
+	if (entry == NULL)
+		return -1;
+
+	if (entry->s.ops->hash_key_set)
+		ret = entry->s.ops->hash_key_set(entry, key, len);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktin_hash_reta(odp_pktio_t pktio, uint32_t reta[], uint32_t num)
+{
+	pktio_entry_t *entry;
+	int ret = -1;
+
+	entry = hash_config_lock(pktio);
+	if (entry == NULL)
+		return -1;
+
+	if (entry->s.ops->hash_reta)
+		ret = entry->s.ops->hash_reta(entry, reta, num);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktin_hash_reta_set(odp_pktio_t pktio, const uint32_t reta[],
+			    uint32_t num)
+{
+	pktio_entry_t *entry;
+	uint32_t i;
+	int ret = -1;
+
+	entry = hash_config_lock(pktio);
+	if (entry == NULL)
+		return -1;
+
+	for (i = 0; i < num; i++) {
+		if (reta[i] >= entry->s.num_in_queue) {
+			unlock_entry(entry);
+			ODP_ERR("Bad input queue index %" PRIu32 "\n",
+				reta[i]);
+			return -1;
+		}
+	}
+
+	if (entry->s.ops->hash_reta_set)
+		ret = entry->s.ops->hash_reta_set(entry, reta, num);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
+int odp_pktin_hash_balance(odp_pktio_t pktio)
+{
+	pktio_entry_t *entry;
+	int ret = -1;
+
+	entry = hash_config_lock(pktio);
+	if (entry == NULL)
+		return -1;
+
+	if (entry->s.ops->hash_balance)
+		ret = entry->s.ops->hash_balance(entry);
+
+	unlock_entry(entry);
+
+	return ret;
+}
+
 int odp_pktin_event_queue(odp_pktio_t pktio, odp_queue_t queues[], int num)
 {
 	pktio_entry_t *entry;
@@ -1915,7 +2503,10 @@ int odp_pktin_recv(odp_pktin_queue_t queue, odp_packet_t packets[], int num)
 	if (odp_unlikely(entry->s.state != PKTIO_STATE_STARTED))
 		return 0;
 
+	_ODP_TRACE_BEGIN(_ODP_TRACE_PKTIN_RECV, queue.index);
 	ret = entry->s.ops->recv(entry, queue.index, packets, num);
+	_ODP_TRACE_END(_ODP_TRACE_PKTIN_RECV, ret);
+
 	if (_ODP_PCAPNG)
 		_odp_dump_pcapng_pkts(entry, queue.index, packets, ret);
 
@@ -2089,6 +2680,7 @@ int odp_pktout_send(odp_pktout_queue_t queue, const odp_packet_t packets[],
 {
 	pktio_entry_t *entry;
 	odp_pktio_t pktio = queue.pktio;
+	int ret;
 
 	entry = get_pktio_entry(pktio);
 	if (entry == NULL) {
@@ -2102,7 +2694,11 @@ int odp_pktout_send(odp_pktout_queue_t queue, const odp_packet_t packets[],
 	if (_ODP_PCAPNG)
 		_odp_dump_pcapng_pkts(entry, queue.index, packets, num);
 
-	return entry->s.ops->send(entry, queue.index, packets, num);
+	_ODP_TRACE_BEGIN(_ODP_TRACE_PKTOUT_SEND, queue.index);
+	ret = entry->s.ops->send(entry, queue.index, packets, num);
+	_ODP_TRACE_END(_ODP_TRACE_PKTOUT_SEND, ret);
+
+	return ret;
 }
 
 /** Get printable format of odp_pktio_t */
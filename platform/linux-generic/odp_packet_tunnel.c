@@ -0,0 +1,361 @@
+/* Copyright (c) 2020, Nokia
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp/api/byteorder.h>
+#include <odp/api/hints.h>
+#include <odp/api/plat/byteorder_inlines.h>
+
+#include <odp_packet_tunnel_internal.h>
+
+#include <protocols/eth.h>
+#include <protocols/ip.h>
+#include <protocols/sctp.h>
+#include <protocols/tcp.h>
+#include <protocols/tunnel.h>
+#include <protocols/udp.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/* Inner EtherType from IP version of the first inner byte */
+static inline uint16_t ip_version_to_ethtype(const uint8_t *ptr)
+{
+	switch (*ptr >> 4) {
+	case _ODP_IPV4:
+		return _ODP_ETHTYPE_IPV4;
+	case _ODP_IPV6:
+		return _ODP_ETHTYPE_IPV6;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Parse tunnel header. Returns offset to the inner packet from 'l4' and
+ * writes inner EtherType into 'ethtype' (_ODP_GRE_PROTO_TEB for an inner
+ * Ethernet header), or 0 on failure.
+ */
+static uint32_t parse_tunnel_hdr(packet_tunnel_t *tun, const uint8_t *l4,
+				 uint32_t len, uint16_t *ethtype)
+{
+	uint32_t hlen;
+
+	switch (tun->type) {
+	case PACKET_TUNNEL_VXLAN: {
+		const _odp_vxlanhdr_t *vxlan;
+
+		hlen = _ODP_UDPHDR_LEN + _ODP_VXLANHDR_LEN;
+		if (len < hlen)
+			return 0;
+
+		vxlan = (const _odp_vxlanhdr_t *)(uintptr_t)
+			(l4 + _ODP_UDPHDR_LEN);
+		if (!(odp_be_to_cpu_32(vxlan->flags) & _ODP_VXLAN_FLAGS_VNI))
+			return 0;
+
+		tun->id = odp_be_to_cpu_32(vxlan->vni) >> 8;
+		*ethtype = _ODP_GRE_PROTO_TEB;
+		return hlen;
+	}
+	case PACKET_TUNNEL_GENEVE: {
+		const _odp_genevehdr_t *geneve;
+
+		if (len < _ODP_UDPHDR_LEN + _ODP_GENEVEHDR_LEN)
+			return 0;
+
+		geneve = (const _odp_genevehdr_t *)(uintptr_t)
+			(l4 + _ODP_UDPHDR_LEN);
+		if (_ODP_GENEVEHDR_VER(geneve->ver_optlen) != 0)
+			return 0;
+
+		hlen = _ODP_UDPHDR_LEN + _ODP_GENEVEHDR_LEN +
+		       _ODP_GENEVEHDR_OPTLEN(geneve->ver_optlen);
+		tun->id = odp_be_to_cpu_32(geneve->vni) >> 8;
+		*ethtype = odp_be_to_cpu_16(geneve->proto);
+		return hlen;
+	}
+	case PACKET_TUNNEL_GRE: {
+		const _odp_grehdr_t *gre;
+		uint16_t flags;
+
+		if (len < _ODP_GREHDR_LEN)
+			return 0;
+
+		gre = (const _odp_grehdr_t *)(uintptr_t)l4;
+		flags = odp_be_to_cpu_16(gre->flags_ver);
+		if (flags & _ODP_GRE_VER_MASK)
+			return 0;
+
+		*ethtype = odp_be_to_cpu_16(gre->proto);
+		hlen = _ODP_GREHDR_LEN;
+		if (flags & _ODP_GRE_FLAG_CSUM)
+			hlen += 4;
+		if (flags & _ODP_GRE_FLAG_KEY) {
+			odp_u32be_t key;
+
+			if (len < hlen + 4)
+				return 0;
+			memcpy(&key, l4 + hlen, sizeof(key));
+			tun->id = odp_be_to_cpu_32(key);
+			/* NVGRE: VSID in upper 24 bits of the key */
+			if (*ethtype == _ODP_GRE_PROTO_TEB)
+				tun->id >>= 8;
+			hlen += 4;
+		}
+		if (flags & _ODP_GRE_FLAG_SEQ)
+			hlen += 4;
+		return hlen;
+	}
+	case PACKET_TUNNEL_GTPU: {
+		const _odp_gtpuhdr_t *gtpu;
+
+		hlen = _ODP_UDPHDR_LEN + _ODP_GTPUHDR_LEN;
+		if (len < hlen)
+			return 0;
+
+		gtpu = (const _odp_gtpuhdr_t *)(uintptr_t)
+			(l4 + _ODP_UDPHDR_LEN);
+		if ((gtpu->flags & _ODP_GTPU_FLAG_VER_MASK) !=
+		    _ODP_GTPU_FLAG_VER1 || gtpu->msg_type != _ODP_GTPU_MSG_GPDU)
+			return 0;
+
+		/* Extension headers are not parsed */
+		if (gtpu->flags & _ODP_GTPU_FLAG_OPT) {
+			hlen = _ODP_UDPHDR_LEN + _ODP_GTPUHDR_OPT_LEN;
+			if (len <= hlen || l4[hlen - 1] != 0)
+				return 0;
+		}
+
+		if (len <= hlen)
+			return 0;
+
+		tun->id = odp_be_to_cpu_32(gtpu->teid);
+		*ethtype = ip_version_to_ethtype(l4 + hlen);
+		return hlen;
+	}
+	default:
+		return 0;
+	}
+}
+
+/* Inner L4 header, fragments are not parsed further */
+static inline void parse_inner_l4(_odp_packet_input_flags_t *flags,
+				  uint8_t proto, uint32_t offset, uint32_t len)
+{
+	if (!flags->ipfrag) {
+		switch (proto) {
+		case _ODP_IPPROTO_TCP:
+			if (offset + _ODP_TCPHDR_LEN <= len)
+				flags->tcp = 1;
+			break;
+		case _ODP_IPPROTO_UDP:
+			if (offset + _ODP_UDPHDR_LEN <= len)
+				flags->udp = 1;
+			break;
+		case _ODP_IPPROTO_SCTP:
+			if (offset + _ODP_SCTPHDR_LEN <= len)
+				flags->sctp = 1;
+			break;
+		case _ODP_IPPROTO_ICMPV4:
+			/* Fall through */
+		case _ODP_IPPROTO_ICMPV6:
+			flags->icmp = 1;
+			break;
+		default:
+			break;
+		}
+	}
+
+	flags->l4 = flags->tcp | flags->udp | flags->sctp | flags->icmp;
+}
+
+/* Check if HW recognized all inner headers and their lengths */
+static inline int hint_complete(const packet_tunnel_hint_t *hint,
+				uint16_t ethtype)
+{
+	if (hint == NULL || hint->l4 == 0 || hint->l3_len == 0)
+		return 0;
+
+	if (ethtype == _ODP_GRE_PROTO_TEB)
+		return hint->eth;
+
+	if (hint->eth)
+		return 0;
+
+	return (ethtype == _ODP_ETHTYPE_IPV4 &&
+		hint->l3_len == _ODP_IPV4HDR_LEN) ||
+	       (ethtype == _ODP_ETHTYPE_IPV6 &&
+		hint->l3_len == _ODP_IPV6HDR_LEN);
+}
+
+/* Set inner header metadata from HW packet type without reading the inner
+ * headers */
+static int parse_inner_hint(packet_tunnel_t *tun,
+			    const packet_tunnel_hint_t *hint,
+			    uint32_t l4_offset, uint32_t offset, uint32_t len)
+{
+	_odp_packet_input_flags_t flags;
+
+	flags.all = 0;
+	tun->l2_offset = l4_offset + offset;
+
+	if (hint->eth) {
+		flags.l2  = 1;
+		flags.eth = 1;
+		flags.vlan = hint->vlan != 0;
+		flags.vlan_qinq = hint->vlan > 1;
+		offset += _ODP_ETHHDR_LEN + hint->vlan * _ODP_VLANHDR_LEN;
+	}
+
+	tun->l3_offset = l4_offset + offset;
+
+	if (offset + hint->l3_len > len)
+		return 0;
+
+	flags.l3 = 1;
+	if (hint->l3_len == _ODP_IPV4HDR_LEN)
+		flags.ipv4 = 1;
+	else
+		flags.ipv6 = 1;
+	offset += hint->l3_len;
+
+	tun->l4_offset = l4_offset + offset;
+
+	if (hint->l4 == _ODP_IPPROTO_FRAG)
+		flags.ipfrag = 1;
+
+	parse_inner_l4(&flags, hint->l4, offset, len);
+	tun->input_flags = flags;
+
+	return 1;
+}
+
+int _odp_packet_parse_tunnel(packet_tunnel_t *tun, const uint8_t *l4,
+			     uint32_t l4_offset, uint32_t len, uint8_t type,
+			     const packet_tunnel_hint_t *hint)
+{
+	_odp_packet_input_flags_t flags;
+	const uint8_t *ptr;
+	uint32_t offset;
+	uint16_t ethtype = 0;
+	uint8_t l4_hint = hint ? hint->l4 : 0;
+	uint8_t proto;
+
+	tun->type = type;
+	tun->id = 0;
+	offset = parse_tunnel_hdr(tun, l4, len, &ethtype);
+	if (offset == 0)
+		return 0;
+
+	if (hint_complete(hint, ethtype))
+		return parse_inner_hint(tun, hint, l4_offset, offset, len);
+
+	flags.all = 0;
+	ptr = l4 + offset;
+	tun->l2_offset = l4_offset + offset;
+
+	/* Inner Ethernet and VLAN headers */
+	if (ethtype == _ODP_GRE_PROTO_TEB) {
+		const _odp_ethhdr_t *eth;
+		const _odp_vlanhdr_t *vlan;
+
+		if (offset + _ODP_ETHHDR_LEN > len)
+			return 0;
+
+		eth = (const _odp_ethhdr_t *)(uintptr_t)ptr;
+		flags.l2  = 1;
+		flags.eth = 1;
+		ethtype = odp_be_to_cpu_16(eth->type);
+		offset += _ODP_ETHHDR_LEN;
+
+		if (ethtype == _ODP_ETHTYPE_VLAN_OUTER) {
+			if (offset + _ODP_VLANHDR_LEN > len)
+				return 0;
+			flags.vlan_qinq = 1;
+			flags.vlan = 1;
+			vlan = (const _odp_vlanhdr_t *)(uintptr_t)(l4 + offset);
+			ethtype = odp_be_to_cpu_16(vlan->type);
+			offset += _ODP_VLANHDR_LEN;
+		}
+
+		if (ethtype == _ODP_ETHTYPE_VLAN) {
+			if (offset + _ODP_VLANHDR_LEN > len)
+				return 0;
+			flags.vlan = 1;
+			vlan = (const _odp_vlanhdr_t *)(uintptr_t)(l4 + offset);
+			ethtype = odp_be_to_cpu_16(vlan->type);
+			offset += _ODP_VLANHDR_LEN;
+		}
+
+		ptr = l4 + offset;
+	}
+
+	tun->l3_offset = l4_offset + offset;
+
+	/* Inner L3 header */
+	switch (ethtype) {
+	case _ODP_ETHTYPE_IPV4: {
+		const _odp_ipv4hdr_t *ipv4;
+		uint32_t ihl;
+		uint16_t frag_offset;
+
+		if (offset + _ODP_IPV4HDR_LEN > len)
+			return 0;
+
+		ipv4 = (const _odp_ipv4hdr_t *)(uintptr_t)ptr;
+		ihl = _ODP_IPV4HDR_IHL(ipv4->ver_ihl);
+		if (_ODP_IPV4HDR_VER(ipv4->ver_ihl) != _ODP_IPV4 ||
+		    ihl < _ODP_IPV4HDR_IHL_MIN)
+			return 0;
+
+		flags.l3 = 1;
+		flags.ipv4 = 1;
+		if (ihl > _ODP_IPV4HDR_IHL_MIN)
+			flags.ipopt = 1;
+		proto = ipv4->proto;
+		offset += ihl * 4;
+
+		/* HW has checked fragmentation */
+		if (l4_hint)
+			break;
+
+		frag_offset = odp_be_to_cpu_16(ipv4->frag_offset);
+		if (odp_unlikely(_ODP_IPV4HDR_IS_FRAGMENT(frag_offset)))
+			flags.ipfrag = 1;
+		break;
+	}
+	case _ODP_ETHTYPE_IPV6: {
+		const _odp_ipv6hdr_t *ipv6;
+
+		if (offset + _ODP_IPV6HDR_LEN > len)
+			return 0;
+
+		ipv6 = (const _odp_ipv6hdr_t *)(uintptr_t)ptr;
+		flags.l3 = 1;
+		flags.ipv6 = 1;
+		proto = ipv6->next_hdr;
+		offset += _ODP_IPV6HDR_LEN;
+
+		if (proto == _ODP_IPPROTO_FRAG)
+			flags.ipfrag = 1;
+		break;
+	}
+	default:
+		return 0;
+	}
+
+	tun->l4_offset = l4_offset + offset;
+
+	if (l4_hint == _ODP_IPPROTO_FRAG)
+		flags.ipfrag = 1;
+	else if (l4_hint)
+		proto = l4_hint;
+
+	parse_inner_l4(&flags, proto, offset, len);
+	tun->input_flags = flags;
+
+	return 1;
+}
@@ -101,6 +101,11 @@ void odp_queue_print(odp_queue_t queue)
 	return _odp_queue_api->queue_print(queue);
 }
 
+int odp_queue_congested(odp_queue_t queue)
+{
+	return _odp_queue_api->queue_congested(queue);
+}
+
 int _odp_queue_init_global(void)
 {
 	const char *sched = getenv("ODP_SCHEDULER");
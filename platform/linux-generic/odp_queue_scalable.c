@@ -370,6 +370,10 @@ static odp_queue_t queue_create(const char *name,
 
 	type = param->type;
 
+	/* Congestion thresholds not supported */
+	if (param->threshold.high)
+		return ODP_QUEUE_INVALID;
+
 	if (type == ODP_QUEUE_TYPE_SCHED) {
 		if (param->sched.prio < odp_schedule_min_prio() ||
 		    param->sched.prio > odp_schedule_max_prio()) {
@@ -901,6 +905,8 @@ static void queue_param_init(odp_queue_param_t *params)
 	params->sched.sync = ODP_SCHED_SYNC_PARALLEL;
 	params->sched.group = ODP_SCHED_GROUP_ALL;
 	params->order = ODP_QUEUE_ORDER_KEEP;
+	params->threshold.notif_queue = ODP_QUEUE_INVALID;
+	params->threshold.notif_pool = ODP_POOL_INVALID;
 }
 
 static int queue_info(odp_queue_t handle, odp_queue_info_t *info)
@@ -1013,6 +1019,12 @@ static void queue_print(odp_queue_t handle)
 	UNLOCK(&queue->s.lock);
 }
 
+static int queue_congested(odp_queue_t handle ODP_UNUSED)
+{
+	/* Congestion thresholds not supported */
+	return 0;
+}
+
 static uint64_t queue_to_u64(odp_queue_t hdl)
 {
 	return _odp_pri(hdl);
@@ -1099,7 +1111,8 @@ _odp_queue_api_fn_t queue_scalable_api = {
 	.queue_to_u64 = queue_to_u64,
 	.queue_param_init = queue_param_init,
 	.queue_info = queue_info,
-	.queue_print = queue_print
+	.queue_print = queue_print,
+	.queue_congested = queue_congested
 };
 
 /* Functions towards internal components */
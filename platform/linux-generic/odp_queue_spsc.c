@@ -31,11 +31,17 @@ static inline void buffer_index_to_buf(odp_buffer_hdr_t *buf_hdr[],
 	}
 }
 
+static uint32_t spsc_queue_depth(queue_entry_t *queue)
+{
+	return ring_spsc_length(&queue->s.ring_spsc);
+}
+
 static inline int spsc_enq_multi(odp_queue_t handle,
 				 odp_buffer_hdr_t *buf_hdr[], int num)
 {
 	queue_entry_t *queue;
 	ring_spsc_t *ring_spsc;
+	int num_enq;
 	uint32_t buf_idx[num];
 
 	queue = qentry_from_handle(handle);
@@ -48,8 +54,13 @@ static inline int spsc_enq_multi(odp_queue_t handle,
 		return -1;
 	}
 
-	return ring_spsc_enq_multi(ring_spsc, queue->s.ring_data,
-				   queue->s.ring_mask, buf_idx, num);
+	num_enq = ring_spsc_enq_multi(ring_spsc, queue->s.ring_data,
+				      queue->s.ring_mask, buf_idx, num);
+
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, spsc_queue_depth);
+
+	return num_enq;
 }
 
 static inline int spsc_deq_multi(odp_queue_t handle,
@@ -74,6 +85,9 @@ static inline int spsc_deq_multi(odp_queue_t handle,
 	if (num_deq == 0)
 		return 0;
 
+	if (odp_unlikely(queue->s.param.threshold.high))
+		queue_thr_update(queue, spsc_queue_depth);
+
 	buffer_index_to_buf(buf_hdr, buf_idx, num_deq);
 
 	return num_deq;
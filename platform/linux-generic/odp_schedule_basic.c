@@ -32,11 +32,13 @@
 #include <odp/api/packet_io.h>
 #include <odp_ring_u32_internal.h>
 #include <odp_timer_internal.h>
+#include <odp_trace_internal.h>
 #include <odp_queue_basic_internal.h>
 #include <odp_libconfig_internal.h>
 #include <odp/api/plat/queue_inlines.h>
 
 #include <string.h>
+#include <inttypes.h>
 
 /* No synchronization context */
 #define NO_SYNC_CONTEXT ODP_SCHED_SYNC_PARALLEL
@@ -104,6 +106,9 @@ ODP_STATIC_ASSERT((8 * sizeof(prio_q_mask_t)) >= MAX_SPREAD,
 /* Ordered stash size */
 #define MAX_ORDERED_STASH 512
 
+/* Limit for packet input poll backoff configuration */
+#define MAX_PKTIN_SKIP 1024
+
 /* Storage for stashed enqueue operation arguments */
 typedef struct {
 	odp_buffer_hdr_t *buf_hdr[QUEUE_MULTI_MAX];
@@ -166,6 +171,29 @@ typedef struct ODP_ALIGNED_CACHE {
 
 } prio_queue_t;
 
+/* Adaptive packet input poll state of a queue. Accessed only by the thread
+ * which has dequeued the queue from a priority queue. */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Current poll burst size */
+	uint16_t burst;
+
+	/* Number of scheduling rounds to skip before the next poll */
+	uint16_t skip;
+
+	/* Current backoff in rounds, doubled after each empty poll */
+	uint16_t backoff;
+
+	/* Number of consecutive empty polls */
+	uint16_t num_empty;
+
+	/* Statistics */
+	uint64_t polls;
+	uint64_t empty_polls;
+	uint64_t skipped;
+	uint64_t pkts;
+
+} pktin_poll_t;
+
 /* Order context of a queue */
 typedef struct ODP_ALIGNED_CACHE {
 	/* Current ordered context id */
@@ -185,6 +213,9 @@ typedef struct {
 		uint8_t burst_max[NUM_PRIO];
 		uint8_t num_spread;
 		uint8_t prefer_ratio;
+		uint8_t pktin_burst_adapt;
+		uint16_t pktin_poll_idle;
+		uint16_t pktin_poll_skip_max;
 	} config;
 
 	uint16_t         max_spread;
@@ -225,6 +256,8 @@ typedef struct {
 	} pktio[NUM_PKTIO];
 	odp_spinlock_t pktio_lock;
 
+	pktin_poll_t pktin_poll[CONFIG_MAX_SCHED_QUEUES];
+
 	order_context_t order[CONFIG_MAX_SCHED_QUEUES];
 
 	/* Scheduler interface config options (not used in fast path) */
@@ -327,6 +360,43 @@ static int read_config_file(sched_global_t *sched)
 
 	ODP_PRINT("\n");
 
+	str = "sched_basic.pktin_poll_idle";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_PKTIN_SKIP || val < 0) {
+		ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->config.pktin_poll_idle = val;
+	ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.pktin_poll_skip_max";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_PKTIN_SKIP || val < 0) {
+		ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->config.pktin_poll_skip_max = val;
+	ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.pktin_burst_adapt";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	sched->config.pktin_burst_adapt = !!val;
+	ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "sched_basic.group_enable.all";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		ODP_ERR("Config option '%s' not found.\n", str);
@@ -460,6 +530,43 @@ static int schedule_init_global(void)
 	return 0;
 }
 
+/* Print packet input polling statistics. Printed on termination in debug
+ * builds. */
+static void pktin_poll_print(void)
+{
+	uint32_t qi;
+	pktin_poll_t *pktin_poll;
+
+	ODP_PRINT("\nScheduler packet input polling\n");
+	ODP_PRINT("------------------------------\n");
+	ODP_PRINT("  pktin_poll_idle:     %u\n", sched->config.pktin_poll_idle);
+	ODP_PRINT("  pktin_poll_skip_max: %u\n",
+		  sched->config.pktin_poll_skip_max);
+	ODP_PRINT("  pktin_burst_adapt:   %u\n\n",
+		  sched->config.pktin_burst_adapt);
+
+	ODP_PRINT("  queue   pktio  pktin          polls    empty polls"
+		  "        skipped           pkts  pkts/poll  burst\n");
+
+	for (qi = 0; qi < CONFIG_MAX_SCHED_QUEUES; qi++) {
+		pktin_poll = &sched->pktin_poll[qi];
+
+		if (pktin_poll->polls == 0 && pktin_poll->skipped == 0)
+			continue;
+
+		ODP_PRINT("  %5u  %6i %6i %14" PRIu64 " %14" PRIu64 " %14"
+			  PRIu64 " %14" PRIu64 " %10.2f %6u\n", qi,
+			  sched->queue[qi].pktio_index,
+			  sched->queue[qi].pktin_index,
+			  pktin_poll->polls, pktin_poll->empty_polls,
+			  pktin_poll->skipped, pktin_poll->pkts,
+			  pktin_poll->polls ? (double)pktin_poll->pkts /
+			  pktin_poll->polls : 0.0, pktin_poll->burst);
+	}
+
+	ODP_PRINT("\n");
+}
+
 static int schedule_term_global(void)
 {
 	int ret = 0;
@@ -467,6 +574,9 @@ static int schedule_term_global(void)
 	int i, j, grp;
 	uint32_t ring_mask = sched->ring_mask;
 
+	if (ODP_DEBUG_PRINT == 1)
+		pktin_poll_print();
+
 	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
 		for (i = 0; i < NUM_PRIO; i++) {
 			for (j = 0; j < MAX_SPREAD; j++) {
@@ -661,11 +771,19 @@ static void schedule_pktio_start(int pktio_index, int num_pktin,
 	sched->pktio[pktio_index].num_pktin = num_pktin;
 
 	for (i = 0; i < num_pktin; i++) {
+		pktin_poll_t *pktin_poll;
+		int prio;
+
 		qi = queue_to_index(queue[i]);
 		sched->queue[qi].poll_pktin  = 1;
 		sched->queue[qi].pktio_index = pktio_index;
 		sched->queue[qi].pktin_index = pktin_idx[i];
 
+		prio = sched->queue[qi].prio;
+		pktin_poll = &sched->pktin_poll[qi];
+		memset(pktin_poll, 0, sizeof(pktin_poll_t));
+		pktin_poll->burst = sched->config.burst_default[prio];
+
 		ODP_ASSERT(pktin_idx[i] <= MAX_PKTIN_INDEX);
 
 		/* Start polling */
@@ -704,12 +822,19 @@ static inline int ordered_own_turn(uint32_t queue_index)
 
 static inline void wait_for_order(uint32_t queue_index)
 {
+	if (ordered_own_turn(queue_index))
+		return;
+
+	_ODP_TRACE_BEGIN(_ODP_TRACE_SCHED_ORDER_WAIT, queue_index);
+
 	/* Busy loop to synchronize ordered processing */
 	while (1) {
+		odp_cpu_pause();
 		if (ordered_own_turn(queue_index))
 			break;
-		odp_cpu_pause();
 	}
+
+	_ODP_TRACE_END(_ODP_TRACE_SCHED_ORDER_WAIT, queue_index);
 }
 
 /**
@@ -885,6 +1010,59 @@ static inline int queue_is_pktin(uint32_t queue_index)
 	return sched->queue[queue_index].poll_pktin;
 }
 
+/* Update adaptive poll state after a poll. Burst size is doubled when a poll
+ * fills the burst and halved when less than half of it is used, within
+ * configured default and maximum burst sizes of the queue priority. Queues
+ * returning repeatedly no packets are skipped for an exponentially growing
+ * number of scheduling rounds. */
+static inline void pktin_poll_update(pktin_poll_t *pktin_poll, uint32_t qi,
+				     int num, int max_num)
+{
+	pktin_poll->polls++;
+
+	if (num == 0) {
+		uint16_t idle = sched->config.pktin_poll_idle;
+		uint16_t skip_max = sched->config.pktin_poll_skip_max;
+
+		pktin_poll->empty_polls++;
+
+		if (pktin_poll->num_empty < idle)
+			pktin_poll->num_empty++;
+
+		if (idle == 0 || pktin_poll->num_empty < idle)
+			return;
+
+		pktin_poll->backoff = pktin_poll->backoff ?
+				      2 * pktin_poll->backoff : 1;
+		if (pktin_poll->backoff > skip_max)
+			pktin_poll->backoff = skip_max;
+
+		pktin_poll->skip = pktin_poll->backoff;
+		return;
+	}
+
+	pktin_poll->pkts     += num;
+	pktin_poll->num_empty = 0;
+	pktin_poll->backoff   = 0;
+
+	if (sched->config.pktin_burst_adapt) {
+		int prio = sched->queue[qi].prio;
+		uint16_t burst = pktin_poll->burst;
+
+		if (num == max_num) {
+			burst = 2 * burst;
+			if (burst > sched->config.burst_max[prio])
+				burst = sched->config.burst_max[prio];
+		} else if (num < max_num / 2) {
+			burst = burst / 2;
+			if (burst < sched->config.burst_default[prio])
+				burst = sched->config.burst_default[prio];
+		}
+
+		pktin_poll->burst = burst;
+	}
+}
+
 static inline int poll_pktin(uint32_t qi, int direct_recv,
 			     odp_event_t ev_tbl[], int max_num)
 {
@@ -893,6 +1071,14 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 	int ret;
 	void *q_int;
 	odp_buffer_hdr_t *b_hdr[CONFIG_BURST_SIZE];
+	pktin_poll_t *pktin_poll = &sched->pktin_poll[qi];
+
+	/* Idle queue is not polled on this round */
+	if (pktin_poll->skip) {
+		pktin_poll->skip--;
+		pktin_poll->skipped++;
+		return 0;
+	}
 
 	hdr_tbl = (odp_buffer_hdr_t **)ev_tbl;
 
@@ -904,10 +1090,18 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 			max_num = CONFIG_BURST_SIZE;
 	}
 
+	if (sched->config.pktin_burst_adapt && max_num > pktin_poll->burst)
+		max_num = pktin_poll->burst;
+
 	pktio_index = sched->queue[qi].pktio_index;
 	pktin_index = sched->queue[qi].pktin_index;
 
+	_ODP_TRACE_BEGIN(_ODP_TRACE_SCHED_POLL_PKTIN, qi);
 	num = sched_cb_pktin_poll(pktio_index, pktin_index, hdr_tbl, max_num);
+	_ODP_TRACE_END(_ODP_TRACE_SCHED_POLL_PKTIN, num);
+
+	if (odp_likely(num >= 0))
+		pktin_poll_update(pktin_poll, qi, num, max_num);
 
 	if (num == 0)
 		return 0;
@@ -1040,9 +1234,16 @@ static inline int do_schedule_grp(odp_queue_t *out_queue, odp_event_t out_ev[],
 				if (pktin) {
 					int direct_recv = !ordered;
 					int num_pkt;
+					int max_pkt = max_deq;
+
+					/* Adaptive burst may grow up to stash
+					 * size (limited by burst_max) */
+					if (stashed &&
+					    sched->config.pktin_burst_adapt)
+						max_pkt = STASH_SIZE;
 
 					num_pkt = poll_pktin(qi, direct_recv,
-							     ev_tbl, max_deq);
+							     ev_tbl, max_pkt);
 
 					if (odp_unlikely(num_pkt < 0))
 						continue;
@@ -1272,6 +1473,11 @@ static void order_unlock(void)
 {
 }
 
+static int schedule_ordered(void)
+{
+	return sched_local.sync_ctx == ODP_SCHED_SYNC_ORDERED;
+}
+
 static void schedule_order_lock(uint32_t lock_index)
 {
 	odp_atomic_u64_t *ord_lock;
@@ -1601,7 +1807,8 @@ const schedule_fn_t schedule_basic_fn = {
 	.order_lock = order_lock,
 	.order_unlock = order_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
-	.get_config = schedule_get_config
+	.get_config = schedule_get_config,
+	.ordered = schedule_ordered
 };
 
 /* Fill in scheduler API calls */
@@ -2119,6 +2119,11 @@ static void order_unlock(void)
 {
 }
 
+static int schedule_ordered(void)
+{
+	return sched_ts->rctx != NULL;
+}
+
 static uint32_t schedule_max_ordered_locks(void)
 {
 	return CONFIG_QUEUE_MAX_ORD_LOCKS;
@@ -2153,6 +2158,7 @@ const schedule_fn_t schedule_scalable_fn = {
 	.order_lock	= order_lock,
 	.order_unlock	= order_unlock,
 	.max_ordered_locks = schedule_max_ordered_locks,
+	.ordered	= schedule_ordered,
 };
 
 const schedule_api_t schedule_scalable_api = {
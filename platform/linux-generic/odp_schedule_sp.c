@@ -957,6 +957,12 @@ static void order_unlock(void)
 {
 }
 
+/* Ordered locks are no-ops, order is not synchronized */
+static int ordered(void)
+{
+	return 0;
+}
+
 static int schedule_capability(odp_schedule_capability_t *capa)
 {
 	memset(capa, 0, sizeof(odp_schedule_capability_t));
@@ -986,7 +992,8 @@ const schedule_fn_t schedule_sp_fn = {
 	.term_local    = term_local,
 	.order_lock    = order_lock,
 	.order_unlock  = order_unlock,
-	.max_ordered_locks = max_ordered_locks
+	.max_ordered_locks = max_ordered_locks,
+	.ordered = ordered
 };
 
 /* Fill in scheduler API calls */
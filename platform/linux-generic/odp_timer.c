@@ -48,6 +48,7 @@
 #include <odp_libconfig_internal.h>
 #include <odp_queue_if.h>
 #include <odp_timer_internal.h>
+#include <odp_trace_internal.h>
 #include <odp/api/plat/queue_inlines.h>
 #include <odp_global_data.h>
 
@@ -1007,7 +1008,9 @@ void _timer_run_inline(int dec)
 	}
 
 	/* Check the timer pools. */
+	_ODP_TRACE_BEGIN(_ODP_TRACE_TIMER_RUN, num);
 	timer_pool_scan_inline(num, now);
+	_ODP_TRACE_END(_ODP_TRACE_TIMER_RUN, num);
 }
 
 /******************************************************************************
@@ -0,0 +1,304 @@
+/* Copyright (c) 2020, Nokia
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp/autoheader_internal.h>
+#include <odp/api/cpu.h>
+#include <odp/api/shared_memory.h>
+#include <odp/api/thread.h>
+#include <odp/api/time.h>
+
+#include <odp_config_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_global_data.h>
+#include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_trace_internal.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CONFIG_ENABLE      "trace.enable"
+#define CONFIG_NUM_EVENTS  "trace.num_events"
+#define CONFIG_FILE        "trace.file"
+
+#define MIN_EVENTS         64
+#define MAX_EVENTS         (1024 * 1024)
+#define MAX_FILE_NAME_LEN  256
+
+typedef struct ODP_ALIGNED_CACHE {
+	/* Number of events written into the ring */
+	uint64_t idx;
+
+	/* Thread has recorded events */
+	int used;
+
+} trace_thread_t;
+
+typedef struct trace_global_t {
+	odp_shm_t shm;
+	uint32_t num_events;
+	uint64_t start_cycles;
+	uint64_t start_ns;
+	char file[MAX_FILE_NAME_LEN];
+	trace_thread_t thread[ODP_THREAD_COUNT_MAX];
+
+	/* Event rings of all threads */
+	_odp_trace_event_t event[] ODP_ALIGNED_CACHE;
+
+} trace_global_t;
+
+static const struct {
+	const char *name;
+	const char *cat;
+} tracepoint[_ODP_TRACE_NUM] = {
+	[_ODP_TRACE_SCHED_POLL_PKTIN] = {"poll_pktin",  "sched"},
+	[_ODP_TRACE_SCHED_ORDER_WAIT] = {"order_wait",  "sched"},
+	[_ODP_TRACE_QUEUE_ENQ]        = {"queue_enq",   "queue"},
+	[_ODP_TRACE_PKTIN_RECV]       = {"pktin_recv",  "pktio"},
+	[_ODP_TRACE_PKTOUT_SEND]      = {"pktout_send", "pktio"},
+	[_ODP_TRACE_TIMER_RUN]        = {"timer_run",   "timer"},
+	[_ODP_TRACE_CRYPTO_DEQ]       = {"crypto_deq",  "crypto"},
+	[_ODP_TRACE_TM_ENQ]           = {"tm_enq",      "tm"},
+	[_ODP_TRACE_TM_EGRESS]        = {"tm_egress",   "tm"}
+};
+
+static const char phase[] = {
+	[_ODP_TRACE_TYPE_BEGIN]   = 'B',
+	[_ODP_TRACE_TYPE_END]     = 'E',
+	[_ODP_TRACE_TYPE_INSTANT] = 'i'
+};
+
+static trace_global_t *trace_global;
+
+__thread _odp_trace_local_t _odp_trace_local;
+
+static int read_config_file(uint32_t *num_events, char *file)
+{
+	const char *str;
+	int val = 0;
+
+	str = CONFIG_ENABLE;
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val == 0)
+		return 0;
+
+	if (!_ODP_TRACE) {
+		ODP_PRINT("Tracepoints are not compiled in (--enable-trace), "
+			  "%s ignored\n", str);
+		return 0;
+	}
+
+	str = CONFIG_NUM_EVENTS;
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < MIN_EVENTS || val > MAX_EVENTS ||
+	    (val & (val - 1))) {
+		ODP_ERR("Bad %s value %i: power of two from %i to %i\n",
+			str, val, MIN_EVENTS, MAX_EVENTS);
+		return -1;
+	}
+
+	*num_events = val;
+
+	str = CONFIG_FILE;
+	if (!_odp_libconfig_lookup_str(str, file, MAX_FILE_NAME_LEN)) {
+		ODP_ERR("Config option '%s' not found or too long.\n", str);
+		return -1;
+	}
+
+	ODP_PRINT("\nTrace config:\n");
+	ODP_PRINT("  %s: %u\n", CONFIG_NUM_EVENTS, *num_events);
+	ODP_PRINT("  %s: %s\n\n", CONFIG_FILE, file);
+
+	return 0;
+}
+
+int _odp_trace_init_global(void)
+{
+	odp_shm_t shm;
+	uint64_t size;
+	uint32_t num_events = 0;
+	char file[MAX_FILE_NAME_LEN];
+
+	trace_global = NULL;
+
+	if (read_config_file(&num_events, file))
+		return -1;
+
+	/* Tracing disabled */
+	if (num_events == 0)
+		return 0;
+
+	size = sizeof(trace_global_t) + (uint64_t)ODP_THREAD_COUNT_MAX *
+	       num_events * sizeof(_odp_trace_event_t);
+
+	shm = odp_shm_reserve("_odp_trace_global", size, ODP_CACHE_LINE_SIZE,
+			      0);
+
+	trace_global = odp_shm_addr(shm);
+
+	if (trace_global == NULL) {
+		ODP_ERR("SHM reserve of trace global data failed\n");
+		return -1;
+	}
+
+	memset(trace_global, 0, sizeof(trace_global_t));
+	trace_global->shm = shm;
+	trace_global->num_events = num_events;
+	strcpy(trace_global->file, file);
+
+	/* Reference point for converting CPU cycles to time */
+	trace_global->start_ns = odp_time_global_ns();
+	trace_global->start_cycles = odp_cpu_cycles();
+
+	return 0;
+}
+
+int _odp_trace_init_local(void)
+{
+	int thr;
+
+	memset(&_odp_trace_local, 0, sizeof(_odp_trace_local_t));
+
+	if (trace_global == NULL)
+		return 0;
+
+	thr = odp_thread_id();
+	trace_global->thread[thr].used = 1;
+
+	_odp_trace_local.idx  = &trace_global->thread[thr].idx;
+	_odp_trace_local.mask = trace_global->num_events - 1;
+	_odp_trace_local.ev   = &trace_global->event[(uint64_t)thr *
+						     trace_global->num_events];
+
+	return 0;
+}
+
+int _odp_trace_term_local(void)
+{
+	/* Events stay in the ring until global termination. A thread
+	 * reusing the same thread ID continues from the same ring. */
+	memset(&_odp_trace_local, 0, sizeof(_odp_trace_local_t));
+
+	return 0;
+}
+
+/* Write events in Chrome trace event format. Timestamps are in
+ * microseconds since global init. */
+static int dump_events(void)
+{
+	FILE *file;
+	int thr;
+	uint32_t depth;
+	uint64_t i, first, last, cycles, end_ns, end_cycles;
+	_odp_trace_event_t *ev;
+	double us_per_cycle;
+	const char *sep = "";
+	uint32_t num_events = trace_global->num_events;
+	int pid = odp_global_ro.main_pid;
+
+	end_cycles = odp_cpu_cycles();
+	end_ns = odp_time_global_ns();
+	cycles = odp_cpu_cycles_diff(end_cycles, trace_global->start_cycles);
+
+	if (cycles == 0)
+		cycles = 1;
+
+	us_per_cycle = (double)(end_ns - trace_global->start_ns) /
+		       (1000.0 * cycles);
+
+	file = fopen(trace_global->file, "w");
+
+	if (file == NULL) {
+		ODP_ERR("Trace file open failed: %s\n", trace_global->file);
+		return -1;
+	}
+
+	fprintf(file, "{\"traceEvents\":[\n");
+
+	for (thr = 0; thr < ODP_THREAD_COUNT_MAX; thr++) {
+		if (!trace_global->thread[thr].used)
+			continue;
+
+		ev = &trace_global->event[(uint64_t)thr * num_events];
+		last = trace_global->thread[thr].idx;
+		first = last > num_events ? last - num_events : 0;
+		depth = 0;
+
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+			"\"pid\":%i,\"tid\":%i,\"args\":{\"name\":"
+			"\"odp thread %i\"}}", sep, pid, thr, thr);
+		sep = ",\n";
+
+		for (i = first; i < last; i++) {
+			_odp_trace_event_t *e = &ev[i & (num_events - 1)];
+
+			if (e->id >= _ODP_TRACE_NUM ||
+			    e->type > _ODP_TRACE_TYPE_INSTANT)
+				continue;
+
+			/* Skip end events of overwritten begin events */
+			if (e->type == _ODP_TRACE_TYPE_BEGIN) {
+				depth++;
+			} else if (e->type == _ODP_TRACE_TYPE_END) {
+				if (depth == 0)
+					continue;
+				depth--;
+			}
+
+			cycles = odp_cpu_cycles_diff(e->cycles,
+						     trace_global->start_cycles);
+
+			fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\","
+				"\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%i,"
+				"\"tid\":%i,%s\"args\":{\"arg\":%" PRIu32 "}}",
+				sep, tracepoint[e->id].name,
+				tracepoint[e->id].cat, phase[e->type],
+				us_per_cycle * cycles, pid, thr,
+				e->type == _ODP_TRACE_TYPE_INSTANT ?
+				"\"s\":\"t\"," : "", e->arg);
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+
+	if (fclose(file)) {
+		ODP_ERR("Trace file write failed: %s\n", trace_global->file);
+		return -1;
+	}
+
+	ODP_PRINT("Trace events written to %s\n", trace_global->file);
+
+	return 0;
+}
+
+int _odp_trace_term_global(void)
+{
+	int ret = 0;
+
+	if (trace_global == NULL)
+		return 0;
+
+	if (dump_events())
+		ret = -1;
+
+	if (odp_shm_free(trace_global->shm)) {
+		ODP_ERR("SHM free failed\n");
+		ret = -1;
+	}
+
+	trace_global = NULL;
+
+	return ret;
+}
@@ -31,6 +31,7 @@
 #include <odp_init_internal.h>
 #include <odp_errno_define.h>
 #include <odp_global_data.h>
+#include <odp_trace_internal.h>
 
 /* Local vars */
 static const
@@ -2255,12 +2256,17 @@ static void tm_send_pkt(tm_system_t *tm_system, uint32_t max_sends)
 			tm_egress_marking(tm_system, odp_pkt);
 
 		tm_system->egress_pkt_desc = EMPTY_PKT_DESC;
-		if (tm_system->egress.egress_kind == ODP_TM_EGRESS_PKT_IO)
+		if (tm_system->egress.egress_kind == ODP_TM_EGRESS_PKT_IO) {
 			odp_pktout_send(tm_system->pktout, &odp_pkt, 1);
-		else if (tm_system->egress.egress_kind == ODP_TM_EGRESS_FN)
+		} else if (tm_system->egress.egress_kind == ODP_TM_EGRESS_FN) {
+			_ODP_TRACE_BEGIN(_ODP_TRACE_TM_EGRESS,
+					 tm_queue_obj->queue_num);
 			tm_system->egress.egress_fcn(odp_pkt);
-		else
+			_ODP_TRACE_END(_ODP_TRACE_TM_EGRESS,
+				       tm_queue_obj->queue_num);
+		} else {
 			return;
+		}
 
 		tm_queue_obj->sent_pkt = tm_queue_obj->pkt;
 		tm_queue_obj->sent_pkt_desc = tm_queue_obj->in_pkt_desc;
@@ -4363,6 +4369,7 @@ int odp_tm_enq(odp_tm_queue_t tm_queue, odp_packet_t pkt)
 {
 	tm_queue_obj_t *tm_queue_obj;
 	tm_system_t *tm_system;
+	int rc;
 
 	tm_queue_obj = GET_TM_QUEUE_OBJ(tm_queue);
 	if (!tm_queue_obj)
@@ -4375,7 +4382,11 @@ int odp_tm_enq(odp_tm_queue_t tm_queue, odp_packet_t pkt)
 	if (odp_atomic_load_u64(&tm_system->destroying))
 		return -1;
 
-	return tm_enqueue(tm_system, tm_queue_obj, pkt);
+	_ODP_TRACE_BEGIN(_ODP_TRACE_TM_ENQ, tm_queue_obj->queue_num);
+	rc = tm_enqueue(tm_system, tm_queue_obj, pkt);
+	_ODP_TRACE_END(_ODP_TRACE_TM_ENQ, rc == 0);
+
+	return rc;
 }
 
 int odp_tm_enq_with_cnt(odp_tm_queue_t tm_queue, odp_packet_t pkt)
@@ -4396,7 +4407,9 @@ int odp_tm_enq_with_cnt(odp_tm_queue_t tm_queue, odp_packet_t pkt)
 	if (odp_atomic_load_u64(&tm_system->destroying))
 		return -1;
 
+	_ODP_TRACE_BEGIN(_ODP_TRACE_TM_ENQ, tm_queue_obj->queue_num);
 	rc = tm_enqueue(tm_system, tm_queue_obj, pkt);
+	_ODP_TRACE_END(_ODP_TRACE_TM_ENQ, rc == 0);
 	if (rc < 0)
 		return rc;
 
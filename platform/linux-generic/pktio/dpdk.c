@@ -1781,7 +1781,7 @@ static void dpdk_ptype_support_set(pktio_entry_t *pktio_entry, uint16_t port_id)
 	int max_num, num, i;
 	pkt_dpdk_t *pkt_dpdk = pkt_priv(pktio_entry);
 	uint32_t mask = RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK |
-			RTE_PTYPE_L4_MASK;
+			RTE_PTYPE_L4_MASK | RTE_PTYPE_TUNNEL_MASK;
 
 	pkt_dpdk->supported_ptypes = 0;
 
@@ -1816,6 +1816,14 @@ static void dpdk_ptype_support_set(pktio_entry_t *pktio_entry, uint16_t port_id)
 			pkt_dpdk->supported_ptypes |= PTYPE_UDP;
 		else if (ptype[i] == RTE_PTYPE_L4_TCP)
 			pkt_dpdk->supported_ptypes |= PTYPE_TCP;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_VXLAN)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_VXLAN;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GENEVE)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GENEVE;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GRE)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GRE;
+		else if (ptype[i] == RTE_PTYPE_TUNNEL_GTPU)
+			pkt_dpdk->supported_ptypes |= PTYPE_TUNNEL_GTPU;
 	}
 }
 
@@ -339,6 +339,114 @@ static inline void dpdk_parse_udp(packet_parser_t *prs,
 	*parseptr += sizeof(_odp_udphdr_t);
 }
 
+/**
+ * Tunnel type from mbuf packet type, or from packet headers when HW does not
+ * recognize the tunnel type
+ */
+static inline uint8_t dpdk_tunnel_type(const uint8_t *l4, uint32_t len,
+				       uint8_t ip_proto,
+				       uint32_t mbuf_packet_type,
+				       uint32_t supported_ptypes)
+{
+	uint8_t tunnel;
+
+	switch (mbuf_packet_type & RTE_PTYPE_TUNNEL_MASK) {
+	case RTE_PTYPE_TUNNEL_VXLAN:
+		return PACKET_TUNNEL_VXLAN;
+	case RTE_PTYPE_TUNNEL_GENEVE:
+		return PACKET_TUNNEL_GENEVE;
+	case RTE_PTYPE_TUNNEL_GRE:
+		/* Fall through */
+	case RTE_PTYPE_TUNNEL_NVGRE:
+		return PACKET_TUNNEL_GRE;
+	case RTE_PTYPE_TUNNEL_GTPU:
+		return PACKET_TUNNEL_GTPU;
+	default:
+		break;
+	}
+
+	tunnel = _odp_packet_tunnel_detect(l4, len, ip_proto);
+
+	/* HW recognizes this tunnel type, but did not mark the packet */
+	switch (tunnel) {
+	case PACKET_TUNNEL_VXLAN:
+		return (supported_ptypes & PTYPE_TUNNEL_VXLAN) ?
+			PACKET_TUNNEL_NONE : tunnel;
+	case PACKET_TUNNEL_GENEVE:
+		return (supported_ptypes & PTYPE_TUNNEL_GENEVE) ?
+			PACKET_TUNNEL_NONE : tunnel;
+	case PACKET_TUNNEL_GRE:
+		return (supported_ptypes & PTYPE_TUNNEL_GRE) ?
+			PACKET_TUNNEL_NONE : tunnel;
+	case PACKET_TUNNEL_GTPU:
+		return (supported_ptypes & PTYPE_TUNNEL_GTPU) ?
+			PACKET_TUNNEL_NONE : tunnel;
+	default:
+		return tunnel;
+	}
+}
+
+/**
+ * Inner headers from mbuf packet type. Inner packet types are valid only
+ * when HW recognized the tunnel. Returns NULL when no inner headers are
+ * known. Protocol is not given when inner IPv6 extension headers may need to
+ * be skipped.
+ */
+static inline const packet_tunnel_hint_t *
+dpdk_inner_hint(uint32_t mbuf_packet_type, packet_tunnel_hint_t *hint)
+{
+	if (!(mbuf_packet_type & RTE_PTYPE_TUNNEL_MASK))
+		return NULL;
+
+	hint->eth = 0;
+	hint->vlan = 0;
+
+	switch (mbuf_packet_type & RTE_PTYPE_INNER_L3_MASK) {
+	case RTE_PTYPE_INNER_L3_IPV4:
+		hint->l3_len = _ODP_IPV4HDR_LEN;
+		break;
+	case RTE_PTYPE_INNER_L3_IPV4_EXT:
+		hint->l3_len = 0;
+		break;
+	case RTE_PTYPE_INNER_L3_IPV6:
+		hint->l3_len = _ODP_IPV6HDR_LEN;
+		break;
+	default:
+		return NULL;
+	}
+
+	switch (mbuf_packet_type & RTE_PTYPE_INNER_L2_MASK) {
+	case RTE_PTYPE_INNER_L2_ETHER_QINQ:
+		hint->vlan++;
+		/* Fall through */
+	case RTE_PTYPE_INNER_L2_ETHER_VLAN:
+		hint->vlan++;
+		/* Fall through */
+	case RTE_PTYPE_INNER_L2_ETHER:
+		hint->eth = 1;
+		break;
+	default:
+		break;
+	}
+
+	switch (mbuf_packet_type & RTE_PTYPE_INNER_L4_MASK) {
+	case RTE_PTYPE_INNER_L4_TCP:
+		hint->l4 = _ODP_IPPROTO_TCP;
+		return hint;
+	case RTE_PTYPE_INNER_L4_UDP:
+		hint->l4 = _ODP_IPPROTO_UDP;
+		return hint;
+	case RTE_PTYPE_INNER_L4_SCTP:
+		hint->l4 = _ODP_IPPROTO_SCTP;
+		return hint;
+	case RTE_PTYPE_INNER_L4_FRAG:
+		hint->l4 = _ODP_IPPROTO_FRAG;
+		return hint;
+	default:
+		return NULL;
+	}
+}
+
 static inline
 int dpdk_packet_parse_common_l3_l4(packet_parser_t *prs,
 				   const uint8_t *parseptr,
@@ -347,9 +455,11 @@ int dpdk_packet_parse_common_l3_l4(packet_parser_t *prs,
 				   int layer, uint16_t ethtype,
 				   uint32_t mbuf_packet_type,
 				   uint64_t mbuf_ol,
+				   uint32_t supported_ptypes,
 				   odp_pktin_config_opt_t pktin_cfg)
 {
 	uint8_t  ip_proto;
+	const uint8_t *l4;
 
 	prs->l3_offset = offset;
 
@@ -395,6 +505,7 @@ int dpdk_packet_parse_common_l3_l4(packet_parser_t *prs,
 
 	/* Set l4 flag only for known ip_proto */
 	prs->input_flags.l4 = 1;
+	l4 = parseptr;
 
 	/* Parse Layer 4 headers */
 	switch (ip_proto) {
@@ -452,6 +563,25 @@ int dpdk_packet_parse_common_l3_l4(packet_parser_t *prs,
 		break;
 	}
 
+	/* Parse tunnel and inner headers */
+	if (layer == ODP_PROTO_LAYER_ALL && !prs->input_flags.ipfrag &&
+	    prs->l4_offset < seg_len) {
+		uint32_t len = seg_len - prs->l4_offset;
+		uint8_t tunnel = dpdk_tunnel_type(l4, len, ip_proto,
+						  mbuf_packet_type,
+						  supported_ptypes);
+		const packet_tunnel_hint_t *hint;
+		packet_tunnel_hint_t hint_data;
+
+		if (odp_unlikely(tunnel != PACKET_TUNNEL_NONE)) {
+			hint = dpdk_inner_hint(mbuf_packet_type, &hint_data);
+			prs->input_flags.tunnel =
+				_odp_packet_parse_tunnel(&prs->tunnel, l4,
+							 prs->l4_offset, len,
+							 tunnel, hint);
+		}
+	}
+
 	return 0;
 }
 
@@ -488,7 +618,7 @@ int _odp_dpdk_packet_parse_common(packet_parser_t *prs, const uint8_t *ptr,
 	return dpdk_packet_parse_common_l3_l4(prs, parseptr, offset, frame_len,
 					      seg_len, layer, ethtype,
 					      mbuf_packet_type, mbuf_ol,
-					      pktin_cfg);
+					      supported_ptype, pktin_cfg);
 }
 
 #endif /* _ODP_PKTIO_DPDK */
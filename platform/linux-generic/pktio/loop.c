@@ -421,6 +421,12 @@ static int loopback_init_capability(pktio_entry_t *pktio_entry)
 	capa->config.pktout.bit.sctp_chksum_ena =
 		capa->config.pktout.bit.sctp_chksum;
 
+	capa->stats.pktin_queue.counter.octets = 1;
+	capa->stats.pktin_queue.counter.packets = 1;
+	capa->stats.pktin_queue.counter.errors = 1;
+	capa->stats.pktout_queue.counter.octets = 1;
+	capa->stats.pktout_queue.counter.packets = 1;
+
 	return 0;
 }
 
@@ -456,6 +462,31 @@ static int loopback_stats_reset(pktio_entry_t *pktio_entry ODP_UNUSED)
 	return 0;
 }
 
+static int loopback_pktin_stats(pktio_entry_t *pktio_entry,
+				uint32_t index ODP_UNUSED,
+				odp_pktin_queue_stats_t *pktin_stats)
+{
+	odp_pktio_stats_t *stats = &pktio_entry->s.stats;
+
+	memset(pktin_stats, 0, sizeof(odp_pktin_queue_stats_t));
+	pktin_stats->octets = stats->in_octets;
+	pktin_stats->packets = stats->in_ucast_pkts;
+	pktin_stats->errors = stats->in_errors;
+	return 0;
+}
+
+static int loopback_pktout_stats(pktio_entry_t *pktio_entry,
+				 uint32_t index ODP_UNUSED,
+				 odp_pktout_queue_stats_t *pktout_stats)
+{
+	odp_pktio_stats_t *stats = &pktio_entry->s.stats;
+
+	memset(pktout_stats, 0, sizeof(odp_pktout_queue_stats_t));
+	pktout_stats->octets = stats->out_octets;
+	pktout_stats->packets = stats->out_ucast_pkts;
+	return 0;
+}
+
 static int loop_init_global(void)
 {
 	ODP_PRINT("PKTIO: initialized loop interface.\n");
@@ -474,6 +505,8 @@ const pktio_if_ops_t loopback_pktio_ops = {
 	.stop = NULL,
 	.stats = loopback_stats,
 	.stats_reset = loopback_stats_reset,
+	.pktin_queue_stats = loopback_pktin_stats,
+	.pktout_queue_stats = loopback_pktout_stats,
 	.recv = loopback_recv,
 	.send = loopback_send,
 	.mtu_get = loopback_mtu_get,
@@ -12,6 +12,7 @@
 #include <linux/ethtool.h>
 #include <errno.h>
 #include <net/if.h>
+#include <inttypes.h>
 
 #include <odp_api.h>
 #include <odp_ethtool_stats.h>
@@ -83,12 +84,33 @@ static struct ethtool_gstrings *get_stringset(int fd, struct ifreq *ifr)
 	return strings;
 }
 
+static struct ethtool_stats *get_stats(int fd, struct ifreq *ifr,
+				       unsigned int n_stats)
+{
+	struct ethtool_stats *estats;
+
+	estats = calloc(1, n_stats * sizeof(uint64_t) +
+			sizeof(struct ethtool_stats));
+	if (!estats)
+		return NULL;
+
+	estats->cmd = ETHTOOL_GSTATS;
+	estats->n_stats = n_stats;
+	ifr->ifr_data = (void *)estats;
+	if (ioctl(fd, SIOCETHTOOL, ifr) < 0) {
+		__odp_errno = errno;
+		free(estats);
+		return NULL;
+	}
+
+	return estats;
+}
+
 static int ethtool_stats(int fd, struct ifreq *ifr, odp_pktio_stats_t *stats)
 {
 	struct ethtool_gstrings *strings;
 	struct ethtool_stats *estats;
 	unsigned int n_stats, i;
-	int err;
 	int cnts;
 
 	strings = get_stringset(fd, ifr);
@@ -102,24 +124,12 @@ static int ethtool_stats(int fd, struct ifreq *ifr, odp_pktio_stats_t *stats)
 		return -1;
 	}
 
-	estats = calloc(1, n_stats * sizeof(uint64_t) +
-			sizeof(struct ethtool_stats));
+	estats = get_stats(fd, ifr, n_stats);
 	if (!estats) {
 		free(strings);
 		return -1;
 	}
 
-	estats->cmd = ETHTOOL_GSTATS;
-	estats->n_stats = n_stats;
-	ifr->ifr_data = (void *)estats;
-	err = ioctl(fd, SIOCETHTOOL, ifr);
-	if (err < 0) {
-		__odp_errno = errno;
-		free(strings);
-		free(estats);
-		return -1;
-	}
-
 	cnts = 0;
 	for (i = 0; i < n_stats; i++) {
 		char *cnt = (char *)&strings->data[i * ETH_GSTRING_LEN];
@@ -173,3 +183,96 @@ int ethtool_stats_get_fd(int fd, const char *name, odp_pktio_stats_t *stats)
 
 	return ethtool_stats(fd, &ifr, stats);
 }
+
+int ethtool_extra_stat_info_fd(int fd, const char *name,
+			       odp_pktio_extra_stat_info_t info[], int num)
+{
+	struct ethtool_gstrings *strings;
+	struct ifreq ifr;
+	int num_stats, i;
+
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", name);
+
+	strings = get_stringset(fd, &ifr);
+	if (!strings)
+		return -1;
+
+	num_stats = strings->len;
+
+	for (i = 0; i < num && i < num_stats; i++)
+		snprintf(info[i].name, ODP_PKTIO_STATS_EXTRA_NAME_LEN, "%.*s",
+			 ETH_GSTRING_LEN,
+			 (char *)&strings->data[i * ETH_GSTRING_LEN]);
+
+	free(strings);
+
+	return num_stats;
+}
+
+int ethtool_extra_stats_fd(int fd, const char *name, uint64_t stats[],
+			   int num)
+{
+	struct ethtool_gstrings *strings;
+	struct ethtool_stats *estats;
+	struct ifreq ifr;
+	int num_stats, i;
+
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", name);
+
+	strings = get_stringset(fd, &ifr);
+	if (!strings)
+		return -1;
+
+	num_stats = strings->len;
+	free(strings);
+
+	if (num == 0)
+		return num_stats;
+
+	estats = get_stats(fd, &ifr, num_stats);
+	if (!estats)
+		return -1;
+
+	for (i = 0; i < num && i < num_stats; i++)
+		stats[i] = estats->data[i];
+
+	free(estats);
+
+	return num_stats;
+}
+
+int ethtool_extra_stat_counter_fd(int fd, const char *name, uint32_t id,
+				  uint64_t *stat)
+{
+	struct ethtool_gstrings *strings;
+	struct ethtool_stats *estats;
+	struct ifreq ifr;
+	uint32_t num_stats;
+
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", name);
+
+	strings = get_stringset(fd, &ifr);
+	if (!strings)
+		return -1;
+
+	num_stats = strings->len;
+	free(strings);
+
+	if (id >= num_stats) {
+		ODP_ERR("invalid extra statistics counter id: %" PRIu32 "\n",
+			id);
+		return -1;
+	}
+
+	estats = get_stats(fd, &ifr, num_stats);
+	if (!estats)
+		return -1;
+
+	*stat = estats->data[id];
+	free(estats);
+
+	return 0;
+}
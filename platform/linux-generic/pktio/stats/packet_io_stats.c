@@ -94,3 +94,32 @@ pktio_stats_type_t sock_stats_type_fd(pktio_entry_t *pktio_entry, int fd)
 
 	return STATS_UNSUPPORTED;
 }
+
+int sock_extra_stat_info_fd(pktio_entry_t *pktio_entry,
+			    odp_pktio_extra_stat_info_t info[], int num,
+			    int fd)
+{
+	int ret;
+
+	ret = ethtool_extra_stat_info_fd(fd, pktio_entry->s.name, info, num);
+
+	/* Interfaces without ethtool statistics have no extra counters */
+	return ret < 0 ? 0 : ret;
+}
+
+int sock_extra_stats_fd(pktio_entry_t *pktio_entry, uint64_t stats[], int num,
+			int fd)
+{
+	int ret;
+
+	ret = ethtool_extra_stats_fd(fd, pktio_entry->s.name, stats, num);
+
+	return ret < 0 ? 0 : ret;
+}
+
+int sock_extra_stat_counter_fd(pktio_entry_t *pktio_entry, uint32_t id,
+			       uint64_t *stat, int fd)
+{
+	return ethtool_extra_stat_counter_fd(fd, pktio_entry->s.name, id,
+					     stat);
+}
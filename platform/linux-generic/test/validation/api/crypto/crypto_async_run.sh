@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# Copyright (c) 2020, Nokia
+# All rights reserved.
+#
+# SPDX-License-Identifier:	BSD-3-Clause
+#
+
+# Run crypto validation tests with asynchronous operations processed by
+# crypto service threads. Any parameter passed as arguments to this script
+# is passed unchanged to the test itself (crypto_main).
+
+# directories where crypto_main binary can be found:
+# -in the validation dir when running make check (intree or out of tree)
+# -in the script directory, when running after 'make install', or
+# -in the validation when running standalone intree.
+# -in the current directory.
+# running stand alone out of tree requires setting PATH
+PATH=${TEST_DIR}/api/crypto:$PATH
+PATH=$(dirname $0):$PATH
+PATH=$(dirname $0)/../../../../../../test/validation/api/crypto:$PATH
+PATH=.:$PATH
+
+crypto_main_path=$(which crypto_main${EXEEXT})
+if [ -x "$crypto_main_path" ] ; then
+	echo "running with $crypto_main_path"
+else
+	echo "cannot find crypto_main${EXEEXT}: please set you PATH for it."
+	exit 1
+fi
+
+# directory where platform test sources are, including config files
+TEST_SRC_DIR=$(dirname $0)/../../..
+
+if [ -f ./crypto-async.conf ]; then
+	ODP_CONFIG_FILE=./crypto-async.conf
+else
+	ODP_CONFIG_FILE=${TEST_SRC_DIR}/crypto-async.conf
+fi
+export ODP_CONFIG_FILE
+
+crypto_main${EXEEXT} $*
@@ -462,6 +462,39 @@ static const uint8_t test_packet_ipv4_rr_nop_icmp[] = {
 	0x00, 0x00
 };
 
+/* IPv4 / UDP / VXLAN (VNI 0x123456) / Ethernet / IPv4 / UDP */
+static const uint8_t test_packet_ipv4_vxlan_ipv4_udp[] = {
+	0x00, 0x00, 0x09, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x09, 0x00, 0x04, 0x00, 0x08, 0x00, 0x45, 0x00,
+	0x00, 0x56, 0x00, 0x02, 0x00, 0x00, 0x40, 0x11,
+	0xF7, 0x41, 0xC0, 0xA8, 0x01, 0x02, 0xC0, 0xA8,
+	0x01, 0x01, 0xC0, 0x00, 0x12, 0xB5, 0x00, 0x42,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x12, 0x34,
+	0x56, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x08, 0x00,
+	0x45, 0x00, 0x00, 0x24, 0x00, 0x01, 0x00, 0x00,
+	0x40, 0x11, 0x66, 0xC6, 0x0A, 0x00, 0x00, 0x01,
+	0x0A, 0x00, 0x00, 0x02, 0x04, 0xD2, 0x16, 0x2E,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03,
+	0x04, 0x05, 0x06, 0x07
+};
+
+/* IPv4 / NVGRE (VSID 0x654321) / Ethernet / IPv4 / UDP */
+static const uint8_t test_packet_ipv4_nvgre_ipv4_udp[] = {
+	0x00, 0x00, 0x09, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x09, 0x00, 0x04, 0x00, 0x08, 0x00, 0x45, 0x00,
+	0x00, 0x4E, 0x00, 0x03, 0x00, 0x00, 0x40, 0x2F,
+	0xF7, 0x2A, 0xC0, 0xA8, 0x01, 0x02, 0xC0, 0xA8,
+	0x01, 0x01, 0x20, 0x00, 0x65, 0x58, 0x65, 0x43,
+	0x21, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+	0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x08, 0x00,
+	0x45, 0x00, 0x00, 0x24, 0x00, 0x01, 0x00, 0x00,
+	0x40, 0x11, 0x66, 0xC6, 0x0A, 0x00, 0x00, 0x01,
+	0x0A, 0x00, 0x00, 0x02, 0x04, 0xD2, 0x16, 0x2E,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03,
+	0x04, 0x05, 0x06, 0x07
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -327,6 +327,26 @@ static void alloc_packets_multi(void)
 			      TEST_REPEAT_COUNT * gbl_args->appl.burst_size);
 }
 
+static void alloc_packets_multi_meta(void)
+{
+	int i;
+	odp_packet_t *pkt_tbl = gbl_args->pkt_tbl;
+
+	alloc_packets_multi();
+
+	/* Packet reset must overwrite all of these */
+	for (i = 0; i < TEST_REPEAT_COUNT * gbl_args->appl.burst_size; i++) {
+		if (odp_packet_l3_offset_set(pkt_tbl[i], TEST_L3_OFFSET) ||
+		    odp_packet_l4_offset_set(pkt_tbl[i], TEST_L4_OFFSET))
+			ODPH_ABORT("Setting test packet offsets failed\n");
+
+		odp_packet_has_ipv4_set(pkt_tbl[i], 1);
+		odp_packet_has_udp_set(pkt_tbl[i], 1);
+		odp_packet_flow_hash_set(pkt_tbl[i], i);
+		odp_packet_color_set(pkt_tbl[i], ODP_PACKET_YELLOW);
+	}
+}
+
 static void alloc_concat_packets(void)
 {
 	allocate_test_packets(gbl_args->pkt.len / 2, gbl_args->pkt_tbl,
@@ -632,6 +652,23 @@ static int bench_packet_reset(void)
 	return !ret;
 }
 
+/* Reset bursts of packets with metadata set. Measures packet header
+ * initialization in the same pattern as packet input does it. */
+static int bench_packet_reset_multi(void)
+{
+	int i, j;
+	int ret = 0;
+
+	for (i = 0; i < TEST_REPEAT_COUNT; i++) {
+		int pkt_idx = i * gbl_args->appl.burst_size;
+
+		for (j = 0; j < gbl_args->appl.burst_size; j++)
+			ret += odp_packet_reset(gbl_args->pkt_tbl[pkt_idx + j],
+						gbl_args->pkt.len);
+	}
+	return !ret;
+}
+
 static int bench_packet_from_event(void)
 {
 	int i;
@@ -1573,6 +1610,8 @@ bench_info_t test_suite[] = {
 		BENCH_INFO(bench_packet_alloc_free_multi, NULL, NULL, NULL),
 		BENCH_INFO(bench_packet_reset, create_packets, free_packets,
 			   NULL),
+		BENCH_INFO(bench_packet_reset_multi, alloc_packets_multi_meta,
+			   free_packets_multi, NULL),
 		BENCH_INFO(bench_packet_from_event, create_events, free_packets,
 			   NULL),
 		BENCH_INFO(bench_packet_from_event_multi, create_events_multi,
@@ -0,0 +1,1165 @@
+/* Copyright (c) 2020, Nokia
+ *
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+/* Maximum number of PMRs in the rule table */
+#define MAX_RULES        1024
+
+/* Maximum number of packets in flight */
+#define MAX_BURST        64
+
+/* Rule PMRs per CoS. One more PMR per CoS is used to link to the next CoS
+ * of the rule table. Implementations may limit the number of PMRs per
+ * source CoS, so the rule table is split into a list of CoS. */
+#define RULES_PER_COS    7
+
+/* Number of destination CoS of rule PMRs */
+#define NUM_DST_COS      8
+
+/* Maximum chain depth */
+#define MAX_CHAIN        16
+
+/* Maximum number of CoS in rule table levels */
+#define MAX_LEVELS       ((MAX_RULES + RULES_PER_COS - 1) / RULES_PER_COS)
+
+/* Rule term value base values. Rule 'i' matches base + i. */
+#define PORT_BASE        1024
+#define ADDR_BASE        0x0a000000
+
+/* Value index which does not match any rule */
+#define MISS_INDEX       (2 * MAX_RULES)
+
+/* Maximum number of poll rounds without packets before giving up */
+#define MAX_IDLE_POLLS   1000000
+
+#define QOS_L2           0x1
+#define QOS_L3           0x2
+
+#define NUM_PCP          8
+#define NUM_DSCP         64
+
+typedef enum {
+	TERM_UDP_DPORT = 0,
+	TERM_UDP_SPORT,
+	TERM_DIP_ADDR,
+	TERM_SIP_ADDR,
+	NUM_TERMS
+} term_type_t;
+
+typedef enum {
+	HIT_UNIFORM = 0,
+	HIT_FIRST,
+	HIT_LAST,
+	HIT_MISS,
+	NUM_HITS
+} hit_dist_t;
+
+typedef struct test_options_t {
+	char     pktio_name[64];
+	uint32_t num_rule;
+	uint32_t term;
+	uint32_t hit;
+	uint32_t chain;
+	uint32_t qos;
+	uint32_t num_round;
+	uint32_t burst;
+	uint32_t pkt_len;
+	uint32_t dst_pool;
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint32_t num_rule;
+	uint64_t packets;
+	uint64_t cycles;
+	uint64_t nsec;
+	uint64_t rule_hits;
+	uint64_t total;
+
+} test_stat_t;
+
+typedef struct test_global_t {
+	test_options_t test_options;
+
+	odp_pool_t pool;
+	odp_pool_t dst_pool;
+	odp_pktio_t pktio;
+	odp_queue_t pktin_queue;
+	odp_pktout_queue_t pktout;
+	odp_queue_t dst_queue;
+	odph_ethaddr_t eth_addr;
+	uint32_t hdr_len;
+	uint32_t l3_offset;
+
+	/* Default CoS, chain CoS and rule table levels */
+	odp_cos_t default_cos;
+	odp_cos_t chain_cos[MAX_CHAIN];
+	odp_pmr_t chain_pmr[MAX_CHAIN];
+	odp_cos_t level_cos[MAX_LEVELS];
+	odp_pmr_t level_pmr[MAX_LEVELS];
+	odp_cos_t dst_cos[NUM_DST_COS];
+	odp_cos_t qos_cos;
+	uint32_t num_level;
+
+	odp_pmr_t rule_pmr[MAX_RULES];
+	uint32_t num_rule_pmr;
+	uint32_t num_level_pmr;
+
+	odp_packet_t pkt[MAX_BURST];
+
+	uint32_t num_stat;
+	test_stat_t stat[32];
+
+} test_global_t;
+
+test_global_t test_global;
+
+static const char *term_name[NUM_TERMS] = {"udp dport", "udp sport",
+					    "ipv4 daddr", "ipv4 saddr"};
+
+static const char *hit_name[NUM_HITS] = {"uniform", "first", "last", "miss"};
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Classifier performance test\n"
+	       "\n"
+	       "Measures packet input cycles per packet through a classifier enabled interface as a function\n"
+	       "of the number of PMRs. Packets are looped back through the interface and classified on input.\n"
+	       "The first measurement step is done without rules and acts as the baseline.\n"
+	       "\n"
+	       "Usage: odp_cls_perf [options]\n"
+	       "\n"
+	       "  -i, --interface        Interface name. Default: loop\n"
+	       "  -n, --num_rule         Maximum number of rules (PMRs). Rule count is doubled on every\n"
+	       "                         measurement step until this is reached. Default: 64\n"
+	       "  -t, --term             Rule term type\n"
+	       "                           0: UDP destination port (default)\n"
+	       "                           1: UDP source port\n"
+	       "                           2: IPv4 destination address\n"
+	       "                           3: IPv4 source address\n"
+	       "  -d, --hit              Rule hit distribution of packets\n"
+	       "                           0: Uniform over all rules (default)\n"
+	       "                           1: All packets hit the first rule\n"
+	       "                           2: All packets hit the last rule\n"
+	       "                           3: No packet hits a rule\n"
+	       "  -c, --chain            Number of chained CoS every packet passes before the rule table.\n"
+	       "                         Default: 0\n"
+	       "  -q, --qos              QoS table bit mask. QoS tables are used for packets that do not\n"
+	       "                         match any PMR of the default CoS.\n"
+	       "                           0x1: L2 priority table (packets are VLAN tagged)\n"
+	       "                           0x2: L3 DSCP table\n"
+	       "  -r, --num_round        Number of rounds per measurement step. Default: 10000\n"
+	       "  -b, --burst            Number of packets per round. Default: 32\n"
+	       "  -l, --pkt_len          Packet length in bytes. Default: 64\n"
+	       "  -p, --dst_pool         Destination CoS of rules use a separate packet pool. Packets that hit\n"
+	       "                         a rule are copied into the pool, which adds the pool switch cost.\n"
+	       "                           0: Same pool for all CoS (default)\n"
+	       "                           1: Separate pool for destination CoS\n"
+	       "  -h, --help             This help\n"
+	       "\n");
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int long_index;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{"interface", required_argument, NULL, 'i'},
+		{"num_rule",  required_argument, NULL, 'n'},
+		{"term",      required_argument, NULL, 't'},
+		{"hit",       required_argument, NULL, 'd'},
+		{"chain",     required_argument, NULL, 'c'},
+		{"qos",       required_argument, NULL, 'q'},
+		{"num_round", required_argument, NULL, 'r'},
+		{"burst",     required_argument, NULL, 'b'},
+		{"pkt_len",   required_argument, NULL, 'l'},
+		{"dst_pool",  required_argument, NULL, 'p'},
+		{"help",      no_argument,       NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+i:n:t:d:c:q:r:b:l:p:h";
+
+	strcpy(test_options->pktio_name, "loop");
+	test_options->num_rule  = 64;
+	test_options->term      = TERM_UDP_DPORT;
+	test_options->hit       = HIT_UNIFORM;
+	test_options->chain     = 0;
+	test_options->qos       = 0;
+	test_options->num_round = 10000;
+	test_options->burst     = 32;
+	test_options->pkt_len   = 64;
+	test_options->dst_pool  = 0;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'i':
+			if (strlen(optarg) >=
+			    sizeof(test_options->pktio_name)) {
+				printf("Error: Too long interface name\n");
+				ret = -1;
+				break;
+			}
+			strcpy(test_options->pktio_name, optarg);
+			break;
+		case 'n':
+			test_options->num_rule = atoi(optarg);
+			break;
+		case 't':
+			test_options->term = atoi(optarg);
+			break;
+		case 'd':
+			test_options->hit = atoi(optarg);
+			break;
+		case 'c':
+			test_options->chain = atoi(optarg);
+			break;
+		case 'q':
+			test_options->qos = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			test_options->num_round = atoi(optarg);
+			break;
+		case 'b':
+			test_options->burst = atoi(optarg);
+			break;
+		case 'l':
+			test_options->pkt_len = atoi(optarg);
+			break;
+		case 'p':
+			test_options->dst_pool = atoi(optarg);
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->num_rule > MAX_RULES) {
+		printf("Error: Too many rules. Max %u.\n", MAX_RULES);
+		ret = -1;
+	}
+
+	if (test_options->term >= NUM_TERMS) {
+		printf("Error: Bad term type %u\n", test_options->term);
+		ret = -1;
+	}
+
+	if (test_options->hit >= NUM_HITS) {
+		printf("Error: Bad hit distribution %u\n", test_options->hit);
+		ret = -1;
+	}
+
+	if (test_options->chain > MAX_CHAIN) {
+		printf("Error: Too long chain. Max %u.\n", MAX_CHAIN);
+		ret = -1;
+	}
+
+	if (test_options->burst == 0 || test_options->burst > MAX_BURST) {
+		printf("Error: Bad burst size. Max %u.\n", MAX_BURST);
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static uint32_t num_levels(uint32_t num_rule)
+{
+	if (num_rule == 0)
+		return 1;
+
+	return (num_rule + RULES_PER_COS - 1) / RULES_PER_COS;
+}
+
+static odp_cos_t create_cos(test_global_t *global, const char *prefix,
+			    uint32_t idx, odp_pool_t pool)
+{
+	odp_cls_cos_param_t cos_param;
+	char name[ODP_COS_NAME_LEN];
+
+	snprintf(name, sizeof(name), "cls_perf_%s_%u", prefix, idx);
+
+	odp_cls_cos_param_init(&cos_param);
+	cos_param.num_queue = 1;
+	cos_param.queue     = global->dst_queue;
+	cos_param.pool      = pool;
+
+	return odp_cls_cos_create(name, &cos_param);
+}
+
+/* PMR which matches all test packets */
+static odp_pmr_t create_link_pmr(odp_cos_t src, odp_cos_t dst)
+{
+	odp_pmr_param_t pmr_param;
+	uint8_t proto = ODPH_IPPROTO_UDP;
+	uint8_t mask = 0xff;
+
+	odp_cls_pmr_param_init(&pmr_param);
+	pmr_param.term        = ODP_PMR_IPPROTO;
+	pmr_param.match.value = &proto;
+	pmr_param.match.mask  = &mask;
+	pmr_param.val_sz      = sizeof(proto);
+
+	return odp_cls_pmr_create(&pmr_param, 1, src, dst);
+}
+
+static int check_capa(test_global_t *global)
+{
+	odp_cls_capability_t cls_capa;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_cos, num_pmr;
+	uint32_t num_level = num_levels(test_options->num_rule);
+	odp_cls_pmr_terms_t *terms = &cls_capa.supported_terms;
+	int supported;
+
+	if (odp_cls_capability(&cls_capa)) {
+		printf("Error: Classifier capability failed\n");
+		return -1;
+	}
+
+	num_cos = 1 + test_options->chain + num_level - 1 + NUM_DST_COS;
+	if (test_options->qos)
+		num_cos++;
+
+	num_pmr = test_options->chain + num_level - 1 + test_options->num_rule;
+
+	if (num_cos > cls_capa.max_cos) {
+		printf("Error: Too many CoS needed (%u). Max %u.\n", num_cos,
+		       cls_capa.max_cos);
+		return -1;
+	}
+
+	if (num_pmr > cls_capa.available_pmr_terms) {
+		printf("Error: Too many PMRs needed (%u). Available %u.\n",
+		       num_pmr, cls_capa.available_pmr_terms);
+		return -1;
+	}
+
+	switch (test_options->term) {
+	case TERM_UDP_DPORT:
+		supported = terms->bit.udp_dport;
+		break;
+	case TERM_UDP_SPORT:
+		supported = terms->bit.udp_sport;
+		break;
+	case TERM_DIP_ADDR:
+		supported = terms->bit.dip_addr;
+		break;
+	default:
+		supported = terms->bit.sip_addr;
+		break;
+	}
+
+	if (!supported || ((test_options->chain || num_level > 1) &&
+			   !terms->bit.ip_proto)) {
+		printf("Error: PMR term not supported\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int create_pool(test_global_t *global)
+{
+	odp_pool_param_t pool_param;
+	test_options_t *test_options = &global->test_options;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type    = ODP_POOL_PACKET;
+	pool_param.pkt.num = 4 * MAX_BURST;
+	pool_param.pkt.len = test_options->pkt_len;
+
+	global->pool = odp_pool_create("cls_perf", &pool_param);
+
+	if (global->pool == ODP_POOL_INVALID) {
+		printf("Error: Pool create failed\n");
+		return -1;
+	}
+
+	if (!test_options->dst_pool) {
+		global->dst_pool = global->pool;
+		return 0;
+	}
+
+	global->dst_pool = odp_pool_create("cls_perf_dst", &pool_param);
+
+	if (global->dst_pool == ODP_POOL_INVALID) {
+		printf("Error: Destination pool create failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int open_pktio(test_global_t *global)
+{
+	odp_pktio_param_t pktio_param;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pktout_queue_param_t pktout_param;
+	odp_queue_param_t queue_param;
+	odp_pktio_t pktio;
+	test_options_t *test_options = &global->test_options;
+
+	odp_queue_param_init(&queue_param);
+	queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+
+	global->dst_queue = odp_queue_create("cls_perf_dst", &queue_param);
+
+	if (global->dst_queue == ODP_QUEUE_INVALID) {
+		printf("Error: Queue create failed\n");
+		return -1;
+	}
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode  = ODP_PKTIN_MODE_QUEUE;
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open(test_options->pktio_name, global->pool,
+			       &pktio_param);
+
+	if (pktio == ODP_PKTIO_INVALID) {
+		printf("Error: Pktio open failed: %s\n",
+		       test_options->pktio_name);
+		return -1;
+	}
+
+	global->pktio = pktio;
+
+	if (odp_pktio_mac_addr(pktio, global->eth_addr.addr,
+			       ODPH_ETHADDR_LEN) != ODPH_ETHADDR_LEN) {
+		printf("Error: MAC address read failed\n");
+		return -1;
+	}
+
+	odp_pktin_queue_param_init(&pktin_param);
+	pktin_param.classifier_enable = 1;
+	pktin_param.num_queues        = 1;
+
+	if (odp_pktin_queue_config(pktio, &pktin_param)) {
+		printf("Error: Pktin config failed\n");
+		return -1;
+	}
+
+	odp_pktout_queue_param_init(&pktout_param);
+	pktout_param.num_queues = 1;
+
+	if (odp_pktout_queue_config(pktio, &pktout_param)) {
+		printf("Error: Pktout config failed\n");
+		return -1;
+	}
+
+	if (odp_pktin_event_queue(pktio, &global->pktin_queue, 1) != 1) {
+		printf("Error: Pktin event queue request failed\n");
+		return -1;
+	}
+
+	if (odp_pktout_queue(pktio, &global->pktout, 1) != 1) {
+		printf("Error: Pktout queue request failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int create_cos_tree(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t chain = test_options->chain;
+	uint32_t i;
+	odp_cos_t src;
+
+	global->default_cos = create_cos(global, "default", 0,
+					 global->pool);
+
+	if (global->default_cos == ODP_COS_INVALID) {
+		printf("Error: Default CoS create failed\n");
+		return -1;
+	}
+
+	if (odp_pktio_default_cos_set(global->pktio, global->default_cos)) {
+		printf("Error: Default CoS set failed\n");
+		return -1;
+	}
+
+	/* Chain of CoS which all packets pass through */
+	src = global->default_cos;
+
+	for (i = 0; i < chain; i++) {
+		global->chain_cos[i] = create_cos(global, "chain", i,
+						  global->pool);
+
+		if (global->chain_cos[i] == ODP_COS_INVALID) {
+			printf("Error: Chain CoS create failed\n");
+			return -1;
+		}
+
+		global->chain_pmr[i] = create_link_pmr(src,
+						       global->chain_cos[i]);
+
+		if (global->chain_pmr[i] == ODP_PMR_INVALID) {
+			printf("Error: Chain PMR create failed\n");
+			return -1;
+		}
+
+		src = global->chain_cos[i];
+	}
+
+	/* Rule table starts from the last CoS of the chain */
+	global->level_cos[0] = src;
+	global->num_level = num_levels(test_options->num_rule);
+
+	for (i = 1; i < global->num_level; i++) {
+		global->level_cos[i] = create_cos(global, "level", i,
+						  global->pool);
+
+		if (global->level_cos[i] == ODP_COS_INVALID) {
+			printf("Error: Level CoS create failed\n");
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NUM_DST_COS; i++) {
+		global->dst_cos[i] = create_cos(global, "dst", i,
+						global->dst_pool);
+
+		if (global->dst_cos[i] == ODP_COS_INVALID) {
+			printf("Error: Destination CoS create failed\n");
+			return -1;
+		}
+	}
+
+	if (test_options->qos) {
+		uint8_t qos_table[NUM_DSCP];
+		odp_cos_t cos_table[NUM_DSCP];
+
+		global->qos_cos = create_cos(global, "qos", 0,
+					     global->pool);
+
+		if (global->qos_cos == ODP_COS_INVALID) {
+			printf("Error: QoS CoS create failed\n");
+			return -1;
+		}
+
+		for (i = 0; i < NUM_DSCP; i++) {
+			qos_table[i] = i;
+			cos_table[i] = global->qos_cos;
+		}
+
+		if ((test_options->qos & QOS_L2) &&
+		    odp_cos_with_l2_priority(global->pktio, NUM_PCP, qos_table,
+					     cos_table)) {
+			printf("Error: L2 QoS table config failed\n");
+			return -1;
+		}
+
+		if ((test_options->qos & QOS_L3) &&
+		    odp_cos_with_l3_qos(global->pktio, NUM_DSCP, qos_table,
+					cos_table, 1)) {
+			printf("Error: L3 QoS table config failed\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int create_rules(test_global_t *global, uint32_t num_rule)
+{
+	odp_pmr_param_t pmr_param;
+	uint32_t i, level, num_level;
+	uint16_t port;
+	uint32_t addr;
+	uint16_t port_mask = 0xffff;
+	uint32_t addr_mask = 0xffffffff;
+	odp_pmr_t pmr;
+	test_options_t *test_options = &global->test_options;
+
+	global->num_rule_pmr = 0;
+	global->num_level_pmr = 0;
+	num_level = num_levels(num_rule);
+
+	for (level = 0; level < num_level; level++) {
+		odp_cos_t src = global->level_cos[level];
+
+		for (i = level * RULES_PER_COS;
+		     i < num_rule && i < (level + 1) * RULES_PER_COS; i++) {
+			odp_cls_pmr_param_init(&pmr_param);
+
+			switch (test_options->term) {
+			case TERM_UDP_DPORT:
+			case TERM_UDP_SPORT:
+				port = odp_cpu_to_be_16(PORT_BASE + i);
+				pmr_param.term = test_options->term ==
+						 TERM_UDP_DPORT ?
+						 ODP_PMR_UDP_DPORT :
+						 ODP_PMR_UDP_SPORT;
+				pmr_param.match.value = &port;
+				pmr_param.match.mask  = &port_mask;
+				pmr_param.val_sz      = sizeof(port);
+				break;
+			default:
+				addr = odp_cpu_to_be_32(ADDR_BASE + i);
+				pmr_param.term = test_options->term ==
+						 TERM_DIP_ADDR ?
+						 ODP_PMR_DIP_ADDR :
+						 ODP_PMR_SIP_ADDR;
+				pmr_param.match.value = &addr;
+				pmr_param.match.mask  = &addr_mask;
+				pmr_param.val_sz      = sizeof(addr);
+				break;
+			}
+
+			pmr = odp_cls_pmr_create(&pmr_param, 1, src,
+						 global->dst_cos[i %
+								 NUM_DST_COS]);
+
+			if (pmr == ODP_PMR_INVALID) {
+				printf("Error: Rule PMR create failed (%u)\n",
+				       i);
+				return -1;
+			}
+
+			global->rule_pmr[global->num_rule_pmr++] = pmr;
+		}
+
+		/* Link to the next level after the rules of this level */
+		if (level + 1 < num_level) {
+			pmr = create_link_pmr(src,
+					      global->level_cos[level + 1]);
+
+			if (pmr == ODP_PMR_INVALID) {
+				printf("Error: Level PMR create failed\n");
+				return -1;
+			}
+
+			global->level_pmr[global->num_level_pmr++] = pmr;
+		}
+	}
+
+	return 0;
+}
+
+static int destroy_rules(test_global_t *global)
+{
+	uint32_t i;
+	int ret = 0;
+
+	for (i = 0; i < global->num_rule_pmr; i++) {
+		if (odp_cls_pmr_destroy(global->rule_pmr[i])) {
+			printf("Error: Rule PMR destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	for (i = 0; i < global->num_level_pmr; i++) {
+		if (odp_cls_pmr_destroy(global->level_pmr[i])) {
+			printf("Error: Level PMR destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	global->num_rule_pmr = 0;
+	global->num_level_pmr = 0;
+
+	return ret;
+}
+
+static int alloc_packets(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t burst = test_options->burst;
+	uint32_t pkt_len = test_options->pkt_len;
+	uint32_t l2_len = ODPH_ETHHDR_LEN;
+	uint32_t i;
+	int num;
+
+	if (test_options->qos & QOS_L2)
+		l2_len += ODPH_VLANHDR_LEN;
+
+	global->l3_offset = l2_len;
+	global->hdr_len = l2_len + ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN;
+
+	if (pkt_len < global->hdr_len) {
+		printf("Error: Too short packet length. Min %u.\n",
+		       global->hdr_len);
+		return -1;
+	}
+
+	num = odp_packet_alloc_multi(global->pool, pkt_len, global->pkt, burst);
+
+	if (num != (int)burst) {
+		printf("Error: Packet alloc failed\n");
+		if (num > 0)
+			odp_packet_free_multi(global->pkt, num);
+		return -1;
+	}
+
+	for (i = 0; i < burst; i++) {
+		if (odp_packet_seg_len(global->pkt[i]) < global->hdr_len) {
+			printf("Error: Too short first segment\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Rule index which packet 'i' is targeted to */
+static uint32_t packet_rule(test_global_t *global, uint32_t num_rule,
+			    uint32_t i)
+{
+	if (num_rule == 0)
+		return MISS_INDEX;
+
+	switch (global->test_options.hit) {
+	case HIT_UNIFORM:
+		return i % num_rule;
+	case HIT_FIRST:
+		return 0;
+	case HIT_LAST:
+		return num_rule - 1;
+	default:
+		return MISS_INDEX;
+	}
+}
+
+static void init_packets(test_global_t *global, uint32_t num_rule)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t burst = test_options->burst;
+	uint32_t pkt_len = test_options->pkt_len;
+	uint32_t l3_offset = global->l3_offset;
+	uint32_t i, rule;
+	uint8_t *data;
+	odph_ethhdr_t *eth;
+	odph_vlanhdr_t *vlan;
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+
+	for (i = 0; i < burst; i++) {
+		data = odp_packet_data(global->pkt[i]);
+		rule = packet_rule(global, num_rule, i);
+
+		eth = (odph_ethhdr_t *)data;
+		memcpy(eth->dst.addr, global->eth_addr.addr, ODPH_ETHADDR_LEN);
+		memcpy(eth->src.addr, global->eth_addr.addr, ODPH_ETHADDR_LEN);
+		eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+
+		if (test_options->qos & QOS_L2) {
+			eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_VLAN);
+			vlan = (odph_vlanhdr_t *)(eth + 1);
+			vlan->tci = odp_cpu_to_be_16(((i % NUM_PCP) << 13) | 1);
+			vlan->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+		}
+
+		ip = (odph_ipv4hdr_t *)(data + l3_offset);
+		memset(ip, 0, ODPH_IPV4HDR_LEN);
+		ip->ver_ihl  = ODPH_IPV4 << 4 | ODPH_IPV4HDR_IHL_MIN;
+		ip->tos      = (i % NUM_DSCP) << 2;
+		ip->tot_len  = odp_cpu_to_be_16(pkt_len - l3_offset);
+		ip->ttl      = 64;
+		ip->proto    = ODPH_IPPROTO_UDP;
+		ip->src_addr = odp_cpu_to_be_32(ADDR_BASE + MISS_INDEX);
+		ip->dst_addr = odp_cpu_to_be_32(ADDR_BASE + MISS_INDEX);
+
+		udp = (odph_udphdr_t *)(data + l3_offset + ODPH_IPV4HDR_LEN);
+		memset(udp, 0, ODPH_UDPHDR_LEN);
+		udp->src_port = odp_cpu_to_be_16(PORT_BASE + MISS_INDEX);
+		udp->dst_port = odp_cpu_to_be_16(PORT_BASE + MISS_INDEX);
+		udp->length   = odp_cpu_to_be_16(pkt_len - l3_offset -
+						 ODPH_IPV4HDR_LEN);
+
+		switch (test_options->term) {
+		case TERM_UDP_DPORT:
+			udp->dst_port = odp_cpu_to_be_16(PORT_BASE + rule);
+			break;
+		case TERM_UDP_SPORT:
+			udp->src_port = odp_cpu_to_be_16(PORT_BASE + rule);
+			break;
+		case TERM_DIP_ADDR:
+			ip->dst_addr = odp_cpu_to_be_32(ADDR_BASE + rule);
+			break;
+		default:
+			ip->src_addr = odp_cpu_to_be_32(ADDR_BASE + rule);
+			break;
+		}
+
+		ip->chksum = ~odp_chksum_ones_comp16(ip, ODPH_IPV4HDR_LEN);
+	}
+}
+
+/* Packets are not owned by the test after a failed round */
+static void invalidate_packets(test_global_t *global)
+{
+	uint32_t i;
+
+	for (i = 0; i < MAX_BURST; i++)
+		global->pkt[i] = ODP_PACKET_INVALID;
+}
+
+/* Send all packets to the interface and receive them back through
+ * the classifier */
+static int loop_packets(test_global_t *global, uint32_t num)
+{
+	odp_event_t ev[MAX_BURST];
+	odp_packet_t *pkt = global->pkt;
+	uint32_t received = 0;
+	uint32_t idle = 0;
+	int ret;
+
+	ret = odp_pktout_send(global->pktout, pkt, num);
+
+	if (odp_unlikely(ret != (int)num)) {
+		printf("Error: Send failed (%i/%u)\n", ret, num);
+		if (ret < 0)
+			ret = 0;
+		odp_packet_free_multi(&pkt[ret], num - ret);
+		invalidate_packets(global);
+		return -1;
+	}
+
+	while (received < num) {
+		/* Poll the interface. Classified packets are delivered to
+		 * the destination queue, others to the pktin queue. */
+		ret = odp_queue_deq_multi(global->pktin_queue, &ev[received],
+					  num - received);
+		if (ret > 0) {
+			received += ret;
+			idle = 0;
+		}
+
+		ret = odp_queue_deq_multi(global->dst_queue, &ev[received],
+					  num - received);
+		if (ret > 0) {
+			received += ret;
+			idle = 0;
+		} else if (odp_unlikely(++idle > MAX_IDLE_POLLS)) {
+			printf("Error: Packets lost (%u/%u)\n", received, num);
+			odp_event_free_multi(ev, received);
+			invalidate_packets(global);
+			return -1;
+		}
+	}
+
+	odp_packet_from_event_multi(pkt, ev, num);
+
+	return 0;
+}
+
+static int run_step(test_global_t *global, uint32_t num_rule,
+		    test_stat_t *stat)
+{
+	odp_cls_pmr_stats_t pmr_stats;
+	odp_time_t t1, t2;
+	uint64_t c1, c2;
+	uint32_t i, round;
+	test_options_t *test_options = &global->test_options;
+	uint32_t burst = test_options->burst;
+	uint32_t num_round = test_options->num_round;
+	uint32_t warm_up = num_round / 10 + 1;
+
+	init_packets(global, num_rule);
+
+	if (create_rules(global, num_rule))
+		return -1;
+
+	for (round = 0; round < warm_up; round++) {
+		if (loop_packets(global, burst))
+			return -1;
+	}
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	for (round = 0; round < num_round; round++) {
+		if (odp_unlikely(loop_packets(global, burst)))
+			return -1;
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	stat->num_rule = num_rule;
+	stat->packets  = (uint64_t)num_round * burst;
+	stat->cycles   = odp_cpu_cycles_diff(c2, c1);
+	stat->nsec     = odp_time_diff_ns(t2, t1);
+	stat->total    = (uint64_t)(warm_up + num_round) * burst;
+
+	/* PMR statistics cover also warm up rounds */
+	stat->rule_hits = 0;
+
+	for (i = 0; i < global->num_rule_pmr; i++) {
+		if (odp_cls_pmr_stats(global->rule_pmr[i], &pmr_stats) == 0)
+			stat->rule_hits += pmr_stats.hits;
+	}
+
+	return destroy_rules(global);
+}
+
+static int run_test(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t max_rule = test_options->num_rule;
+	uint32_t num_rule = 0;
+	int ret = 0;
+
+	if (odp_pktio_start(global->pktio)) {
+		printf("Error: Pktio start failed\n");
+		return -1;
+	}
+
+	while (1) {
+		if (run_step(global, num_rule,
+			     &global->stat[global->num_stat])) {
+			ret = -1;
+			break;
+		}
+
+		global->num_stat++;
+
+		if (num_rule == max_rule)
+			break;
+
+		num_rule = num_rule ? 2 * num_rule : 1;
+
+		if (num_rule > max_rule)
+			num_rule = max_rule;
+	}
+
+	if (odp_pktio_stop(global->pktio)) {
+		printf("Error: Pktio stop failed\n");
+		return -1;
+	}
+
+	return ret;
+}
+
+static void print_options(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+
+	printf("\nClassifier performance test\n");
+	printf("  interface   %s\n", test_options->pktio_name);
+	printf("  max rules   %u\n", test_options->num_rule);
+	printf("  rule term   %s\n", term_name[test_options->term]);
+	printf("  rule hits   %s\n", hit_name[test_options->hit]);
+	printf("  chain depth %u\n", test_options->chain);
+	printf("  QoS tables  %s%s%s\n",
+	       test_options->qos & QOS_L2 ? "L2 " : "",
+	       test_options->qos & QOS_L3 ? "L3 " : "",
+	       test_options->qos ? "" : "none");
+	printf("  num rounds  %u\n", test_options->num_round);
+	printf("  burst size  %u\n", test_options->burst);
+	printf("  pkt length  %u\n", test_options->pkt_len);
+	printf("  dst pool    %s\n\n",
+	       test_options->dst_pool ? "separate" : "same");
+}
+
+static void print_stat(test_global_t *global)
+{
+	uint32_t i;
+	test_stat_t *stat;
+	double cycles, base, nsec;
+
+	if (global->num_stat == 0 || global->stat[0].packets == 0) {
+		printf("No results.\n");
+		return;
+	}
+
+	base = (double)global->stat[0].cycles / global->stat[0].packets;
+
+	printf("RESULTS - per packet, baseline without rules:\n");
+	printf("---------------------------------------------\n");
+	printf("  rules  cycles   delta   nsec    Mpps    rule hits\n");
+
+	for (i = 0; i < global->num_stat; i++) {
+		stat = &global->stat[i];
+		cycles = (double)stat->cycles / stat->packets;
+		nsec = (double)stat->nsec / stat->packets;
+
+		printf("  %5u  %7.1f %7.1f %6.1f %7.3f  %6.2f %%\n",
+		       stat->num_rule, cycles, cycles - base, nsec,
+		       1000.0 / nsec,
+		       (100.0 * stat->rule_hits) / stat->total);
+	}
+
+	printf("\n");
+}
+
+static int destroy_resources(test_global_t *global)
+{
+	uint32_t i;
+	int ret = 0;
+
+	if (global->pktio != ODP_PKTIO_INVALID) {
+		if (odp_pktio_close(global->pktio)) {
+			printf("Error: Pktio close failed\n");
+			ret = -1;
+		}
+	}
+
+	if (destroy_rules(global))
+		ret = -1;
+
+	for (i = 0; i < global->test_options.chain; i++) {
+		if (global->chain_pmr[i] != ODP_PMR_INVALID)
+			odp_cls_pmr_destroy(global->chain_pmr[i]);
+		if (global->chain_cos[i] != ODP_COS_INVALID)
+			odp_cos_destroy(global->chain_cos[i]);
+	}
+
+	for (i = 1; i < global->num_level; i++) {
+		if (global->level_cos[i] != ODP_COS_INVALID)
+			odp_cos_destroy(global->level_cos[i]);
+	}
+
+	for (i = 0; i < NUM_DST_COS; i++) {
+		if (global->dst_cos[i] != ODP_COS_INVALID)
+			odp_cos_destroy(global->dst_cos[i]);
+	}
+
+	if (global->qos_cos != ODP_COS_INVALID)
+		odp_cos_destroy(global->qos_cos);
+
+	if (global->default_cos != ODP_COS_INVALID)
+		odp_cos_destroy(global->default_cos);
+
+	if (global->dst_queue != ODP_QUEUE_INVALID) {
+		if (odp_queue_destroy(global->dst_queue)) {
+			printf("Error: Queue destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	for (i = 0; i < MAX_BURST; i++) {
+		if (global->pkt[i] != ODP_PACKET_INVALID)
+			odp_packet_free(global->pkt[i]);
+	}
+
+	if (global->dst_pool != ODP_POOL_INVALID &&
+	    global->dst_pool != global->pool) {
+		if (odp_pool_destroy(global->dst_pool)) {
+			printf("Error: Pool destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	if (global->pool != ODP_POOL_INVALID) {
+		if (odp_pool_destroy(global->pool)) {
+			printf("Error: Pool destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+static void init_global(test_global_t *global)
+{
+	uint32_t i;
+
+	memset(global, 0, sizeof(test_global_t));
+	global->pool        = ODP_POOL_INVALID;
+	global->dst_pool    = ODP_POOL_INVALID;
+	global->pktio       = ODP_PKTIO_INVALID;
+	global->dst_queue   = ODP_QUEUE_INVALID;
+	global->default_cos = ODP_COS_INVALID;
+	global->qos_cos     = ODP_COS_INVALID;
+
+	for (i = 0; i < MAX_CHAIN; i++) {
+		global->chain_cos[i] = ODP_COS_INVALID;
+		global->chain_pmr[i] = ODP_PMR_INVALID;
+	}
+
+	for (i = 0; i < MAX_LEVELS; i++)
+		global->level_cos[i] = ODP_COS_INVALID;
+
+	for (i = 0; i < NUM_DST_COS; i++)
+		global->dst_cos[i] = ODP_COS_INVALID;
+
+	for (i = 0; i < MAX_BURST; i++)
+		global->pkt[i] = ODP_PACKET_INVALID;
+}
+
+int main(int argc, char **argv)
+{
+	odp_instance_t instance;
+	odp_init_t init;
+	test_global_t *global;
+	int ret = 0;
+
+	global = &test_global;
+	init_global(global);
+
+	if (parse_options(argc, argv, &global->test_options))
+		return -1;
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto   = 1;
+	init.not_used.feat.ipsec    = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.timer    = 1;
+	init.not_used.feat.tm       = 1;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		printf("Error: Global init failed.\n");
+		return -1;
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_WORKER)) {
+		printf("Error: Local init failed.\n");
+		return -1;
+	}
+
+	print_options(global);
+
+	if (check_capa(global) || create_pool(global) || open_pktio(global) ||
+	    create_cos_tree(global) || alloc_packets(global) ||
+	    run_test(global))
+		ret = -1;
+	else
+		print_stat(global);
+
+	if (destroy_resources(global))
+		ret = -1;
+
+	if (odp_term_local()) {
+		printf("Error: term local failed.\n");
+		return -1;
+	}
+
+	if (odp_term_global(instance)) {
+		printf("Error: term global failed.\n");
+		return -1;
+	}
+
+	return ret;
+}
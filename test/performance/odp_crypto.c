@@ -28,6 +28,11 @@
  */
 #define POOL_NUM_PKT  64
 
+/** @def MAX_BURST
+ * Maximum number of packets per crypto operation call
+ */
+#define MAX_BURST  32
+
 static uint8_t test_iv[16] = "0123456789abcdef";
 
 static uint8_t test_key16[16] = { 0x01, 0x02, 0x03, 0x04, 0x05,
@@ -113,6 +118,12 @@ typedef struct {
 	 */
 	int in_flight;
 
+	/**
+	 * Number of packets passed to a single crypto operation call.
+	 * Specified through -b or --burst option. Default is 1.
+	 */
+	int burst;
+
 	/**
 	 * Number of iteration to repeat crypto operation to get good
 	 * average number. Specified through -i or --terations option.
@@ -695,12 +706,13 @@ run_measure_one(crypto_args_t *cargs,
 		unsigned int payload_length,
 		crypto_run_result_t *result)
 {
-	odp_crypto_packet_op_param_t params;
+	odp_crypto_packet_op_param_t params[MAX_BURST];
 
 	odp_pool_t pkt_pool;
 	odp_queue_t out_queue;
 	odp_packet_t pkt = ODP_PACKET_INVALID;
 	int rc = 0;
+	int i;
 
 	pkt_pool = odp_pool_lookup("packet_pool");
 	if (pkt_pool == ODP_POOL_INVALID) {
@@ -727,15 +739,17 @@ run_measure_one(crypto_args_t *cargs,
 	int packets_received = 0;
 
 	/* Initialize parameters block */
-	memset(&params, 0, sizeof(params));
-	params.session = *session;
+	memset(params, 0, sizeof(params));
+	for (i = 0; i < MAX_BURST; i++) {
+		params[i].session = *session;
 
-	params.cipher_range.offset = 0;
-	params.cipher_range.length = payload_length;
+		params[i].cipher_range.offset = 0;
+		params[i].cipher_range.length = payload_length;
 
-	params.auth_range.offset = 0;
-	params.auth_range.length = payload_length;
-	params.hash_result_offset = payload_length;
+		params[i].auth_range.offset = 0;
+		params[i].auth_range.length = payload_length;
+		params[i].hash_result_offset = payload_length;
+	}
 
 	fill_time_record(&start);
 
@@ -746,58 +760,90 @@ run_measure_one(crypto_args_t *cargs,
 		if ((packets_sent < cargs->iteration_count) &&
 		    (packets_sent - packets_received <
 		     cargs->in_flight)) {
-			odp_packet_t out_pkt;
+			odp_packet_t pkt_tbl[MAX_BURST];
+			odp_packet_t out_pkt[MAX_BURST];
+			int num_pkt = cargs->burst;
+
+			if (num_pkt > cargs->iteration_count - packets_sent)
+				num_pkt = cargs->iteration_count - packets_sent;
+
+			if ((cargs->schedule || cargs->poll) &&
+			    num_pkt > cargs->in_flight -
+				      (packets_sent - packets_received))
+				num_pkt = cargs->in_flight -
+					  (packets_sent - packets_received);
+
+			for (i = 0; i < num_pkt; i++) {
+				if (!cargs->reuse_packet) {
+					pkt = make_packet(pkt_pool,
+							  payload_length);
+					if (ODP_PACKET_INVALID == pkt)
+						break;
+				}
 
-			if (!cargs->reuse_packet) {
-				pkt = make_packet(pkt_pool, payload_length);
-				if (ODP_PACKET_INVALID == pkt)
-					return -1;
-			}
+				pkt_tbl[i] = pkt;
+				out_pkt[i] = cargs->in_place ?
+					     pkt : ODP_PACKET_INVALID;
 
-			out_pkt = cargs->in_place ? pkt : ODP_PACKET_INVALID;
+				if (cargs->debug_packets) {
+					mem = odp_packet_data(pkt);
+					print_mem("Packet before encryption:",
+						  mem, payload_length);
+				}
+			}
 
-			if (cargs->debug_packets) {
-				mem = odp_packet_data(pkt);
-				print_mem("Packet before encryption:",
-					  mem, payload_length);
+			if (i < num_pkt) {
+				while (i--)
+					odp_packet_free(pkt_tbl[i]);
+				return -1;
 			}
 
 			if (cargs->schedule || cargs->poll) {
-				rc = odp_crypto_op_enq(&pkt, &out_pkt,
-						       &params, 1);
+				rc = odp_crypto_op_enq(pkt_tbl, out_pkt,
+						       params, num_pkt);
 				if (rc <= 0) {
 					app_err("failed odp_crypto_packet_op_enq: rc = %d\n",
 						rc);
 					if (!cargs->reuse_packet)
-						odp_packet_free(pkt);
+						odp_packet_free_multi(pkt_tbl,
+								      num_pkt);
 					break;
 				}
+				if (rc < num_pkt && !cargs->reuse_packet)
+					odp_packet_free_multi(&pkt_tbl[rc],
+							      num_pkt - rc);
 				packets_sent += rc;
 			} else {
-				rc = odp_crypto_op(&pkt, &out_pkt,
-						   &params, 1);
+				rc = odp_crypto_op(pkt_tbl, out_pkt,
+						   params, num_pkt);
 				if (rc <= 0) {
 					app_err("failed odp_crypto_packet_op: rc = %d\n",
 						rc);
 					if (!cargs->reuse_packet)
-						odp_packet_free(pkt);
+						odp_packet_free_multi(pkt_tbl,
+								      num_pkt);
 					break;
 				}
+				if (rc < num_pkt && !cargs->reuse_packet)
+					odp_packet_free_multi(&pkt_tbl[rc],
+							      num_pkt - rc);
 				packets_sent += rc;
-				packets_received++;
-				if (cargs->debug_packets) {
-					mem = odp_packet_data(out_pkt);
-					print_mem("Immediately encrypted "
-						   "packet",
-						  mem,
-						  payload_length +
-						  config->session.
-						   auth_digest_len);
+				packets_received += rc;
+
+				for (i = 0; i < rc; i++) {
+					pkt = out_pkt[i];
+
+					if (cargs->debug_packets) {
+						mem = odp_packet_data(pkt);
+						print_mem("Immediately encrypted "
+							  "packet", mem,
+							  payload_length +
+							  config->session.
+							  auth_digest_len);
+					}
+					if (!cargs->reuse_packet)
+						odp_packet_free(pkt);
 				}
-				if (cargs->reuse_packet)
-					pkt = out_pkt;
-				else
-					odp_packet_free(out_pkt);
 			}
 		}
 
@@ -1133,6 +1179,7 @@ int main(int argc, char *argv[])
 	} else {
 		printf("Run in sync mode\n");
 	}
+	printf("Burst size: %i\n", cargs.burst);
 
 	memset(thr, 0, sizeof(thr));
 
@@ -1192,6 +1239,7 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 	int long_index;
 	static const struct option longopts[] = {
 		{"algorithm", optional_argument, NULL, 'a'},
+		{"burst", optional_argument, NULL, 'b'},
 		{"debug",  no_argument, NULL, 'd'},
 		{"flight", optional_argument, NULL, 'f'},
 		{"help", no_argument, NULL, 'h'},
@@ -1205,10 +1253,11 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+a:c:df:hi:m:nl:spr";
+	static const char *shortopts = "+a:b:c:df:hi:m:nl:spr";
 
 	cargs->in_place = 0;
 	cargs->in_flight = 1;
+	cargs->burst = 1;
 	cargs->debug_packets = 0;
 	cargs->iteration_count = 10000;
 	cargs->payload_length = 0;
@@ -1232,6 +1281,9 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 				exit(-1);
 			}
 			break;
+		case 'b':
+			cargs->burst = atoi(optarg);
+			break;
 		case 'd':
 			cargs->debug_packets = 1;
 			break;
@@ -1280,6 +1332,16 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 		usage(argv[0]);
 		exit(-1);
 	}
+	if (cargs->burst < 1 || cargs->burst > MAX_BURST) {
+		printf("-b (burst) must be between 1 and %i\n", MAX_BURST);
+		usage(argv[0]);
+		exit(-1);
+	}
+	if ((cargs->burst > 1) && cargs->reuse_packet) {
+		printf("-b (burst > 1) and -r (reuse packet) options are not compatible\n");
+		usage(argv[0]);
+		exit(-1);
+	}
 }
 
 /**
@@ -1298,7 +1360,10 @@ static void usage(char *progname)
 	       progname, progname);
 
 	print_config_names("				      ");
-	printf("  -d, --debug	       Enable dump of processed packets.\n"
+	printf("  -b, --burst <number> Number of packets per crypto operation call (default 1).\n"
+	       "		       Compare e.g. -b 1 and -b 8 to see the effect of\n"
+	       "		       multi-buffer AES-CBC encryption of packet bursts.\n"
+	       "  -d, --debug	       Enable dump of processed packets.\n"
 	       "  -f, --flight <number> Max number of packet processed in parallel (default 1)\n"
 	       "  -i, --iterations <number> Number of iterations.\n"
 	       "  -n, --inplace	       Encrypt on place.\n"
@@ -28,6 +28,21 @@
  */
 #define POOL_NUM_PKT  64
 
+/** @def MAX_BURST
+ * Maximum number of packets per IPsec operation call
+ */
+#define MAX_BURST  32
+
+/** @def MAX_FRAGS
+ * Maximum number of output fragments per packet when fragmenting
+ */
+#define MAX_FRAGS  32
+
+/** @def MAX_WORKERS
+ * Maximum number of worker threads in sync mode
+ */
+#define MAX_WORKERS  32
+
 static uint8_t test_salt[16] = "0123456789abcdef";
 
 static uint8_t test_key16[16] = { 0x01, 0x02, 0x03, 0x04, 0x05,
@@ -150,6 +165,32 @@ typedef struct {
 	 * Specified through -u argument.
 	 */
 	int ah;
+
+	/*
+	 * Number of worker threads processing packets on the same SA in
+	 * sync mode. Specified through -c or --workers option.
+	 * Default is 1.
+	 */
+	int num_workers;
+
+	/*
+	 * Number of packets per IPsec operation call in sync mode.
+	 * Specified through -b or --burst option. Default is 1.
+	 */
+	int burst;
+
+	/*
+	 * SA MTU. When non-zero, packets exceeding it are fragmented
+	 * before or after IPsec processing in sync mode.
+	 * Specified through -M or --mtu option.
+	 */
+	uint32_t mtu;
+
+	/*
+	 * Fragmentation mode used with MTU.
+	 * Specified through -F or --frag option. Default is after.
+	 */
+	odp_ipsec_frag_mode_t frag_mode;
 } ipsec_args_t;
 
 /*
@@ -186,6 +227,24 @@ typedef struct {
 	struct rusage ru_thread; /**< Rusage value for current thread */
 } time_record_t;
 
+/**
+ * Data shared between worker threads in multi-threaded sync mode.
+ */
+typedef struct {
+	odp_barrier_t barrier;
+	odp_atomic_u32_t next_idx;
+	odp_instance_t instance;
+	odp_cpumask_t cpumask;
+	ipsec_args_t cargs;
+	odp_ipsec_sa_t sa;
+	unsigned int payload_length;
+	time_record_t start[MAX_WORKERS];
+	time_record_t end[MAX_WORKERS];
+	int rc[MAX_WORKERS];
+} worker_global_t;
+
+static worker_global_t *worker_global;
+
 /**
  * Set of predefined payloads.
  */
@@ -488,6 +547,15 @@ get_rusage_thread_diff(time_record_t *start, time_record_t *end)
 	return get_rusage_diff(&start->ru_thread, &end->ru_thread);
 }
 
+/**
+ * Get time value in microseconds
+ */
+static unsigned long long
+get_usec(struct timeval *tv)
+{
+	return (tv->tv_sec * 1000000ULL) + tv->tv_usec;
+}
+
 /**
  * Get diff of elapsed time between two time snap records
  */
@@ -571,6 +639,11 @@ create_sa_from_config(ipsec_alg_config_t *config,
 		param.mode = ODP_IPSEC_MODE_TRANSPORT;
 	}
 
+	if (cargs->mtu) {
+		param.outbound.mtu = cargs->mtu;
+		param.outbound.frag_mode = cargs->frag_mode;
+	}
+
 	if (cargs->schedule || cargs->poll) {
 		out_queue = odp_queue_lookup("ipsec-out");
 		if (out_queue == ODP_QUEUE_INVALID) {
@@ -632,7 +705,8 @@ run_measure_one(ipsec_args_t *cargs,
 {
 	odp_ipsec_out_param_t param;
 	odp_pool_t pkt_pool;
-	odp_packet_t pkt = ODP_PACKET_INVALID;
+	odp_packet_t pkt[MAX_BURST];
+	odp_packet_t out_pkt[MAX_BURST * MAX_FRAGS];
 	int rc = 0;
 
 	pkt_pool = odp_pool_lookup("packet_pool");
@@ -642,7 +716,6 @@ run_measure_one(ipsec_args_t *cargs,
 	}
 
 	int packets_sent = 0;
-	int packets_received = 0;
 
 	/* Initialize parameters block */
 	memset(&param, 0, sizeof(param));
@@ -652,47 +725,59 @@ run_measure_one(ipsec_args_t *cargs,
 
 	fill_time_record(start);
 
-	while ((packets_sent < cargs->iteration_count) ||
-	       (packets_received < cargs->iteration_count)) {
-		if ((packets_sent < cargs->iteration_count) &&
-		    (packets_sent - packets_received <
-		     cargs->in_flight)) {
-			odp_packet_t out_pkt;
-			int num_out = 1;
+	while (packets_sent < cargs->iteration_count) {
+		int num_pkt = cargs->burst;
+		int num_out;
+		int i;
 
-			pkt = make_packet(pkt_pool, payload_length);
-			if (ODP_PACKET_INVALID == pkt)
-				return -1;
+		if (num_pkt > cargs->iteration_count - packets_sent)
+			num_pkt = cargs->iteration_count - packets_sent;
 
-			out_pkt = cargs->in_place ? pkt : ODP_PACKET_INVALID;
+		for (i = 0; i < num_pkt; i++) {
+			pkt[i] = make_packet(pkt_pool, payload_length);
+			if (ODP_PACKET_INVALID == pkt[i])
+				break;
+
+			out_pkt[i] = cargs->in_place ? pkt[i] :
+				     ODP_PACKET_INVALID;
 
 			if (cargs->debug_packets)
-				odp_packet_print_data(pkt, 0,
-						      odp_packet_len(pkt));
+				odp_packet_print_data(pkt[i], 0,
+						      odp_packet_len(pkt[i]));
+		}
 
-			rc = odp_ipsec_out(&pkt, 1,
-					   &out_pkt, &num_out,
-					   &param);
-			if (rc <= 0) {
-				app_err("failed odp_ipsec_out: rc = %d\n",
-					rc);
-				odp_packet_free(pkt);
-				break;
-			}
-			if (odp_packet_has_error(out_pkt)) {
+		if (i < num_pkt) {
+			odp_packet_free_multi(pkt, i);
+			return -1;
+		}
+
+		num_out = cargs->mtu ? num_pkt * MAX_FRAGS : num_pkt;
+		rc = odp_ipsec_out(pkt, num_pkt, out_pkt, &num_out, &param);
+		if (rc <= 0) {
+			app_err("failed odp_ipsec_out: rc = %d\n", rc);
+			odp_packet_free_multi(pkt, num_pkt);
+			break;
+		}
+
+		if (rc < num_pkt)
+			odp_packet_free_multi(&pkt[rc], num_pkt - rc);
+
+		for (i = 0; i < num_out; i++) {
+			odp_packet_t out = out_pkt[i];
+
+			if (odp_packet_has_error(out)) {
 				odp_ipsec_packet_result_t result;
 
-				odp_ipsec_result(&result, out_pkt);
+				odp_ipsec_result(&result, out);
 				app_err("Received error packet: %d\n",
 					result.status.error.all);
 			}
-			packets_sent += rc;
-			packets_received += num_out;
 			if (cargs->debug_packets)
-				odp_packet_print_data(out_pkt, 0,
-						      odp_packet_len(out_pkt));
-			odp_packet_free(out_pkt);
+				odp_packet_print_data(out, 0,
+						      odp_packet_len(out));
 		}
+		odp_packet_free_multi(out_pkt, num_out);
+		packets_sent += rc;
 	}
 
 	fill_time_record(end);
@@ -797,6 +882,92 @@ run_measure_one_async(ipsec_args_t *cargs,
  * Process one algorithm. Note if paload size is specicified it is
  * only one run. Or iterate over set of predefined payloads.
  */
+static int run_worker_func(void *arg)
+{
+	worker_global_t *wg = (worker_global_t *)arg;
+	uint32_t idx = odp_atomic_fetch_inc_u32(&wg->next_idx);
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&wg->barrier);
+
+	wg->rc[idx] = run_measure_one(&wg->cargs, wg->sa, wg->payload_length,
+				      &wg->start[idx], &wg->end[idx]);
+	return 0;
+}
+
+/**
+ * Run measurement iterations on all worker threads on the same SA.
+ * Results are per packet over packets of all workers.
+ */
+static int
+run_measure_workers(ipsec_args_t *cargs,
+		    odp_ipsec_sa_t sa,
+		    unsigned int payload_length,
+		    ipsec_run_result_t *result)
+{
+	worker_global_t *wg = worker_global;
+	odph_odpthread_params_t thr_param;
+	odph_odpthread_t thr[MAX_WORKERS];
+	time_record_t start, end;
+	unsigned long long first, last, usec;
+	unsigned long long thread_usec = 0;
+	double num_op;
+	int num_workers = cargs->num_workers;
+	int i;
+
+	wg->cargs = *cargs;
+	wg->sa = sa;
+	wg->payload_length = payload_length;
+	odp_atomic_init_u32(&wg->next_idx, 0);
+	odp_barrier_init(&wg->barrier, num_workers);
+
+	memset(&thr_param, 0, sizeof(thr_param));
+	thr_param.start    = run_worker_func;
+	thr_param.arg      = wg;
+	thr_param.thr_type = ODP_THREAD_WORKER;
+	thr_param.instance = wg->instance;
+
+	memset(thr, 0, sizeof(thr));
+
+	fill_time_record(&start);
+
+	if (odph_odpthreads_create(thr, &wg->cpumask, &thr_param) !=
+	    num_workers) {
+		app_err("Worker thread create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odph_odpthreads_join(thr);
+
+	fill_time_record(&end);
+
+	first = get_usec(&wg->start[0].tv);
+	last = get_usec(&wg->end[0].tv);
+
+	for (i = 0; i < num_workers; i++) {
+		if (wg->rc[i])
+			return wg->rc[i];
+
+		usec = get_usec(&wg->start[i].tv);
+		if (usec < first)
+			first = usec;
+
+		usec = get_usec(&wg->end[i].tv);
+		if (usec > last)
+			last = usec;
+
+		thread_usec += get_rusage_thread_diff(&wg->start[i],
+						      &wg->end[i]);
+	}
+
+	num_op = (double)cargs->iteration_count * num_workers;
+	result->elapsed = (last - first) / num_op;
+	result->rusage_self = get_rusage_self_diff(&start, &end) / num_op;
+	result->rusage_thread = thread_usec / num_op;
+
+	return 0;
+}
+
 static int
 run_measure_one_config(ipsec_args_t *cargs,
 		       ipsec_alg_config_t *config)
@@ -824,6 +995,16 @@ run_measure_one_config(ipsec_args_t *cargs,
 		ipsec_run_result_t result;
 		time_record_t start, end;
 
+		if (cargs->num_workers > 1) {
+			rc = run_measure_workers(cargs, sa, payloads[i],
+						 &result);
+			if (rc)
+				break;
+
+			print_result(cargs, payloads[i], config, &result);
+			continue;
+		}
+
 		if (cargs->schedule || cargs->poll)
 			rc = run_measure_one_async(cargs, sa,
 						   payloads[i],
@@ -899,7 +1080,11 @@ static void usage(char *progname)
 	       progname, progname);
 
 	print_config_names("				      ");
-	printf("  -d, --debug	       Enable dump of processed packets.\n"
+	printf("  -b, --burst <number> Number of packets per IPsec operation call in\n"
+	       "		       sync mode (default 1).\n"
+	       "  -c, --workers <number> Number of worker threads processing packets\n"
+	       "		       on the same SA in sync mode (default 1).\n"
+	       "  -d, --debug	       Enable dump of processed packets.\n"
 	       "  -f, --flight <number> Max number of packet processed in parallel (default 1)\n"
 	       "  -i, --iterations <number> Number of iterations.\n"
 	       "  -n, --inplace	       Encrypt on place.\n"
@@ -908,6 +1093,10 @@ static void usage(char *progname)
 	       "  -p, --poll           Poll completion queue for completion events.\n"
 	       "  -t, --tunnel         Use tunnel-mode IPsec transformation.\n"
 	       "  -u, --ah             Use AH transformation instead of ESP.\n"
+	       "  -M, --mtu <number>   SA MTU in bytes. Larger packets are fragmented\n"
+	       "		       (sync mode only, default 0: no fragmentation).\n"
+	       "  -F, --frag <mode>    Fragmentation mode used with MTU: before or\n"
+	       "		       after IPsec processing (default after).\n"
 	       "  -h, --help	       Display help and exit.\n"
 	       "\n");
 }
@@ -918,6 +1107,8 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 	int long_index;
 	static const struct option longopts[] = {
 		{"algorithm", optional_argument, NULL, 'a'},
+		{"burst", optional_argument, NULL, 'b'},
+		{"workers", optional_argument, NULL, 'c'},
 		{"debug",  no_argument, NULL, 'd'},
 		{"flight", optional_argument, NULL, 'f'},
 		{"help", no_argument, NULL, 'h'},
@@ -929,10 +1120,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		{"schedule", no_argument, NULL, 's'},
 		{"tunnel", no_argument, NULL, 't'},
 		{"ah", no_argument, NULL, 'u'},
+		{"mtu", required_argument, NULL, 'M'},
+		{"frag", required_argument, NULL, 'F'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+a:c:df:hi:m:nl:sptu";
+	static const char *shortopts = "+a:b:c:df:hi:m:nl:sptuM:F:";
 
 	cargs->in_place = 0;
 	cargs->in_flight = 1;
@@ -942,6 +1135,10 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 	cargs->alg_config = NULL;
 	cargs->schedule = 0;
 	cargs->ah = 0;
+	cargs->num_workers = 1;
+	cargs->burst = 1;
+	cargs->mtu = 0;
+	cargs->frag_mode = ODP_IPSEC_FRAG_AFTER;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
@@ -959,6 +1156,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 				exit(-1);
 			}
 			break;
+		case 'b':
+			cargs->burst = atoi(optarg);
+			break;
+		case 'c':
+			cargs->num_workers = atoi(optarg);
+			break;
 		case 'd':
 			cargs->debug_packets = 1;
 			break;
@@ -990,6 +1193,21 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		case 'u':
 			cargs->ah = 1;
 			break;
+		case 'M':
+			cargs->mtu = atoi(optarg);
+			break;
+		case 'F':
+			if (!strcmp(optarg, "before")) {
+				cargs->frag_mode = ODP_IPSEC_FRAG_BEFORE;
+			} else if (!strcmp(optarg, "after")) {
+				cargs->frag_mode = ODP_IPSEC_FRAG_AFTER;
+			} else {
+				printf("unknown fragmentation mode '%s'\n",
+				       optarg);
+				usage(argv[0]);
+				exit(-1);
+			}
+			break;
 		default:
 			break;
 		}
@@ -1002,6 +1220,32 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		usage(argv[0]);
 		exit(-1);
 	}
+
+	if (cargs->mtu && (cargs->schedule || cargs->poll ||
+			   cargs->in_place)) {
+		printf("-M (mtu) is not compatible with -s, -p or -n\n");
+		usage(argv[0]);
+		exit(-1);
+	}
+
+	if (cargs->burst < 1 || cargs->burst > MAX_BURST) {
+		printf("-b (burst) must be between 1 and %i\n", MAX_BURST);
+		usage(argv[0]);
+		exit(-1);
+	}
+
+	if (cargs->num_workers < 1 || cargs->num_workers > MAX_WORKERS) {
+		printf("-c (workers) must be between 1 and %i\n", MAX_WORKERS);
+		usage(argv[0]);
+		exit(-1);
+	}
+
+	if ((cargs->burst > 1 || cargs->num_workers > 1) &&
+	    (cargs->schedule || cargs->poll)) {
+		printf("-b (burst) and -c (workers) options are supported only in sync mode\n");
+		usage(argv[0]);
+		exit(-1);
+	}
 }
 
 int main(int argc, char *argv[])
@@ -1022,6 +1266,8 @@ int main(int argc, char *argv[])
 	odp_pool_capability_t capa;
 	odp_ipsec_config_t config;
 	uint32_t max_seg_len;
+	uint32_t num_pkt;
+	odp_shm_t shm = ODP_SHM_INVALID;
 	unsigned int i;
 
 	/* Let helper collect its own arguments (e.g. --odph_proc) */
@@ -1065,11 +1311,20 @@ int main(int argc, char *argv[])
 
 	global_num_payloads = i;
 
+	/* Packets in flight: input and output packets of each worker */
+	num_pkt = 2 * cargs.burst * cargs.num_workers;
+	if (cargs.mtu)
+		num_pkt = (1 + MAX_FRAGS) * cargs.burst * cargs.num_workers;
+	if (num_pkt < POOL_NUM_PKT)
+		num_pkt = POOL_NUM_PKT;
+	if (capa.pkt.max_num && num_pkt > capa.pkt.max_num)
+		num_pkt = capa.pkt.max_num;
+
 	/* Create packet pool */
 	odp_pool_param_init(&param);
 	param.pkt.seg_len = max_seg_len;
 	param.pkt.len	   = max_seg_len;
-	param.pkt.num	   = POOL_NUM_PKT;
+	param.pkt.num	   = num_pkt;
 	param.type	   = ODP_POOL_PACKET;
 	pool = odp_pool_create("packet_pool", &param);
 
@@ -1129,6 +1384,33 @@ int main(int argc, char *argv[])
 		printf("Run in async poll mode\n");
 	} else {
 		printf("Run in sync mode\n");
+
+		if (cargs.num_workers > 1) {
+			shm = odp_shm_reserve("worker_global",
+					      sizeof(worker_global_t),
+					      ODP_CACHE_LINE_SIZE, 0);
+			if (shm == ODP_SHM_INVALID) {
+				app_err("Shared memory reserve failed.\n");
+				exit(EXIT_FAILURE);
+			}
+
+			worker_global = odp_shm_addr(shm);
+			memset(worker_global, 0, sizeof(worker_global_t));
+			worker_global->instance = instance;
+
+			cargs.num_workers =
+				odp_cpumask_default_worker(&cpumask,
+							   cargs.num_workers);
+			worker_global->cpumask = cpumask;
+			(void)odp_cpumask_to_str(&cpumask, cpumaskstr,
+						 sizeof(cpumaskstr));
+			printf("num worker threads:  %i\n",
+			       cargs.num_workers);
+			printf("cpu mask:	     %s\n",
+			       cpumaskstr);
+		}
+
+		printf("burst size:	     %i\n", cargs.burst);
 	}
 
 	memset(thr, 0, sizeof(thr));
@@ -1164,6 +1446,10 @@ int main(int argc, char *argv[])
 
 	if (cargs.schedule || cargs.poll)
 		odp_queue_destroy(out_queue);
+	if (shm != ODP_SHM_INVALID && odp_shm_free(shm)) {
+		app_err("Error: shm free\n");
+		exit(EXIT_FAILURE);
+	}
 	if (odp_pool_destroy(pool)) {
 		app_err("Error: pool destroy\n");
 		exit(EXIT_FAILURE);
@@ -93,6 +93,8 @@ typedef struct {
 	int burst_rx;           /* Receive burst size */
 	int pool_per_if;        /* Create pool per interface */
 	uint32_t num_pkt;       /* Number of packets per pool */
+	uint32_t rx_queue_size; /* Pktin queue size, 0 for default */
+	uint32_t tx_queue_size; /* Pktout queue size, 0 for default */
 	int verbose;		/* Verbose output */
 } appl_args_t;
 
@@ -107,6 +109,8 @@ typedef union ODP_ALIGNED_CACHE {
 		uint64_t tx_drops;
 		/* Number of failed packet copies */
 		uint64_t copy_fails;
+		/* CPU cycles spent on loop rounds that received packets */
+		uint64_t cycles;
 	} s;
 
 	uint8_t padding[ODP_CACHE_LINE_SIZE];
@@ -373,6 +377,7 @@ static int run_worker_sched_mode(void *arg)
 		int sent;
 		unsigned tx_drops;
 		int src_idx;
+		uint64_t c1 = odp_cpu_cycles();
 
 		pkts = odp_schedule_multi_no_wait(NULL, ev_tbl, max_burst);
 
@@ -432,6 +437,7 @@ static int run_worker_sched_mode(void *arg)
 		}
 
 		stats->s.packets += pkts;
+		stats->s.cycles += odp_cpu_cycles_diff(odp_cpu_cycles(), c1);
 	}
 
 	/* Make sure that latest stat writes are visible to other threads */
@@ -496,6 +502,7 @@ static int run_worker_plain_queue_mode(void *arg)
 		int sent;
 		unsigned tx_drops;
 		odp_event_t event[MAX_PKT_BURST];
+		uint64_t c1;
 
 		if (num_pktio > 1) {
 			dst_idx   = thr_args->pktio[pktio].tx_idx;
@@ -509,6 +516,7 @@ static int run_worker_plain_queue_mode(void *arg)
 				pktio = 0;
 		}
 
+		c1 = odp_cpu_cycles();
 		pkts = odp_queue_deq_multi(queue, event, max_burst);
 		if (odp_unlikely(pkts <= 0))
 			continue;
@@ -563,6 +571,7 @@ static int run_worker_plain_queue_mode(void *arg)
 		}
 
 		stats->s.packets += pkts;
+		stats->s.cycles += odp_cpu_cycles_diff(odp_cpu_cycles(), c1);
 	}
 
 	/* Make sure that latest stat writes are visible to other threads */
@@ -630,6 +639,7 @@ static int run_worker_direct_mode(void *arg)
 	while (!odp_atomic_load_u32(&gbl_args->exit_threads)) {
 		int sent;
 		unsigned tx_drops;
+		uint64_t c1;
 
 		if (num_pktio > 1) {
 			dst_idx   = thr_args->pktio[pktio].tx_idx;
@@ -643,6 +653,7 @@ static int run_worker_direct_mode(void *arg)
 				pktio = 0;
 		}
 
+		c1 = odp_cpu_cycles();
 		pkts = odp_pktin_recv(pktin, pkt_tbl, max_burst);
 		if (odp_unlikely(pkts <= 0))
 			continue;
@@ -695,6 +706,7 @@ static int run_worker_direct_mode(void *arg)
 		}
 
 		stats->s.packets += pkts;
+		stats->s.cycles += odp_cpu_cycles_diff(odp_cpu_cycles(), c1);
 	}
 
 	/* Make sure that latest stat writes are visible to other threads */
@@ -726,6 +738,9 @@ static int create_pktio(const char *dev, int idx, int num_rx, int num_tx,
 	odp_pktio_op_mode_t mode_tx;
 	pktin_mode_t in_mode = gbl_args->appl.in_mode;
 	odp_pktio_info_t info;
+	uint32_t rx_size = gbl_args->appl.rx_queue_size;
+	uint32_t tx_size = gbl_args->appl.tx_queue_size;
+	int i;
 
 	odp_pktio_param_init(&pktio_param);
 
@@ -817,6 +832,38 @@ static int create_pktio(const char *dev, int idx, int num_rx, int num_tx,
 	pktout_param.op_mode    = mode_tx;
 	pktout_param.num_queues = num_tx;
 
+	if (rx_size) {
+		if (pktio_capa.max_input_queue_size == 0) {
+			printf("Input queue size not configurable %s\n", dev);
+			rx_size = 0;
+		} else if (rx_size > pktio_capa.max_input_queue_size) {
+			rx_size = pktio_capa.max_input_queue_size;
+		} else if (rx_size < pktio_capa.min_input_queue_size) {
+			rx_size = pktio_capa.min_input_queue_size;
+		}
+	}
+
+	if (tx_size) {
+		if (pktio_capa.max_output_queue_size == 0) {
+			printf("Output queue size not configurable %s\n", dev);
+			tx_size = 0;
+		} else if (tx_size > pktio_capa.max_output_queue_size) {
+			tx_size = pktio_capa.max_output_queue_size;
+		} else if (tx_size < pktio_capa.min_output_queue_size) {
+			tx_size = pktio_capa.min_output_queue_size;
+		}
+	}
+
+	for (i = 0; i < num_rx; i++)
+		pktin_param.queue_size[i] = rx_size;
+
+	for (i = 0; i < num_tx; i++)
+		pktout_param.queue_size[i] = tx_size;
+
+	if (rx_size || tx_size)
+		printf("Queue sizes %s: rx %" PRIu32 ", tx %" PRIu32
+		       " (0: default)\n", dev, rx_size, tx_size);
+
 	if (odp_pktin_queue_config(pktio, &pktin_param)) {
 		ODPH_ERR("Error: input queue config failed %s\n", dev);
 		return -1;
@@ -884,6 +931,8 @@ static int print_speed_stats(int num_workers, stats_t **thr_stats,
 	uint64_t pkts_prev = 0;
 	uint64_t pps;
 	uint64_t rx_drops, tx_drops, copy_fails;
+	uint64_t cycles = 0;
+	uint64_t cycles_prev = 0;
 	uint64_t maximum_pps = 0;
 	int i;
 	int elapsed = 0;
@@ -902,6 +951,7 @@ static int print_speed_stats(int num_workers, stats_t **thr_stats,
 		rx_drops = 0;
 		tx_drops = 0;
 		copy_fails = 0;
+		cycles = 0;
 
 		sleep(timeout);
 
@@ -910,6 +960,7 @@ static int print_speed_stats(int num_workers, stats_t **thr_stats,
 			rx_drops += thr_stats[i]->s.rx_drops;
 			tx_drops += thr_stats[i]->s.tx_drops;
 			copy_fails += thr_stats[i]->s.copy_fails;
+			cycles += thr_stats[i]->s.cycles;
 		}
 		if (stats_enabled) {
 			pps = (pkts - pkts_prev) / timeout;
@@ -921,18 +972,29 @@ static int print_speed_stats(int num_workers, stats_t **thr_stats,
 			if (gbl_args->appl.packet_copy)
 				printf("%" PRIu64 " copy fails, ", copy_fails);
 
-			printf("%" PRIu64 " rx drops, %" PRIu64 " tx drops\n",
+			printf("%" PRIu64 " rx drops, %" PRIu64 " tx drops, ",
 			       rx_drops, tx_drops);
 
+			printf("%.1f cycles/pkt\n", pkts > pkts_prev ?
+			       (double)(cycles - cycles_prev) /
+			       (pkts - pkts_prev) : 0.0);
+
 			pkts_prev = pkts;
+			cycles_prev = cycles;
 		}
 		elapsed += timeout;
 	} while (!odp_atomic_load_u32(&gbl_args->exit_threads) && (loop_forever ||
 		 (elapsed < duration)));
 
-	if (stats_enabled)
+	if (stats_enabled) {
+		/* Busy cycles (receive, processing and send) per packet,
+		 * summed over all workers */
+		if (pkts)
+			printf("Average %.1f CPU cycles per packet.\n",
+			       (double)cycles / pkts);
 		printf("TEST RESULT: %" PRIu64 " maximum packets per second.\n",
 		       maximum_pps);
+	}
 
 	return pkts > 100 ? 0 : -1;
 }
@@ -1212,6 +1274,14 @@ static void usage(char *progname)
 	       "                          1: Create a pool per interface\n"
 	       "  -n, --num_pkt <num>     Number of packets per pool. Default is 16k or\n"
 	       "                          the maximum capability. Use 0 for the default.\n"
+	       "  -R, --rx_queue_size <num>\n"
+	       "                          Packet input queue (ring) size. Use 0 for the\n"
+	       "                          default. Larger rings absorb bursts with less\n"
+	       "                          drops (throughput), smaller rings reduce queueing\n"
+	       "                          delay (latency).\n"
+	       "  -T, --tx_queue_size <num>\n"
+	       "                          Packet output queue (ring) size. Use 0 for the\n"
+	       "                          default.\n"
 	       "  -v, --verbose           Verbose output.\n"
 	       "  -h, --help              Display help and exit.\n\n"
 	       "\n", NO_PATH(progname), NO_PATH(progname), MAX_PKTIOS
@@ -1250,12 +1320,14 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		{"packet_copy", required_argument, NULL, 'p'},
 		{"pool_per_if", required_argument, NULL, 'y'},
 		{"num_pkt", required_argument, NULL, 'n'},
+		{"rx_queue_size", required_argument, NULL, 'R'},
+		{"tx_queue_size", required_argument, NULL, 'T'},
 		{"verbose", no_argument, NULL, 'v'},
 		{"help", no_argument, NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:t:a:i:m:o:r:d:s:e:k:g:b:p:y:n:vh";
+	static const char *shortopts = "+c:t:a:i:m:o:r:d:s:e:k:g:b:p:y:n:R:T:vh";
 
 	appl_args->time = 0; /* loop forever if time to run is 0 */
 	appl_args->accuracy = 1; /* get and print pps stats second */
@@ -1270,6 +1342,8 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 	appl_args->chksum = 0; /* don't use checksum offload by default */
 	appl_args->pool_per_if = 0;
 	appl_args->num_pkt = 0;
+	appl_args->rx_queue_size = 0;
+	appl_args->tx_queue_size = 0;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
@@ -1410,6 +1484,12 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		case 'n':
 			appl_args->num_pkt = atoi(optarg);
 			break;
+		case 'R':
+			appl_args->rx_queue_size = atoi(optarg);
+			break;
+		case 'T':
+			appl_args->tx_queue_size = atoi(optarg);
+			break;
 		case 'v':
 			appl_args->verbose = 1;
 			break;
@@ -1489,6 +1569,10 @@ static void print_info(appl_args_t *appl_args)
 	printf("Burst size:         %i\n", appl_args->burst_rx);
 	printf("Number of pools:    %i\n", appl_args->pool_per_if ?
 					   appl_args->if_count : 1);
+	printf("RX queue size:      %" PRIu32 "%s\n", appl_args->rx_queue_size,
+	       appl_args->rx_queue_size ? "" : " (default)");
+	printf("TX queue size:      %" PRIu32 "%s\n", appl_args->tx_queue_size,
+	       appl_args->tx_queue_size ? "" : " (default)");
 
 	if (appl_args->extra_feat) {
 		printf("Extra features:     %s%s%s\n",
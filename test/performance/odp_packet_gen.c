@@ -30,6 +30,23 @@
 /* Minimum number of packets to receive in CI test */
 #define MIN_RX_PACKETS_CI 800
 
+/* Latency mode packet identifier */
+#define LAT_MAGIC         0x6c617430
+
+/* Maximum number of latency streams (tx threads x interfaces) */
+#define MAX_STREAMS       (ODP_THREAD_COUNT_MAX * MAX_PKTIOS)
+
+/* Latency histograms have log-linear buckets: each power of two range is
+ * divided into 2^LAT_SUB_BITS linear sub-buckets. Values up to 2^LAT_MAX_BITS
+ * nsec are recorded with about 3% precision. */
+#define LAT_SUB_BITS      5
+#define LAT_SUB_NUM       (1 << LAT_SUB_BITS)
+#define LAT_MAX_BITS      40
+#define LAT_BUCKETS       ((LAT_MAX_BITS - LAT_SUB_BITS + 1) * LAT_SUB_NUM)
+
+/* Ethernet preamble, inter-frame gap and CRC */
+#define ETH_OVERHEAD      24
+
 typedef struct test_options_t {
 	uint64_t gap_nsec;
 	uint64_t quit;
@@ -49,6 +66,11 @@ typedef struct test_options_t {
 	uint16_t udp_src;
 	uint16_t udp_dst;
 	uint32_t wait_sec;
+	uint64_t rate_pps;
+	uint64_t rate_bps;
+	double   period_nsec;
+	int      latency;
+	int      hw_ts;
 
 	struct vlan_hdr {
 		uint16_t tpid;
@@ -66,6 +88,24 @@ typedef struct test_options_t {
 
 } test_options_t;
 
+/* Latency mode header in the beginning of UDP payload */
+typedef struct latency_hdr_t {
+	uint32_t magic;
+	uint32_t stream;
+	uint64_t seq;
+	uint64_t tx_nsec;
+
+} latency_hdr_t;
+
+typedef struct latency_stat_t {
+	uint64_t num;
+	uint64_t min;
+	uint64_t max;
+	uint64_t sum;
+	uint64_t hist[LAT_BUCKETS];
+
+} latency_stat_t;
+
 typedef struct thread_arg_t {
 	void *global;
 	int tx_thr;
@@ -93,6 +133,11 @@ typedef struct ODP_ALIGNED_CACHE thread_stat_t {
 
 	} pktio[MAX_PKTIOS];
 
+	/* Latency mode: packet latency on RX threads, or delay from
+	 * transmit call to HW timestamp on TX threads */
+	uint64_t lat_reorder;
+	latency_stat_t lat;
+
 } thread_stat_t;
 
 typedef struct test_global_t {
@@ -161,12 +206,24 @@ static void print_usage(void)
 	       "                            Default value: 0,0\n"
 	       "  -q, --quit                Quit after this many transmit rounds.\n"
 	       "                            Default: 0 (don't quit)\n"
+	       "  -R, --rate <pps>          Transmit packet rate per interface. Overrides gap, rounds\n"
+	       "                            are paced to reach the rate. Use burst size and bursts\n"
+	       "                            of one for evenly spaced packets. Default: 0 (use gap)\n"
+	       "  -B, --bit_rate <bps>      Transmit bit rate per interface including %u bytes of\n"
+	       "                            Ethernet framing overhead per packet. Overrides gap.\n"
+	       "  -L, --latency             Latency mode. Each packet carries a sequence number and\n"
+	       "                            a transmit timestamp (global time) in UDP payload.\n"
+	       "                            RX threads measure latency into histograms, and track\n"
+	       "                            packet loss and reordering.\n"
+	       "  -T, --hw_ts               Use packet input timestamps as receive time in latency\n"
+	       "                            mode. Also measures transmit delay with packet output\n"
+	       "                            timestamps of the first TX thread, when supported.\n"
 	       "  -u, --update_stat <msec>  Update and print statistics every <msec> milliseconds.\n"
 	       "                            0: Don't print statistics periodically (default)\n"
 	       "  -h, --help                This help\n"
 	       "  -w, --wait <sec>          Wait up to <sec> seconds for network links to be up.\n"
 	       "                            Default: 0 (don't check link status)\n"
-	       "\n");
+	       "\n", ETH_OVERHEAD);
 }
 
 static int parse_vlan(const char *str, test_global_t *global)
@@ -238,11 +295,15 @@ static int parse_options(int argc, char *argv[], test_global_t *global)
 		{"quit",        required_argument, NULL, 'q'},
 		{"wait",        required_argument, NULL, 'w'},
 		{"update_stat", required_argument, NULL, 'u'},
+		{"rate",        required_argument, NULL, 'R'},
+		{"bit_rate",    required_argument, NULL, 'B'},
+		{"latency",     no_argument,       NULL, 'L'},
+		{"hw_ts",       no_argument,       NULL, 'T'},
 		{"help",        no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+i:e:r:t:n:l:b:x:g:v:s:d:o:p:c:q:u:w:h";
+	static const char *shortopts = "+i:e:r:t:n:l:b:x:g:v:s:d:o:p:c:q:u:w:R:B:LTh";
 
 	test_options->num_pktio  = 0;
 	test_options->num_rx     = 1;
@@ -266,6 +327,10 @@ static int parse_options(int argc, char *argv[], test_global_t *global)
 	test_options->quit = 0;
 	test_options->update_msec = 0;
 	test_options->wait_sec = 0;
+	test_options->rate_pps = 0;
+	test_options->rate_bps = 0;
+	test_options->latency = 0;
+	test_options->hw_ts = 0;
 
 	for (i = 0; i < MAX_PKTIOS; i++) {
 		memcpy(global->pktio[i].eth_dst.addr, default_eth_dst, 6);
@@ -421,6 +486,18 @@ static int parse_options(int argc, char *argv[], test_global_t *global)
 		case 'w':
 			test_options->wait_sec = atoi(optarg);
 			break;
+		case 'R':
+			test_options->rate_pps = strtoull(optarg, NULL, 0);
+			break;
+		case 'B':
+			test_options->rate_bps = strtoull(optarg, NULL, 0);
+			break;
+		case 'L':
+			test_options->latency = 1;
+			break;
+		case 'T':
+			test_options->hw_ts = 1;
+			break;
 		case 'h':
 			/* fall through */
 		default:
@@ -452,14 +529,38 @@ static int parse_options(int argc, char *argv[], test_global_t *global)
 		      (test_options->num_pktio * test_options->num_rx *
 		      test_options->burst_size);
 
+	/* Latency mode transmits copies of the packets */
+	if (test_options->latency)
+		min_packets += test_options->num_pktio * test_options->num_tx *
+			       num_tx_pkt;
+
 	if (test_options->num_pkt < min_packets) {
 		printf("Error: Pool needs to have at least %u packets\n",
 		       min_packets);
 		ret = -1;
 	}
 
-	if (test_options->gap_nsec) {
-		double gap_hz = 1000000000.0 / test_options->gap_nsec;
+	/* Transmit round period */
+	test_options->period_nsec = test_options->gap_nsec;
+
+	if (test_options->rate_bps && test_options->rate_pps == 0)
+		test_options->rate_pps = test_options->rate_bps /
+			((test_options->pkt_len + ETH_OVERHEAD) * 8);
+
+	if (test_options->rate_bps && test_options->rate_pps == 0) {
+		printf("Error: Too low bit rate\n");
+		ret = -1;
+	}
+
+	/* Transmit is paced on the period, which may be less than 1 nsec
+	 * with high rates */
+	if (test_options->rate_pps)
+		test_options->period_nsec = 1000000000.0 * num_tx_pkt *
+					    test_options->num_tx /
+					    test_options->rate_pps;
+
+	if (test_options->period_nsec > 0.0) {
+		double gap_hz = 1000000000.0 / test_options->period_nsec;
 
 		if (gap_hz > (double)odp_time_local_res()) {
 			printf("\nWARNING: Burst gap exceeds time counter resolution "
@@ -485,6 +586,15 @@ static int parse_options(int argc, char *argv[], test_global_t *global)
 		ret = -1;
 	}
 
+	if (test_options->latency &&
+	    test_options->hdr_len + sizeof(latency_hdr_t) >
+	    test_options->pkt_len) {
+		printf("Error: Latency mode needs %u bytes packet length\n",
+		       (uint32_t)(test_options->hdr_len +
+				  sizeof(latency_hdr_t)));
+		ret = -1;
+	}
+
 	return ret;
 }
 
@@ -567,8 +677,20 @@ static int open_pktios(test_global_t *global)
 	printf("  packet length       %u bytes\n", pkt_len);
 	printf("  tx burst size       %u\n", test_options->burst_size);
 	printf("  tx bursts           %u\n", test_options->bursts);
-	printf("  tx burst gap        %" PRIu64 " nsec\n",
-	       test_options->gap_nsec);
+	if (test_options->rate_pps) {
+		printf("  tx round period     %.3f nsec\n",
+		       test_options->period_nsec);
+		printf("  tx rate             %" PRIu64 " pps\n",
+		       test_options->rate_pps);
+	} else {
+		printf("  tx burst gap        %" PRIu64 " nsec\n",
+		       test_options->gap_nsec);
+	}
+	printf("  latency mode        %s\n",
+	       test_options->latency ? "yes" : "no");
+	if (test_options->latency)
+		printf("  hw timestamps       %s\n",
+		       test_options->hw_ts ? "yes" : "no");
 	printf("  clock resolution    %" PRIu64 " Hz\n", odp_time_local_res());
 	for (i = 0; i < test_options->num_vlan; i++) {
 		printf("  VLAN[%i]             %x:%x\n", i,
@@ -694,6 +816,17 @@ static int open_pktios(test_global_t *global)
 		odp_pktio_config_init(&pktio_config);
 		pktio_config.parser.layer = ODP_PROTO_LAYER_ALL;
 
+		if (test_options->latency && test_options->hw_ts) {
+			if (pktio_capa.config.pktin.bit.ts_all)
+				pktio_config.pktin.bit.ts_all = 1;
+			else
+				printf("Warning (%s): Packet input timestamps not supported\n",
+				       name);
+
+			if (pktio_capa.config.pktout.bit.ts_ena)
+				pktio_config.pktout.bit.ts_ena = 1;
+		}
+
 		odp_pktio_config(pktio, &pktio_config);
 
 		odp_pktin_queue_param_init(&pktin_param);
@@ -859,6 +992,77 @@ static int close_pktios(test_global_t *global)
 	return ret;
 }
 
+static inline uint32_t lat_bucket(uint64_t nsec)
+{
+	uint32_t shift;
+
+	if (nsec < LAT_SUB_NUM)
+		return nsec;
+
+	if (nsec >= (1ULL << LAT_MAX_BITS))
+		return LAT_BUCKETS - 1;
+
+	shift = 63 - __builtin_clzll(nsec) - LAT_SUB_BITS;
+
+	return shift * LAT_SUB_NUM + (nsec >> shift);
+}
+
+/* Smallest value of a histogram bucket */
+static uint64_t lat_bucket_value(uint32_t idx)
+{
+	uint32_t shift = 0;
+
+	if (idx >= LAT_SUB_NUM)
+		shift = idx / LAT_SUB_NUM - 1;
+
+	return (uint64_t)(idx - shift * LAT_SUB_NUM) << shift;
+}
+
+static inline void lat_stat_add(latency_stat_t *lat, uint64_t nsec)
+{
+	if (odp_unlikely(lat->num == 0 || nsec < lat->min))
+		lat->min = nsec;
+
+	if (nsec > lat->max)
+		lat->max = nsec;
+
+	lat->num++;
+	lat->sum += nsec;
+	lat->hist[lat_bucket(nsec)]++;
+}
+
+/* Update latency statistics with a received packet. Stream sequence numbers
+ * are stored incremented by one, zero means no packets received yet. */
+static inline void rx_latency(thread_stat_t *stat, odp_packet_t pkt,
+			      uint64_t rx_nsec, int hw_ts,
+			      uint64_t stream_seq[])
+{
+	latency_hdr_t lat;
+	uint32_t offset;
+
+	if (odp_unlikely(!odp_packet_has_udp(pkt)))
+		return;
+
+	offset = odp_packet_l4_offset(pkt) + ODPH_UDPHDR_LEN;
+
+	if (odp_packet_copy_to_mem(pkt, offset, sizeof(lat), &lat))
+		return;
+
+	if (odp_unlikely(lat.magic != LAT_MAGIC || lat.stream >= MAX_STREAMS))
+		return;
+
+	if (hw_ts && odp_packet_has_ts(pkt))
+		rx_nsec = odp_time_to_ns(odp_packet_ts(pkt));
+
+	lat_stat_add(&stat->lat, rx_nsec > lat.tx_nsec ?
+		     rx_nsec - lat.tx_nsec : 0);
+
+	if (lat.seq + 1 < stream_seq[lat.stream])
+		stat->lat_reorder++;
+	else
+		stream_seq[lat.stream] = lat.seq + 1;
+}
+
 static int rx_thread(void *arg)
 {
 	int i, thr, num;
@@ -879,10 +1083,22 @@ static int rx_thread(void *arg)
 	int paused = 0;
 	int max_num = 32;
 	odp_event_t ev[max_num];
+	int latency = global->test_options.latency;
+	int hw_ts = global->test_options.hw_ts;
+	uint64_t *stream_seq = NULL;
 
 	thr = odp_thread_id();
 	global->stat[thr].thread_type = RX_THREAD;
 
+	if (latency) {
+		stream_seq = calloc(MAX_STREAMS, sizeof(uint64_t));
+		if (stream_seq == NULL) {
+			printf("Error: Stream table alloc failed\n");
+			ret = -1;
+			latency = 0;
+		}
+	}
+
 	/* Start all workers at the same time */
 	odp_barrier_wait(&global->barrier);
 
@@ -931,6 +1147,15 @@ static int rx_thread(void *arg)
 			bytes += odp_packet_len(pkt);
 		}
 
+		if (latency) {
+			uint64_t rx_nsec = odp_time_global_ns();
+
+			for (i = 0; i < num; i++)
+				rx_latency(&global->stat[thr],
+					   odp_packet_from_event(ev[i]),
+					   rx_nsec, hw_ts, stream_seq);
+		}
+
 		rx_packets += num;
 		rx_bytes   += bytes;
 
@@ -948,6 +1173,8 @@ static int rx_thread(void *arg)
 	if (clock_started)
 		nsec = odp_time_diff_ns(t2, t1);
 
+	free(stream_seq);
+
 	/* Update stats*/
 	global->stat[thr].time_nsec   = nsec;
 	global->stat[thr].rx_timeouts = rx_timeouts;
@@ -1063,7 +1290,10 @@ static int init_packets(test_global_t *global, int pktio,
 		odp_packet_has_eth_set(pkt, 1);
 		odp_packet_has_ipv4_set(pkt, 1);
 		odp_packet_has_udp_set(pkt, 1);
-		udp->chksum = odph_ipv4_udp_chksum(pkt);
+
+		/* Latency mode modifies payload, so UDP checksum is not used */
+		if (!test_options->latency)
+			udp->chksum = odph_ipv4_udp_chksum(pkt);
 
 		/* Increment port numbers */
 		if (test_options->c_mode.udp_src) {
@@ -1121,6 +1351,81 @@ static inline int send_burst(odp_pktout_queue_t pktout, odp_packet_t pkt[],
 	return sent;
 }
 
+/* Send copies of packets with latency header. Returns number of packets
+ * sent. Sequence number in the header is advanced only for sent packets. */
+static inline int send_burst_lat(odp_pktout_queue_t pktout, odp_pool_t pool,
+				 odp_packet_t pkt[], int burst_size,
+				 uint32_t offset, latency_hdr_t *lat,
+				 int ts_request)
+{
+	int i, sent;
+	int num = burst_size;
+	odp_packet_t pkt_cp[burst_size];
+
+	for (i = 0; i < burst_size; i++) {
+		pkt_cp[i] = odp_packet_copy(pkt[i], pool);
+
+		if (pkt_cp[i] == ODP_PACKET_INVALID) {
+			num = i;
+			break;
+		}
+	}
+
+	if (odp_unlikely(num == 0))
+		return 0;
+
+	lat->tx_nsec = odp_time_global_ns();
+
+	for (i = 0; i < num; i++) {
+		lat->seq++;
+		odp_packet_copy_from_mem(pkt_cp[i], offset, sizeof(*lat), lat);
+	}
+
+	if (ts_request)
+		odp_packet_ts_request(pkt_cp[0], 1);
+
+	sent = odp_pktout_send(pktout, pkt_cp, num);
+
+	if (odp_unlikely(sent < 0))
+		sent = 0;
+
+	if (odp_unlikely(sent != num)) {
+		uint32_t num_drop = num - sent;
+
+		odp_packet_free_multi(&pkt_cp[sent], num_drop);
+		lat->seq -= num_drop;
+	}
+
+	return sent;
+}
+
+/* Record delay from transmit call to packet output timestamp of the previous
+ * burst. Returns non-zero when timestamps are not available. */
+static int tx_delay(odp_pktio_t pktio, latency_stat_t *stat,
+		    uint64_t tx_nsec, uint64_t *prev_ts)
+{
+	odp_time_t ts;
+	uint64_t ts_nsec;
+	int ret = odp_pktout_ts_read(pktio, &ts);
+
+	if (ret < 0)
+		return -1;
+
+	if (ret > 0)
+		return 0;
+
+	ts_nsec = odp_time_to_ns(ts);
+
+	/* Same timestamp as last time */
+	if (ts_nsec == *prev_ts)
+		return 0;
+
+	*prev_ts = ts_nsec;
+	lat_stat_add(stat, ts_nsec > tx_nsec ? ts_nsec - tx_nsec : 0);
+
+	return 0;
+}
+
 static int tx_thread(void *arg)
 {
 	int i, thr, tx_thr, num_alloc;
@@ -1132,7 +1437,7 @@ static int tx_thread(void *arg)
 	test_options_t *test_options = &global->test_options;
 	int periodic_stat = test_options->update_msec ? 1 : 0;
 	odp_pool_t pool = global->pool;
-	uint64_t gap_nsec = test_options->gap_nsec;
+	double period_nsec = test_options->period_nsec;
 	uint64_t quit = test_options->quit;
 	uint64_t tx_timeouts = 0;
 	uint64_t tx_packets = 0;
@@ -1146,11 +1451,30 @@ static int tx_thread(void *arg)
 	int num_pkt = num_pktio * bursts * burst_size;
 	odp_pktout_queue_t pktout[num_pktio];
 	odp_packet_t pkt[num_pkt];
+	int latency = test_options->latency;
+	uint32_t lat_offset = test_options->hdr_len;
+	latency_hdr_t lat[num_pktio];
+	uint64_t prev_ts[num_pktio];
+	uint64_t req_nsec[num_pktio];
+	int ts_request;
 
 	thr = odp_thread_id();
 	tx_thr = thread_arg->tx_thr;
 	global->stat[thr].thread_type = TX_THREAD;
 
+	/* Output timestamps are per interface, so only the first TX thread
+	 * requests those. */
+	ts_request = latency && test_options->hw_ts && tx_thr == 0;
+
+	for (i = 0; i < num_pktio; i++) {
+		lat[i].magic = LAT_MAGIC;
+		lat[i].stream = tx_thr * MAX_PKTIOS + i;
+		lat[i].seq = 0;
+		lat[i].tx_nsec = 0;
+		prev_ts[i] = 0;
+		req_nsec[i] = 0;
+	}
+
 	num_alloc = odp_packet_alloc_multi(pool, pkt_len, pkt, num_pkt);
 
 	if (num_alloc != num_pkt) {
@@ -1176,7 +1500,8 @@ static int tx_thread(void *arg)
 	t1 = odp_time_local();
 
 	/* Start TX burst at different per thread offset */
-	t1_nsec = odp_time_to_ns(t1) + gap_nsec + (tx_thr * gap_nsec / num_tx);
+	t1_nsec = odp_time_to_ns(t1) +
+		  (uint64_t)(period_nsec + tx_thr * period_nsec / num_tx);
 
 	while (ret == 0) {
 		exit_test = odp_atomic_load_u32(&global->exit_test);
@@ -1188,8 +1513,10 @@ static int tx_thread(void *arg)
 			break;
 		}
 
-		if (gap_nsec) {
-			uint64_t nsec = t1_nsec + tx_timeouts * gap_nsec;
+		if (period_nsec > 0.0) {
+			/* Period has a fractional part when pacing to a rate */
+			uint64_t nsec = t1_nsec +
+					(uint64_t)(tx_timeouts * period_nsec);
 
 			next_tmo = odp_time_local_from_ns(nsec);
 			odp_time_wait_until(next_tmo);
@@ -1201,10 +1528,28 @@ static int tx_thread(void *arg)
 			int sent, j;
 			int first = i * bursts * burst_size;
 
+			if (ts_request && req_nsec[i] &&
+			    tx_delay(global->pktio[i].pktio,
+				     &global->stat[thr].lat, req_nsec[i],
+				     &prev_ts[i]))
+				ts_request = 0;
+
 			for (j = 0; j < bursts; j++) {
-				sent = send_burst(pktout[i],
-						  &pkt[first + j * burst_size],
-						  burst_size);
+				odp_packet_t *burst = &pkt[first +
+							   j * burst_size];
+				int req = ts_request && j == 0;
+
+				if (latency)
+					sent = send_burst_lat(pktout[i], pool,
+							      burst, burst_size,
+							      lat_offset,
+							      &lat[i], req);
+				else
+					sent = send_burst(pktout[i], burst,
+							  burst_size);
+
+				if (req && sent > 0)
+					req_nsec[i] = lat[i].tx_nsec;
 
 				if (odp_unlikely(sent < 0)) {
 					ret = -1;
@@ -1351,6 +1696,105 @@ static void periodic_print_loop(test_global_t *global)
 	}
 }
 
+static void lat_stat_merge(latency_stat_t *dst, const latency_stat_t *src)
+{
+	int i;
+
+	if (src->num == 0)
+		return;
+
+	if (dst->num == 0 || src->min < dst->min)
+		dst->min = src->min;
+
+	if (src->max > dst->max)
+		dst->max = src->max;
+
+	dst->num += src->num;
+	dst->sum += src->sum;
+
+	for (i = 0; i < LAT_BUCKETS; i++)
+		dst->hist[i] += src->hist[i];
+}
+
+/* Percentile in units of 0.1%. Returns the highest value of the bucket. */
+static uint64_t lat_percentile(const latency_stat_t *lat, uint32_t permille)
+{
+	uint64_t target = (lat->num * permille + 999) / 1000;
+	uint64_t sum = 0;
+	uint64_t val;
+	uint32_t i;
+
+	for (i = 0; i < LAT_BUCKETS - 1; i++) {
+		sum += lat->hist[i];
+
+		if (sum >= target)
+			break;
+	}
+
+	if (i == LAT_BUCKETS - 1)
+		return lat->max;
+
+	val = lat_bucket_value(i + 1) - 1;
+
+	return val < lat->max ? val : lat->max;
+}
+
+static void print_latency(const char *name, const latency_stat_t *lat)
+{
+	if (lat->num == 0) {
+		printf("  %-26s  no samples\n", name);
+		return;
+	}
+
+	printf("  %-26s  min %" PRIu64 ", ave %" PRIu64 ", p50 %" PRIu64
+	       ", p99 %" PRIu64 ", p99.9 %" PRIu64 ", max %" PRIu64 "\n",
+	       name, lat->min, lat->sum / lat->num, lat_percentile(lat, 500),
+	       lat_percentile(lat, 990), lat_percentile(lat, 999), lat->max);
+}
+
+static void print_latency_stat(test_global_t *global, uint64_t tx_pkt_sum)
+{
+	int i;
+	uint64_t reorder = 0;
+	uint64_t lost = 0;
+	latency_stat_t *rx_lat, *tx_lat;
+
+	rx_lat = calloc(2, sizeof(latency_stat_t));
+	if (rx_lat == NULL) {
+		printf("Error: Latency stat alloc failed\n");
+		return;
+	}
+
+	tx_lat = &rx_lat[1];
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		thread_stat_t *stat = &global->stat[i];
+
+		if (stat->thread_type == RX_THREAD) {
+			lat_stat_merge(rx_lat, &stat->lat);
+			reorder += stat->lat_reorder;
+		} else if (stat->thread_type == TX_THREAD) {
+			lat_stat_merge(tx_lat, &stat->lat);
+		}
+	}
+
+	/* Packets drained after stopping interfaces were not measured */
+	if (tx_pkt_sum > rx_lat->num + global->drained)
+		lost = tx_pkt_sum - rx_lat->num - global->drained;
+
+	printf("LATENCY\n");
+	printf("  packets measured:           %" PRIu64 "\n", rx_lat->num);
+	printf("  packets lost:               %" PRIu64 " (%.3f%%)\n", lost,
+	       tx_pkt_sum ? 100.0 * lost / tx_pkt_sum : 0.0);
+	printf("  packets reordered:          %" PRIu64 "\n", reorder);
+	print_latency("latency (nsec):", rx_lat);
+	if (global->test_options.hw_ts)
+		print_latency("tx timestamp delay (nsec):", tx_lat);
+	printf("\n");
+
+	free(rx_lat);
+}
+
 static int print_final_stat(test_global_t *global)
 {
 	int i, num_thr;
@@ -1475,6 +1919,9 @@ static int print_final_stat(test_global_t *global)
 	printf("  tx Mbit/s:                  %.1f\n", tx_mbit_per_sec);
 	printf("\n");
 
+	if (test_options->latency)
+		print_latency_stat(global, tx_pkt_sum);
+
 	if (rx_pkt_sum < MIN_RX_PACKETS_CI)
 		return -1;
 
@@ -0,0 +1,757 @@
+/* Copyright (c) 2020, Nokia
+ *
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#define TABLE_NAME       "table_perf"
+
+#define MAX_KEY_SIZE     256
+#define MAX_VALUE_SIZE   256
+
+/* Number of buckets in odph_hash_table */
+#define HASH_BUCKETS     0x10000
+
+/* Estimated per node and per bucket overhead of odph_hash_table */
+#define HASH_NODE_OVERHEAD   (2 * sizeof(void *))
+#define HASH_BUCKET_OVERHEAD (2 * sizeof(void *) + sizeof(odp_rwlock_t))
+
+/* Space reserved for table headers */
+#define TABLE_HDR_SIZE   4096
+
+/* IP lookup table entries are /24 prefixes starting from this address */
+#define IP_BASE          0x0a000000
+#define IP_CIDR          24
+#define IP_MAX_ENTRIES   (1 << 16)
+
+#define MB               (1024 * 1024)
+
+typedef enum {
+	TABLE_HASH = 0,
+	TABLE_CUCKOO,
+	TABLE_IPLOOKUP,
+	TABLE_LINEAR,
+	NUM_TABLES
+} table_type_t;
+
+typedef enum {
+	PHASE_PUT = 0,
+	PHASE_GET,
+	PHASE_MIXED,
+	PHASE_REMOVE,
+	NUM_PHASES
+} phase_t;
+
+typedef struct table_info_t {
+	const char *name;
+	odph_table_ops_t *ops;
+
+	/* Multiple threads may insert and remove (different) keys */
+	odp_bool_t parallel_write;
+
+	/* Multiple threads may update values of existing keys while others
+	 * are reading */
+	odp_bool_t parallel_mixed;
+
+} table_info_t;
+
+typedef struct test_options_t {
+	uint32_t num_cpu;
+	uint32_t table;
+	uint32_t num_entry;
+	uint32_t key_size;
+	uint32_t value_size;
+	uint32_t load;
+	uint32_t num_round;
+	uint32_t write_pct;
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint64_t ops;
+	uint64_t fails;
+	uint64_t cycles;
+	uint64_t max_cycles;
+	uint64_t nsec;
+
+} test_stat_t;
+
+typedef struct test_global_t {
+	test_options_t test_options;
+
+	odp_atomic_u32_t worker_idx;
+	odp_barrier_t barrier;
+	odp_cpumask_t cpumask;
+	odph_table_t table;
+	const table_info_t *info;
+	uint32_t capacity;
+	odp_bool_t skip_mixed;
+	odph_odpthread_t thread_tbl[ODP_THREAD_COUNT_MAX];
+	test_stat_t stat[NUM_PHASES][ODP_THREAD_COUNT_MAX];
+
+} test_global_t;
+
+test_global_t test_global;
+
+static const table_info_t table_info[NUM_TABLES] = {
+	{"hash",     &odph_hash_table_ops,     0, 1},
+	{"cuckoo",   &odph_cuckoo_table_ops,   0, 0},
+	{"iplookup", &odph_iplookup_table_ops, 0, 0},
+	{"linear",   &odph_linear_table_ops,   1, 1}
+};
+
+static const char *phase_name[NUM_PHASES] = {"put", "get", "mixed",
+					      "remove"};
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Helper table performance test\n"
+	       "\n"
+	       "Measures put, get, mixed get/update and remove operations of a helper table. Keys are\n"
+	       "inserted and removed in parallel only when the table type supports concurrent writers.\n"
+	       "\n"
+	       "Usage: odp_table_perf [options]\n"
+	       "\n"
+	       "  -c, --num_cpu          Number of CPUs (worker threads). 0: all available CPUs. Default 1.\n"
+	       "  -t, --table            Table type\n"
+	       "                           0: Hash table (default)\n"
+	       "                           1: Cuckoo table\n"
+	       "                           2: IP lookup (LPM) table. Keys are /24 IPv4 prefixes.\n"
+	       "                           3: Linear table. Keys are indexes.\n"
+	       "  -n, --num_entry        Number of entries inserted into the table. Default 10000.\n"
+	       "  -k, --key_size         Key size in bytes for hash and cuckoo tables. Default 16.\n"
+	       "  -v, --value_size       Value size in bytes. Default 8.\n"
+	       "  -l, --load             Load factor in percent. Table capacity is set to\n"
+	       "                         num_entry * 100 / load. Not used with IP lookup table. Default 50.\n"
+	       "  -r, --num_round        Number of get and mixed operations per thread. Default 100000.\n"
+	       "  -w, --write            Percentage of updates in the mixed phase. Default 10.\n"
+	       "  -h, --help             This help\n"
+	       "\n");
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int long_index;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{"num_cpu",    required_argument, NULL, 'c'},
+		{"table",      required_argument, NULL, 't'},
+		{"num_entry",  required_argument, NULL, 'n'},
+		{"key_size",   required_argument, NULL, 'k'},
+		{"value_size", required_argument, NULL, 'v'},
+		{"load",       required_argument, NULL, 'l'},
+		{"num_round",  required_argument, NULL, 'r'},
+		{"write",      required_argument, NULL, 'w'},
+		{"help",       no_argument,       NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+c:t:n:k:v:l:r:w:h";
+
+	test_options->num_cpu    = 1;
+	test_options->table      = TABLE_HASH;
+	test_options->num_entry  = 10000;
+	test_options->key_size   = 16;
+	test_options->value_size = 8;
+	test_options->load       = 50;
+	test_options->num_round  = 100000;
+	test_options->write_pct  = 10;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'c':
+			test_options->num_cpu = atoi(optarg);
+			break;
+		case 't':
+			test_options->table = atoi(optarg);
+			break;
+		case 'n':
+			test_options->num_entry = atoi(optarg);
+			break;
+		case 'k':
+			test_options->key_size = atoi(optarg);
+			break;
+		case 'v':
+			test_options->value_size = atoi(optarg);
+			break;
+		case 'l':
+			test_options->load = atoi(optarg);
+			break;
+		case 'r':
+			test_options->num_round = atoi(optarg);
+			break;
+		case 'w':
+			test_options->write_pct = atoi(optarg);
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->table >= NUM_TABLES) {
+		printf("Error: Bad table type %u\n", test_options->table);
+		return -1;
+	}
+
+	if (test_options->table == TABLE_LINEAR)
+		test_options->key_size = sizeof(uint32_t);
+
+	/* IP lookup table stores buffer handles */
+	if (test_options->table == TABLE_IPLOOKUP) {
+		test_options->key_size = sizeof(odph_iplookup_prefix_t);
+		test_options->value_size = sizeof(odp_buffer_t);
+
+		if (test_options->num_entry > IP_MAX_ENTRIES) {
+			printf("Error: Max %u entries in IP lookup table\n",
+			       IP_MAX_ENTRIES);
+			ret = -1;
+		}
+	}
+
+	if (test_options->num_entry == 0) {
+		printf("Error: No entries\n");
+		ret = -1;
+	}
+
+	if (test_options->key_size < sizeof(uint32_t) ||
+	    test_options->key_size > MAX_KEY_SIZE) {
+		printf("Error: Key size must be %zu ... %u bytes\n",
+		       sizeof(uint32_t), MAX_KEY_SIZE);
+		ret = -1;
+	}
+
+	if (test_options->value_size == 0 ||
+	    test_options->value_size > MAX_VALUE_SIZE) {
+		printf("Error: Value size must be 1 ... %u bytes\n",
+		       MAX_VALUE_SIZE);
+		ret = -1;
+	}
+
+	if (test_options->load == 0 || test_options->load > 100) {
+		printf("Error: Load factor must be 1 ... 100 %%\n");
+		ret = -1;
+	}
+
+	if (test_options->write_pct > 100) {
+		printf("Error: Write percentage must be 0 ... 100 %%\n");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static int set_num_cpu(test_global_t *global)
+{
+	int ret;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+
+	/* One thread used for the main thread */
+	if (num_cpu > ODP_THREAD_COUNT_MAX - 1) {
+		printf("Error: Too many workers. Maximum is %i.\n",
+		       ODP_THREAD_COUNT_MAX - 1);
+		return -1;
+	}
+
+	ret = odp_cpumask_default_worker(&global->cpumask, num_cpu);
+
+	if (num_cpu && ret != num_cpu) {
+		printf("Error: Too many workers. Max supported %i.\n", ret);
+		return -1;
+	}
+
+	/* Zero: all available workers */
+	if (num_cpu == 0) {
+		num_cpu = ret;
+		test_options->num_cpu = num_cpu;
+	}
+
+	odp_barrier_init(&global->barrier, num_cpu);
+
+	return 0;
+}
+
+/* Table size parameter from the number of entries and the load factor.
+ * Hash and linear table sizes are given in megabytes, cuckoo table size
+ * as number of entries. */
+static uint32_t table_size(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t key_size = test_options->key_size;
+	uint32_t value_size = test_options->value_size;
+	uint64_t capacity, bytes;
+
+	capacity = ((uint64_t)test_options->num_entry * 100 +
+		    test_options->load - 1) / test_options->load;
+	global->capacity = capacity;
+
+	switch (test_options->table) {
+	case TABLE_HASH:
+		bytes = TABLE_HDR_SIZE + HASH_BUCKETS * HASH_BUCKET_OVERHEAD +
+			capacity * (HASH_NODE_OVERHEAD + key_size +
+				    value_size);
+		return (bytes + MB - 1) / MB;
+	case TABLE_CUCKOO:
+		return capacity;
+	case TABLE_LINEAR:
+		bytes = TABLE_HDR_SIZE +
+			capacity * (sizeof(odp_rwlock_t) + value_size);
+		return (bytes + MB - 1) / MB;
+	default:
+		return 0;
+	}
+}
+
+static int create_table(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	const table_info_t *info = &table_info[test_options->table];
+	uint32_t size = table_size(global);
+
+	global->info = info;
+	global->table = info->ops->f_create(TABLE_NAME, size,
+					    test_options->key_size,
+					    test_options->value_size);
+
+	if (global->table == NULL) {
+		printf("Error: Table create failed (size %u)\n", size);
+		return -1;
+	}
+
+	/* Only concurrent readers are safe with some table types */
+	global->skip_mixed = test_options->num_cpu > 1 &&
+			     test_options->write_pct &&
+			     !info->parallel_mixed;
+
+	return 0;
+}
+
+/* Memory reserved by the table. IP lookup table memory does not include
+ * the trie and subtree buffer pools, which are allocated on demand. */
+static uint64_t table_memory(test_global_t *global)
+{
+	odp_shm_info_t shm_info;
+	odp_pool_info_t pool_info;
+	odp_shm_t shm;
+	odp_pool_t pool;
+	uint64_t size = 0;
+
+	shm = odp_shm_lookup(TABLE_NAME);
+
+	if (shm != ODP_SHM_INVALID && odp_shm_info(shm, &shm_info) == 0)
+		size += shm_info.size;
+
+	/* Cuckoo table stores keys and values in a buffer pool */
+	if (global->test_options.table == TABLE_CUCKOO) {
+		pool = odp_pool_lookup("kv_" TABLE_NAME);
+
+		if (pool != ODP_POOL_INVALID &&
+		    odp_pool_info(pool, &pool_info) == 0)
+			size += pool_info.max_data_addr -
+				pool_info.min_data_addr + 1;
+	}
+
+	return size;
+}
+
+static inline uint32_t rand_u32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	/* xorshift32 */
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* Write key of entry 'idx' for put and remove operations */
+static inline void set_key(test_global_t *global, uint8_t *key, uint32_t idx)
+{
+	odph_iplookup_prefix_t *prefix;
+	uint32_t u32;
+
+	switch (global->test_options.table) {
+	case TABLE_IPLOOKUP:
+		prefix = (odph_iplookup_prefix_t *)(uintptr_t)key;
+		prefix->ip = IP_BASE + (idx << (32 - IP_CIDR));
+		prefix->cidr = IP_CIDR;
+		break;
+	case TABLE_LINEAR:
+		memcpy(key, &idx, sizeof(idx));
+		break;
+	default:
+		/* Scramble index bits over the key. Multiplication with an
+		 * odd number keeps keys unique. */
+		u32 = idx * 0x9e3779b1;
+		memcpy(key, &u32, sizeof(u32));
+		break;
+	}
+}
+
+/* Write key of entry 'idx' for get operations */
+static inline void set_get_key(test_global_t *global, uint8_t *key,
+			       uint32_t idx)
+{
+	uint32_t ip;
+
+	if (global->test_options.table == TABLE_IPLOOKUP) {
+		ip = IP_BASE + (idx << (32 - IP_CIDR)) + 1;
+		memcpy(key, &ip, sizeof(ip));
+		return;
+	}
+
+	set_key(global, key, idx);
+}
+
+static inline void set_value(test_global_t *global, uint8_t *value,
+			     uint32_t idx)
+{
+	uint32_t value_size = global->test_options.value_size;
+	uint32_t u32 = idx + 1;
+
+	memcpy(value, &u32, value_size < sizeof(u32) ?
+	       value_size : sizeof(u32));
+}
+
+static inline void stat_op(test_stat_t *stat, uint64_t c1, uint64_t c2,
+			   int ret)
+{
+	uint64_t cycles = odp_cpu_cycles_diff(c2, c1);
+
+	stat->ops++;
+	stat->cycles += cycles;
+
+	if (cycles > stat->max_cycles)
+		stat->max_cycles = cycles;
+
+	if (odp_unlikely(ret < 0))
+		stat->fails++;
+}
+
+/* Put or remove entries. With single writer tables, the first worker
+ * handles all entries. */
+static void run_write(test_global_t *global, uint32_t widx, phase_t phase,
+		      test_stat_t *stat)
+{
+	uint8_t key[MAX_KEY_SIZE];
+	uint8_t value[MAX_VALUE_SIZE];
+	uint64_t c1, c2;
+	uint32_t i, first, step;
+	int ret;
+	test_options_t *test_options = &global->test_options;
+	odph_table_ops_t *ops = global->info->ops;
+	odph_table_t table = global->table;
+
+	if (global->info->parallel_write) {
+		first = widx;
+		step = test_options->num_cpu;
+	} else {
+		if (widx)
+			return;
+
+		first = 0;
+		step = 1;
+	}
+
+	memset(key, 0x5a, sizeof(key));
+	memset(value, 0, sizeof(value));
+
+	for (i = first; i < test_options->num_entry; i += step) {
+		set_key(global, key, i);
+
+		if (phase == PHASE_PUT) {
+			set_value(global, value, i);
+			c1 = odp_cpu_cycles();
+			ret = ops->f_put(table, key, value);
+			c2 = odp_cpu_cycles();
+		} else {
+			c1 = odp_cpu_cycles();
+			ret = ops->f_remove(table, key);
+			c2 = odp_cpu_cycles();
+		}
+
+		stat_op(stat, c1, c2, ret);
+	}
+}
+
+/* Random gets, and updates of existing keys in the mixed phase */
+static void run_read(test_global_t *global, uint32_t widx, phase_t phase,
+		     test_stat_t *stat)
+{
+	uint8_t key[MAX_KEY_SIZE];
+	uint8_t value[MAX_VALUE_SIZE];
+	uint64_t c1, c2;
+	uint32_t i, idx, r;
+	int ret;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_entry = test_options->num_entry;
+	uint32_t write_pct = 0;
+	uint32_t seed = 0x12345678 + widx;
+	odph_table_ops_t *ops = global->info->ops;
+	odph_table_t table = global->table;
+
+	if (phase == PHASE_MIXED)
+		write_pct = test_options->write_pct;
+
+	memset(key, 0x5a, sizeof(key));
+	memset(value, 0, sizeof(value));
+
+	for (i = 0; i < test_options->num_round; i++) {
+		r = rand_u32(&seed);
+		idx = r % num_entry;
+
+		if (write_pct && ((r >> 16) % 100) < write_pct) {
+			set_key(global, key, idx);
+			set_value(global, value, idx);
+			c1 = odp_cpu_cycles();
+			ret = ops->f_put(table, key, value);
+			c2 = odp_cpu_cycles();
+		} else {
+			set_get_key(global, key, idx);
+			c1 = odp_cpu_cycles();
+			ret = ops->f_get(table, key, value, MAX_VALUE_SIZE);
+			c2 = odp_cpu_cycles();
+		}
+
+		stat_op(stat, c1, c2, ret);
+	}
+}
+
+static int test_table(void *arg)
+{
+	int thr;
+	uint32_t widx;
+	phase_t phase;
+	odp_time_t t1, t2;
+	test_stat_t *stat;
+	test_global_t *global = arg;
+	odp_bool_t has_remove = global->info->ops->f_remove != NULL;
+
+	thr = odp_thread_id();
+	widx = odp_atomic_fetch_inc_u32(&global->worker_idx);
+
+	for (phase = 0; phase < NUM_PHASES; phase++) {
+		stat = &global->stat[phase][thr];
+
+		if (phase == PHASE_MIXED && global->skip_mixed)
+			continue;
+
+		if (phase == PHASE_REMOVE && !has_remove)
+			continue;
+
+		/* Start all workers at the same time */
+		odp_barrier_wait(&global->barrier);
+
+		t1 = odp_time_local();
+
+		if (phase == PHASE_PUT || phase == PHASE_REMOVE)
+			run_write(global, widx, phase, stat);
+		else
+			run_read(global, widx, phase, stat);
+
+		t2 = odp_time_local();
+
+		if (stat->ops)
+			stat->nsec = odp_time_diff_ns(t2, t1);
+	}
+
+	return 0;
+}
+
+static int start_workers(test_global_t *global, odp_instance_t instance)
+{
+	odph_odpthread_params_t thr_params;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+
+	memset(&thr_params, 0, sizeof(thr_params));
+	thr_params.thr_type = ODP_THREAD_WORKER;
+	thr_params.instance = instance;
+	thr_params.arg      = global;
+	thr_params.start    = test_table;
+
+	if (odph_odpthreads_create(global->thread_tbl, &global->cpumask,
+				   &thr_params) != num_cpu)
+		return -1;
+
+	return 0;
+}
+
+static void print_stat(test_global_t *global, uint64_t memory)
+{
+	int i;
+	phase_t phase;
+	test_stat_t *stat;
+	uint64_t ops, fails, cycles, max_cycles, nsec;
+	uint32_t num_thr;
+	test_options_t *test_options = &global->test_options;
+
+	printf("RESULTS - sum over threads, latency per operation:\n");
+	printf("--------------------------------------------------\n");
+	printf("  phase   threads       ops   fails   Mops/sec   ave cycles   max cycles\n");
+
+	for (phase = 0; phase < NUM_PHASES; phase++) {
+		ops = 0;
+		fails = 0;
+		cycles = 0;
+		max_cycles = 0;
+		nsec = 0;
+		num_thr = 0;
+
+		for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+			stat = &global->stat[phase][i];
+
+			if (stat->ops == 0)
+				continue;
+
+			ops    += stat->ops;
+			fails  += stat->fails;
+			cycles += stat->cycles;
+			nsec   += stat->nsec;
+			num_thr++;
+
+			if (stat->max_cycles > max_cycles)
+				max_cycles = stat->max_cycles;
+		}
+
+		if (ops == 0) {
+			printf("  %-6s  skipped\n", phase_name[phase]);
+			continue;
+		}
+
+		/* Throughput from average thread run time */
+		printf("  %-6s  %7u  %8" PRIu64 "  %6" PRIu64 "  %9.3f  %11.1f"
+		       "  %11" PRIu64 "\n", phase_name[phase], num_thr, ops,
+		       fails, (1000.0 * ops * num_thr) / nsec,
+		       (double)cycles / ops, max_cycles);
+	}
+
+	printf("\n");
+	printf("  table memory:         %.3f MB\n", (double)memory / MB);
+	printf("  memory per entry:     %.1f bytes\n",
+	       (double)memory / test_options->num_entry);
+
+	if (test_options->table == TABLE_IPLOOKUP)
+		printf("  (trie and subtree pools not included)\n");
+
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	odp_instance_t instance;
+	odp_init_t init;
+	test_global_t *global;
+	test_options_t *test_options;
+	uint64_t memory;
+	int ret = 0;
+
+	global = &test_global;
+	memset(global, 0, sizeof(test_global_t));
+	test_options = &global->test_options;
+	odp_atomic_init_u32(&global->worker_idx, 0);
+
+	if (parse_options(argc, argv, test_options))
+		return -1;
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls      = 1;
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto   = 1;
+	init.not_used.feat.ipsec    = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.timer    = 1;
+	init.not_used.feat.tm       = 1;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		printf("Error: Global init failed.\n");
+		return -1;
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		printf("Error: Local init failed.\n");
+		return -1;
+	}
+
+	if (set_num_cpu(global))
+		return -1;
+
+	if (create_table(global))
+		return -1;
+
+	printf("\nHelper table performance test\n");
+	printf("  num cpu     %u\n", test_options->num_cpu);
+	printf("  table       %s\n", global->info->name);
+	printf("  num entries %u\n", test_options->num_entry);
+	printf("  key size    %u\n", test_options->key_size);
+	printf("  value size  %u\n", test_options->value_size);
+	if (test_options->table != TABLE_IPLOOKUP)
+		printf("  capacity    %u (load %u %%)\n", global->capacity,
+		       test_options->load);
+	printf("  num rounds  %u\n", test_options->num_round);
+	printf("  write       %u %%\n", test_options->write_pct);
+	if (global->skip_mixed)
+		printf("  Mixed phase skipped: %s table does not support "
+		       "concurrent writes\n", global->info->name);
+	printf("\n");
+
+	/* Start workers */
+	if (start_workers(global, instance)) {
+		printf("Error: Worker start failed.\n");
+		return -1;
+	}
+
+	/* Wait workers to exit */
+	odph_odpthreads_join(global->thread_tbl);
+
+	/* Entries have been removed, but memory is still reserved */
+	memory = table_memory(global);
+
+	print_stat(global, memory);
+
+	if (global->info->ops->f_des(global->table)) {
+		printf("Error: Table destroy failed.\n");
+		ret = -1;
+	}
+
+	if (odp_term_local()) {
+		printf("Error: term local failed.\n");
+		return -1;
+	}
+
+	if (odp_term_global(instance)) {
+		printf("Error: term global failed.\n");
+		return -1;
+	}
+
+	return ret;
+}
@@ -0,0 +1,901 @@
+/* Copyright (c) 2020, Nokia
+ *
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#define MAX_QUEUES       1024
+#define MAX_NODES        1024
+
+/* Shaper burst size in packets */
+#define SHAPER_BURST     8
+
+/* Shaper rates are measured after this warm up period */
+#define WARM_UP_NS       (100 * ODP_TIME_MSEC_IN_NS)
+
+/* Maximum time to wait for the TM system to drain after the test */
+#define DRAIN_TMO_NS     (10 * ODP_TIME_SEC_IN_NS)
+
+/* Number of queues printed separately */
+#define MAX_PRINT_QUEUES 16
+
+typedef struct test_options_t {
+	uint32_t num_cpu;
+	uint32_t num_level;
+	uint32_t fanout;
+	uint32_t num_queue;
+	uint64_t queue_bps;
+	uint64_t root_bps;
+	uint32_t pkt_len;
+	uint32_t num_pkt;
+	uint32_t duration;
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint64_t enqs;
+	uint64_t enq_fails;
+	uint64_t alloc_fails;
+	uint64_t enq_cycles;
+	uint64_t cycles;
+	uint64_t nsec;
+
+} test_stat_t;
+
+/* Egress counters of a TM queue */
+typedef struct queue_ctx_t {
+	odp_atomic_u64_t packets;
+	uint64_t start;
+	uint64_t end;
+
+} queue_ctx_t;
+
+typedef struct test_global_t {
+	test_options_t test_options;
+
+	odp_atomic_u32_t exit_test;
+	odp_atomic_u32_t worker_idx;
+	odp_barrier_t barrier;
+	odp_pool_t pool;
+	odp_cpumask_t cpumask;
+	odp_tm_t tm;
+	odp_tm_shaper_t queue_shaper;
+	odp_tm_shaper_t root_shaper;
+	uint32_t num_node;
+	uint32_t num_tm_queue;
+	uint64_t window_nsec;
+	odp_tm_node_t node[MAX_NODES];
+	odp_tm_queue_t tm_queue[MAX_QUEUES];
+	queue_ctx_t queue_ctx[MAX_QUEUES];
+	odph_odpthread_t thread_tbl[ODP_THREAD_COUNT_MAX];
+	test_stat_t stat[ODP_THREAD_COUNT_MAX];
+
+} test_global_t;
+
+test_global_t test_global;
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Traffic manager performance test\n"
+	       "\n"
+	       "Worker threads enqueue packets into TM queues of a hierarchy of TM nodes. Packets exit\n"
+	       "the TM system through an egress function, so no network interfaces are needed.\n"
+	       "\n"
+	       "Usage: odp_tm_perf [options]\n"
+	       "\n"
+	       "  -c, --num_cpu          Number of CPUs (worker threads). 0: all available CPUs. Default 1.\n"
+	       "  -l, --num_level        Number of TM node levels. Default 1.\n"
+	       "  -f, --fanout           Number of child nodes per node. Default 2.\n"
+	       "  -q, --num_queue        Number of TM queues per leaf node. Default 4.\n"
+	       "  -s, --queue_rate       TM queue shaper rate in bits per second. 0: no shaper (default).\n"
+	       "  -S, --root_rate        Root node shaper rate in bits per second. 0: no shaper (default).\n"
+	       "  -L, --pkt_len          Packet length in bytes. Default 64.\n"
+	       "  -n, --num_pkt          Number of packets in the pool. Default 8192.\n"
+	       "  -t, --time             Test duration in seconds. Default 1.\n"
+	       "  -h, --help             This help\n"
+	       "\n");
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int long_index;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{"num_cpu",    required_argument, NULL, 'c'},
+		{"num_level",  required_argument, NULL, 'l'},
+		{"fanout",     required_argument, NULL, 'f'},
+		{"num_queue",  required_argument, NULL, 'q'},
+		{"queue_rate", required_argument, NULL, 's'},
+		{"root_rate",  required_argument, NULL, 'S'},
+		{"pkt_len",    required_argument, NULL, 'L'},
+		{"num_pkt",    required_argument, NULL, 'n'},
+		{"time",       required_argument, NULL, 't'},
+		{"help",       no_argument,       NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+c:l:f:q:s:S:L:n:t:h";
+
+	test_options->num_cpu   = 1;
+	test_options->num_level = 1;
+	test_options->fanout    = 2;
+	test_options->num_queue = 4;
+	test_options->queue_bps = 0;
+	test_options->root_bps  = 0;
+	test_options->pkt_len   = 64;
+	test_options->num_pkt   = 8192;
+	test_options->duration  = 1;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'c':
+			test_options->num_cpu = atoi(optarg);
+			break;
+		case 'l':
+			test_options->num_level = atoi(optarg);
+			break;
+		case 'f':
+			test_options->fanout = atoi(optarg);
+			break;
+		case 'q':
+			test_options->num_queue = atoi(optarg);
+			break;
+		case 's':
+			test_options->queue_bps = strtoull(optarg, NULL, 0);
+			break;
+		case 'S':
+			test_options->root_bps = strtoull(optarg, NULL, 0);
+			break;
+		case 'L':
+			test_options->pkt_len = atoi(optarg);
+			break;
+		case 'n':
+			test_options->num_pkt = atoi(optarg);
+			break;
+		case 't':
+			test_options->duration = atoi(optarg);
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->num_level == 0 || test_options->fanout == 0 ||
+	    test_options->num_queue == 0) {
+		printf("Error: Levels, fanout and queues must be non-zero\n");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static int set_num_cpu(test_global_t *global)
+{
+	int ret;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+
+	/* One thread used for the main thread */
+	if (num_cpu > ODP_THREAD_COUNT_MAX - 1) {
+		printf("Error: Too many workers. Maximum is %i.\n",
+		       ODP_THREAD_COUNT_MAX - 1);
+		return -1;
+	}
+
+	ret = odp_cpumask_default_worker(&global->cpumask, num_cpu);
+
+	if (num_cpu && ret != num_cpu) {
+		printf("Error: Too many workers. Max supported %i.\n", ret);
+		return -1;
+	}
+
+	/* Zero: all available workers */
+	if (num_cpu == 0) {
+		num_cpu = ret;
+		test_options->num_cpu = num_cpu;
+	}
+
+	odp_barrier_init(&global->barrier, num_cpu);
+
+	return 0;
+}
+
+static int create_pool(test_global_t *global)
+{
+	odp_pool_param_t pool_param;
+	test_options_t *test_options = &global->test_options;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type    = ODP_POOL_PACKET;
+	pool_param.pkt.num = test_options->num_pkt;
+	pool_param.pkt.len = test_options->pkt_len;
+
+	global->pool = odp_pool_create("tm perf", &pool_param);
+
+	if (global->pool == ODP_POOL_INVALID) {
+		printf("Error: Pool create failed.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static void tm_egress(odp_packet_t pkt)
+{
+	queue_ctx_t *ctx = odp_packet_user_ptr(pkt);
+
+	odp_atomic_inc_u64(&ctx->packets);
+	odp_packet_free(pkt);
+}
+
+static odp_tm_shaper_t create_shaper(const char *name, uint64_t bps,
+				     uint32_t pkt_len)
+{
+	odp_tm_shaper_params_t shaper_param;
+
+	odp_tm_shaper_params_init(&shaper_param);
+	shaper_param.commit_bps   = bps;
+	shaper_param.commit_burst = SHAPER_BURST * pkt_len * 8;
+
+	return odp_tm_shaper_create(name, &shaper_param);
+}
+
+static int create_tm(test_global_t *global)
+{
+	odp_tm_capabilities_t tm_capa;
+	odp_tm_requirements_t req;
+	odp_tm_level_requirements_t *per_level;
+	odp_tm_egress_t egress;
+	odp_tm_node_params_t node_param;
+	odp_tm_queue_params_t queue_param;
+	odp_tm_node_t parent;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_level = test_options->num_level;
+	uint32_t fanout = test_options->fanout;
+	uint32_t num_queue = test_options->num_queue;
+	uint32_t pkt_len = test_options->pkt_len;
+	uint32_t level, i, j, nodes, first, prev_first, num_tm_queue;
+	char name[64];
+
+	if (odp_tm_capabilities(&tm_capa, 1) < 1) {
+		printf("Error: TM capability failed\n");
+		return -1;
+	}
+
+	if (!tm_capa.egress_fcn_supported) {
+		printf("Error: TM egress function not supported\n");
+		return -1;
+	}
+
+	if (num_level > tm_capa.max_levels) {
+		printf("Error: Too many levels. Max %u.\n", tm_capa.max_levels);
+		return -1;
+	}
+
+	/* Count nodes and queues of the hierarchy */
+	nodes = 1;
+	global->num_node = 0;
+
+	for (level = 0; level < num_level; level++) {
+		if (nodes > tm_capa.per_level[level].max_num_tm_nodes ||
+		    global->num_node + nodes > MAX_NODES) {
+			printf("Error: Too many nodes on level %u\n", level);
+			return -1;
+		}
+
+		global->num_node += nodes;
+
+		if (level < num_level - 1)
+			nodes *= fanout;
+	}
+
+	num_tm_queue = nodes * num_queue;
+
+	if (num_tm_queue > tm_capa.max_tm_queues ||
+	    num_tm_queue > MAX_QUEUES) {
+		printf("Error: Too many TM queues (%u)\n", num_tm_queue);
+		return -1;
+	}
+
+	if (test_options->queue_bps && !tm_capa.tm_queue_shaper_supported) {
+		printf("Error: TM queue shaper not supported\n");
+		return -1;
+	}
+
+	if (test_options->root_bps &&
+	    !tm_capa.per_level[0].tm_node_shaper_supported) {
+		printf("Error: TM node shaper not supported\n");
+		return -1;
+	}
+
+	odp_tm_requirements_init(&req);
+	req.max_tm_queues          = num_tm_queue;
+	req.num_levels             = num_level;
+	req.tm_queue_shaper_needed = test_options->queue_bps ? 1 : 0;
+
+	nodes = 1;
+
+	for (level = 0; level < num_level; level++) {
+		per_level = &req.per_level[level];
+		per_level->max_num_tm_nodes   = nodes;
+		per_level->max_fanin_per_node = level < num_level - 1 ?
+						fanout : num_queue;
+		per_level->max_priority       = 0;
+		per_level->min_weight         = ODP_TM_MIN_SCHED_WEIGHT;
+		per_level->max_weight         = ODP_TM_MIN_SCHED_WEIGHT;
+
+		if (level == 0 && test_options->root_bps)
+			per_level->tm_node_shaper_needed = 1;
+
+		nodes *= fanout;
+	}
+
+	odp_tm_egress_init(&egress);
+	egress.egress_kind = ODP_TM_EGRESS_FN;
+	egress.egress_fcn  = tm_egress;
+
+	global->tm = odp_tm_create("tm perf", &req, &egress);
+
+	if (global->tm == ODP_TM_INVALID) {
+		printf("Error: TM create failed\n");
+		return -1;
+	}
+
+	if (test_options->queue_bps) {
+		global->queue_shaper = create_shaper("tm perf queue",
+						     test_options->queue_bps,
+						     pkt_len);
+
+		if (global->queue_shaper == ODP_TM_INVALID) {
+			printf("Error: Queue shaper create failed\n");
+			return -1;
+		}
+	}
+
+	if (test_options->root_bps) {
+		global->root_shaper = create_shaper("tm perf root",
+						    test_options->root_bps,
+						    pkt_len);
+
+		if (global->root_shaper == ODP_TM_INVALID) {
+			printf("Error: Root shaper create failed\n");
+			return -1;
+		}
+	}
+
+	/* Nodes are stored level by level. Node 'j' of a level is connected
+	 * to node 'j / fanout' of the previous level. */
+	nodes = 1;
+	first = 0;
+	prev_first = 0;
+
+	for (level = 0; level < num_level; level++) {
+		for (j = 0; j < nodes; j++) {
+			i = first + j;
+
+			odp_tm_node_params_init(&node_param);
+			node_param.level     = level;
+			node_param.max_fanin = level < num_level - 1 ?
+					       fanout : num_queue;
+
+			if (level == 0)
+				node_param.shaper_profile = global->root_shaper;
+
+			snprintf(name, sizeof(name), "node_%u_%u", level, j);
+			global->node[i] = odp_tm_node_create(global->tm, name,
+							     &node_param);
+
+			if (global->node[i] == ODP_TM_INVALID) {
+				printf("Error: Node create failed (%s)\n",
+				       name);
+				return -1;
+			}
+
+			if (level == 0)
+				parent = ODP_TM_ROOT;
+			else
+				parent = global->node[prev_first + j / fanout];
+
+			if (odp_tm_node_connect(global->node[i], parent)) {
+				printf("Error: Node connect failed (%s)\n",
+				       name);
+				return -1;
+			}
+		}
+
+		prev_first = first;
+		first += nodes;
+
+		if (level < num_level - 1)
+			nodes *= fanout;
+	}
+
+	/* Queues are connected to the last level nodes */
+	for (i = 0; i < num_tm_queue; i++) {
+		odp_tm_queue_params_init(&queue_param);
+		queue_param.shaper_profile = global->queue_shaper;
+		queue_param.priority       = 0;
+
+		global->tm_queue[i] = odp_tm_queue_create(global->tm,
+							  &queue_param);
+
+		if (global->tm_queue[i] == ODP_TM_INVALID) {
+			printf("Error: TM queue create failed (%u)\n", i);
+			return -1;
+		}
+
+		global->num_tm_queue++;
+		parent = global->node[prev_first + i / num_queue];
+
+		if (odp_tm_queue_connect(global->tm_queue[i], parent)) {
+			printf("Error: TM queue connect failed (%u)\n", i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int test_tm(void *arg)
+{
+	int thr;
+	uint32_t idx, q, num_cpu, num_tm_queue, pkt_len;
+	uint64_t c1, c2, c3, c4, cycles, nsec;
+	uint64_t enqs, enq_fails, alloc_fails, enq_cycles;
+	odp_time_t t1, t2;
+	odp_packet_t pkt;
+	test_global_t *global = arg;
+	test_options_t *test_options = &global->test_options;
+	odp_pool_t pool = global->pool;
+
+	thr = odp_thread_id();
+	idx = odp_atomic_fetch_inc_u32(&global->worker_idx);
+	num_cpu = test_options->num_cpu;
+	num_tm_queue = global->num_tm_queue;
+	pkt_len = test_options->pkt_len;
+
+	/* Workers start from different queues */
+	q = idx % num_tm_queue;
+	enqs = 0;
+	enq_fails = 0;
+	alloc_fails = 0;
+	enq_cycles = 0;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	while (odp_atomic_load_u32(&global->exit_test) == 0) {
+		pkt = odp_packet_alloc(pool, pkt_len);
+
+		if (odp_unlikely(pkt == ODP_PACKET_INVALID)) {
+			alloc_fails++;
+			continue;
+		}
+
+		odp_packet_user_ptr_set(pkt, &global->queue_ctx[q]);
+
+		c3 = odp_cpu_cycles();
+
+		if (odp_unlikely(odp_tm_enq(global->tm_queue[q], pkt))) {
+			enq_fails++;
+			odp_packet_free(pkt);
+		} else {
+			c4 = odp_cpu_cycles();
+			enq_cycles += odp_cpu_cycles_diff(c4, c3);
+			enqs++;
+		}
+
+		q += num_cpu;
+		if (q >= num_tm_queue)
+			q = q % num_tm_queue;
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	nsec   = odp_time_diff_ns(t2, t1);
+	cycles = odp_cpu_cycles_diff(c2, c1);
+
+	/* Update stats*/
+	global->stat[thr].enqs        = enqs;
+	global->stat[thr].enq_fails   = enq_fails;
+	global->stat[thr].alloc_fails = alloc_fails;
+	global->stat[thr].enq_cycles  = enq_cycles;
+	global->stat[thr].cycles      = cycles;
+	global->stat[thr].nsec        = nsec;
+
+	return 0;
+}
+
+static int start_workers(test_global_t *global, odp_instance_t instance)
+{
+	odph_odpthread_params_t thr_params;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+
+	memset(&thr_params, 0, sizeof(thr_params));
+	thr_params.thr_type = ODP_THREAD_WORKER;
+	thr_params.instance = instance;
+	thr_params.arg      = global;
+	thr_params.start    = test_tm;
+
+	if (odph_odpthreads_create(global->thread_tbl, &global->cpumask,
+				   &thr_params) != num_cpu)
+		return -1;
+
+	return 0;
+}
+
+/* Measure egress rates over a window while workers are running */
+static void measure(test_global_t *global)
+{
+	odp_time_t t1, t2;
+	uint32_t i;
+	uint64_t duration = global->test_options.duration;
+
+	odp_time_wait_ns(WARM_UP_NS);
+
+	t1 = odp_time_local();
+	for (i = 0; i < global->num_tm_queue; i++)
+		global->queue_ctx[i].start =
+			odp_atomic_load_u64(&global->queue_ctx[i].packets);
+
+	odp_time_wait_ns(duration * ODP_TIME_SEC_IN_NS);
+
+	t2 = odp_time_local();
+	for (i = 0; i < global->num_tm_queue; i++)
+		global->queue_ctx[i].end =
+			odp_atomic_load_u64(&global->queue_ctx[i].packets);
+
+	global->window_nsec = odp_time_diff_ns(t2, t1);
+
+	odp_atomic_store_u32(&global->exit_test, 1);
+}
+
+static uint64_t egress_packets(test_global_t *global)
+{
+	uint32_t i;
+	uint64_t sum = 0;
+
+	for (i = 0; i < global->num_tm_queue; i++)
+		sum += odp_atomic_load_u64(&global->queue_ctx[i].packets);
+
+	return sum;
+}
+
+/* Disable shaping and wait until all packets have left the TM system */
+static int drain_tm(test_global_t *global)
+{
+	odp_tm_shaper_params_t shaper_param;
+	uint64_t enqs = 0;
+	uint64_t waited = 0;
+	int i;
+
+	odp_tm_shaper_params_init(&shaper_param);
+
+	if (global->queue_shaper != ODP_TM_INVALID)
+		odp_tm_shaper_params_update(global->queue_shaper,
+					    &shaper_param);
+
+	if (global->root_shaper != ODP_TM_INVALID)
+		odp_tm_shaper_params_update(global->root_shaper,
+					    &shaper_param);
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		enqs += global->stat[i].enqs;
+
+	while (egress_packets(global) < enqs ||
+	       !odp_tm_is_idle(global->tm)) {
+		if (waited > DRAIN_TMO_NS) {
+			printf("Error: TM drain timeout (%" PRIu64 "/%"
+			       PRIu64 ")\n", egress_packets(global), enqs);
+			return -1;
+		}
+
+		odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+		waited += ODP_TIME_MSEC_IN_NS;
+	}
+
+	return 0;
+}
+
+static double achieved_bps(test_global_t *global, uint64_t packets)
+{
+	uint32_t pkt_len = global->test_options.pkt_len;
+
+	return (8.0 * packets * pkt_len * ODP_TIME_SEC_IN_NS) /
+	       global->window_nsec;
+}
+
+static void print_shaper_stat(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint64_t queue_bps = test_options->queue_bps;
+	uint64_t root_bps = test_options->root_bps;
+	uint64_t packets, sum = 0;
+	double bps, min_bps = 0, max_bps = 0;
+	uint32_t i;
+
+	printf("RESULTS - egress rate per shaper (Mbps):\n");
+	printf("----------------------------------------\n");
+
+	for (i = 0; i < global->num_tm_queue; i++) {
+		packets = global->queue_ctx[i].end - global->queue_ctx[i].start;
+		bps = achieved_bps(global, packets);
+		sum += packets;
+
+		if (i == 0 || bps < min_bps)
+			min_bps = bps;
+		if (i == 0 || bps > max_bps)
+			max_bps = bps;
+
+		if (queue_bps && i < MAX_PRINT_QUEUES)
+			printf("  queue %4u: %10.3f / %10.3f (%+.2f %%)\n", i,
+			       bps / 1000000, queue_bps / 1000000.0,
+			       100.0 * (bps - queue_bps) / queue_bps);
+	}
+
+	bps = achieved_bps(global, sum / global->num_tm_queue);
+
+	printf("  queue min:  %10.3f\n", min_bps / 1000000);
+	printf("  queue ave:  %10.3f", bps / 1000000);
+	if (queue_bps)
+		printf(" / %10.3f (%+.2f %%)", queue_bps / 1000000.0,
+		       100.0 * (bps - queue_bps) / queue_bps);
+	printf("\n");
+	printf("  queue max:  %10.3f\n", max_bps / 1000000);
+
+	bps = achieved_bps(global, sum);
+
+	printf("  root:       %10.3f", bps / 1000000);
+	if (root_bps)
+		printf(" / %10.3f (%+.2f %%)", root_bps / 1000000.0,
+		       100.0 * (bps - root_bps) / root_bps);
+	printf("\n\n");
+
+	printf("  egress packets:       %" PRIu64 "\n", sum);
+	printf("  egress pps:           %.3f M\n\n",
+	       (1000.0 * sum) / global->window_nsec);
+}
+
+static void print_stat(test_global_t *global)
+{
+	int i, num;
+	double enqs_ave, nsec_ave, cycles_ave, enq_cycles_ave;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+	uint64_t enqs_sum = 0;
+	uint64_t enq_fails_sum = 0;
+	uint64_t alloc_fails_sum = 0;
+	uint64_t enq_cycles_sum = 0;
+	uint64_t nsec_sum = 0;
+	uint64_t cycles_sum = 0;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		enqs_sum        += global->stat[i].enqs;
+		enq_fails_sum   += global->stat[i].enq_fails;
+		alloc_fails_sum += global->stat[i].alloc_fails;
+		enq_cycles_sum  += global->stat[i].enq_cycles;
+		nsec_sum        += global->stat[i].nsec;
+		cycles_sum      += global->stat[i].cycles;
+	}
+
+	if (enqs_sum == 0 || global->window_nsec == 0) {
+		printf("No results.\n");
+		return;
+	}
+
+	enqs_ave       = enqs_sum / num_cpu;
+	nsec_ave       = nsec_sum / num_cpu;
+	cycles_ave     = cycles_sum / num_cpu;
+	enq_cycles_ave = enq_cycles_sum / num_cpu;
+	num = 0;
+
+	printf("RESULTS - per thread (Million enqueues per sec):\n");
+	printf("------------------------------------------------\n");
+	printf("        1      2      3      4      5      6      7      8      9     10");
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		if (global->stat[i].nsec) {
+			if ((num % 10) == 0)
+				printf("\n   ");
+
+			printf("%6.1f ", (1000.0 * global->stat[i].enqs) /
+			       global->stat[i].nsec);
+			num++;
+		}
+	}
+	printf("\n\n");
+
+	printf("RESULTS - average over %i threads:\n", num_cpu);
+	printf("----------------------------------\n");
+	printf("  duration:             %.3f msec\n", nsec_ave / 1000000);
+	printf("  num cycles:           %.3f M\n", cycles_ave / 1000000);
+	printf("  enqueues:             %.0f\n", enqs_ave);
+	printf("  cycles per enqueue:   %.3f\n", enq_cycles_ave / enqs_ave);
+	printf("  cycles per packet:    %.3f\n", cycles_ave / enqs_ave);
+	printf("  enqueues per sec:     %.3f M\n",
+	       (1000.0 * enqs_ave) / nsec_ave);
+	printf("  total enqueue fails:  %" PRIu64 "\n", enq_fails_sum);
+	printf("  total alloc fails:    %" PRIu64 "\n\n", alloc_fails_sum);
+
+	print_shaper_stat(global);
+}
+
+static int destroy_tm(test_global_t *global)
+{
+	uint32_t i;
+	int ret = 0;
+
+	for (i = 0; i < global->num_tm_queue; i++) {
+		odp_tm_queue_disconnect(global->tm_queue[i]);
+
+		if (odp_tm_queue_destroy(global->tm_queue[i])) {
+			printf("Error: TM queue destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	/* Destroy leaf nodes first */
+	for (i = global->num_node; i > 0; i--) {
+		if (global->node[i - 1] == ODP_TM_INVALID)
+			continue;
+
+		odp_tm_node_disconnect(global->node[i - 1]);
+
+		if (odp_tm_node_destroy(global->node[i - 1])) {
+			printf("Error: TM node destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	if (global->tm != ODP_TM_INVALID && odp_tm_destroy(global->tm)) {
+		printf("Error: TM destroy failed\n");
+		ret = -1;
+	}
+
+	if (global->queue_shaper != ODP_TM_INVALID)
+		odp_tm_shaper_destroy(global->queue_shaper);
+
+	if (global->root_shaper != ODP_TM_INVALID)
+		odp_tm_shaper_destroy(global->root_shaper);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	odp_instance_t instance;
+	odp_init_t init;
+	test_global_t *global;
+	test_options_t *test_options;
+	uint32_t i;
+	int ret = 0;
+
+	global = &test_global;
+	memset(global, 0, sizeof(test_global_t));
+	global->pool         = ODP_POOL_INVALID;
+	global->tm           = ODP_TM_INVALID;
+	global->queue_shaper = ODP_TM_INVALID;
+	global->root_shaper  = ODP_TM_INVALID;
+	test_options = &global->test_options;
+
+	for (i = 0; i < MAX_NODES; i++)
+		global->node[i] = ODP_TM_INVALID;
+
+	for (i = 0; i < MAX_QUEUES; i++)
+		odp_atomic_init_u64(&global->queue_ctx[i].packets, 0);
+
+	odp_atomic_init_u32(&global->exit_test, 0);
+	odp_atomic_init_u32(&global->worker_idx, 0);
+
+	if (parse_options(argc, argv, test_options))
+		return -1;
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls      = 1;
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto   = 1;
+	init.not_used.feat.ipsec    = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.timer    = 1;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		printf("Error: Global init failed.\n");
+		return -1;
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		printf("Error: Local init failed.\n");
+		return -1;
+	}
+
+	if (set_num_cpu(global))
+		return -1;
+
+	printf("\nTraffic manager performance test\n");
+	printf("  num cpu     %u\n", test_options->num_cpu);
+	printf("  num levels  %u\n", test_options->num_level);
+	printf("  fanout      %u\n", test_options->fanout);
+	printf("  leaf queues %u\n", test_options->num_queue);
+	printf("  queue rate  %" PRIu64 " bps\n", test_options->queue_bps);
+	printf("  root rate   %" PRIu64 " bps\n", test_options->root_bps);
+	printf("  pkt length  %u\n", test_options->pkt_len);
+	printf("  num packets %u\n", test_options->num_pkt);
+	printf("  duration    %u sec\n", test_options->duration);
+
+	if (create_pool(global) || create_tm(global)) {
+		ret = -1;
+		goto destroy;
+	}
+
+	printf("  TM nodes    %u\n", global->num_node);
+	printf("  TM queues   %u\n\n", global->num_tm_queue);
+
+	/* Start workers */
+	if (start_workers(global, instance)) {
+		printf("Error: Worker start failed.\n");
+		return -1;
+	}
+
+	measure(global);
+
+	/* Wait workers to exit */
+	odph_odpthreads_join(global->thread_tbl);
+
+	if (drain_tm(global))
+		ret = -1;
+
+	print_stat(global);
+
+destroy:
+	if (destroy_tm(global))
+		ret = -1;
+
+	if (global->pool != ODP_POOL_INVALID &&
+	    odp_pool_destroy(global->pool)) {
+		printf("Error: Pool destroy failed.\n");
+		ret = -1;
+	}
+
+	if (odp_term_local()) {
+		printf("Error: term local failed.\n");
+		return -1;
+	}
+
+	if (odp_term_global(instance)) {
+		printf("Error: term global failed.\n");
+		return -1;
+	}
+
+	return ret;
+}
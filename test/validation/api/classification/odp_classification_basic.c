@@ -9,6 +9,8 @@
 #include "classification.h"
 
 #define PMR_SET_NUM	5
+#define HASH_QUEUES_MAX	64
+#define PMR_UPDATE_ROUNDS	1000
 
 static void classification_test_create_cos(void)
 {
@@ -137,6 +139,78 @@ static void classification_test_create_pmr_match(void)
 	odp_pktio_close(pktio);
 }
 
+static void classification_test_pmr_update(void)
+{
+	odp_pmr_t pmr[PMR_SET_NUM];
+	uint16_t val;
+	uint16_t mask;
+	int i, round;
+	odp_pmr_param_t pmr_param;
+	odp_cos_t default_cos;
+	odp_cos_t cos;
+	odp_queue_t default_queue;
+	odp_queue_t queue;
+	odp_pool_t default_pool;
+	odp_pool_t pool;
+	odp_pool_t pkt_pool;
+	odp_cls_cos_param_t cls_param;
+	odp_pktio_t pktio;
+
+	pkt_pool = pool_create("pkt_pool");
+	CU_ASSERT_FATAL(pkt_pool != ODP_POOL_INVALID);
+
+	pktio = create_pktio(ODP_QUEUE_TYPE_SCHED, pkt_pool, true);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+
+	configure_default_cos(pktio, &default_cos,
+			      &default_queue, &default_pool);
+
+	queue = queue_create("pmr_update", true);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	pool = pool_create("pmr_update");
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.queue = queue;
+	cls_param.drop_policy = ODP_COS_DROP_POOL;
+
+	cos = odp_cls_cos_create("pmr_update", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+
+	mask = 0xffff;
+	odp_cls_pmr_param_init(&pmr_param);
+	pmr_param.term = find_first_supported_l3_pmr();
+	pmr_param.range_term = false;
+	pmr_param.match.value = &val;
+	pmr_param.match.mask = &mask;
+	pmr_param.val_sz = sizeof(val);
+
+	/* Replace rules repeatedly. Resources of removed rules must be
+	 * reclaimed for new rules. */
+	for (round = 0; round < PMR_UPDATE_ROUNDS; round++) {
+		for (i = 0; i < PMR_SET_NUM; i++) {
+			val = 1024 + i;
+			pmr[i] = odp_cls_pmr_create(&pmr_param, 1, default_cos,
+						    cos);
+			CU_ASSERT_FATAL(pmr[i] != ODP_PMR_INVALID);
+		}
+
+		for (i = 0; i < PMR_SET_NUM; i++)
+			CU_ASSERT(odp_cls_pmr_destroy(pmr[i]) == 0);
+	}
+
+	odp_cos_destroy(cos);
+	odp_queue_destroy(queue);
+	odp_pool_destroy(pool);
+	odp_pool_destroy(pkt_pool);
+	odp_queue_destroy(default_queue);
+	odp_pool_destroy(default_pool);
+	odp_cos_destroy(default_cos);
+	odp_pktio_close(pktio);
+}
+
 static void classification_test_cos_set_queue(void)
 {
 	int retval;
@@ -180,6 +254,48 @@ static void classification_test_cos_set_queue(void)
 	odp_pool_destroy(pool);
 }
 
+static void classification_test_cos_hash_queues(void)
+{
+	odp_cls_capability_t capa;
+	odp_cls_cos_param_t cls_param;
+	odp_pool_t pool;
+	odp_cos_t cos;
+	odp_queue_t queue[HASH_QUEUES_MAX];
+	uint32_t num_queue, i, j;
+
+	CU_ASSERT_FATAL(odp_cls_capability(&capa) == 0);
+	if (capa.max_hash_queues < 2)
+		return;
+
+	num_queue = capa.max_hash_queues;
+	if (num_queue > HASH_QUEUES_MAX)
+		num_queue = HASH_QUEUES_MAX;
+
+	pool = pool_create("cls_basic_pool");
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.num_queue = num_queue;
+	cls_param.hash_proto.proto.ipv4_udp = 1;
+	cls_param.drop_policy = ODP_COS_DROP_POOL;
+
+	cos = odp_cls_cos_create("CoSHashQueues", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+
+	CU_ASSERT(odp_cls_cos_num_queue(cos) == num_queue);
+	CU_ASSERT(odp_cls_cos_queues(cos, queue, num_queue) == num_queue);
+
+	for (i = 0; i < num_queue; i++) {
+		CU_ASSERT(queue[i] != ODP_QUEUE_INVALID);
+		for (j = i + 1; j < num_queue; j++)
+			CU_ASSERT(queue[i] != queue[j]);
+	}
+
+	CU_ASSERT(odp_cos_destroy(cos) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 static void classification_test_cos_set_pool(void)
 {
 	int retval;
@@ -326,7 +442,9 @@ odp_testinfo_t classification_suite_basic[] = {
 	ODP_TEST_INFO(classification_test_create_cos),
 	ODP_TEST_INFO(classification_test_destroy_cos),
 	ODP_TEST_INFO(classification_test_create_pmr_match),
+	ODP_TEST_INFO(classification_test_pmr_update),
 	ODP_TEST_INFO(classification_test_cos_set_queue),
+	ODP_TEST_INFO(classification_test_cos_hash_queues),
 	ODP_TEST_INFO(classification_test_cos_set_drop),
 	ODP_TEST_INFO(classification_test_cos_set_pool),
 	ODP_TEST_INFO(classification_test_pmr_composite_create),
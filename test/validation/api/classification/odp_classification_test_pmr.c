@@ -16,6 +16,31 @@ static odp_atomic_u32_t seq;
 static cls_packet_info_t default_pkt_info;
 static odp_cls_capability_t cls_capa;
 
+#define PMR_UPDATE_PKTS 1000
+
+/* VXLAN test packets */
+#define VXLAN_PORT      4789
+#define VXLAN_HDR_LEN   8
+#define VXLAN_FLAG_VNI  0x08000000
+#define VXLAN_VNI       0x123456
+#define VXLAN_INNER_LEN (VXLAN_HDR_LEN + ODPH_ETHHDR_LEN + \
+			 ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN)
+#define INNER_DPORT     5000
+
+/* CoS hash queue test */
+#define HASH_NUM_QUEUES 8
+#define HASH_NUM_FLOWS  32
+#define HASH_FLOW_PKTS  16
+
+
+/* PMR update thread state */
+static struct {
+	odp_cos_t src_cos;
+	odp_cos_t dst_cos;
+	odp_atomic_u32_t stop;
+	odp_atomic_u32_t rounds;
+} pmr_update;
+
 int classification_suite_pmr_init(void)
 {
 	memset(&cls_capa, 0, sizeof(odp_cls_capability_t));
@@ -386,6 +411,9 @@ static void classification_test_pmr_term_tcp_sport(void)
 	odp_cls_cos_param_t cls_param;
 	odp_pmr_param_t pmr_param;
 	odph_ethhdr_t *eth;
+	odp_cls_cos_stats_t cos_stats;
+	odp_cls_pmr_stats_t pmr_stats;
+	uint32_t pkt_len;
 
 	val  = odp_cpu_to_be_16(CLS_DEFAULT_SPORT);
 	mask = odp_cpu_to_be_16(0xffff);
@@ -433,6 +461,7 @@ static void classification_test_pmr_term_tcp_sport(void)
 
 	tcp = (odph_tcphdr_t *)odp_packet_l4_ptr(pkt, NULL);
 	tcp->src_port = val;
+	pkt_len = odp_packet_len(pkt);
 
 	enqueue_pktio_interface(pkt, pktio);
 
@@ -444,6 +473,13 @@ static void classification_test_pmr_term_tcp_sport(void)
 	CU_ASSERT(recvpool == pool);
 	odp_packet_free(pkt);
 
+	CU_ASSERT(odp_cls_pmr_stats(pmr, &pmr_stats) == 0);
+	CU_ASSERT(pmr_stats.hits == 1);
+	CU_ASSERT(odp_cls_cos_stats(cos, &cos_stats) == 0);
+	CU_ASSERT(cos_stats.packets == 1);
+	CU_ASSERT(cos_stats.octets == pkt_len);
+	CU_ASSERT(cos_stats.discards == 0);
+
 	pkt = create_packet(default_pkt_info);
 	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
 	seqno = cls_pkt_get_seq(pkt);
@@ -464,6 +500,12 @@ static void classification_test_pmr_term_tcp_sport(void)
 	recvpool = odp_packet_pool(pkt);
 	CU_ASSERT(recvpool == default_pool);
 
+	CU_ASSERT(odp_cls_pmr_stats(pmr, &pmr_stats) == 0);
+	CU_ASSERT(pmr_stats.hits == 1);
+	CU_ASSERT(odp_cls_cos_stats(default_cos, &cos_stats) == 0);
+	CU_ASSERT(cos_stats.packets == 1);
+	odp_cls_print_all();
+
 	odp_packet_free(pkt);
 	odp_cos_destroy(cos);
 	odp_cos_destroy(default_cos);
@@ -2382,6 +2424,486 @@ static void classification_test_pmr_term_custom_l3(void)
 	test_pmr_term_custom(1);
 }
 
+/* Create and destroy a two term PMR until stopped */
+static int pmr_update_worker(void *arg ODP_UNUSED)
+{
+	odp_pmr_param_t pmr_param[2];
+	odp_pmr_t pmr;
+	uint16_t dport = odp_cpu_to_be_16(CLS_DEFAULT_DPORT);
+	uint16_t sport = odp_cpu_to_be_16(CLS_DEFAULT_SPORT);
+	uint16_t mask = 0xffff;
+
+	odp_cls_pmr_param_init(&pmr_param[0]);
+	pmr_param[0].term = ODP_PMR_UDP_DPORT;
+	pmr_param[0].match.value = &dport;
+	pmr_param[0].match.mask = &mask;
+	pmr_param[0].val_sz = sizeof(dport);
+
+	odp_cls_pmr_param_init(&pmr_param[1]);
+	pmr_param[1].term = ODP_PMR_UDP_SPORT;
+	pmr_param[1].match.value = &sport;
+	pmr_param[1].match.mask = &mask;
+	pmr_param[1].val_sz = sizeof(sport);
+
+	while (!odp_atomic_load_u32(&pmr_update.stop)) {
+		pmr = odp_cls_pmr_create(pmr_param, 2, pmr_update.src_cos,
+					 pmr_update.dst_cos);
+		CU_ASSERT(pmr != ODP_PMR_INVALID);
+		if (pmr == ODP_PMR_INVALID)
+			break;
+
+		CU_ASSERT(odp_cls_pmr_destroy(pmr) == 0);
+		odp_atomic_inc_u32(&pmr_update.rounds);
+	}
+
+	return CU_get_number_of_failures();
+}
+
+/* Classify packets while another thread creates and destroys a PMR. Each
+ * packet must be classified either with or without the PMR, never with a
+ * partially updated rule set. */
+static void classification_test_pmr_update_mt(void)
+{
+	odp_packet_t pkt;
+	odph_udphdr_t *udp;
+	odph_ethhdr_t *eth;
+	uint32_t seqno;
+	int retval, i, match;
+	int num_pmr_hits = 0;
+	odp_pktio_t pktio;
+	odp_pool_t pool;
+	odp_queue_t queue;
+	odp_queue_t retqueue;
+	odp_queue_t default_queue;
+	odp_cos_t default_cos;
+	odp_pool_t default_pool;
+	odp_cos_t cos;
+	odp_cls_cos_param_t cls_param;
+	cls_packet_info_t pkt_info;
+	pthrd_arg thrdarg;
+
+	pktio = create_pktio(ODP_QUEUE_TYPE_SCHED, pkt_pool, true);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+	retval = start_pktio(pktio);
+	CU_ASSERT(retval == 0);
+
+	configure_default_cos(pktio, &default_cos,
+			      &default_queue, &default_pool);
+
+	queue = queue_create("pmr_update_mt", true);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	pool = pool_create("pmr_update_mt");
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.queue = queue;
+	cls_param.drop_policy = ODP_COS_DROP_POOL;
+
+	cos = odp_cls_cos_create("pmr_update_mt", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+
+	pmr_update.src_cos = default_cos;
+	pmr_update.dst_cos = cos;
+	odp_atomic_init_u32(&pmr_update.stop, 0);
+	odp_atomic_init_u32(&pmr_update.rounds, 0);
+
+	thrdarg.testcase = 0;
+	thrdarg.numthrds = 1;
+	CU_ASSERT_FATAL(odp_cunit_thread_create(pmr_update_worker,
+						&thrdarg) == 1);
+
+	pkt_info = default_pkt_info;
+	pkt_info.udp = true;
+
+	/* Every other packet matches only the first term of the PMR, and
+	 * must always be classified into the default CoS */
+	for (i = 0; i < PMR_UPDATE_PKTS; i++) {
+		match = !(i & 1);
+
+		pkt = create_packet(pkt_info);
+		CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+		seqno = cls_pkt_get_seq(pkt);
+		CU_ASSERT(seqno != TEST_SEQ_INVALID);
+		eth = (odph_ethhdr_t *)odp_packet_l2_ptr(pkt, NULL);
+		odp_pktio_mac_addr(pktio, eth->src.addr, ODPH_ETHADDR_LEN);
+		odp_pktio_mac_addr(pktio, eth->dst.addr, ODPH_ETHADDR_LEN);
+
+		udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, NULL);
+		udp->dst_port = odp_cpu_to_be_16(CLS_DEFAULT_DPORT);
+		udp->src_port = odp_cpu_to_be_16(CLS_DEFAULT_SPORT +
+						 (match ? 0 : 1));
+
+		enqueue_pktio_interface(pkt, pktio);
+
+		pkt = receive_packet(&retqueue, ODP_TIME_SEC_IN_NS);
+		CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+		CU_ASSERT(seqno == cls_pkt_get_seq(pkt));
+
+		if (match) {
+			CU_ASSERT(retqueue == queue ||
+				  retqueue == default_queue);
+			if (retqueue == queue) {
+				CU_ASSERT(odp_packet_pool(pkt) == pool);
+				num_pmr_hits++;
+			}
+		} else {
+			CU_ASSERT(retqueue == default_queue);
+		}
+
+		if (retqueue == default_queue)
+			CU_ASSERT(odp_packet_pool(pkt) == default_pool);
+
+		odp_packet_free(pkt);
+	}
+
+	odp_atomic_store_u32(&pmr_update.stop, 1);
+	CU_ASSERT(odp_cunit_thread_exit(&thrdarg) >= 0);
+	CU_ASSERT(odp_atomic_load_u32(&pmr_update.rounds) > 0);
+
+	printf("\n    PMR updates: %" PRIu32 ", packets matched: %i/%i\n",
+	       odp_atomic_load_u32(&pmr_update.rounds), num_pmr_hits,
+	       PMR_UPDATE_PKTS / 2);
+
+	odp_cos_destroy(cos);
+	odp_cos_destroy(default_cos);
+	stop_pktio(pktio);
+	odp_queue_destroy(queue);
+	odp_queue_destroy(default_queue);
+	odp_pool_destroy(default_pool);
+	odp_pool_destroy(pool);
+	odp_pktio_close(pktio);
+}
+
+static int check_capa_pmr_update_mt(void)
+{
+	return cls_capa.supported_terms.bit.udp_dport &&
+	       cls_capa.supported_terms.bit.udp_sport &&
+	       cls_capa.max_pmr_terms >= 2;
+}
+
+/* Create an IPv4/UDP/VXLAN packet carrying an Ethernet/IPv4/UDP packet */
+static odp_packet_t create_vxlan_packet(odp_pktio_t pktio, uint32_t vni,
+					uint16_t inner_dport)
+{
+	odp_packet_t pkt;
+	cls_packet_info_t pkt_info;
+	odph_ethhdr_t *eth;
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+	uint8_t *vxlan;
+	odp_u32be_t val;
+	uint32_t offset;
+
+	pkt_info = default_pkt_info;
+	pkt_info.udp = true;
+	pkt_info.len = VXLAN_INNER_LEN;
+	pkt = create_packet(pkt_info);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+	eth = (odph_ethhdr_t *)odp_packet_l2_ptr(pkt, NULL);
+	odp_pktio_mac_addr(pktio, eth->src.addr, ODPH_ETHADDR_LEN);
+	odp_pktio_mac_addr(pktio, eth->dst.addr, ODPH_ETHADDR_LEN);
+
+	/* Outer UDP checksum is not used */
+	udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, NULL);
+	udp->dst_port = odp_cpu_to_be_16(VXLAN_PORT);
+	udp->chksum = 0;
+
+	offset = odp_packet_l4_offset(pkt) + ODPH_UDPHDR_LEN;
+	vxlan = (uint8_t *)odp_packet_offset(pkt, offset, NULL, NULL);
+	CU_ASSERT_FATAL(vxlan != NULL);
+	memset(vxlan, 0, VXLAN_INNER_LEN);
+
+	val = odp_cpu_to_be_32(VXLAN_FLAG_VNI);
+	memcpy(vxlan, &val, sizeof(val));
+	val = odp_cpu_to_be_32(vni << 8);
+	memcpy(vxlan + 4, &val, sizeof(val));
+
+	eth = (odph_ethhdr_t *)(vxlan + VXLAN_HDR_LEN);
+	eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+
+	ip = (odph_ipv4hdr_t *)(eth + 1);
+	ip->ver_ihl = ODPH_IPV4 << 4 | ODPH_IPV4HDR_IHL_MIN;
+	ip->tot_len = odp_cpu_to_be_16(ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN);
+	ip->ttl = DEFAULT_TTL;
+	ip->proto = ODPH_IPPROTO_UDP;
+	ip->src_addr = odp_cpu_to_be_32(0x0a000001);
+	ip->dst_addr = odp_cpu_to_be_32(0x0a000002);
+
+	udp = (odph_udphdr_t *)(ip + 1);
+	udp->src_port = odp_cpu_to_be_16(CLS_DEFAULT_SPORT);
+	udp->dst_port = odp_cpu_to_be_16(inner_dport);
+	udp->length = odp_cpu_to_be_16(ODPH_UDPHDR_LEN);
+
+	return pkt;
+}
+
+static uint16_t pkt_ip_id(odp_packet_t pkt)
+{
+	odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)odp_packet_l3_ptr(pkt, NULL);
+
+	CU_ASSERT_FATAL(ip != NULL);
+	return odp_be_to_cpu_16(ip->id);
+}
+
+/* Send a packet and check that it is received from the expected queue */
+static void send_and_check(odp_pktio_t pktio, odp_packet_t pkt,
+			   odp_queue_t queue, odp_pool_t pool)
+{
+	odp_queue_t retqueue;
+	uint16_t ip_id = pkt_ip_id(pkt);
+
+	enqueue_pktio_interface(pkt, pktio);
+
+	pkt = receive_packet(&retqueue, ODP_TIME_SEC_IN_NS);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(pkt_ip_id(pkt) == ip_id);
+	CU_ASSERT(retqueue == queue);
+	CU_ASSERT(odp_packet_pool(pkt) == pool);
+	odp_packet_free(pkt);
+}
+
+/* Tunnel packet PMR test. Sends VXLAN packets, which match and do not match
+ * the PMR, and a plain UDP packet which has the same outer UDP destination
+ * port as the inner port of the matching packet. */
+static void test_pmr_tunnel(odp_cls_pmr_term_t term)
+{
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	odph_udphdr_t *udp;
+	uint32_t vni_val, vni_mask;
+	uint16_t port_val, port_mask;
+	int retval;
+	odp_pktio_t pktio;
+	odp_pool_t pool;
+	odp_queue_t queue;
+	odp_queue_t default_queue;
+	odp_cos_t default_cos;
+	odp_pool_t default_pool;
+	odp_pmr_t pmr;
+	odp_cos_t cos;
+	odp_pmr_param_t pmr_param;
+	odp_cls_cos_param_t cls_param;
+	cls_packet_info_t pkt_info;
+
+	pktio = create_pktio(ODP_QUEUE_TYPE_SCHED, pkt_pool, true);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+	retval = start_pktio(pktio);
+	CU_ASSERT(retval == 0);
+
+	configure_default_cos(pktio, &default_cos,
+			      &default_queue, &default_pool);
+
+	queue = queue_create("pmr_tunnel", true);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	pool = pool_create("pmr_tunnel");
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.queue = queue;
+	cls_param.drop_policy = ODP_COS_DROP_POOL;
+
+	cos = odp_cls_cos_create("pmr_tunnel", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+
+	odp_cls_pmr_param_init(&pmr_param);
+	pmr_param.term = term;
+
+	if (term == ODP_PMR_LD_VNI) {
+		vni_val = odp_cpu_to_be_32(VXLAN_VNI);
+		vni_mask = odp_cpu_to_be_32(0xffffff);
+		pmr_param.match.value = &vni_val;
+		pmr_param.match.mask = &vni_mask;
+		pmr_param.val_sz = sizeof(vni_val);
+	} else {
+		port_val = odp_cpu_to_be_16(INNER_DPORT);
+		port_mask = odp_cpu_to_be_16(0xffff);
+		pmr_param.match.value = &port_val;
+		pmr_param.match.mask = &port_mask;
+		pmr_param.val_sz = sizeof(port_val);
+	}
+
+	pmr = odp_cls_pmr_create(&pmr_param, 1, default_cos, cos);
+	CU_ASSERT_FATAL(pmr != ODP_PMR_INVALID);
+
+	pkt = create_vxlan_packet(pktio, VXLAN_VNI, INNER_DPORT);
+	send_and_check(pktio, pkt, queue, pool);
+
+	if (term == ODP_PMR_LD_VNI)
+		pkt = create_vxlan_packet(pktio, VXLAN_VNI + 1, INNER_DPORT);
+	else
+		pkt = create_vxlan_packet(pktio, VXLAN_VNI, INNER_DPORT + 1);
+	send_and_check(pktio, pkt, default_queue, default_pool);
+
+	/* Outer header must not match inner header terms */
+	pkt_info = default_pkt_info;
+	pkt_info.udp = true;
+	pkt = create_packet(pkt_info);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, NULL);
+	udp->dst_port = odp_cpu_to_be_16(INNER_DPORT);
+	udp->chksum = 0;
+	eth = (odph_ethhdr_t *)odp_packet_l2_ptr(pkt, NULL);
+	odp_pktio_mac_addr(pktio, eth->src.addr, ODPH_ETHADDR_LEN);
+	odp_pktio_mac_addr(pktio, eth->dst.addr, ODPH_ETHADDR_LEN);
+	send_and_check(pktio, pkt, default_queue, default_pool);
+
+	odp_cos_destroy(cos);
+	odp_cos_destroy(default_cos);
+	odp_cls_pmr_destroy(pmr);
+	stop_pktio(pktio);
+	odp_queue_destroy(queue);
+	odp_queue_destroy(default_queue);
+	odp_pool_destroy(default_pool);
+	odp_pool_destroy(pool);
+	odp_pktio_close(pktio);
+}
+
+static void classification_test_pmr_term_ld_vni(void)
+{
+	test_pmr_tunnel(ODP_PMR_LD_VNI);
+}
+
+static void classification_test_pmr_term_inner_udp_dport(void)
+{
+	test_pmr_tunnel(ODP_PMR_INNER_HDR_OFF + ODP_PMR_UDP_DPORT);
+}
+
+/* Send 'flow_pkts' packets of 'num_flows' UDP flows to a CoS with hash
+ * queues. All packets of a flow must be delivered to the same queue, also
+ * when the classifier reuses a flow hash calculated on packet input (e.g.
+ * NIC RSS hash). Returns the number of queues that received packets. */
+static uint32_t test_cos_hash(uint32_t num_flows, uint32_t flow_pkts,
+			      uint32_t *num_queue_out)
+{
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	odph_udphdr_t *udp;
+	odp_pktio_t pktio;
+	odp_pool_t pool;
+	odp_cos_t cos;
+	odp_queue_t retqueue;
+	odp_cls_cos_param_t cls_param;
+	cls_packet_info_t pkt_info;
+	odp_queue_t queue[HASH_NUM_QUEUES];
+	int flow_queue[HASH_NUM_FLOWS];
+	uint32_t queue_flows[HASH_NUM_QUEUES];
+	uint32_t num_queue, num_used, i, j, flow;
+	int q;
+
+	CU_ASSERT_FATAL(num_flows <= HASH_NUM_FLOWS);
+
+	num_queue = HASH_NUM_QUEUES;
+	if (cls_capa.max_hash_queues < num_queue)
+		num_queue = cls_capa.max_hash_queues;
+
+	pktio = create_pktio(ODP_QUEUE_TYPE_SCHED, pkt_pool, true);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+	CU_ASSERT(start_pktio(pktio) == 0);
+
+	pool = pool_create("hash_pool");
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_cls_cos_param_init(&cls_param);
+	cls_param.pool = pool;
+	cls_param.num_queue = num_queue;
+	cls_param.hash_proto.proto.ipv4_udp = 1;
+	cls_param.drop_policy = ODP_COS_DROP_POOL;
+	cls_param.queue_param.type = ODP_QUEUE_TYPE_SCHED;
+	cls_param.queue_param.sched.prio = odp_schedule_max_prio();
+	cls_param.queue_param.sched.sync = ODP_SCHED_SYNC_PARALLEL;
+	cls_param.queue_param.sched.group = ODP_SCHED_GROUP_ALL;
+
+	cos = odp_cls_cos_create("hash_cos", &cls_param);
+	CU_ASSERT_FATAL(cos != ODP_COS_INVALID);
+	CU_ASSERT_FATAL(odp_cls_cos_queues(cos, queue, num_queue) ==
+			num_queue);
+	CU_ASSERT_FATAL(odp_pktio_default_cos_set(pktio, cos) == 0);
+
+	for (i = 0; i < num_flows; i++)
+		flow_queue[i] = -1;
+
+	memset(queue_flows, 0, sizeof(queue_flows));
+	pkt_info = default_pkt_info;
+	pkt_info.udp = true;
+
+	for (i = 0; i < flow_pkts; i++) {
+		for (flow = 0; flow < num_flows; flow++) {
+			pkt = create_packet(pkt_info);
+			CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+			eth = (odph_ethhdr_t *)odp_packet_l2_ptr(pkt, NULL);
+			odp_pktio_mac_addr(pktio, eth->src.addr,
+					   ODPH_ETHADDR_LEN);
+			odp_pktio_mac_addr(pktio, eth->dst.addr,
+					   ODPH_ETHADDR_LEN);
+			udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, NULL);
+			udp->src_port = odp_cpu_to_be_16(CLS_DEFAULT_SPORT +
+							 flow);
+
+			enqueue_pktio_interface(pkt, pktio);
+
+			pkt = receive_packet(&retqueue, ODP_TIME_SEC_IN_NS);
+			CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+			CU_ASSERT(odp_packet_pool(pkt) == pool);
+
+			udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, NULL);
+			CU_ASSERT_FATAL(udp != NULL);
+			j = odp_be_to_cpu_16(udp->src_port) -
+			    CLS_DEFAULT_SPORT;
+			CU_ASSERT(j == flow);
+			odp_packet_free(pkt);
+
+			for (q = 0; q < (int)num_queue; q++)
+				if (queue[q] == retqueue)
+					break;
+			CU_ASSERT_FATAL(q < (int)num_queue);
+
+			if (flow_queue[flow] < 0) {
+				flow_queue[flow] = q;
+				queue_flows[q]++;
+			}
+			CU_ASSERT(flow_queue[flow] == q);
+		}
+	}
+
+	num_used = 0;
+	for (q = 0; q < (int)num_queue; q++)
+		if (queue_flows[q])
+			num_used++;
+
+	odp_cos_destroy(cos);
+	stop_pktio(pktio);
+	odp_pool_destroy(pool);
+	odp_pktio_close(pktio);
+
+	*num_queue_out = num_queue;
+	return num_used;
+}
+
+/* Packets of a flow stay on the same queue */
+static void classification_test_cos_hash_flow(void)
+{
+	uint32_t num_queue;
+
+	test_cos_hash(2, HASH_FLOW_PKTS, &num_queue);
+}
+
+/* With a reasonable hash function, flows are spread over most of the
+ * queues */
+static void classification_test_cos_hash_distribution(void)
+{
+	uint32_t num_used, num_queue;
+
+	num_used = test_cos_hash(HASH_NUM_FLOWS, 1, &num_queue);
+
+	CU_ASSERT(num_used > 1);
+	CU_ASSERT(num_used >= num_queue / 2);
+}
+
 static int check_capa_tcp_dport(void)
 {
 	return cls_capa.supported_terms.bit.tcp_dport;
@@ -2467,6 +2989,16 @@ static int check_capa_custom_l3(void)
 	return cls_capa.supported_terms.bit.custom_l3;
 }
 
+static int check_capa_ld_vni(void)
+{
+	return cls_capa.supported_terms.bit.ld_vni;
+}
+
+static int check_capa_hash_queues(void)
+{
+	return cls_capa.max_hash_queues >= 2;
+}
+
 static int check_capa_pmr_series(void)
 {
 	uint64_t support;
@@ -2520,5 +3052,15 @@ odp_testinfo_t classification_suite_pmr[] = {
 				  check_capa_pmr_series),
 	ODP_TEST_INFO(classification_test_pktin_classifier_flag),
 	ODP_TEST_INFO(classification_test_pmr_term_tcp_dport_multi),
+	ODP_TEST_INFO_CONDITIONAL(classification_test_pmr_update_mt,
+				  check_capa_pmr_update_mt),
+	ODP_TEST_INFO_CONDITIONAL(classification_test_pmr_term_ld_vni,
+				  check_capa_ld_vni),
+	ODP_TEST_INFO_CONDITIONAL(classification_test_pmr_term_inner_udp_dport,
+				  check_capa_udp_dport),
+	ODP_TEST_INFO_CONDITIONAL(classification_test_cos_hash_flow,
+				  check_capa_hash_queues),
+	ODP_TEST_INFO_CONDITIONAL(classification_test_cos_hash_distribution,
+				  check_capa_hash_queues),
 	ODP_TEST_INFO_NULL,
 };
@@ -1308,6 +1308,192 @@ static void crypto_test_dec_alg_aes_cbc_ovr_iv(void)
 		  false);
 }
 
+/* Number of packets per odp_crypto_op() call in burst tests */
+#define BURST_NUM 8
+
+static int check_alg_aes_cbc_burst(void)
+{
+	/* Bursts are tested only with the synchronous packet API */
+	if (!suite_context.packet || suite_context.op_mode != ODP_CRYPTO_SYNC)
+		return ODP_TEST_INACTIVE;
+
+	return check_alg_aes_cbc();
+}
+
+static odp_bool_t cipher_key_supported(odp_cipher_alg_t cipher_alg,
+				       crypto_test_reference_t *ref)
+{
+	int num = odp_crypto_cipher_capability(cipher_alg, NULL, 0);
+	int i;
+
+	CU_ASSERT_FATAL(num > 0);
+
+	odp_crypto_cipher_capability_t capa[num];
+
+	CU_ASSERT_FATAL(odp_crypto_cipher_capability(cipher_alg, capa,
+						     num) == num);
+
+	for (i = 0; i < num; i++) {
+		if (capa[i].key_len == ref->cipher_key_length &&
+		    capa[i].iv_len == ref->cipher_iv_length &&
+		    !capa[i].bit_mode)
+			return true;
+	}
+
+	return false;
+}
+
+static odp_crypto_session_t burst_session_create(odp_crypto_op_t op,
+						 odp_cipher_alg_t cipher_alg,
+						 crypto_test_reference_t *ref)
+{
+	odp_crypto_session_t session;
+	odp_crypto_ses_create_err_t status;
+	odp_crypto_session_param_t ses_params;
+
+	/* IV is given per operation */
+	odp_crypto_session_param_init(&ses_params);
+	ses_params.op = op;
+	ses_params.op_mode = ODP_CRYPTO_SYNC;
+	ses_params.cipher_alg = cipher_alg;
+	ses_params.auth_alg = ODP_AUTH_ALG_NULL;
+	ses_params.output_pool = suite_context.pool;
+	ses_params.cipher_key.data = ref->cipher_key;
+	ses_params.cipher_key.length = ref->cipher_key_length;
+	ses_params.cipher_iv.data = NULL;
+	ses_params.cipher_iv.length = ref->cipher_iv_length;
+
+	if (odp_crypto_session_create(&ses_params, &session, &status))
+		return ODP_CRYPTO_SESSION_INVALID;
+
+	return session;
+}
+
+/* Process packets of two reference vectors in a single odp_crypto_op()
+ * call. The first packets of the burst use the first vector and the rest
+ * the second one. Packet data starts at different offsets, so that
+ * implementations processing packets of a burst together see differently
+ * aligned buffers. */
+static void alg_test_burst(odp_crypto_op_t op,
+			   odp_cipher_alg_t cipher_alg,
+			   crypto_test_reference_t *ref0,
+			   crypto_test_reference_t *ref1)
+{
+	crypto_test_reference_t *ref[BURST_NUM];
+	odp_crypto_session_t session[2];
+	odp_crypto_packet_op_param_t param[BURST_NUM];
+	odp_crypto_packet_result_t result;
+	odp_packet_t pkt[BURST_NUM];
+	odp_packet_t out_pkt[BURST_NUM];
+	uint8_t *in, *out;
+	uint32_t offset;
+	int num_pkt = 0;
+	int i, num;
+
+	session[0] = burst_session_create(op, cipher_alg, ref0);
+	session[1] = burst_session_create(op, cipher_alg, ref1);
+	CU_ASSERT_FATAL(session[0] != ODP_CRYPTO_SESSION_INVALID);
+	CU_ASSERT_FATAL(session[1] != ODP_CRYPTO_SESSION_INVALID);
+
+	memset(param, 0, sizeof(param));
+
+	for (i = 0; i < BURST_NUM; i++) {
+		int first = i < (BURST_NUM / 2 + 1);
+
+		ref[i] = first ? ref0 : ref1;
+		in = op == ODP_CRYPTO_OP_ENCODE ? ref[i]->plaintext :
+						  ref[i]->ciphertext;
+		offset = i;
+
+		pkt[i] = odp_packet_alloc(suite_context.pool,
+					  offset + ref[i]->length);
+		CU_ASSERT(pkt[i] != ODP_PACKET_INVALID);
+		if (pkt[i] == ODP_PACKET_INVALID)
+			break;
+
+		CU_ASSERT(!odp_packet_copy_from_mem(pkt[i], offset,
+						    ref[i]->length, in));
+		out_pkt[i] = pkt[i];
+
+		param[i].session = first ? session[0] : session[1];
+		param[i].cipher_iv_ptr = ref[i]->cipher_iv;
+		param[i].cipher_range.offset = offset;
+		param[i].cipher_range.length = ref[i]->length;
+		param[i].hash_result_offset = offset + ref[i]->length;
+		num_pkt++;
+	}
+
+	num = 0;
+	while (num < num_pkt) {
+		int ret = odp_crypto_op(&pkt[num], &out_pkt[num], &param[num],
+					num_pkt - num);
+
+		CU_ASSERT(ret > 0);
+		if (ret <= 0)
+			break;
+		num += ret;
+	}
+
+	for (i = 0; i < num; i++) {
+		out = op == ODP_CRYPTO_OP_ENCODE ? ref[i]->ciphertext :
+						   ref[i]->plaintext;
+
+		CU_ASSERT(out_pkt[i] == pkt[i]);
+		CU_ASSERT(odp_crypto_result(&result, out_pkt[i]) == 0);
+		CU_ASSERT(result.ok);
+		CU_ASSERT(!packet_cmp_mem(out_pkt[i], i, out,
+					  ref[i]->length));
+	}
+
+	for (i = 0; i < num_pkt; i++)
+		odp_packet_free(i < num ? out_pkt[i] : pkt[i]);
+
+	CU_ASSERT(!odp_crypto_session_destroy(session[0]));
+	CU_ASSERT(!odp_crypto_session_destroy(session[1]));
+}
+
+static void check_alg_burst(odp_crypto_op_t op,
+			    odp_cipher_alg_t cipher_alg,
+			    crypto_test_reference_t *ref,
+			    size_t count)
+{
+	size_t idx, next;
+	int tested = 0;
+
+	for (idx = 0; idx < count; idx++) {
+		next = (idx + 1) % count;
+
+		if (!cipher_key_supported(cipher_alg, &ref[idx]) ||
+		    !cipher_key_supported(cipher_alg, &ref[next]))
+			continue;
+
+		alg_test_burst(op, cipher_alg, &ref[idx], &ref[next]);
+		tested++;
+	}
+
+	CU_ASSERT(tested > 0);
+}
+
+/* This test verifies encode operation for AES_CBC algorithm when multiple
+ * packets are passed to a single odp_crypto_op() call */
+static void crypto_test_enc_alg_aes_cbc_burst(void)
+{
+	check_alg_burst(ODP_CRYPTO_OP_ENCODE,
+			ODP_CIPHER_ALG_AES_CBC,
+			aes_cbc_reference,
+			ARRAY_SIZE(aes_cbc_reference));
+}
+
+/* This test verifies decode operation for AES_CBC algorithm when multiple
+ * packets are passed to a single odp_crypto_op() call */
+static void crypto_test_dec_alg_aes_cbc_burst(void)
+{
+	check_alg_burst(ODP_CRYPTO_OP_DECODE,
+			ODP_CIPHER_ALG_AES_CBC,
+			aes_cbc_reference,
+			ARRAY_SIZE(aes_cbc_reference));
+}
+
 static int check_alg_aes_ctr(void)
 {
 	return check_alg_support(ODP_CIPHER_ALG_AES_CTR, ODP_AUTH_ALG_NULL);
@@ -2482,6 +2668,10 @@ odp_testinfo_t crypto_suite[] = {
 				  check_alg_aes_cbc),
 	ODP_TEST_INFO_CONDITIONAL(crypto_test_dec_alg_aes_cbc_ovr_iv,
 				  check_alg_aes_cbc),
+	ODP_TEST_INFO_CONDITIONAL(crypto_test_enc_alg_aes_cbc_burst,
+				  check_alg_aes_cbc_burst),
+	ODP_TEST_INFO_CONDITIONAL(crypto_test_dec_alg_aes_cbc_burst,
+				  check_alg_aes_cbc_burst),
 	ODP_TEST_INFO_CONDITIONAL(crypto_test_enc_alg_aes_ctr,
 				  check_alg_aes_ctr),
 	ODP_TEST_INFO_CONDITIONAL(crypto_test_dec_alg_aes_ctr,
@@ -637,9 +637,9 @@ static int ipsec_send_in_one(const ipsec_test_part *part,
 	return num_out;
 }
 
-static int ipsec_send_out_one(const ipsec_test_part *part,
-			      odp_ipsec_sa_t sa,
-			      odp_packet_t *pkto)
+int ipsec_send_out_one(const ipsec_test_part *part,
+		       odp_ipsec_sa_t sa,
+		       odp_packet_t *pkto)
 {
 	odp_ipsec_out_param_t param;
 	int num_out = part->out_pkt;
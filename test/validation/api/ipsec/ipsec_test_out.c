@@ -4,6 +4,8 @@
  * SPDX-License-Identifier:     BSD-3-Clause
  */
 
+#include <odp/helper/odph_api.h>
+
 #include "ipsec.h"
 
 #include "test_vectors.h"
@@ -157,6 +159,78 @@ static void test_out_ipv4_esp_null_sha256(void)
 	ipsec_sa_destroy(sa);
 }
 
+#define MANY_SA_NUM        130
+#define MANY_SA_ROUNDS     10
+#define MANY_SA_SOFT_LIMIT 200
+
+/*
+ * Packets of many SAs are processed in turns. Sequence numbers of each SA
+ * must not have gaps, and life time counters must not run ahead of the
+ * number of processed packets.
+ */
+static void test_out_ipv4_esp_null_sha256_many_sa(void)
+{
+	odp_ipsec_capability_t capa;
+	odp_ipsec_sa_param_t param;
+	odp_ipsec_sa_t sa[MANY_SA_NUM];
+	uint32_t num_sa, i, round;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+
+	num_sa = MANY_SA_NUM;
+	if (num_sa > capa.max_num_sa)
+		num_sa = capa.max_num_sa;
+
+	for (i = 0; i < num_sa; i++) {
+		ipsec_sa_param_fill(&param,
+				    false, false, 123 + i, NULL,
+				    ODP_CIPHER_ALG_NULL, NULL,
+				    ODP_AUTH_ALG_SHA256_HMAC, &key_5a_256,
+				    NULL, NULL);
+		param.lifetime.soft_limit.packets = MANY_SA_SOFT_LIMIT;
+
+		sa[i] = odp_ipsec_sa_create(&param);
+
+		CU_ASSERT_NOT_EQUAL_FATAL(ODP_IPSEC_SA_INVALID, sa[i]);
+	}
+
+	ipsec_test_part test = {
+		.pkt_in = &pkt_ipv4_icmp_0,
+		.out_pkt = 1,
+	};
+
+	for (round = 1; round <= MANY_SA_ROUNDS; round++) {
+		for (i = 0; i < num_sa; i++) {
+			odp_ipsec_packet_result_t result;
+			odp_packet_t pkt;
+			odp_u32be_t seq;
+			/* Sequence number follows SPI in ESP header */
+			uint32_t seq_offset = pkt_ipv4_icmp_0.l4_offset + 4;
+
+			CU_ASSERT_FATAL(ipsec_send_out_one(&test, sa[i],
+							   &pkt) == 1);
+
+			CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, seq_offset,
+							       sizeof(seq),
+							       &seq) == 0);
+			CU_ASSERT_EQUAL(round, odp_be_to_cpu_32(seq));
+
+			if (ODP_EVENT_PACKET_IPSEC ==
+			    odp_event_subtype(odp_packet_to_event(pkt))) {
+				CU_ASSERT_EQUAL(0, odp_ipsec_result(&result,
+								    pkt));
+				CU_ASSERT_EQUAL(0, result.status.error.all);
+				CU_ASSERT_EQUAL(0, result.status.warn.all);
+			}
+
+			odp_packet_free(pkt);
+		}
+	}
+
+	for (i = 0; i < num_sa; i++)
+		ipsec_sa_destroy(sa[i]);
+}
+
 static void test_out_ipv4_esp_null_sha256_tun_ipv4(void)
 {
 	odp_ipsec_tunnel_param_t tunnel;
@@ -750,6 +824,235 @@ static void test_out_ipv4_esp_null_sha256_frag_check_2(void)
 	ipsec_sa_destroy(sa);
 }
 
+#define FRAG_MTU      100
+#define FRAG_MAX_PKTS 8
+#define FRAG_BUF_LEN  256
+
+static int ipsec_check_out_frag(odp_bool_t before)
+{
+	odp_ipsec_capability_t capa;
+
+	/* Tests call odp_ipsec_out() and odp_ipsec_in() directly */
+	if (suite_context.outbound_op_mode != ODP_IPSEC_OP_MODE_SYNC ||
+	    suite_context.inbound_op_mode != ODP_IPSEC_OP_MODE_SYNC)
+		return ODP_TEST_INACTIVE;
+
+	if (odp_ipsec_capability(&capa) < 0 ||
+	    (before && capa.frag_before == ODP_SUPPORT_NO) ||
+	    (!before && capa.frag_after == ODP_SUPPORT_NO))
+		return ODP_TEST_INACTIVE;
+
+	return ipsec_check_esp_null_sha256();
+}
+
+static int ipsec_check_out_frag_before(void)
+{
+	return ipsec_check_out_frag(true);
+}
+
+static int ipsec_check_out_frag_after(void)
+{
+	return ipsec_check_out_frag(false);
+}
+
+/*
+ * Check that IPv4 fragments are in order and have consistent headers, and
+ * copy their payload into 'buf'. Returns total payload length.
+ */
+static uint32_t ipv4_frag_payload(odp_packet_t pkt[], int num, uint8_t *buf)
+{
+	uint32_t total = 0;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		odph_ipv4hdr_t ip;
+		uint32_t l3 = odp_packet_l3_offset(pkt[i]);
+		uint32_t hdr_len, len, offset;
+		uint16_t frag;
+
+		CU_ASSERT_FATAL(l3 != ODP_PACKET_OFFSET_INVALID);
+		CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt[i], l3, sizeof(ip),
+						       &ip) == 0);
+
+		hdr_len = ODPH_IPV4HDR_IHL(ip.ver_ihl) * 4;
+		len = odp_be_to_cpu_16(ip.tot_len) - hdr_len;
+		frag = odp_be_to_cpu_16(ip.frag_offset);
+		offset = ODPH_IPV4HDR_FRAG_OFFSET(frag) * 8;
+
+		/* Fragments are output in order, all but the last one have
+		 * the more fragments flag set */
+		CU_ASSERT(offset == total);
+		CU_ASSERT(!ODPH_IPV4HDR_FLAGS_MORE_FRAGS(frag) ==
+			  (i == num - 1));
+		CU_ASSERT(odp_packet_len(pkt[i]) == l3 + hdr_len + len);
+		CU_ASSERT_FATAL(offset + len <= FRAG_BUF_LEN);
+
+		CU_ASSERT(odp_packet_copy_to_mem(pkt[i], l3 + hdr_len, len,
+						 buf + offset) == 0);
+		total = offset + len;
+	}
+
+	return total;
+}
+
+static void ipsec_out_frag_sa_param(odp_ipsec_sa_param_t *param,
+				    odp_bool_t in,
+				    odp_ipsec_tunnel_param_t *tunnel,
+				    uint32_t *src, uint32_t *dst)
+{
+	memset(tunnel, 0, sizeof(odp_ipsec_tunnel_param_t));
+	tunnel->type = ODP_IPSEC_TUNNEL_IPV4;
+	tunnel->ipv4.src_addr = src;
+	tunnel->ipv4.dst_addr = dst;
+	tunnel->ipv4.ttl = 64;
+
+	ipsec_sa_param_fill(param,
+			    in, false, 123, tunnel,
+			    ODP_CIPHER_ALG_NULL, NULL,
+			    ODP_AUTH_ALG_SHA256_HMAC, &key_5a_256,
+			    NULL, NULL);
+}
+
+/*
+ * Resulting ESP packet is fragmented. Reassembled fragment payload must
+ * match the reference output of the same SA without fragmentation.
+ */
+static void test_out_ipv4_esp_null_sha256_frag_after(void)
+{
+	const ipsec_test_packet *ref =
+		&pkt_ipv4_icmp_0_esp_tun_ipv4_null_sha256_1;
+	odp_ipsec_tunnel_param_t tunnel;
+	odp_ipsec_sa_param_t param;
+	odp_ipsec_out_param_t out_param;
+	odp_ipsec_packet_result_t result;
+	odp_ipsec_sa_t sa;
+	odp_packet_t pkt;
+	odp_packet_t pkto[FRAG_MAX_PKTS];
+	uint8_t buf[FRAG_BUF_LEN];
+	uint32_t src = IPV4ADDR(10, 0, 111, 2);
+	uint32_t dst = IPV4ADDR(10, 0, 222, 2);
+	uint32_t ref_hdr_len = ref->l3_offset + ODPH_IPV4HDR_LEN;
+	int num_out = FRAG_MAX_PKTS;
+	int i;
+
+	ipsec_out_frag_sa_param(&param, false, &tunnel, &src, &dst);
+	param.outbound.frag_mode = ODP_IPSEC_FRAG_AFTER;
+	param.outbound.mtu = FRAG_MTU;
+
+	sa = odp_ipsec_sa_create(&param);
+	CU_ASSERT_NOT_EQUAL_FATAL(ODP_IPSEC_SA_INVALID, sa);
+
+	memset(&out_param, 0, sizeof(out_param));
+	out_param.num_sa = 1;
+	out_param.sa = &sa;
+
+	pkt = ipsec_packet(&pkt_ipv4_icmp_0);
+	CU_ASSERT_EQUAL(1, odp_ipsec_out(&pkt, 1, pkto, &num_out,
+					 &out_param));
+	CU_ASSERT_FATAL(num_out > 1);
+
+	for (i = 0; i < num_out; i++) {
+		CU_ASSERT(odp_packet_len(pkto[i]) -
+			  odp_packet_l3_offset(pkto[i]) <= FRAG_MTU);
+		CU_ASSERT_EQUAL(0, odp_ipsec_result(&result, pkto[i]));
+		CU_ASSERT_EQUAL(0, result.status.error.all);
+		CU_ASSERT_EQUAL(sa, result.sa);
+	}
+
+	CU_ASSERT(ipv4_frag_payload(pkto, num_out, buf) ==
+		  ref->len - ref_hdr_len);
+	CU_ASSERT(!memcmp(buf, &ref->data[ref_hdr_len],
+			  ref->len - ref_hdr_len));
+
+	odp_packet_free_multi(pkto, num_out);
+
+	ipsec_sa_destroy(sa);
+}
+
+/*
+ * Inner packet is fragmented before encapsulation. Every output packet is a
+ * complete ESP packet that fits into the MTU. Decapsulated inner fragments
+ * must reassemble into the original packet payload.
+ */
+static void test_out_ipv4_esp_null_sha256_frag_before(void)
+{
+	const ipsec_test_packet *ref = &pkt_ipv4_icmp_0;
+	odp_ipsec_tunnel_param_t tunnel;
+	odp_ipsec_sa_param_t param;
+	odp_ipsec_out_param_t out_param;
+	odp_ipsec_in_param_t in_param;
+	odp_ipsec_packet_result_t result;
+	odp_ipsec_sa_t sa, sa_in;
+	odp_packet_t pkt;
+	odp_packet_t pkto[FRAG_MAX_PKTS];
+	odp_packet_t pkti[FRAG_MAX_PKTS];
+	uint8_t buf[FRAG_BUF_LEN];
+	uint32_t src = IPV4ADDR(10, 0, 111, 2);
+	uint32_t dst = IPV4ADDR(10, 0, 222, 2);
+	uint32_t ref_hdr_len = ref->l3_offset + ODPH_IPV4HDR_LEN;
+	int num_out = FRAG_MAX_PKTS;
+	int num_in;
+	int i;
+
+	ipsec_out_frag_sa_param(&param, false, &tunnel, &src, &dst);
+	param.outbound.frag_mode = ODP_IPSEC_FRAG_BEFORE;
+	param.outbound.mtu = FRAG_MTU;
+
+	sa = odp_ipsec_sa_create(&param);
+	CU_ASSERT_NOT_EQUAL_FATAL(ODP_IPSEC_SA_INVALID, sa);
+
+	ipsec_out_frag_sa_param(&param, true, &tunnel, &src, &dst);
+
+	sa_in = odp_ipsec_sa_create(&param);
+	CU_ASSERT_NOT_EQUAL_FATAL(ODP_IPSEC_SA_INVALID, sa_in);
+
+	memset(&out_param, 0, sizeof(out_param));
+	out_param.num_sa = 1;
+	out_param.sa = &sa;
+
+	pkt = ipsec_packet(ref);
+	CU_ASSERT_EQUAL(1, odp_ipsec_out(&pkt, 1, pkto, &num_out,
+					 &out_param));
+	CU_ASSERT_FATAL(num_out > 1);
+
+	memset(&in_param, 0, sizeof(in_param));
+	in_param.num_sa = 1;
+	in_param.sa = &sa_in;
+
+	for (i = 0; i < num_out; i++) {
+		odph_ipv4hdr_t ip;
+		uint32_t l3 = odp_packet_l3_offset(pkto[i]);
+		uint16_t frag;
+
+		/* Outer packets are not fragmented */
+		CU_ASSERT(odp_packet_len(pkto[i]) - l3 <= FRAG_MTU);
+		CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkto[i], l3, sizeof(ip),
+						       &ip) == 0);
+		frag = odp_be_to_cpu_16(ip.frag_offset);
+		CU_ASSERT(!ODPH_IPV4HDR_IS_FRAGMENT(frag));
+
+		CU_ASSERT_EQUAL(0, odp_ipsec_result(&result, pkto[i]));
+		CU_ASSERT_EQUAL(0, result.status.error.all);
+
+		num_in = 1;
+		CU_ASSERT_EQUAL(1, odp_ipsec_in(&pkto[i], 1, &pkti[i],
+						&num_in, &in_param));
+		CU_ASSERT_FATAL(num_in == 1);
+		CU_ASSERT_EQUAL(0, odp_ipsec_result(&result, pkti[i]));
+		CU_ASSERT_EQUAL(0, result.status.error.all);
+	}
+
+	CU_ASSERT(ipv4_frag_payload(pkti, num_out, buf) ==
+		  ref->len - ref_hdr_len);
+	CU_ASSERT(!memcmp(buf, &ref->data[ref_hdr_len],
+			  ref->len - ref_hdr_len));
+
+	odp_packet_free_multi(pkti, num_out);
+
+	ipsec_sa_destroy(sa_in);
+	ipsec_sa_destroy(sa);
+}
+
 static void test_out_ipv6_ah_sha256(void)
 {
 	odp_ipsec_sa_param_t param;
@@ -1200,6 +1503,8 @@ odp_testinfo_t ipsec_out_suite[] = {
 				  ipsec_check_ah_sha256),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256,
 				  ipsec_check_esp_null_sha256),
+	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_many_sa,
+				  ipsec_check_esp_null_sha256),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_tun_ipv4,
 				  ipsec_check_esp_null_sha256),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_tun_ipv6,
@@ -1228,6 +1533,10 @@ odp_testinfo_t ipsec_out_suite[] = {
 				  ipsec_check_esp_null_sha256),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_frag_check_2,
 				  ipsec_check_esp_null_sha256),
+	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_frag_after,
+				  ipsec_check_out_frag_after),
+	ODP_TEST_INFO_CONDITIONAL(test_out_ipv4_esp_null_sha256_frag_before,
+				  ipsec_check_out_frag_before),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv6_ah_sha256,
 				  ipsec_check_ah_sha256),
 	ODP_TEST_INFO_CONDITIONAL(test_out_ipv6_ah_sha256_tun_ipv4,
@@ -24,6 +24,10 @@ ODP_STATIC_ASSERT(PACKET_POOL_NUM_SEG > 1 &&
 /* Number of packets in parse test */
 #define PARSE_TEST_NUM_PKT 10
 
+/* Outer header offsets of tunnel parse test packets */
+#define PARSE_TEST_L3_OFFSET 14
+#define PARSE_TEST_L4_OFFSET (PARSE_TEST_L3_OFFSET + 20)
+
 static odp_pool_capability_t pool_capa;
 static odp_pool_param_t default_param;
 static odp_pool_t default_pool;
@@ -1218,6 +1222,37 @@ static void packet_test_error_flags(void)
 	CU_ASSERT(err == 0 || err == 1);
 }
 
+static void packet_test_lso_request(void)
+{
+	odp_packet_t pkt;
+	odp_packet_lso_opt_t lso_opt;
+
+	pkt = odp_packet_alloc(default_pool, packet_len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(!odp_packet_has_lso_request(pkt));
+
+	memset(&lso_opt, 0, sizeof(lso_opt));
+	CU_ASSERT(odp_packet_lso_request(pkt, &lso_opt) < 0);
+	CU_ASSERT(!odp_packet_has_lso_request(pkt));
+
+	lso_opt.payload_offset = 54;
+	lso_opt.max_payload_len = 1446;
+	CU_ASSERT(odp_packet_lso_request(pkt, &lso_opt) == 0);
+	CU_ASSERT(odp_packet_has_lso_request(pkt));
+
+	odp_packet_lso_request_clr(pkt);
+	CU_ASSERT(!odp_packet_has_lso_request(pkt));
+
+	CU_ASSERT(odp_packet_lso_request(pkt, &lso_opt) == 0);
+	odp_packet_free(pkt);
+
+	/* Request is reset on allocation */
+	pkt = odp_packet_alloc(default_pool, packet_len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(!odp_packet_has_lso_request(pkt));
+	odp_packet_free(pkt);
+}
+
 struct packet_metadata {
 	uint32_t l2_off;
 	uint32_t l3_off;
@@ -2755,6 +2790,8 @@ static void parse_eth_ipv4_udp(void)
 		CU_ASSERT(chksum_status == ODP_PACKET_CHKSUM_UNKNOWN);
 		chksum_status = odp_packet_l4_chksum_status(pkt[i]);
 		CU_ASSERT(chksum_status == ODP_PACKET_CHKSUM_UNKNOWN);
+		CU_ASSERT(odp_packet_reass_status(pkt[i]) ==
+			  ODP_PACKET_REASS_NONE);
 	}
 
 	parse.proto = ODP_PROTO_ETH;
@@ -3470,6 +3507,78 @@ static void parse_eth_ipv4_rr_nop_icmp(void)
 	odp_packet_free_multi(pkt, num_pkt);
 }
 
+/* Ethernet/IPv4/UDP/VXLAN/Ethernet/IPv4/UDP. Inner headers must not affect
+ * outer parse results. */
+static void parse_eth_ipv4_vxlan(void)
+{
+	odp_packet_parse_param_t parse;
+	int i;
+	int num_pkt = PARSE_TEST_NUM_PKT;
+	odp_packet_t pkt[num_pkt];
+
+	parse_test_alloc(pkt, test_packet_ipv4_vxlan_ipv4_udp,
+			 sizeof(test_packet_ipv4_vxlan_ipv4_udp), num_pkt);
+
+	parse.proto = ODP_PROTO_ETH;
+	parse.last_layer = ODP_PROTO_LAYER_ALL;
+	parse.chksums = parse_test.all_chksums;
+
+	CU_ASSERT(odp_packet_parse(pkt[0], 0, &parse) == 0);
+	CU_ASSERT(odp_packet_parse_multi(&pkt[1], parse_test.offset_zero,
+					 num_pkt - 1, &parse) == (num_pkt - 1));
+
+	for (i = 0; i < num_pkt; i++) {
+		CU_ASSERT(odp_packet_has_eth(pkt[i]));
+		CU_ASSERT(odp_packet_has_ipv4(pkt[i]));
+		CU_ASSERT(odp_packet_has_udp(pkt[i]));
+		CU_ASSERT(!odp_packet_has_ipv6(pkt[i]));
+		CU_ASSERT(!odp_packet_has_tcp(pkt[i]));
+		CU_ASSERT(!odp_packet_has_ipfrag(pkt[i]));
+		CU_ASSERT(!odp_packet_has_error(pkt[i]));
+		CU_ASSERT(odp_packet_l3_offset(pkt[i]) ==
+			  PARSE_TEST_L3_OFFSET);
+		CU_ASSERT(odp_packet_l4_offset(pkt[i]) ==
+			  PARSE_TEST_L4_OFFSET);
+		CU_ASSERT_EQUAL(odp_packet_l4_type(pkt[i]),
+				ODP_PROTO_L4_TYPE_UDP);
+	}
+
+	odp_packet_free_multi(pkt, num_pkt);
+}
+
+/* Ethernet/IPv4/NVGRE/Ethernet/IPv4/UDP */
+static void parse_eth_ipv4_nvgre(void)
+{
+	odp_packet_parse_param_t parse;
+	int i;
+	int num_pkt = PARSE_TEST_NUM_PKT;
+	odp_packet_t pkt[num_pkt];
+
+	parse_test_alloc(pkt, test_packet_ipv4_nvgre_ipv4_udp,
+			 sizeof(test_packet_ipv4_nvgre_ipv4_udp), num_pkt);
+
+	parse.proto = ODP_PROTO_ETH;
+	parse.last_layer = ODP_PROTO_LAYER_ALL;
+	parse.chksums = parse_test.all_chksums;
+
+	CU_ASSERT(odp_packet_parse(pkt[0], 0, &parse) == 0);
+	CU_ASSERT(odp_packet_parse_multi(&pkt[1], parse_test.offset_zero,
+					 num_pkt - 1, &parse) == (num_pkt - 1));
+
+	for (i = 0; i < num_pkt; i++) {
+		CU_ASSERT(odp_packet_has_eth(pkt[i]));
+		CU_ASSERT(odp_packet_has_ipv4(pkt[i]));
+		CU_ASSERT(!odp_packet_has_udp(pkt[i]));
+		CU_ASSERT(!odp_packet_has_tcp(pkt[i]));
+		CU_ASSERT(!odp_packet_has_ipv6(pkt[i]));
+		CU_ASSERT(!odp_packet_has_error(pkt[i]));
+		CU_ASSERT(odp_packet_l3_offset(pkt[i]) ==
+			  PARSE_TEST_L3_OFFSET);
+	}
+
+	odp_packet_free_multi(pkt, num_pkt);
+}
+
 static void parse_result(void)
 {
 	odp_packet_parse_param_t parse;
@@ -3598,6 +3707,7 @@ odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_segment_last),
 	ODP_TEST_INFO(packet_test_in_flags),
 	ODP_TEST_INFO(packet_test_error_flags),
+	ODP_TEST_INFO(packet_test_lso_request),
 	ODP_TEST_INFO(packet_test_add_rem_data),
 	ODP_TEST_INFO(packet_test_copy),
 	ODP_TEST_INFO(packet_test_copydata),
@@ -3638,6 +3748,8 @@ odp_testinfo_t packet_parse_suite[] = {
 	ODP_TEST_INFO(parse_eth_ipv4_udp_first_frag),
 	ODP_TEST_INFO(parse_eth_ipv4_udp_last_frag),
 	ODP_TEST_INFO(parse_eth_ipv4_rr_nop_icmp),
+	ODP_TEST_INFO(parse_eth_ipv4_vxlan),
+	ODP_TEST_INFO(parse_eth_ipv4_nvgre),
 	ODP_TEST_INFO(parse_result),
 	ODP_TEST_INFO_NULL,
 };
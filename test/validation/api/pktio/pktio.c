@@ -31,6 +31,34 @@
 #define PKTIN_TS_MAX_RES       10000000000
 #define PKTIN_TS_CMP_RES       1
 
+#define BP_ROUNDS              10
+#define BP_THR_HIGH            8
+#define BP_THR_LOW             2
+
+#define LSO_HDR_LEN            (ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + \
+				ODPH_TCPHDR_LEN)
+#define LSO_PAYLOAD_LEN        1000
+#define LSO_MAX_PAYLOAD        300
+#define LSO_NUM_SEGS           ((LSO_PAYLOAD_LEN + LSO_MAX_PAYLOAD - 1) / \
+				LSO_MAX_PAYLOAD)
+#define LSO_TCP_SEQ            0x12345678
+#define LSO_SRC_PORT           12051
+#define LSO_DST_PORT           12052
+
+#define IDLE_ROUNDS            4
+#define IDLE_NS                (20 * ODP_TIME_MSEC_IN_NS)
+
+#define GRO_NUM_SEGS           4
+#define GRO_SEG_LEN            200
+#define GRO_TCP_SEQ            0x87654321
+#define GRO_SRC_PORT           12053
+#define GRO_DST_PORT           12054
+#define GRO_WAIT_NS            (10 * ODP_TIME_MSEC_IN_NS)
+
+#define REASS_PKT_LEN          400
+#define REASS_NUM_FRAGS        3
+#define REASS_TMO_NS           (10 * ODP_TIME_MSEC_IN_NS)
+
 #define PKTIO_SRC_MAC		{1, 2, 3, 4, 5, 6}
 #define PKTIO_DST_MAC		{6, 5, 4, 3, 2, 1}
 #undef DEBUG_STATS
@@ -996,6 +1024,59 @@ static void pktio_test_sched_multi(void)
 	test_txrx(ODP_PKTIN_MODE_SCHED, 1, TXRX_MODE_MULTI);
 }
 
+/* Packets sent after an idle period, with burst sizes both larger and
+ * smaller than the previous burst, must all be received. Only reception is
+ * verified, since scheduler polling and burst sizes are not visible
+ * through the API. */
+static void pktio_test_sched_idle(void)
+{
+	pktio_info_t pktios[MAX_NUM_IFACES];
+	pktio_info_t *io;
+	odp_event_t ev;
+	odp_time_t end;
+	int num_pkts[IDLE_ROUNDS] = {PKT_BUF_NUM / 2, 1, TX_BATCH_LEN,
+				     PKT_BUF_NUM / 2};
+	int i, if_b;
+
+	for (i = 0; i < num_ifaces; ++i) {
+		io = &pktios[i];
+
+		io->name      = iface_name[i];
+		io->id        = create_pktio(i, ODP_PKTIN_MODE_SCHED,
+					     ODP_PKTOUT_MODE_DIRECT);
+		io->queue_out = ODP_QUEUE_INVALID;
+		io->inq       = ODP_QUEUE_INVALID;
+		io->in_mode   = ODP_PKTIN_MODE_SCHED;
+		CU_ASSERT_FATAL(odp_pktout_queue(io->id, &io->pktout, 1) == 1);
+		CU_ASSERT_FATAL(odp_pktio_start(io->id) == 0);
+
+		_pktio_wait_linkup(io->id);
+	}
+
+	if_b = (num_ifaces == 1) ? 0 : 1;
+
+	for (i = 0; i < IDLE_ROUNDS; i++) {
+		/* Schedule on an idle interface */
+		end = odp_time_sum(odp_time_local(),
+				   odp_time_local_from_ns(IDLE_NS));
+
+		while (odp_time_cmp(end, odp_time_local()) > 0) {
+			ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+			if (ev != ODP_EVENT_INVALID)
+				odp_event_free(ev);
+		}
+
+		pktio_txrx_multi(&pktios[0], &pktios[if_b], num_pkts[i],
+				 TXRX_MODE_MULTI);
+	}
+
+	for (i = 0; i < num_ifaces; ++i) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktios[i].id) == 0);
+		flush_input_queue(pktios[i].id, ODP_PKTIN_MODE_SCHED);
+		CU_ASSERT(odp_pktio_close(pktios[i].id) == 0);
+	}
+}
+
 static void pktio_test_sched_multi_event(void)
 {
 	test_txrx(ODP_PKTIN_MODE_SCHED, 1, TXRX_MODE_MULTI_EVENT);
@@ -1557,6 +1638,24 @@ static void pktio_test_pktin_queue_config_direct(void)
 	queue_param.num_queues = capa.max_input_queues + 1;
 	CU_ASSERT(odp_pktin_queue_config(pktio, &queue_param) < 0);
 
+	CU_ASSERT(capa.min_input_queue_size <= capa.max_input_queue_size);
+	queue_param.num_queues = 1;
+	if (capa.max_input_queue_size) {
+		queue_param.queue_size[0] = capa.max_input_queue_size;
+		CU_ASSERT(odp_pktin_queue_config(pktio, &queue_param) == 0);
+		queue_param.queue_size[0] = capa.min_input_queue_size;
+		CU_ASSERT(odp_pktin_queue_config(pktio, &queue_param) == 0);
+		if (capa.max_input_queue_size < UINT32_MAX) {
+			queue_param.queue_size[0] =
+				capa.max_input_queue_size + 1;
+			CU_ASSERT(odp_pktin_queue_config(pktio,
+							 &queue_param) < 0);
+		}
+	} else {
+		queue_param.queue_size[0] = 1;
+		CU_ASSERT(odp_pktin_queue_config(pktio, &queue_param) < 0);
+	}
+
 	CU_ASSERT_FATAL(odp_pktio_close(pktio) == 0);
 }
 
@@ -1703,6 +1802,24 @@ static void pktio_test_pktout_queue_config(void)
 	queue_param.num_queues = capa.max_output_queues + 1;
 	CU_ASSERT(odp_pktout_queue_config(pktio, &queue_param) < 0);
 
+	CU_ASSERT(capa.min_output_queue_size <= capa.max_output_queue_size);
+	queue_param.num_queues = 1;
+	if (capa.max_output_queue_size) {
+		queue_param.queue_size[0] = capa.max_output_queue_size;
+		CU_ASSERT(odp_pktout_queue_config(pktio, &queue_param) == 0);
+		queue_param.queue_size[0] = capa.min_output_queue_size;
+		CU_ASSERT(odp_pktout_queue_config(pktio, &queue_param) == 0);
+		if (capa.max_output_queue_size < UINT32_MAX) {
+			queue_param.queue_size[0] =
+				capa.max_output_queue_size + 1;
+			CU_ASSERT(odp_pktout_queue_config(pktio,
+							  &queue_param) < 0);
+		}
+	} else {
+		queue_param.queue_size[0] = 1;
+		CU_ASSERT(odp_pktout_queue_config(pktio, &queue_param) < 0);
+	}
+
 	CU_ASSERT(odp_pktio_close(pktio) == 0);
 }
 
@@ -1863,6 +1980,269 @@ static void pktio_test_statistics_counters(void)
 	}
 }
 
+static int pktio_check_queue_statistics_counters(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || (capa.stats.pktin_queue.all_counters == 0 &&
+			capa.stats.pktout_queue.all_counters == 0))
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static void pktio_test_queue_statistics_counters(void)
+{
+	odp_pktio_t pktio_rx, pktio_tx;
+	odp_pktio_t pktio[MAX_NUM_IFACES] = {
+		ODP_PKTIO_INVALID, ODP_PKTIO_INVALID
+	};
+	odp_packet_t pkt;
+	odp_packet_t tx_pkt[100];
+	uint32_t pkt_seq[100];
+	int i, pkts, tx_pkts, ret, alloc;
+	odp_pktin_queue_t pktin;
+	odp_pktout_queue_t pktout;
+	odp_pktin_queue_stats_t in_stats;
+	odp_pktout_queue_stats_t out_stats;
+	odp_pktio_capability_t rx_capa, tx_capa;
+	uint64_t wait = odp_pktin_wait_time(ODP_TIME_MSEC_IN_NS);
+
+	for (i = 0; i < num_ifaces; i++) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+	}
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	CU_ASSERT_FATAL(odp_pktio_capability(pktio_tx, &tx_capa) == 0);
+	CU_ASSERT_FATAL(odp_pktio_capability(pktio_rx, &rx_capa) == 0);
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin, 1) == 1);
+
+	for (i = 0; i < num_ifaces; i++)
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+
+	alloc = create_packets(tx_pkt, pkt_seq, 100, pktio_tx, pktio_rx);
+
+	for (i = 0; i < num_ifaces; i++)
+		CU_ASSERT(odp_pktio_stats_reset(pktio[i]) == 0);
+
+	/* send */
+	for (pkts = 0; pkts != alloc; ) {
+		ret = odp_pktout_send(pktout, &tx_pkt[pkts], alloc - pkts);
+		if (ret < 0) {
+			CU_FAIL("unable to send packet\n");
+			break;
+		}
+		pkts += ret;
+	}
+	tx_pkts = pkts;
+
+	/* get */
+	for (i = 0, pkts = 0; i < 1000 && pkts != tx_pkts; i++) {
+		ret = odp_pktin_recv_tmo(pktin, &pkt, 1, wait);
+		if (ret == 1) {
+			if (pktio_pkt_seq(pkt) != TEST_SEQ_INVALID)
+				pkts++;
+			odp_packet_free(pkt);
+		}
+	}
+
+	CU_ASSERT(pkts == tx_pkts);
+
+	CU_ASSERT(odp_pktin_queue_stats(pktin, &in_stats) == 0);
+	if (rx_capa.stats.pktin_queue.counter.packets)
+		CU_ASSERT(in_stats.packets >= (uint64_t)pkts);
+	if (rx_capa.stats.pktin_queue.counter.octets)
+		CU_ASSERT(in_stats.octets >= PKT_LEN_NORMAL * (uint64_t)pkts);
+	CU_ASSERT(in_stats.discards == 0);
+	CU_ASSERT(in_stats.errors == 0);
+
+	CU_ASSERT(odp_pktout_queue_stats(pktout, &out_stats) == 0);
+	if (tx_capa.stats.pktout_queue.counter.packets)
+		CU_ASSERT(out_stats.packets >= (uint64_t)pkts);
+	if (tx_capa.stats.pktout_queue.counter.octets)
+		CU_ASSERT(out_stats.octets >= PKT_LEN_NORMAL * (uint64_t)pkts);
+	CU_ASSERT(out_stats.discards == 0);
+	CU_ASSERT(out_stats.errors == 0);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT(odp_pktio_stop(pktio[i]) == 0);
+		flush_input_queue(pktio[i], ODP_PKTIN_MODE_DIRECT);
+		CU_ASSERT(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static void pktio_test_extra_stats(void)
+{
+	odp_pktio_t pktio;
+	int num_info, num_stats, i;
+
+	pktio = create_pktio(0, ODP_PKTIN_MODE_DIRECT,
+			     ODP_PKTOUT_MODE_DIRECT);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+	CU_ASSERT_FATAL(odp_pktio_start(pktio) == 0);
+
+	num_info = odp_pktio_extra_stat_info(pktio, NULL, 0);
+	CU_ASSERT(num_info >= 0);
+
+	num_stats = odp_pktio_extra_stats(pktio, NULL, 0);
+	CU_ASSERT(num_stats >= 0);
+
+	CU_ASSERT(num_info == num_stats);
+
+	if (num_info > 0 && num_info == num_stats) {
+		odp_pktio_extra_stat_info_t stats_info[num_stats];
+		uint64_t extra_stats[num_stats];
+
+		CU_ASSERT(odp_pktio_extra_stat_info(pktio, stats_info,
+						    num_info) == num_info);
+		CU_ASSERT(odp_pktio_extra_stats(pktio, extra_stats,
+						num_stats) == num_stats);
+
+		for (i = 0; i < num_stats; i++) {
+			uint64_t stat = 0;
+
+			CU_ASSERT(strlen(stats_info[i].name) > 0);
+			CU_ASSERT(odp_pktio_extra_stat_counter(pktio, i,
+							       &stat) == 0);
+		}
+
+		odp_pktio_extra_stats_print(pktio);
+	}
+
+	CU_ASSERT(odp_pktio_stop(pktio) == 0);
+	CU_ASSERT(odp_pktio_close(pktio) == 0);
+}
+
+static int pktio_check_pktin_hash_reta(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.hash.reta_update || capa.max_input_queues < 2)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static void pktio_test_pktin_hash_reta(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	odp_pktin_queue_param_t in_queue_param;
+	uint32_t reta_size, i;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+	CU_ASSERT_FATAL(odp_pktio_capability(pktio, &capa) == 0);
+
+	reta_size = capa.hash.reta_size;
+	CU_ASSERT_FATAL(reta_size > 0);
+
+	odp_pktin_queue_param_init(&in_queue_param);
+	in_queue_param.hash_enable = 1;
+	in_queue_param.num_queues = 2;
+	in_queue_param.hash_proto.proto.ipv4_udp = 1;
+
+	CU_ASSERT_FATAL(odp_pktin_queue_config(pktio, &in_queue_param) == 0);
+	CU_ASSERT_FATAL(odp_pktout_queue_config(pktio, NULL) == 0);
+
+	/* Interface must be started */
+	CU_ASSERT(odp_pktin_hash_balance(pktio) < 0);
+
+	CU_ASSERT_FATAL(odp_pktio_start(pktio) == 0);
+
+	uint32_t reta[reta_size];
+	uint32_t reta_out[reta_size];
+
+	ret = odp_pktin_hash_reta(pktio, reta, reta_size);
+	CU_ASSERT(ret == (int)reta_size);
+	for (i = 0; i < reta_size; i++)
+		CU_ASSERT(reta[i] < 2);
+
+	/* All entries into the second queue */
+	for (i = 0; i < reta_size; i++)
+		reta[i] = 1;
+	CU_ASSERT(odp_pktin_hash_reta_set(pktio, reta, reta_size) == 0);
+	CU_ASSERT(odp_pktin_hash_reta(pktio, reta_out, reta_size) ==
+		  (int)reta_size);
+	CU_ASSERT(memcmp(reta, reta_out, sizeof(reta)) == 0);
+
+	/* Alternating queues */
+	for (i = 0; i < reta_size; i++)
+		reta[i] = i % 2;
+	CU_ASSERT(odp_pktin_hash_reta_set(pktio, reta, reta_size) == 0);
+	CU_ASSERT(odp_pktin_hash_reta(pktio, reta_out, reta_size) ==
+		  (int)reta_size);
+	CU_ASSERT(memcmp(reta, reta_out, sizeof(reta)) == 0);
+
+	/* Bad table size and queue index */
+	CU_ASSERT(odp_pktin_hash_reta_set(pktio, reta, reta_size - 1) < 0);
+	reta[0] = 2;
+	CU_ASSERT(odp_pktin_hash_reta_set(pktio, reta, reta_size) < 0);
+
+	/* First call starts sampling, no load yet */
+	CU_ASSERT(odp_pktin_hash_balance(pktio) == 0);
+	CU_ASSERT(odp_pktin_hash_balance(pktio) == 0);
+
+	if (capa.hash.proto_update) {
+		odp_pktin_hash_proto_t hash_proto;
+
+		hash_proto.all_bits = 0;
+		hash_proto.proto.ipv4 = 1;
+		CU_ASSERT(odp_pktin_hash_proto_set(pktio, &hash_proto) == 0);
+	}
+
+	if (capa.hash.key_update) {
+		uint8_t key[capa.hash.key_size];
+
+		for (i = 0; i < capa.hash.key_size; i++)
+			key[i] = i;
+		CU_ASSERT(odp_pktin_hash_key_set(pktio, key,
+						 capa.hash.key_size) == 0);
+		CU_ASSERT(odp_pktin_hash_key_set(pktio, key,
+						 capa.hash.key_size + 1) < 0);
+	}
+
+	CU_ASSERT(odp_pktio_stop(pktio) == 0);
+	CU_ASSERT(odp_pktio_close(pktio) == 0);
+}
+
 static int pktio_check_start_stop(void)
 {
 	if (getenv("ODP_PKTIO_TEST_DISABLE_START_STOP"))
@@ -1993,6 +2373,93 @@ static void pktio_test_start_stop(void)
 		odp_event_free(ev);
 }
 
+static int pktio_check_pktin_backpressure(void)
+{
+	odp_queue_capability_t capa;
+
+	if (odp_queue_capability(&capa) || !capa.threshold)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static void pktio_test_pktin_backpressure(void)
+{
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	odp_pktio_t pktio_in;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pktout_queue_t pktout;
+	odp_packet_t pkt;
+	odp_packet_t tx_pkt[PKT_BUF_NUM];
+	uint32_t pkt_seq[PKT_BUF_NUM];
+	odp_event_t ev;
+	int i, round, pkts, alloc, empty;
+	uint64_t wait = odp_schedule_wait_time(ODP_TIME_MSEC_IN_NS);
+
+	for (i = 0; i < num_ifaces; i++) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_SCHED,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+	}
+
+	pktio_in = num_ifaces > 1 ? pktio[1] : pktio[0];
+
+	odp_pktin_queue_param_init(&pktin_param);
+	pktin_param.queue_param.sched.sync = ODP_SCHED_SYNC_ATOMIC;
+	pktin_param.queue_param.threshold.high = BP_THR_HIGH;
+	pktin_param.queue_param.threshold.low = BP_THR_LOW;
+	pktin_param.backpressure = 1;
+	CU_ASSERT_FATAL(odp_pktin_queue_config(pktio_in, &pktin_param) == 0);
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio[0], &pktout, 1) == 1);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+		_pktio_wait_linkup(pktio[i]);
+	}
+
+	/* Each round fills the event queue over the high threshold. Input
+	 * must be polled again after the application has drained the queue,
+	 * so that all packets are received. */
+	for (round = 0; round < BP_ROUNDS; round++) {
+		alloc = create_packets(tx_pkt, pkt_seq, PKT_BUF_NUM, pktio[0],
+				       pktio_in);
+		CU_ASSERT_FATAL(alloc > BP_THR_HIGH);
+		CU_ASSERT_FATAL(send_packets(pktout, tx_pkt, alloc) == 0);
+
+		pkts = 0;
+		empty = 0;
+
+		while (pkts < alloc && empty < 100) {
+			ev = odp_schedule(NULL, wait);
+
+			if (ev == ODP_EVENT_INVALID) {
+				empty++;
+				continue;
+			}
+
+			empty = 0;
+
+			if (odp_event_type(ev) == ODP_EVENT_PACKET) {
+				pkt = odp_packet_from_event(ev);
+				if (pktio_pkt_seq(pkt) != TEST_SEQ_INVALID)
+					pkts++;
+			}
+			odp_event_free(ev);
+		}
+
+		CU_ASSERT(pkts == alloc);
+	}
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT(odp_pktio_close(pktio[i]) == 0);
+	}
+
+	while ((ev = odp_schedule(NULL, wait)) != ODP_EVENT_INVALID)
+		odp_event_free(ev);
+}
+
 static void pktio_test_recv_on_wonly(void)
 {
 	odp_pktio_t pktio;
@@ -2164,6 +2631,948 @@ static void pktio_test_pktin_ts(void)
 	}
 }
 
+static int pktio_check_pktout_ts(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.config.pktout.bit.ts_ena)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static void pktio_test_pktout_ts(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	pktio_info_t pktio_rx_info;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	uint32_t pkt_seq[TX_BATCH_LEN];
+	odp_time_t ts_prev = ODP_TIME_NULL;
+	odp_time_t ts;
+	int num_ts = 0;
+	int ret;
+	int i, j;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.pktout.bit.ts_ena = i == 0;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+	pktio_rx_info.id   = pktio_rx;
+	pktio_rx_info.inq  = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	ret = create_packets(pkt_tbl, pkt_seq, TX_BATCH_LEN, pktio_tx,
+			     pktio_rx);
+	CU_ASSERT_FATAL(ret == TX_BATCH_LEN);
+
+	ret = odp_pktout_queue(pktio_tx, &pktout_queue, 1);
+	CU_ASSERT_FATAL(ret > 0);
+
+	/* Send packets one at a time and read output timestamp of each */
+	for (i = 0; i < TX_BATCH_LEN; i++) {
+		odp_packet_ts_request(pkt_tbl[i], 1);
+
+		CU_ASSERT_FATAL(odp_pktout_send(pktout_queue,
+						&pkt_tbl[i], 1) == 1);
+		ret = wait_for_packets(&pktio_rx_info, &pkt_tbl[i], &pkt_seq[i],
+				       1, TXRX_MODE_SINGLE, ODP_TIME_SEC_IN_NS);
+		CU_ASSERT(ret == 1);
+		if (ret != 1)
+			break;
+
+		/* Timestamp may become available after a delay */
+		for (j = 0; j < 100; j++) {
+			ret = odp_pktout_ts_read(pktio_tx, &ts);
+			if (ret <= 0)
+				break;
+			odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+		}
+		CU_ASSERT(ret >= 0);
+
+		if (ret == 0) {
+			CU_ASSERT(odp_time_cmp(ts, ts_prev) >= 0);
+			ts_prev = ts;
+			num_ts++;
+		}
+
+		odp_packet_free(pkt_tbl[i]);
+	}
+
+	for (i = i + 1; i < TX_BATCH_LEN; i++)
+		odp_packet_free(pkt_tbl[i]);
+
+	CU_ASSERT(num_ts > 0);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static int pktio_check_pktout_lso(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.config.enable_lso || !capa.lso.tcp_ipv4 ||
+	    capa.lso.max_payload_offset < LSO_HDR_LEN ||
+	    capa.lso.max_segments < LSO_NUM_SEGS)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static odp_packet_t pktio_create_lso_packet(void)
+{
+	odp_packet_t pkt;
+	odph_tcphdr_t *tcp;
+	uint8_t *buf;
+	uint32_t i;
+
+	pkt = odp_packet_alloc(default_pkt_pool, LSO_HDR_LEN + LSO_PAYLOAD_LEN);
+	if (pkt == ODP_PACKET_INVALID)
+		return pkt;
+
+	/* Headers must be contiguous (within the first segment) */
+	if (odp_packet_seg_len(pkt) < LSO_HDR_LEN) {
+		odp_packet_free(pkt);
+		return ODP_PACKET_INVALID;
+	}
+
+	buf = odp_packet_data(pkt);
+	pktio_init_packet_eth_ipv4(pkt, ODPH_IPPROTO_TCP);
+
+	odp_packet_l4_offset_set(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN);
+	tcp = (odph_tcphdr_t *)(buf + ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN);
+	memset(tcp, 0, ODPH_TCPHDR_LEN);
+	tcp->src_port = odp_cpu_to_be_16(LSO_SRC_PORT);
+	tcp->dst_port = odp_cpu_to_be_16(LSO_DST_PORT);
+	tcp->seq_no = odp_cpu_to_be_32(LSO_TCP_SEQ);
+	tcp->hl = ODPH_TCPHDR_LEN / 4;
+	tcp->ack = 1;
+	tcp->psh = 1;
+	tcp->window = odp_cpu_to_be_16(0xffff);
+
+	for (i = 0; i < LSO_PAYLOAD_LEN; i++) {
+		uint8_t byte = (uint8_t)i;
+
+		if (odp_packet_copy_from_mem(pkt, LSO_HDR_LEN + i, 1, &byte)) {
+			odp_packet_free(pkt);
+			return ODP_PACKET_INVALID;
+		}
+	}
+
+	return pkt;
+}
+
+/* Check an output packet of the LSO test and return its payload length,
+ * or -1 when the packet does not belong to the test. */
+static int pktio_check_lso_segment(odp_packet_t pkt, uint32_t *seq_out)
+{
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+	uint32_t len, payload_len, offset, i;
+	uint8_t byte;
+
+	len = odp_packet_len(pkt);
+	if (len < LSO_HDR_LEN)
+		return -1;
+
+	if (odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN, ODPH_IPV4HDR_LEN,
+				   &ip) ||
+	    odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN,
+				   ODPH_TCPHDR_LEN, &tcp))
+		return -1;
+
+	if (ip.proto != ODPH_IPPROTO_TCP ||
+	    odp_be_to_cpu_16(tcp.src_port) != LSO_SRC_PORT ||
+	    odp_be_to_cpu_16(tcp.dst_port) != LSO_DST_PORT)
+		return -1;
+
+	payload_len = odp_be_to_cpu_16(ip.tot_len) - ODPH_IPV4HDR_LEN -
+		      ODPH_TCPHDR_LEN;
+	CU_ASSERT(payload_len <= LSO_MAX_PAYLOAD);
+	CU_ASSERT(len >= LSO_HDR_LEN + payload_len);
+
+	/* Payload continues from where the TCP sequence number points to */
+	offset = odp_be_to_cpu_32(tcp.seq_no) - LSO_TCP_SEQ;
+	CU_ASSERT(offset + payload_len <= LSO_PAYLOAD_LEN);
+	*seq_out = offset;
+
+	for (i = 0; i < payload_len && LSO_HDR_LEN + i < len; i++) {
+		odp_packet_copy_to_mem(pkt, LSO_HDR_LEN + i, 1, &byte);
+		if (byte != (uint8_t)(offset + i)) {
+			CU_FAIL("LSO payload mismatch");
+			break;
+		}
+	}
+
+	return payload_len;
+}
+
+static void pktio_test_pktout_lso(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_pktin_queue_t pktin_queue;
+	odp_packet_lso_opt_t lso_opt;
+	odp_packet_t pkt;
+	odp_packet_t pkt_tbl[LSO_NUM_SEGS];
+	uint32_t next_seq = 0;
+	uint32_t seq;
+	uint64_t wait;
+	int num_segs = 0;
+	int total_len = 0;
+	int ret, len;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.enable_lso = 1;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout_queue, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin_queue, 1) == 1);
+
+	pkt = pktio_create_lso_packet();
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	pktio_pkt_set_macs(pkt, pktio_tx, pktio_rx);
+
+	lso_opt.payload_offset  = LSO_HDR_LEN;
+	lso_opt.max_payload_len = LSO_MAX_PAYLOAD;
+	CU_ASSERT_FATAL(odp_packet_lso_request(pkt, &lso_opt) == 0);
+	CU_ASSERT(odp_packet_has_lso_request(pkt));
+
+	CU_ASSERT_FATAL(odp_pktout_send(pktout_queue, &pkt, 1) == 1);
+
+	/* Receive output packets until all payload has been seen or
+	 * no more packets arrive */
+	wait = odp_pktin_wait_time(ODP_TIME_SEC_IN_NS);
+
+	while (total_len < LSO_PAYLOAD_LEN) {
+		ret = odp_pktin_recv_tmo(pktin_queue, pkt_tbl, LSO_NUM_SEGS,
+					 wait);
+		if (ret <= 0)
+			break;
+
+		for (i = 0; i < ret; i++) {
+			len = pktio_check_lso_segment(pkt_tbl[i], &seq);
+			odp_packet_free(pkt_tbl[i]);
+
+			if (len < 0)
+				continue;
+
+			/* Segments are sent in order */
+			CU_ASSERT(seq == next_seq);
+			next_seq = seq + len;
+			total_len += len;
+			num_segs++;
+		}
+	}
+
+	CU_ASSERT(total_len == LSO_PAYLOAD_LEN);
+	CU_ASSERT(num_segs == LSO_NUM_SEGS);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static int pktio_check_pktout_frag(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	uint32_t maxlen;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	maxlen = odp_pktout_maxlen(pktio);
+	(void)odp_pktio_close(pktio);
+
+	/* Test packet is 1.5 times the maximum frame length */
+	if (ret < 0 || !capa.config.enable_frag || !capa.frag.ipv4 ||
+	    capa.frag.max_frags < 2 || maxlen == 0 ||
+	    maxlen + maxlen / 2 > PKT_BUF_SIZE)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+/* Copy payload of an IPv4 fragment of the test packet into 'buf'. Returns
+ * payload length, or -1 when the packet is not a fragment of the test
+ * packet. */
+static int pktio_frag_payload(odp_packet_t pkt, uint16_t ip_id,
+			      uint32_t max_len, uint8_t *buf, int *last)
+{
+	odph_ipv4hdr_t ip;
+	odp_u16sum_t chksum, rx_chksum;
+	uint32_t hdr_len, len, offset;
+	uint16_t frag;
+
+	if (odp_packet_len(pkt) < ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN ||
+	    odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN, sizeof(ip), &ip))
+		return -1;
+
+	if (ODPH_IPV4HDR_VER(ip.ver_ihl) != ODPH_IPV4 ||
+	    ip.proto != ODPH_IPPROTO_UDP ||
+	    odp_be_to_cpu_16(ip.id) != ip_id ||
+	    odp_be_to_cpu_32(ip.src_addr) != 0x0a000001)
+		return -1;
+
+	hdr_len = ODPH_IPV4HDR_IHL(ip.ver_ihl) * 4;
+	len = odp_be_to_cpu_16(ip.tot_len) - hdr_len;
+	frag = odp_be_to_cpu_16(ip.frag_offset);
+	offset = ODPH_IPV4HDR_FRAG_OFFSET(frag) * 8;
+
+	CU_ASSERT(ODPH_IPV4HDR_IS_FRAGMENT(frag));
+	rx_chksum = ip.chksum;
+	CU_ASSERT(odph_ipv4_csum(pkt, ODPH_ETHHDR_LEN, &ip, &chksum) == 0);
+	CU_ASSERT(chksum == rx_chksum);
+	CU_ASSERT(odp_packet_len(pkt) >= ODPH_ETHHDR_LEN + hdr_len + len);
+	if (offset + len > max_len) {
+		CU_FAIL("Fragment out of range");
+		return -1;
+	}
+
+	CU_ASSERT(!odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN + hdr_len,
+					  len, buf + offset));
+	*last = !ODPH_IPV4HDR_FLAGS_MORE_FRAGS(frag);
+
+	return len;
+}
+
+static void pktio_test_pktout_frag(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	odp_pktio_capability_t capa;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_pktin_queue_t pktin_queue;
+	odp_packet_t pkt, ref;
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	odph_ipv4hdr_t ip;
+	uint32_t maxlen, pkt_len, ip_len;
+	uint64_t wait;
+	int num_frags = 0;
+	int total_len = 0;
+	int last_seen = 0;
+	int cksum_ena = 0;
+	int ret, len, last;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+		CU_ASSERT_FATAL(odp_pktio_capability(pktio[i], &capa) == 0);
+
+		odp_pktio_config_init(&config);
+		config.enable_frag = 1;
+
+		/* L4 checksum is inserted before fragmentation */
+		if (i == 0 && capa.config.pktout.bit.udp_chksum_ena &&
+		    capa.config.pktout.bit.udp_chksum) {
+			config.pktout.bit.udp_chksum_ena = 1;
+			config.pktout.bit.udp_chksum = 1;
+			cksum_ena = 1;
+		}
+
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout_queue, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin_queue, 1) == 1);
+
+	maxlen = odp_pktout_maxlen(pktio_tx);
+	pkt_len = maxlen + maxlen / 2;
+	ip_len = pkt_len - ODPH_ETHHDR_LEN;
+
+	pkt = odp_packet_alloc(default_pkt_pool, pkt_len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(pktio_init_packet_udp(pkt) != TEST_SEQ_INVALID);
+	pktio_pkt_set_macs(pkt, pktio_tx, pktio_rx);
+
+	/* Reference copy with the checksum that the output inserts */
+	ref = odp_packet_copy(pkt, default_pkt_pool);
+	CU_ASSERT_FATAL(ref != ODP_PACKET_INVALID);
+	if (cksum_ena) {
+		odph_udphdr_t *udp = odp_packet_l4_ptr(ref, NULL);
+
+		udp->chksum = odph_ipv4_udp_chksum(ref);
+	}
+
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(ref, ODPH_ETHHDR_LEN,
+					       sizeof(ip), &ip) == 0);
+
+	uint8_t ref_buf[ip_len];
+	uint8_t buf[ip_len];
+
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(ref, ODPH_ETHHDR_LEN +
+					       ODPH_IPV4HDR_LEN,
+					       ip_len - ODPH_IPV4HDR_LEN,
+					       ref_buf) == 0);
+	odp_packet_free(ref);
+
+	CU_ASSERT_FATAL(odp_pktout_send(pktout_queue, &pkt, 1) == 1);
+
+	/* Receive fragments until all payload has been seen or no more
+	 * packets arrive */
+	wait = odp_pktin_wait_time(ODP_TIME_SEC_IN_NS);
+
+	while (!last_seen || total_len < (int)(ip_len - ODPH_IPV4HDR_LEN)) {
+		ret = odp_pktin_recv_tmo(pktin_queue, pkt_tbl, TX_BATCH_LEN,
+					 wait);
+		if (ret <= 0)
+			break;
+
+		for (i = 0; i < ret; i++) {
+			CU_ASSERT(odp_packet_len(pkt_tbl[i]) <= maxlen);
+			len = pktio_frag_payload(pkt_tbl[i],
+						 odp_be_to_cpu_16(ip.id),
+						 ip_len - ODPH_IPV4HDR_LEN,
+						 buf, &last);
+			odp_packet_free(pkt_tbl[i]);
+
+			if (len < 0)
+				continue;
+
+			total_len += len;
+			last_seen |= last;
+			num_frags++;
+		}
+	}
+
+	CU_ASSERT(num_frags >= 2);
+	CU_ASSERT(last_seen);
+	CU_ASSERT(total_len == (int)(ip_len - ODPH_IPV4HDR_LEN));
+	if (total_len == (int)(ip_len - ODPH_IPV4HDR_LEN))
+		CU_ASSERT(!memcmp(buf, ref_buf, total_len));
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static int pktio_check_pktin_gro(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.config.enable_gro)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+/* Create a TCP segment of the GRO test. Payload bytes are numbered by
+ * their offset in the TCP stream. */
+static odp_packet_t pktio_create_gro_segment(uint32_t offset, int last)
+{
+	odp_packet_t pkt;
+	odph_tcphdr_t *tcp;
+	uint8_t *buf;
+	uint32_t i;
+
+	pkt = odp_packet_alloc(default_pkt_pool, LSO_HDR_LEN + GRO_SEG_LEN);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(odp_packet_seg_len(pkt) >= LSO_HDR_LEN);
+
+	buf = odp_packet_data(pkt);
+	pktio_init_packet_eth_ipv4(pkt, ODPH_IPPROTO_TCP);
+
+	odp_packet_l4_offset_set(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN);
+	tcp = (odph_tcphdr_t *)(buf + ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN);
+	memset(tcp, 0, ODPH_TCPHDR_LEN);
+	tcp->src_port = odp_cpu_to_be_16(GRO_SRC_PORT);
+	tcp->dst_port = odp_cpu_to_be_16(GRO_DST_PORT);
+	tcp->seq_no = odp_cpu_to_be_32(GRO_TCP_SEQ + offset);
+	tcp->ack_no = odp_cpu_to_be_32(1);
+	tcp->hl = ODPH_TCPHDR_LEN / 4;
+	tcp->ack = 1;
+	tcp->psh = last;
+	tcp->window = odp_cpu_to_be_16(0xffff);
+
+	for (i = 0; i < GRO_SEG_LEN; i++) {
+		uint8_t byte = (uint8_t)(offset + i);
+
+		CU_ASSERT_FATAL(odp_packet_copy_from_mem(pkt, LSO_HDR_LEN + i,
+							 1, &byte) == 0);
+	}
+
+	/* Segments with bad checksum are not coalesced */
+	odp_packet_has_ipv4_set(pkt, 1);
+	odp_packet_has_tcp_set(pkt, 1);
+	CU_ASSERT_FATAL(odph_tcp_chksum_set(pkt) == 0);
+
+	return pkt;
+}
+
+/* Check a received packet of the GRO test and return its payload length,
+ * or -1 when the packet does not belong to the test. */
+static int pktio_check_gro_packet(odp_packet_t pkt, uint32_t *offset_out)
+{
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+	uint32_t len, payload_len, offset, i;
+	uint8_t byte;
+
+	len = odp_packet_len(pkt);
+	if (len < LSO_HDR_LEN)
+		return -1;
+
+	if (odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN, ODPH_IPV4HDR_LEN,
+				   &ip) ||
+	    odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN,
+				   ODPH_TCPHDR_LEN, &tcp))
+		return -1;
+
+	if (ip.proto != ODPH_IPPROTO_TCP ||
+	    odp_be_to_cpu_16(tcp.src_port) != GRO_SRC_PORT ||
+	    odp_be_to_cpu_16(tcp.dst_port) != GRO_DST_PORT)
+		return -1;
+
+	/* IP length matches the (coalesced) packet */
+	payload_len = odp_be_to_cpu_16(ip.tot_len) - ODPH_IPV4HDR_LEN -
+		      ODPH_TCPHDR_LEN;
+	CU_ASSERT(len >= LSO_HDR_LEN + payload_len);
+	CU_ASSERT(payload_len % GRO_SEG_LEN == 0);
+	CU_ASSERT(odp_packet_l4_chksum_status(pkt) != ODP_PACKET_CHKSUM_BAD);
+
+	offset = odp_be_to_cpu_32(tcp.seq_no) - GRO_TCP_SEQ;
+	CU_ASSERT(offset + payload_len <= GRO_NUM_SEGS * GRO_SEG_LEN);
+	*offset_out = offset;
+
+	/* Only the last segment has PSH set */
+	CU_ASSERT(tcp.psh == (offset + payload_len ==
+			      GRO_NUM_SEGS * GRO_SEG_LEN));
+
+	for (i = 0; i < payload_len && LSO_HDR_LEN + i < len; i++) {
+		odp_packet_copy_to_mem(pkt, LSO_HDR_LEN + i, 1, &byte);
+		if (byte != (uint8_t)(offset + i)) {
+			CU_FAIL("GRO payload mismatch");
+			break;
+		}
+	}
+
+	return payload_len;
+}
+
+/* Send TCP segments of a flow in a single burst and check that they are
+ * received as one packet when GRO is enabled on the input queue, or as
+ * separate packets when it is not. Segments are given time to arrive into
+ * the interface, so that a single receive call returns all of them. */
+static void pktio_test_gro(int queue_gro)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	odp_pktio_config_t config;
+	odp_pktin_queue_param_t pktin_param;
+	odp_pktout_queue_t pktout_queue;
+	odp_pktin_queue_t pktin_queue;
+	odp_packet_t seg[GRO_NUM_SEGS];
+	odp_packet_t pkt_tbl[GRO_NUM_SEGS];
+	uint32_t next_offset = 0;
+	uint32_t offset;
+	uint64_t wait;
+	int num_pkts = 0;
+	int total_len = 0;
+	int ret, len;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.enable_gro = 1;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		odp_pktin_queue_param_init(&pktin_param);
+		pktin_param.enable_gro[0] = queue_gro;
+		CU_ASSERT_FATAL(odp_pktin_queue_config(pktio[i],
+						       &pktin_param) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout_queue, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin_queue, 1) == 1);
+
+	for (i = 0; i < GRO_NUM_SEGS; i++) {
+		seg[i] = pktio_create_gro_segment(i * GRO_SEG_LEN,
+						  i == GRO_NUM_SEGS - 1);
+		pktio_pkt_set_macs(seg[i], pktio_tx, pktio_rx);
+	}
+
+	CU_ASSERT_FATAL(odp_pktout_send(pktout_queue, seg, GRO_NUM_SEGS) ==
+			GRO_NUM_SEGS);
+
+	odp_time_wait_ns(GRO_WAIT_NS);
+	wait = odp_pktin_wait_time(ODP_TIME_SEC_IN_NS);
+
+	while (total_len < GRO_NUM_SEGS * GRO_SEG_LEN) {
+		ret = odp_pktin_recv_tmo(pktin_queue, pkt_tbl, GRO_NUM_SEGS,
+					 wait);
+		if (ret <= 0)
+			break;
+
+		for (i = 0; i < ret; i++) {
+			len = pktio_check_gro_packet(pkt_tbl[i], &offset);
+			odp_packet_free(pkt_tbl[i]);
+
+			if (len < 0)
+				continue;
+
+			CU_ASSERT(offset == next_offset);
+			next_offset = offset + len;
+			total_len += len;
+			num_pkts++;
+		}
+	}
+
+	CU_ASSERT(total_len == GRO_NUM_SEGS * GRO_SEG_LEN);
+	CU_ASSERT(num_pkts == (queue_gro ? 1 : GRO_NUM_SEGS));
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static void pktio_test_pktin_gro(void)
+{
+	pktio_test_gro(1);
+}
+
+static void pktio_test_pktin_gro_queue_disabled(void)
+{
+	pktio_test_gro(0);
+}
+
+static int pktio_check_pktin_reass(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.reassembly.ipv4 ||
+	    capa.reassembly.max_num_frags < REASS_NUM_FRAGS)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+/* Create an IPv4 fragment of the test packet */
+static odp_packet_t pktio_create_frag(odp_packet_t pkt, uint32_t offset,
+				      uint32_t len, int more)
+{
+	odp_packet_t frag;
+	odph_ipv4hdr_t *ip;
+	uint32_t hdr_len = ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN;
+
+	frag = odp_packet_alloc(default_pkt_pool, hdr_len + len);
+	CU_ASSERT_FATAL(frag != ODP_PACKET_INVALID);
+
+	CU_ASSERT_FATAL(odp_packet_copy_from_pkt(frag, 0, pkt, 0,
+						 hdr_len) == 0);
+	CU_ASSERT_FATAL(odp_packet_copy_from_pkt(frag, hdr_len, pkt,
+						 hdr_len + offset, len) == 0);
+
+	odp_packet_l2_offset_set(frag, 0);
+	odp_packet_l3_offset_set(frag, ODPH_ETHHDR_LEN);
+	ip = odp_packet_l3_ptr(frag, NULL);
+	ip->tot_len = odp_cpu_to_be_16(ODPH_IPV4HDR_LEN + len);
+	ip->frag_offset = odp_cpu_to_be_16((more ? 0x2000 : 0) | offset / 8);
+	ip->chksum = 0;
+	odph_ipv4_csum_update(frag);
+
+	return frag;
+}
+
+/* Send the test packet as IPv4 fragments, or only the first fragment when
+ * 'complete' is zero, and check reassembly status of the received packet.
+ * Incomplete fragments are passed after the maximum wait time, also when
+ * no other packets are received. */
+static void pktio_test_reass(odp_pktin_mode_t in_mode, int complete)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	pktio_info_t pktio_rx_info;
+	odp_pktio_capability_t capa;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_packet_t pkt, rx_pkt;
+	odp_packet_t frag[REASS_NUM_FRAGS];
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	odph_ipv4hdr_t ip;
+	odp_time_t end;
+	uint64_t wait_ns;
+	uint32_t payload_len = REASS_PKT_LEN - ODPH_ETHHDR_LEN -
+			       ODPH_IPV4HDR_LEN;
+	/* Fragment offsets are in 8 byte units */
+	uint32_t frag_len = (payload_len / REASS_NUM_FRAGS + 7) & ~7u;
+	uint16_t ip_id, frag_offset;
+	uint8_t ref_buf[payload_len];
+	uint8_t buf[payload_len];
+	int num_frags = complete ? REASS_NUM_FRAGS : 1;
+	int i, num;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, in_mode, ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+		CU_ASSERT_FATAL(odp_pktio_capability(pktio[i], &capa) == 0);
+
+		odp_pktio_config_init(&config);
+		config.reassembly.en_ipv4 = 1;
+		config.reassembly.max_num_frags = REASS_NUM_FRAGS;
+		if (!complete && capa.reassembly.max_wait_time >= REASS_TMO_NS)
+			config.reassembly.max_wait_time = REASS_TMO_NS;
+
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout_queue, 1) == 1);
+
+	pktio_rx_info.id = pktio_rx;
+	pktio_rx_info.inq = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = in_mode;
+
+	pkt = odp_packet_alloc(default_pkt_pool, REASS_PKT_LEN);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(pktio_init_packet_udp(pkt) != TEST_SEQ_INVALID);
+	pktio_pkt_set_macs(pkt, pktio_tx, pktio_rx);
+
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN,
+					       sizeof(ip), &ip) == 0);
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN +
+					       ODPH_IPV4HDR_LEN, payload_len,
+					       ref_buf) == 0);
+	ip_id = odp_be_to_cpu_16(ip.id);
+
+	for (i = 0; i < REASS_NUM_FRAGS; i++) {
+		uint32_t offset = i * frag_len;
+		int last = (i == REASS_NUM_FRAGS - 1);
+
+		frag[i] = pktio_create_frag(pkt, offset,
+					    last ? payload_len - offset :
+					    frag_len, !last);
+	}
+	odp_packet_free(pkt);
+
+	/* Out of order fragments */
+	if (complete) {
+		pkt = frag[0];
+		frag[0] = frag[REASS_NUM_FRAGS - 1];
+		frag[REASS_NUM_FRAGS - 1] = pkt;
+	}
+
+	CU_ASSERT_FATAL(odp_pktout_send(pktout_queue, frag, num_frags) ==
+			num_frags);
+	if (!complete)
+		odp_packet_free_multi(&frag[1], REASS_NUM_FRAGS - 1);
+
+	/* Poll until the test packet has been received */
+	rx_pkt = ODP_PACKET_INVALID;
+	wait_ns = ODP_TIME_SEC_IN_NS;
+	if (!complete)
+		wait_ns += config.reassembly.max_wait_time ?
+			   config.reassembly.max_wait_time :
+			   capa.reassembly.max_wait_time;
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(wait_ns));
+
+	while (rx_pkt == ODP_PACKET_INVALID &&
+	       odp_time_cmp(end, odp_time_local()) > 0) {
+		num = get_packets(&pktio_rx_info, pkt_tbl, TX_BATCH_LEN,
+				  TXRX_MODE_MULTI);
+		if (num < 0)
+			break;
+
+		for (i = 0; i < num; i++) {
+			odp_packet_t tmp = pkt_tbl[i];
+
+			if (rx_pkt == ODP_PACKET_INVALID &&
+			    odp_packet_len(tmp) >= ODPH_ETHHDR_LEN +
+			    ODPH_IPV4HDR_LEN &&
+			    !odp_packet_copy_to_mem(tmp, ODPH_ETHHDR_LEN,
+						    sizeof(ip), &ip) &&
+			    odp_be_to_cpu_16(ip.id) == ip_id &&
+			    odp_be_to_cpu_32(ip.src_addr) == 0x0a000001)
+				rx_pkt = tmp;
+			else
+				odp_packet_free(tmp);
+		}
+	}
+
+	CU_ASSERT_FATAL(rx_pkt != ODP_PACKET_INVALID);
+	frag_offset = odp_be_to_cpu_16(ip.frag_offset);
+
+	if (complete) {
+		CU_ASSERT(odp_packet_reass_status(rx_pkt) ==
+			  ODP_PACKET_REASS_COMPLETE);
+		CU_ASSERT(!ODPH_IPV4HDR_IS_FRAGMENT(frag_offset));
+		CU_ASSERT(odp_be_to_cpu_16(ip.tot_len) ==
+			  ODPH_IPV4HDR_LEN + payload_len);
+		CU_ASSERT_FATAL(odp_packet_len(rx_pkt) >= REASS_PKT_LEN);
+		CU_ASSERT(!odp_packet_copy_to_mem(rx_pkt, ODPH_ETHHDR_LEN +
+						  ODPH_IPV4HDR_LEN,
+						  payload_len, buf));
+		CU_ASSERT(!memcmp(buf, ref_buf, payload_len));
+	} else {
+		CU_ASSERT(odp_packet_reass_status(rx_pkt) ==
+			  ODP_PACKET_REASS_INCOMPLETE);
+		CU_ASSERT(ODPH_IPV4HDR_FLAGS_MORE_FRAGS(frag_offset));
+		CU_ASSERT(ODPH_IPV4HDR_FRAG_OFFSET(frag_offset) == 0);
+		CU_ASSERT(odp_be_to_cpu_16(ip.tot_len) ==
+			  ODPH_IPV4HDR_LEN + frag_len);
+	}
+	odp_packet_free(rx_pkt);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		flush_input_queue(pktio[i], in_mode);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static void pktio_test_pktin_reass(void)
+{
+	pktio_test_reass(ODP_PKTIN_MODE_DIRECT, 1);
+}
+
+static void pktio_test_pktin_reass_tmo(void)
+{
+	pktio_test_reass(ODP_PKTIN_MODE_DIRECT, 0);
+}
+
+static void pktio_test_pktin_reass_tmo_sched(void)
+{
+	pktio_test_reass(ODP_PKTIN_MODE_SCHED, 0);
+}
+
 static void pktio_test_chksum(void (*config_fn)(odp_pktio_t, odp_pktio_t),
 			      void (*prep_fn)(odp_packet_t pkt),
 			      void (*test_fn)(odp_packet_t pkt))
@@ -2957,6 +4366,7 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 	ODP_TEST_INFO(pktio_test_plain_multi),
 	ODP_TEST_INFO(pktio_test_sched_queue),
 	ODP_TEST_INFO(pktio_test_sched_multi),
+	ODP_TEST_INFO(pktio_test_sched_idle),
 	ODP_TEST_INFO(pktio_test_recv),
 	ODP_TEST_INFO(pktio_test_recv_multi),
 	ODP_TEST_INFO(pktio_test_recv_queue),
@@ -2968,6 +4378,8 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 	ODP_TEST_INFO(pktio_test_mac),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_start_stop,
 				  pktio_check_start_stop),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_backpressure,
+				  pktio_check_pktin_backpressure),
 	ODP_TEST_INFO(pktio_test_recv_on_wonly),
 	ODP_TEST_INFO(pktio_test_send_on_ronly),
 	ODP_TEST_INFO(pktio_test_plain_multi_event),
@@ -2975,8 +4387,29 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 	ODP_TEST_INFO(pktio_test_recv_multi_event),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_statistics_counters,
 				  pktio_check_statistics_counters),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_queue_statistics_counters,
+				  pktio_check_queue_statistics_counters),
+	ODP_TEST_INFO(pktio_test_extra_stats),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_hash_reta,
+				  pktio_check_pktin_hash_reta),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_ts,
 				  pktio_check_pktin_ts),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktout_ts,
+				  pktio_check_pktout_ts),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktout_lso,
+				  pktio_check_pktout_lso),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktout_frag,
+				  pktio_check_pktout_frag),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_gro,
+				  pktio_check_pktin_gro),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_gro_queue_disabled,
+				  pktio_check_pktin_gro),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_reass,
+				  pktio_check_pktin_reass),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_reass_tmo,
+				  pktio_check_pktin_reass),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_reass_tmo_sched,
+				  pktio_check_pktin_reass),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_chksum_in_ipv4,
 				  pktio_check_chksum_in_ipv4),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_chksum_in_udp,
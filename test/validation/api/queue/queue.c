@@ -14,6 +14,9 @@
 #define GLOBALS_NAME		"queue_test_globals"
 #define DEQ_RETRIES             100
 #define ENQ_RETRIES             100
+#define THR_NUM_EVENT           (100 * 1000)
+#define THR_HIGH                16
+#define THR_LOW                 4
 
 typedef struct {
 	pthrd_arg        cu_thr;
@@ -33,6 +36,12 @@ typedef struct {
 		odp_atomic_u32_t counter;
 	} pair;
 
+	struct {
+		odp_queue_t queue;
+		odp_barrier_t barrier;
+		odp_atomic_u32_t counter;
+	} thr;
+
 	struct {
 		uint32_t num_event;
 	} thread[ODP_THREAD_COUNT_MAX];
@@ -695,6 +704,101 @@ static void queue_test_param(void)
 	CU_ASSERT(odp_queue_destroy(queue) == 0);
 }
 
+static void queue_test_threshold(void)
+{
+	odp_queue_capability_t capa;
+	odp_queue_param_t param;
+	odp_pool_param_t pool_param;
+	odp_pool_t notif_pool;
+	odp_queue_t notif_queue, queue;
+	odp_queue_threshold_notif_t *notif;
+	odp_event_t ev;
+	odp_buffer_t buf;
+	int i;
+	const uint32_t high = 16;
+	const uint32_t low = 4;
+
+	CU_ASSERT_FATAL(odp_queue_capability(&capa) == 0);
+
+	if (!capa.threshold) {
+		printf("\n    Queue thresholds NOT supported\n");
+		return;
+	}
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_BUFFER;
+	pool_param.buf.size = sizeof(odp_queue_threshold_notif_t);
+	pool_param.buf.num = 8;
+
+	notif_pool = odp_pool_create("notif_pool", &pool_param);
+	CU_ASSERT_FATAL(notif_pool != ODP_POOL_INVALID);
+
+	notif_queue = odp_queue_create("notif_queue", NULL);
+	CU_ASSERT_FATAL(notif_queue != ODP_QUEUE_INVALID);
+
+	odp_queue_param_init(&param);
+	CU_ASSERT(param.threshold.high == 0);
+	CU_ASSERT(param.threshold.notif_queue == ODP_QUEUE_INVALID);
+
+	/* Low threshold must be below high threshold */
+	param.size = 2 * high;
+	param.threshold.high = low;
+	param.threshold.low = high;
+	CU_ASSERT(odp_queue_create("thr_queue", &param) == ODP_QUEUE_INVALID);
+
+	param.threshold.high = high;
+	param.threshold.low = low;
+	param.threshold.notif_queue = notif_queue;
+	param.threshold.notif_pool = notif_pool;
+
+	queue = odp_queue_create("thr_queue", &param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+	CU_ASSERT(odp_queue_congested(queue) == 0);
+
+	for (i = 0; i < (int)high; i++) {
+		CU_ASSERT(odp_queue_congested(queue) == 0);
+		buf = odp_buffer_alloc(pool);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+		CU_ASSERT(odp_queue_enq(queue, odp_buffer_to_event(buf)) == 0);
+	}
+
+	CU_ASSERT(odp_queue_congested(queue) == 1);
+
+	ev = odp_queue_deq(notif_queue);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	notif = odp_buffer_addr(odp_buffer_from_event(ev));
+	CU_ASSERT(notif->queue == queue);
+	CU_ASSERT(notif->congested);
+	CU_ASSERT(notif->depth >= high);
+	odp_event_free(ev);
+
+	for (i = high; i > (int)low; i--) {
+		CU_ASSERT(odp_queue_congested(queue) == 1);
+		ev = odp_queue_deq(queue);
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+		odp_event_free(ev);
+	}
+
+	CU_ASSERT(odp_queue_congested(queue) == 0);
+
+	ev = odp_queue_deq(notif_queue);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	notif = odp_buffer_addr(odp_buffer_from_event(ev));
+	CU_ASSERT(notif->queue == queue);
+	CU_ASSERT(!notif->congested);
+	CU_ASSERT(notif->depth <= low);
+	odp_event_free(ev);
+
+	CU_ASSERT(odp_queue_deq(notif_queue) == ODP_EVENT_INVALID);
+
+	while ((ev = odp_queue_deq(queue)) != ODP_EVENT_INVALID)
+		odp_event_free(ev);
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_queue_destroy(notif_queue) == 0);
+	CU_ASSERT(odp_pool_destroy(notif_pool) == 0);
+}
+
 static void queue_test_info(void)
 {
 	odp_queue_t q_plain, q_order;
@@ -816,6 +920,122 @@ static uint32_t dequeue_and_free_all(odp_queue_t queue)
 	return num;
 }
 
+static int queue_thr_work_loop(void *arg)
+{
+	odp_event_t ev;
+	odp_buffer_t buf;
+	int producer;
+	uint32_t num = 0;
+	test_globals_t *globals = arg;
+	odp_queue_t queue = globals->thr.queue;
+
+	producer = odp_atomic_fetch_inc_u32(&globals->thr.counter) == 0;
+
+	odp_barrier_wait(&globals->thr.barrier);
+
+	while (num < THR_NUM_EVENT) {
+		if (producer) {
+			buf = odp_buffer_alloc(pool);
+
+			if (buf == ODP_BUFFER_INVALID) {
+				odp_cpu_pause();
+				continue;
+			}
+
+			ev = odp_buffer_to_event(buf);
+
+			if (odp_queue_enq(queue, ev)) {
+				CU_FAIL("Enqueue failed");
+				odp_event_free(ev);
+				return -1;
+			}
+		} else {
+			ev = odp_queue_deq(queue);
+
+			if (ev == ODP_EVENT_INVALID) {
+				odp_cpu_pause();
+				continue;
+			}
+
+			odp_event_free(ev);
+		}
+
+		num++;
+	}
+
+	return 0;
+}
+
+/* Producer and consumer threads move the queue depth concurrently across
+ * both thresholds. Congestion state must not be left set when the queue
+ * has been emptied. */
+static void test_threshold_mt(odp_queue_op_mode_t op_mode)
+{
+	odp_queue_capability_t capa;
+	odp_queue_param_t param;
+	odp_shm_t shm;
+	test_globals_t *globals;
+	odp_queue_t queue;
+
+	CU_ASSERT_FATAL(odp_queue_capability(&capa) == 0);
+
+	if (!capa.threshold) {
+		printf("\n    Queue thresholds NOT supported\n");
+		return;
+	}
+
+	shm = odp_shm_lookup(GLOBALS_NAME);
+	CU_ASSERT_FATAL(shm != ODP_SHM_INVALID);
+	globals = odp_shm_addr(shm);
+
+	odp_queue_param_init(&param);
+	param.size = MAX_NUM_EVENT;
+	param.enq_mode = op_mode;
+	param.deq_mode = op_mode;
+	param.threshold.high = THR_HIGH;
+	param.threshold.low = THR_LOW;
+
+	if (capa.plain.max_size && param.size > capa.plain.max_size)
+		param.size = capa.plain.max_size;
+
+	queue = odp_queue_create("thr_queue_mt", &param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	globals->thr.queue = queue;
+	odp_barrier_init(&globals->thr.barrier, 2);
+	odp_atomic_init_u32(&globals->thr.counter, 0);
+
+	/* Create one worker thread, this thread is the other one */
+	globals->cu_thr.numthrds = 1;
+	odp_cunit_thread_create(queue_thr_work_loop, (pthrd_arg *)globals);
+
+	CU_ASSERT(queue_thr_work_loop(globals) == 0);
+
+	odp_cunit_thread_exit((pthrd_arg *)globals);
+
+	/* Consumer has emptied the queue */
+	CU_ASSERT(odp_queue_deq(queue) == ODP_EVENT_INVALID);
+	CU_ASSERT(odp_queue_congested(queue) == 0);
+
+	/* State follows single threaded operations after the test */
+	CU_ASSERT(alloc_and_enqueue(queue, pool, THR_HIGH) == THR_HIGH);
+	CU_ASSERT(odp_queue_congested(queue) == 1);
+	CU_ASSERT(dequeue_and_free_all(queue) == THR_HIGH);
+	CU_ASSERT(odp_queue_congested(queue) == 0);
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+}
+
+static void queue_test_threshold_mt(void)
+{
+	test_threshold_mt(ODP_QUEUE_OP_MT);
+}
+
+static void queue_test_threshold_mt_spsc(void)
+{
+	test_threshold_mt(ODP_QUEUE_OP_MT_UNSAFE);
+}
+
 static int enqueue_with_retry(odp_queue_t queue, odp_event_t ev)
 {
 	int i;
@@ -983,6 +1203,9 @@ odp_testinfo_t queue_suite[] = {
 	ODP_TEST_INFO(queue_test_pair_lf_spsc),
 	ODP_TEST_INFO(queue_test_param),
 	ODP_TEST_INFO(queue_test_info),
+	ODP_TEST_INFO(queue_test_threshold),
+	ODP_TEST_INFO(queue_test_threshold_mt),
+	ODP_TEST_INFO(queue_test_threshold_mt_spsc),
 	ODP_TEST_INFO(queue_test_mt_plain_block),
 	ODP_TEST_INFO(queue_test_mt_plain_nonblock_lf),
 	ODP_TEST_INFO_NULL,